@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_BENCHMARK_H
+#define BOOLEVAL_BENCHMARK_H
+
+#include <chrono>
+#include <string>
+#include <iomanip>
+#include <iostream>
+
+namespace benchmark {
+
+/**
+ * Prevents the compiler from optimizing away the computed value.
+ *
+ * @param value Value to keep alive
+ */
+template <typename T>
+inline void do_not_optimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r"(&value) : "memory");
+#else
+    static volatile char sink;
+    sink = *reinterpret_cast<volatile char const*>(&value);
+#endif
+}
+
+/**
+ * Runs the function the specified number of times and prints
+ * the average duration of a single run.
+ *
+ * @param name       Name of the measured operation
+ * @param iterations Number of times to run the function
+ * @param func       Function to measure
+ *
+ * @return Average duration of a single run in nanoseconds
+ */
+template <typename F>
+double measure(std::string const& name, std::size_t const iterations, F&& func) {
+    auto const start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        func(i);
+    }
+    auto const end = std::chrono::steady_clock::now();
+
+    auto const total = std::chrono::duration<double, std::nano>(end - start).count();
+    auto const average = total / static_cast<double>(iterations);
+
+    std::cout << std::left << std::setw(48) << name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(2)
+              << average << " ns/op" << std::endl;
+
+    return average;
+}
+
+} // benchmark
+
+#endif // BOOLEVAL_BENCHMARK_H
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <chrono>
+#include <string>
+#include <cstring>
+#include <iomanip>
+#include <vector>
+#include <iostream>
+#include <booleval/io/binary_filter.hpp>
+#include "benchmark.hpp"
+
+namespace {
+
+constexpr std::size_t record_size{ 32 };
+
+/**
+ * Generates records of the following layout: uint64 id, int32 quantity,
+ * float64 price, string[8] symbol and 4 bytes of padding.
+ */
+std::string generate_records(std::size_t const count) {
+    static char const* symbols[] = { "AAPL", "MSFT", "GOOG", "AMZN" };
+
+    std::string buffer(count * record_size, '\0');
+    for (std::size_t i = 0; i < count; ++i) {
+        auto const record = &buffer[i * record_size];
+
+        auto const id = static_cast<uint64_t>(i);
+        auto const quantity = static_cast<int32_t>(i % 1000);
+        auto const price = static_cast<double>(i % 10000) / 100.0;
+
+        std::memcpy(record, &id, sizeof(id));
+        std::memcpy(record + 8, &quantity, sizeof(quantity));
+        std::memcpy(record + 12, &price, sizeof(price));
+        std::memcpy(record + 20, symbols[i % 4], 4);
+    }
+
+    return buffer;
+}
+
+} // namespace
+
+int main() {
+    using namespace booleval;
+
+    constexpr std::size_t count{ 8 << 20 };
+    auto const buffer = generate_records(count);
+
+    auto const schema = io::binary_schema::parse(
+        "id        uint64     0\n"
+        "quantity  int32      8\n"
+        "price     float64    12\n"
+        "symbol    string[8]  20\n"
+        "record_size 32\n"
+    );
+
+    char const* expressions[] = {
+        "quantity < 100",
+        "symbol AAPL and price > 50.5",
+        "quantity > 990 or id 42",
+        "quantity < 20 and symbol AAPL and price > 50.5",
+        "quantity < 20 and symbol like \"%PL\"",
+        "quantity >= 20 or symbol like \"%PL\""
+    };
+
+    std::cout << "Filtering " << count << " binary records of " << record_size << " bytes" << std::endl;
+    for (auto const expression : expressions) {
+        io::binary_filter filter{ schema };
+        if (!filter.expression(expression)) {
+            std::cerr << "Expression not valid!" << std::endl;
+            return 1;
+        }
+
+        auto const start = std::chrono::steady_clock::now();
+        auto const matches = filter.for_each_match(buffer, [](auto const index, auto const&) {
+            benchmark::do_not_optimize(index);
+        });
+        auto const end = std::chrono::steady_clock::now();
+
+        std::size_t row_matches{ 0 };
+        auto const row_start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < count; ++i) {
+            row_matches += filter.matches(io::binary_record(buffer.data() + i * record_size, record_size)) ? 1 : 0;
+        }
+        auto const row_end = std::chrono::steady_clock::now();
+
+        auto const batch = std::chrono::duration<double, std::nano>(end - start).count() / count;
+        auto const row = std::chrono::duration<double, std::nano>(row_end - row_start).count() / count;
+        std::cout << std::left << std::setw(40) << expression
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(8) << batch << " ns/record (batch)"
+                  << std::setw(8) << row << " ns/record (row)"
+                  << std::setw(10) << matches << " matches"
+                  << (matches == row_matches ? "" : " MISMATCH") << std::endl;
+    }
+
+    // The records are sorted by id, so the statistics of the ids skip most blocks
+    std::vector<uint64_t> ids(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        std::memcpy(&ids[i], buffer.data() + i * record_size, sizeof(uint64_t));
+    }
+
+    io::zone_map zones{ io::binary_batch::block_size };
+    zones.add("id", ids);
+
+    std::cout << std::endl << "Filtering with zone maps" << std::endl;
+    for (auto const expression : { "id >= 8000000 and quantity < 100", "id < 100000 or id > 8300000" }) {
+        io::binary_filter filter{ schema };
+        if (!filter.expression(expression)) {
+            std::cerr << "Expression not valid!" << std::endl;
+            return 1;
+        }
+
+        utils::bitmap bits;
+        auto const start = std::chrono::steady_clock::now();
+        auto const matches = filter.evaluate(buffer, bits);
+        auto const end = std::chrono::steady_clock::now();
+
+        utils::bitmap zone_bits;
+        auto const zone_start = std::chrono::steady_clock::now();
+        auto const zone_matches = filter.evaluate(buffer, zones, zone_bits);
+        auto const zone_end = std::chrono::steady_clock::now();
+
+        auto const batch = std::chrono::duration<double, std::nano>(end - start).count() / count;
+        auto const zone = std::chrono::duration<double, std::nano>(zone_end - zone_start).count() / count;
+        std::cout << std::left << std::setw(40) << expression
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(8) << batch << " ns/record (batch)"
+                  << std::setw(8) << zone << " ns/record (zone map)"
+                  << std::setw(10) << zone_matches << " matches"
+                  << (matches == zone_matches && bits == zone_bits ? "" : " MISMATCH") << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <random>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <booleval/evaluator.hpp>
+#include <booleval/typed_evaluator.hpp>
+#include "benchmark.hpp"
+
+namespace {
+
+struct event {
+    std::string level;
+    std::string host;
+    unsigned status{ 0 };
+    double latency{ 0 };
+};
+
+} // namespace
+
+int main() {
+    using namespace booleval;
+
+    std::mt19937 generator{ 42 };
+    char const* levels[] = { "debug", "info", "warning", "error" };
+    char const* hosts[] = { "api.example.com", "www.example.com", "cdn.example.net" };
+    unsigned const statuses[] = { 200, 200, 200, 301, 404, 500, 503 };
+
+    std::vector<event> events(4096);
+    for (auto& e : events) {
+        e.level = levels[generator() % std::size(levels)];
+        e.host = hosts[generator() % std::size(hosts)];
+        e.status = statuses[generator() % std::size(statuses)];
+        e.latency = static_cast<double>(generator() % 2000) / 1000.0;
+    }
+
+    char const* expressions[] = {
+        "status >= 500",
+        "level error and host api.example.com",
+        "(status >= 500 or latency > 1.5) and host ends_with .com",
+        "(level error or level warning) and (status 404 or status 503 or latency > 1.9)"
+    };
+
+    constexpr std::size_t iterations{ 1000000 };
+    for (auto const expression : expressions) {
+        evaluator<> e({
+            { "level",   &event::level },
+            { "host",    &event::host },
+            { "status",  &event::status },
+            { "latency", &event::latency }
+        });
+
+        if (!e.expression(expression)) {
+            std::cerr << "Invalid expression: " << expression << std::endl;
+            return 1;
+        }
+
+        std::cout << std::endl << expression << std::endl;
+
+        benchmark::measure("tree visitor", iterations, [&](auto const i) {
+            benchmark::do_not_optimize(e.evaluate(events[i % events.size()]));
+        });
+
+        auto const closures = e.compile<event>();
+        benchmark::measure("closure tree", iterations, [&](auto const i) {
+            benchmark::do_not_optimize(closures.evaluate(events[i % events.size()]));
+        });
+
+        typed_evaluator<event> typed({
+            { "level",   &event::level },
+            { "host",    &event::host },
+            { "status",  &event::status },
+            { "latency", &event::latency }
+        });
+        [[maybe_unused]] auto const valid = typed.expression(expression);
+        benchmark::measure("typed evaluator", iterations, [&](auto const i) {
+            benchmark::do_not_optimize(typed.evaluate(events[i % events.size()]));
+        });
+
+        [[maybe_unused]] auto const compiled = e.compile_decision_diagram();
+        benchmark::measure("decision diagram", iterations, [&](auto const i) {
+            benchmark::do_not_optimize(e.evaluate(events[i % events.size()]));
+        });
+    }
+
+    return 0;
+}
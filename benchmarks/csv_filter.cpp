@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <chrono>
+#include <string>
+#include <iomanip>
+#include <iostream>
+#include <booleval/io/csv_filter.hpp>
+#include "benchmark.hpp"
+
+namespace {
+
+/**
+ * Generates CSV rows of roughly the specified size, header line included.
+ */
+std::string generate_rows(std::size_t const size) {
+    static char const* cities[] = { "Paris", "Berlin", "\"New York\"", "Tokyo" };
+
+    std::string buffer{ "id,timestamp,city,amount,quantity,customer,comment\n" };
+    buffer.reserve(size + 512);
+
+    for (std::size_t i = 0; buffer.size() < size; ++i) {
+        buffer += std::to_string(i);
+        buffer += ",2020-06-01T12:00:";
+        buffer += std::to_string(i % 60);
+        buffer += "Z,";
+        buffer += cities[i % 4];
+        buffer += ",";
+        buffer += std::to_string(i % 1000) + "." + std::to_string(i % 100);
+        buffer += ",";
+        buffer += std::to_string(i % 17);
+        buffer += ",customer-";
+        buffer += std::to_string(i % 4096);
+        buffer += ",\"delivered, signed by the recipient\"\n";
+    }
+
+    return buffer;
+}
+
+} // namespace
+
+int main() {
+    using namespace booleval;
+
+    constexpr std::size_t size{ 256 << 20 };
+    auto const buffer = generate_rows(size);
+
+    char const* expressions[] = {
+        "id < 100",
+        "city Paris and amount > 500.5",
+        "quantity > 15 or customer customer-42"
+    };
+
+    std::cout << "Filtering " << buffer.size() / (1 << 20) << " MiB of CSV rows" << std::endl;
+    for (auto const expression : expressions) {
+        io::csv_filter filter;
+        auto rows = std::string_view(buffer);
+        if (!filter.expression(expression) || !filter.header(io::csv_filter::split_header(rows))) {
+            std::cerr << "Expression not valid!" << std::endl;
+            return 1;
+        }
+
+        auto const start = std::chrono::steady_clock::now();
+        auto const count = filter.for_each_match(rows, [](auto const index, auto const) {
+            benchmark::do_not_optimize(index);
+        });
+        auto const end = std::chrono::steady_clock::now();
+
+        auto const duration = std::chrono::duration<double>(end - start).count();
+        std::cout << std::left << std::setw(48) << expression
+                  << std::right << std::setw(8) << std::fixed << std::setprecision(2)
+                  << static_cast<double>(buffer.size()) / duration / 1e9 << " GB/s"
+                  << std::setw(12) << count << " matches" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+#include <booleval/parallel/parallel_filter.hpp>
+#include "benchmark.hpp"
+
+namespace {
+
+class obj {
+public:
+    obj(uint32_t const field_a, double const field_b)
+        : field_a_(field_a),
+          field_b_(field_b)
+    {}
+
+    uint32_t field_a() const noexcept {
+        return field_a_;
+    }
+
+    double field_b() const noexcept {
+        return field_b_;
+    }
+
+private:
+    uint32_t field_a_;
+    double field_b_;
+};
+
+} // namespace
+
+int main() {
+    using namespace booleval;
+
+    constexpr std::size_t count{ 1000000 };
+
+    std::vector<obj> objects;
+    objects.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        objects.emplace_back(static_cast<uint32_t>(i % 100), static_cast<double>(i % 1000) / 10);
+    }
+
+    booleval::evaluator evaluator({
+        { "field_a", &obj::field_a },
+        { "field_b", &obj::field_b }
+    });
+
+    if (!evaluator.expression("field_a lt 10 and field_b gt 50.5")) {
+        std::cerr << "Expression not valid!" << std::endl;
+        return 1;
+    }
+
+    // Powers of two up to the number of hardware threads, followed by that number itself
+    auto const max_threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    std::vector<std::size_t> thread_counts;
+    for (std::size_t threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    double single_thread_duration{ 0 };
+
+    std::cout << "Parallel filtering of " << count << " objects" << std::endl;
+    for (auto const threads : thread_counts) {
+        parallel::thread_pool pool{ threads };
+
+        auto const start = std::chrono::steady_clock::now();
+        auto const selection = parallel::parallel_filter(objects, evaluator, pool);
+        auto const end = std::chrono::steady_clock::now();
+        benchmark::do_not_optimize(selection);
+
+        auto const duration = std::chrono::duration<double>(end - start).count();
+        if (1 == threads) {
+            single_thread_duration = duration;
+        }
+
+        std::cout << std::setw(4) << threads << " threads"
+                  << std::setw(14) << std::fixed << std::setprecision(0)
+                  << static_cast<double>(count) / duration << " objects/s"
+                  << std::setw(10) << std::setprecision(2)
+                  << single_thread_duration / duration << "x speedup"
+                  << std::setw(10) << selection.size() << " selected" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <regex>
+#include <random>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <booleval/utils/regex.hpp>
+#include "benchmark.hpp"
+
+namespace {
+
+/**
+ * Generates access log lines in the combined log format.
+ */
+std::vector<std::string> generate_lines(std::size_t const count) {
+    static char const* methods[] = { "GET", "GET", "GET", "POST", "PUT", "DELETE" };
+    static char const* paths[] = { "/", "/index.html", "/api/v1/users/42", "/api/v2/orders?page=3", "/static/app.js", "/admin/login" };
+    static char const* agents[] = { "Mozilla/5.0 (X11; Linux x86_64)", "curl/7.68.0", "Googlebot/2.1 (+http://www.google.com/bot.html)" };
+    static int const statuses[] = { 200, 200, 200, 201, 301, 304, 404, 500, 503 };
+
+    std::mt19937 generator{ 42 };
+    std::vector<std::string> lines;
+    lines.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto const g = [&generator](std::size_t const n) { return generator() % n; };
+
+        std::string line;
+        line += std::to_string(10 + g(240)) + "." + std::to_string(g(256)) + "." + std::to_string(g(256)) + "." + std::to_string(g(256));
+        line += " - - [10/Oct/2020:13:55:" + std::to_string(10 + g(50)) + " +0000] \"";
+        line += std::string(methods[g(std::size(methods))]) + " " + paths[g(std::size(paths))] + " HTTP/1.1\" ";
+        line += std::to_string(statuses[g(std::size(statuses))]) + " " + std::to_string(g(100000));
+        line += " \"-\" \"" + std::string(agents[g(std::size(agents))]) + "\"";
+        lines.push_back(std::move(line));
+    }
+
+    return lines;
+}
+
+} // namespace
+
+int main() {
+    using namespace booleval;
+
+    constexpr std::size_t count{ 4096 };
+    constexpr std::size_t iterations{ 200000 };
+    auto const lines = generate_lines(count);
+
+    char const* patterns[] = {
+        "\" 5\\d\\d ",
+        "^10\\.\\d+\\.\\d+\\.\\d+ ",
+        "(GET|POST) /api/v\\d/[a-z]+",
+        "[Bb]ot|crawler|spider",
+        "\"-\" \"curl/[0-9.]+\"$"
+    };
+
+    std::cout << "Searching " << count << " access log lines" << std::endl;
+    for (auto const pattern : patterns) {
+        utils::regex const expression{ pattern };
+        std::regex const reference{ pattern, std::regex::ECMAScript | std::regex::optimize };
+
+        std::size_t matches{ 0 };
+        std::size_t reference_matches{ 0 };
+        for (auto const& line : lines) {
+            matches += expression.matches(line) ? 1 : 0;
+            reference_matches += std::regex_search(line, reference) ? 1 : 0;
+        }
+
+        std::cout << std::endl << pattern << "  (" << expression.states() << " states, "
+                  << matches << " matches" << (matches == reference_matches ? "" : ", MISMATCH") << ")" << std::endl;
+
+        benchmark::measure("std::regex_search", iterations / 20, [&](auto const i) {
+            benchmark::do_not_optimize(std::regex_search(lines[i % count], reference));
+        });
+
+        benchmark::measure("utils::regex::matches", iterations, [&](auto const i) {
+            benchmark::do_not_optimize(expression.matches(lines[i % count]));
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <random>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <string_view>
+#include <booleval/rule_set.hpp>
+#include <booleval/evaluator.hpp>
+#include "benchmark.hpp"
+
+namespace {
+
+class request {
+public:
+    request(std::string host, std::string path)
+        : host_{ std::move(host) }, path_{ std::move(path) }
+    {}
+
+    std::string const& host() const noexcept { return host_; }
+    std::string const& path() const noexcept { return path_; }
+
+private:
+    std::string host_;
+    std::string path_;
+};
+
+/**
+ * Generates URL routing rules: exact paths, path sections and a few host rules.
+ */
+std::vector<std::string> generate_rules(std::size_t const count) {
+    std::vector<std::string> rules;
+    rules.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto const id = std::to_string(i);
+        switch (i % 4) {
+        case 0:
+        case 1:
+            rules.push_back("path \"/api/v1/resource/" + id + "\"");
+            break;
+
+        case 2:
+            rules.push_back("path contains \"/section" + id + "/\" and host www.example.com");
+            break;
+
+        default:
+            rules.push_back("host \"tenant" + id + ".example.com\" or path \"/tenant/" + id + "\"");
+            break;
+        }
+    }
+
+    return rules;
+}
+
+} // namespace
+
+int main() {
+    using namespace booleval;
+
+    std::map<std::string_view, utils::any_mem_fn> const fields{
+        { "host", &request::host },
+        { "path", &request::path }
+    };
+
+    std::mt19937 generator{ 42 };
+    std::vector<request> requests;
+    for (std::size_t i = 0; i < 1024; ++i) {
+        auto const id = std::to_string(generator() % 100000);
+        requests.emplace_back(
+            0 == i % 2 ? "www.example.com" : "tenant" + id + ".example.com",
+            0 == i % 3 ? "/api/v1/resource/" + id : "/static/section" + id + "/index.html"
+        );
+    }
+
+    for (std::size_t const count : { 100, 1000, 50000 }) {
+        auto const expressions = generate_rules(count);
+
+        rule_set<> rules{ fields };
+        if (!rules.rules(std::vector<std::string_view>(std::begin(expressions), std::end(expressions)))) {
+            std::cerr << "Invalid rules" << std::endl;
+            return 1;
+        }
+
+        std::vector<evaluator<>> evaluators(count, evaluator<>{ fields });
+        for (std::size_t i = 0; i < count; ++i) {
+            [[maybe_unused]] auto const valid = evaluators[i].expression(expressions[i]);
+        }
+
+        std::cout << std::endl << count << " rules, " << rules.indexed_predicates() << " indexed predicates" << std::endl;
+
+        benchmark::measure("evaluator per rule", 2000000 / count, [&](auto const i) {
+            std::size_t matches{ 0 };
+            for (auto const& e : evaluators) {
+                matches += e.evaluate(requests[i % requests.size()]) ? 1 : 0;
+            }
+            benchmark::do_not_optimize(matches);
+        });
+
+        std::vector<std::size_t> matches;
+        benchmark::measure("rule_set::evaluate", 200000, [&](auto const i) {
+            rules.evaluate(requests[i % requests.size()], matches);
+            benchmark::do_not_optimize(matches);
+        });
+    }
+
+    // Routing table of mutually exclusive rules, the first (and only) satisfied one is looked for
+    std::vector<std::string> routes;
+    for (std::size_t i = 0; i < 500; ++i) {
+        auto const tenant = std::to_string(i / 5);
+        switch (i % 5) {
+        case 0:
+            routes.push_back("host \"tenant" + tenant + ".example.com\" and path \"/\"");
+            break;
+
+        case 1:
+            routes.push_back("host \"tenant" + tenant + ".example.com\" and path starts_with /static/");
+            break;
+
+        case 2:
+            routes.push_back("host \"tenant" + tenant + ".example.com\" and path starts_with /api/");
+            break;
+
+        case 3:
+            routes.push_back("host \"tenant" + tenant + ".example.com\" and path contains admin");
+            break;
+
+        default:
+            routes.push_back("host \"tenant" + tenant + ".example.com\"");
+            break;
+        }
+    }
+
+    rule_set<> table{ fields };
+    if (!table.rules(std::vector<std::string_view>(std::begin(routes), std::end(routes)))) {
+        std::cerr << "Invalid routes" << std::endl;
+        return 1;
+    }
+
+    std::vector<evaluator<>> route_evaluators(routes.size(), evaluator<>{ fields });
+    for (std::size_t i = 0; i < routes.size(); ++i) {
+        [[maybe_unused]] auto const valid = route_evaluators[i].expression(routes[i]);
+    }
+
+    char const* paths[] = { "/", "/static/app.js", "/api/v1/users", "/admin", "/about" };
+    std::vector<request> tenant_requests;
+    for (std::size_t i = 0; i < 1024; ++i) {
+        tenant_requests.emplace_back(
+            "tenant" + std::to_string(generator() % 100) + ".example.com",
+            paths[generator() % std::size(paths)]
+        );
+    }
+
+    std::cout << std::endl << routes.size() << " routes, " << table.decision_nodes() << " decision nodes" << std::endl;
+
+    benchmark::measure("evaluator per route, first match", 20000, [&](auto const i) {
+        auto const& r = tenant_requests[i % tenant_requests.size()];
+        std::size_t route{ 0 };
+        while (route < route_evaluators.size() && !route_evaluators[route].evaluate(r)) {
+            ++route;
+        }
+        benchmark::do_not_optimize(route);
+    });
+
+    benchmark::measure("rule_set::first_match", 2000000, [&](auto const i) {
+        benchmark::do_not_optimize(table.first_match(tenant_requests[i % tenant_requests.size()]));
+    });
+
+    return 0;
+}
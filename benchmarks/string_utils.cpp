@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <booleval/utils/string_utils.hpp>
+#include "benchmark.hpp"
+
+namespace {
+
+/**
+ * Parses floating point value the way booleval used to on GCC/CLANG.
+ */
+std::optional<double> legacy_from_chars(std::string_view strv) {
+    double value{};
+
+    std::stringstream ss;
+    ss << strv;
+    ss >> value;
+
+    if (ss.fail()) {
+        return std::nullopt;
+    }
+
+    return value;
+}
+
+/**
+ * Formats floating point value the way booleval used to on GCC/CLANG.
+ */
+std::string legacy_to_chars(double const value) {
+    auto str = std::to_string(value);
+    std::string_view strv{ str.c_str(), str.size() };
+    str = booleval::utils::rtrim(strv, '0');
+    return str;
+}
+
+} // namespace
+
+int main() {
+    using namespace booleval;
+
+    constexpr std::size_t count{ 1024 };
+    constexpr std::size_t iterations{ 1000000 };
+
+    std::mt19937_64 generator{ 42 };
+    std::uniform_int_distribution<int64_t> distribution{ -100000000, 100000000 };
+
+    std::vector<double> values(count);
+    std::vector<std::string> strings(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        // Values with up to four decimals, as typically found in filter predicates
+        values[i] = static_cast<double>(distribution(generator)) / 10000;
+        strings[i] = utils::to_chars(values[i]);
+    }
+
+    std::cout << "Floating point parsing" << std::endl;
+
+    benchmark::measure("std::stringstream", iterations, [&](auto const i) {
+        benchmark::do_not_optimize(legacy_from_chars(strings[i % count]));
+    });
+
+    benchmark::measure("utils::from_chars", iterations, [&](auto const i) {
+        benchmark::do_not_optimize(utils::from_chars<double>(strings[i % count]));
+    });
+
+    benchmark::measure("utils::detail::parse_floating_point", iterations, [&](auto const i) {
+        benchmark::do_not_optimize(utils::detail::parse_floating_point<double>(strings[i % count]));
+    });
+
+    std::cout << std::endl << "Floating point formatting" << std::endl;
+
+    benchmark::measure("std::to_string + rtrim", iterations, [&](auto const i) {
+        benchmark::do_not_optimize(legacy_to_chars(values[i % count]));
+    });
+
+    benchmark::measure("utils::to_chars (string)", iterations, [&](auto const i) {
+        benchmark::do_not_optimize(utils::to_chars(values[i % count]));
+    });
+
+    std::array<char, utils::max_chars<double>> buffer;
+    benchmark::measure("utils::to_chars (buffer)", iterations, [&](auto const i) {
+        benchmark::do_not_optimize(utils::to_chars(buffer, values[i % count]));
+    });
+
+    benchmark::measure("utils::detail::format_floating_point", iterations, [&](auto const i) {
+        auto const& value = values[i % count];
+        benchmark::do_not_optimize(
+            utils::detail::format_floating_point(buffer.data(), buffer.data() + buffer.size(), value)
+        );
+    });
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <iostream>
+#include <booleval/io/mapped_file.hpp>
+#include <booleval/io/ndjson_filter.hpp>
+
+/**
+ * Filters newline-delimited JSON records read from the file
+ * (or from the standard input) and prints the matching ones.
+ *
+ * Usage: ndjson_filter <expression> [file]
+ * E.g.:  ndjson_filter "level error and http.status >= 500" app.log
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " <expression> [file]" << std::endl;
+        return 1;
+    }
+
+    booleval::io::ndjson_filter filter;
+    if (!filter.expression(argv[1])) {
+        std::cerr << "Expression not valid!" << std::endl;
+        return 1;
+    }
+
+    std::ios::sync_with_stdio(false);
+
+    std::size_t count{ 0 };
+    if (3 == argc) {
+        booleval::io::mapped_file file;
+        if (!file.open(argv[2])) {
+            std::cerr << "Cannot open file '" << argv[2] << "'!" << std::endl;
+            return 1;
+        }
+        count = filter.filter(file.data(), std::cout);
+    } else {
+        count = filter.filter(0, std::cout);
+    }
+
+    std::cout.flush();
+    std::cerr << count << " matching records" << std::endl;
+
+    return 0;
+}
@@ -31,10 +31,14 @@
 #define BOOLEVAL_EVALUATOR_H
 
 #include <map>
+#include <vector>
+#include <ostream>
 #include <string_view>
 #include <booleval/utils/any_mem_fn.hpp>
+#include <booleval/tree/closure_tree.hpp>
 #include <booleval/tree/result_visitor.hpp>
 #include <booleval/tree/expression_tree.hpp>
+#include <booleval/tree/decision_diagram.hpp>
 
 namespace booleval {
 
@@ -43,8 +47,9 @@ namespace booleval {
  *
  * Represents a class for evaluating logical expressions in a form of a string.
  * It builds an expression tree and traverses that tree in order to evaluate fields.
+ * If Profile is true, per-node evaluation statistics are collected (see profile()).
  */
-template <typename MemFn = utils::any_mem_fn>
+template <typename MemFn = utils::any_mem_fn, bool Profile = false>
 class evaluator {
     using field_map = std::map<std::string_view, MemFn>;
 
@@ -90,6 +95,44 @@ public:
      */
     [[nodiscard]] bool expression(std::string_view expression);
 
+    /**
+     * Gets the names of the fields referenced in the expression.
+     *
+     * @return Referenced field names if the evaluation is activated, otherwise empty collection
+     */
+    [[nodiscard]] std::vector<std::string_view> referenced_fields() const {
+        if (is_activated_) {
+            return expression_tree_.referenced_fields();
+        }
+
+        return {};
+    }
+
+    /**
+     * Gets the equality conditions necessary for the expression to be satisfied,
+     * e.g. for looking the literals up in indexes before evaluating the objects
+     * (see tree::conjunctive_core).
+     *
+     * @return Necessary equality conditions if the evaluation is activated, otherwise empty collection
+     */
+    [[nodiscard]] tree::equality_conditions conjunctive_core() const {
+        if (is_activated_) {
+            return expression_tree_.conjunctive_core();
+        }
+
+        return {};
+    }
+
+    /**
+     * Gets the root node of the expression tree, e.g. for compiling the expression
+     * into another form without parsing it again.
+     *
+     * @return Root node if the evaluation is activated, otherwise nullptr
+     */
+    [[nodiscard]] tree::tree_node const* root() const noexcept {
+        return is_activated_ ? expression_tree_.root().get() : nullptr;
+    }
+
     /**
      * Evaluates expression tree for the object passed in.
      *
@@ -98,33 +141,118 @@ public:
      * @return True if the object's members satisfy the expression, otherwise false
      */
     template <typename T>
-    [[nodiscard]] bool evaluate(T const& obj) {
-        if (is_activated_) {
-            return result_visitor_.visit(*expression_tree_.root(), obj);
-        } else {
+    [[nodiscard]] bool evaluate(T const& obj) const {
+        if (!is_activated_) {
             return false;
         }
+
+        if (decision_diagram_.is_built()) {
+            return decision_diagram_.evaluate([this, &obj](tree::tree_node const& node) {
+                return result_visitor_.visit(node, obj);
+            });
+        }
+
+        return result_visitor_.visit(*expression_tree_.root(), obj);
+    }
+
+    /**
+     * Compiles the expression into a tree of functions specialized for the object
+     * type and for the operations and literals of the expression (see tree::closure_tree).
+     * The compiled expression is independent of the evaluator, but refers to the expression.
+     *
+     * @return Compiled expression, which is empty if the evaluation is not activated
+     */
+    template <typename T>
+    [[nodiscard]] tree::closure_tree<T, MemFn> compile() const {
+        if (is_activated_) {
+            return { expression_tree_.root(), result_visitor_.fields() };
+        }
+
+        return {};
+    }
+
+    /**
+     * Compiles the expression into a binary decision diagram (see tree::decision_diagram),
+     * which evaluates each predicate at most once and only when its result matters.
+     * If the diagram would be too large, the expression tree keeps being used.
+     * Setting a new expression discards the diagram. In the profiling mode,
+     * only the statistics of the predicates are collected for the diagram.
+     *
+     * @param max_nodes Maximum number of nodes created while compiling
+     *
+     * @return True if the expression is compiled, otherwise false
+     */
+    [[nodiscard]] bool compile_decision_diagram(std::size_t const max_nodes = tree::decision_diagram::default_max_nodes) {
+        return is_activated_ && decision_diagram_.build(expression_tree_.root().get(), max_nodes);
+    }
+
+    /**
+     * Gets the binary decision diagram the expression is compiled into.
+     *
+     * @return Decision diagram, which is empty unless the expression is compiled
+     */
+    [[nodiscard]] tree::decision_diagram const& decision_diagram() const noexcept {
+        return decision_diagram_;
+    }
+
+    /**
+     * Writes the human-readable description of the expression: the parsed tree
+     * with implicit operators marked, the field bindings, the literal types
+     * and the estimated cost of evaluating a single object.
+     *
+     * @param out Output stream to write the description to
+     */
+    void explain(std::ostream& out) const {
+        tree::explain(is_activated_ ? expression_tree_.root().get() : nullptr,
+                      expression_tree_.expression(),
+                      [this](std::string_view const field) {
+                          return result_visitor_.has_field(field);
+                      },
+                      out);
+    }
+
+    /**
+     * Gets the statistics collected for each node of the expression tree
+     * since the expression was set or the statistics were cleared.
+     * Available in the profiling mode only.
+     *
+     * @return Statistics of all the nodes
+     */
+    [[nodiscard]] tree::profile_report profile() const {
+        return result_visitor_.report();
+    }
+
+    /**
+     * Resets the statistics collected so far. Available in the profiling mode only.
+     */
+    void clear_profile() noexcept {
+        result_visitor_.clear_profile();
     }
 
 private:
     bool is_activated_{ false };
-    tree::result_visitor<MemFn> result_visitor_;
+    tree::result_visitor<MemFn, Profile> result_visitor_;
     tree::expression_tree expression_tree_;
+    tree::decision_diagram decision_diagram_;
 };
 
-template<typename MemFn>
-bool evaluator<MemFn>::expression(std::string_view expression) {
+template<typename MemFn, bool Profile>
+bool evaluator<MemFn, Profile>::expression(std::string_view expression) {
     is_activated_ = false;
+    decision_diagram_.clear();
 
     if (expression.empty()) {
-        return true;
+        // The previous tree refers to the previous expression, which may be gone
+        expression_tree_ = {};
+    } else if (expression_tree_.build(expression)) {
+        is_activated_ = true;
     }
 
-    if (expression_tree_.build(expression)) {
-        is_activated_ = true;
+    if constexpr (Profile) {
+        result_visitor_.reset_profile(is_activated_ ? expression_tree_.root().get() : nullptr, expression);
     }
 
-    return is_activated_;
+    return is_activated_ || expression.empty();
 }
 
 } // booleval
@@ -77,6 +77,21 @@ struct field_not_found : base_exception {
     {}
 };
 
+/**
+ * struct schema_error
+ *
+ * Exception thrown when a schema description is not valid.
+ */
+struct schema_error : base_exception {
+    schema_error(std::string const& message)
+        : base_exception(message)
+    {}
+
+    schema_error(std::size_t const line, std::string const& message)
+        : base_exception("Line " + std::to_string(line) + ": " + message)
+    {}
+};
+
 } // booleval
 
 #endif // BOOLEVAL_EXCEPTIONS_H
\ No newline at end of file
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_ARROW_FILTER_H
+#define BOOLEVAL_ARROW_FILTER_H
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <booleval/io/arrow_c_data.hpp>
+#include <booleval/io/typed_comparison.hpp>
+#include <booleval/io/zone_map.hpp>
+#include <booleval/tree/tree_node.hpp>
+#include <booleval/utils/bitmap.hpp>
+
+namespace booleval {
+
+namespace io {
+
+/**
+ * class arrow_filter
+ *
+ * Represents a filter of Arrow record batches exchanged through the Arrow C data
+ * interface. The columns are read in place and evaluated column by column, the
+ * same way as binary records (see typed_comparison), producing a bitmap in the
+ * layout of Arrow boolean arrays. Null values do not satisfy any comparison,
+ * neither do the rows of the record batch that are null themselves. Null tests
+ * (is null, is not null) are the validity bitmaps of the columns, so the null
+ * handling costs a bitwise operation per 64 values rather than a branch per value.
+ * As with binary records, the operands of logical operations only evaluate the
+ * rows not decided yet, and null rows of the record batch are not evaluated at all.
+ *
+ * Supported column formats are integers (c, C, s, S, i, I, l, L), floating point
+ * (f, g), boolean (b) and strings (u, U). Boolean values compare as 0 and 1 and
+ * the literals true and false are accepted for them.
+ */
+class arrow_filter {
+public:
+    /**
+     * Maximum number of rows evaluated at once.
+     */
+    static constexpr std::size_t block_size{ 1024 };
+
+    arrow_filter() = default;
+    arrow_filter(arrow_filter&& rhs) = default;
+    arrow_filter(arrow_filter const& rhs) = delete;
+
+    /**
+     * Binds the columns of the record batch schema. The schema is not retained.
+     *
+     * @param schema Schema of the record batches, i.e. a struct of the columns
+     *
+     * @throws schema_error If the schema does not describe a struct
+     */
+    arrow_filter(ArrowSchema const& schema);
+
+    arrow_filter& operator=(arrow_filter&& rhs) = default;
+    arrow_filter& operator=(arrow_filter const& rhs) = delete;
+
+    ~arrow_filter() = default;
+
+    /**
+     * Sets the expression to be used for filtering. The expression is
+     * copied so it does not need to outlive the filter.
+     *
+     * @param expression Expression to be used for filtering
+     *
+     * @return True if the expression is valid, otherwise false
+     *
+     * @throws field_not_found If the expression references a column missing from
+     *                         the schema or of an unsupported format
+     */
+    [[nodiscard]] bool expression(std::string_view expression);
+
+    /**
+     * Checks whether the filtering is activated or not.
+     *
+     * @return True if the filtering is activated, otherwise false
+     */
+    [[nodiscard]] bool is_activated() const noexcept;
+
+    /**
+     * Evaluates the record batch.
+     *
+     * @param batch Record batch, i.e. a struct array of the columns
+     * @param bits  Bitmap the results are written to, one bit per row in the
+     *              least significant bit order, resized to (length + 63) / 64 words
+     *
+     * @return Number of rows satisfying the expression
+     *
+     * @throws schema_error If the batch does not match the schema
+     */
+    std::size_t evaluate(ArrowArray const& batch, std::vector<uint64_t>& bits) const;
+
+    /**
+     * Evaluates the record batch.
+     *
+     * @param batch Record batch, i.e. a struct array of the columns
+     * @param bits  Bitmap the results are written to, resized to the length of the batch
+     *
+     * @return Number of rows satisfying the expression
+     *
+     * @throws schema_error If the batch does not match the schema
+     */
+    std::size_t evaluate(ArrowArray const& batch, utils::bitmap& bits) const;
+
+    /**
+     * Evaluates the record batch, deciding the comparisons of numeric columns
+     * from the bounds of their values and rejecting equalities by the Bloom
+     * filters of the columns where possible (see zone_map).
+     *
+     * @param batch Record batch, i.e. a struct array of the columns
+     * @param zones Statistics of the columns, the first row of the batch being row 0
+     * @param bits  Bitmap the results are written to, resized to the length of the batch
+     *
+     * @return Number of rows satisfying the expression
+     *
+     * @throws schema_error If the batch does not match the schema
+     */
+    std::size_t evaluate(ArrowArray const& batch, zone_map const& zones, utils::bitmap& bits) const;
+
+    /**
+     * Gets the indices of the rows satisfying the expression.
+     *
+     * @param batch Record batch, i.e. a struct array of the columns
+     *
+     * @return Indices of the matching rows
+     *
+     * @throws schema_error If the batch does not match the schema
+     */
+    [[nodiscard]] std::vector<std::size_t> select(ArrowArray const& batch) const;
+
+    /**
+     * Exports the bitmap as an Arrow boolean array without copying it. The consumer
+     * takes over the bitmap and releases it through the array release callback.
+     *
+     * @param bits   Bitmap produced by evaluate()
+     * @param length Number of rows of the bitmap
+     * @param array  Array to be filled in
+     * @param schema Schema to be filled in
+     */
+    static void export_bitmap(std::vector<uint64_t> bits, int64_t length, ArrowArray& array, ArrowSchema& schema);
+
+private:
+    enum class column_kind : uint8_t {
+        unsupported,
+        fixed,
+        boolean,
+        string,
+        large_string
+    };
+
+    struct column {
+        std::string name;
+        column_kind kind{ column_kind::unsupported };
+        binary_type type{ binary_type::uint8 };
+    };
+
+    struct node {
+        token::token_type op{ token::token_type::unknown };
+        typed_comparison comparison;
+        std::string_view literal;
+        std::shared_ptr<utils::string_matcher const> matcher;
+        double value{ std::numeric_limits<double>::quiet_NaN() };
+        std::size_t column{ 0 };
+        std::size_t left{ 0 };
+        std::size_t right{ 0 };
+    };
+
+    [[nodiscard]] column const* find(std::string_view name) const noexcept;
+    [[nodiscard]] std::size_t compile(tree::tree_node const& tree_node);
+
+    std::size_t evaluate(ArrowArray const& batch, zone_map const* zones, utils::bitmap& bits) const;
+    void evaluate(node const& n, ArrowArray const& batch, std::size_t first, std::size_t count,
+                  uint64_t const* selected, uint64_t* bits, zone_map const* zones) const;
+    void scan(node const& n, ArrowArray const& array, std::size_t first, block_selection const& selection, uint64_t* bits) const;
+
+private:
+    std::vector<column> columns_;
+    std::unique_ptr<std::string> expression_;
+    std::vector<node> nodes_;
+};
+
+} // io
+
+} // booleval
+
+#endif // BOOLEVAL_ARROW_FILTER_H
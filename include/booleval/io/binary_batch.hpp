@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_BINARY_BATCH_H
+#define BOOLEVAL_BINARY_BATCH_H
+
+#include <limits>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <booleval/tree/tree_node.hpp>
+#include <booleval/io/binary_record.hpp>
+#include <booleval/io/binary_schema.hpp>
+#include <booleval/io/typed_comparison.hpp>
+#include <booleval/io/zone_map.hpp>
+
+namespace booleval {
+
+namespace io {
+
+/**
+ * class binary_batch
+ *
+ * Represents an expression compiled for evaluating a batch of contiguous binary
+ * records column by column. Each comparison scans its field across the batch
+ * with a strided typed load and sets one bit per record (see typed_comparison),
+ * while logical operations combine the resulting bitmaps a word at a time.
+ * The right operand of a logical and only evaluates the records accepted by
+ * the left one, the right operand of a logical or only the records not accepted
+ * yet; sparse selections are scanned through the indices of the selected
+ * records (see block_selection). The results are the same as with the evaluator.
+ * Given the statistics of the fields, comparisons decided for the whole block
+ * by the bounds of the values, or equalities excluded by the Bloom filters of
+ * the fields, are not scanned at all (see zone_map).
+ */
+class binary_batch {
+public:
+    /**
+     * Maximum number of records evaluated at once.
+     */
+    static constexpr std::size_t block_size{ 1024 };
+
+    binary_batch() = default;
+    binary_batch(binary_batch&& rhs) = default;
+    binary_batch(binary_batch const& rhs) = default;
+
+    /**
+     * Compiles the expression tree. The literals are referred to, so the
+     * expression the tree is built from must outlive the batch.
+     *
+     * @param root   Root of the expression tree
+     * @param schema Schema of the records containing all referenced fields
+     */
+    binary_batch(tree::tree_node const& root, binary_schema const& schema);
+
+    binary_batch& operator=(binary_batch&& rhs) = default;
+    binary_batch& operator=(binary_batch const& rhs) = default;
+
+    ~binary_batch() = default;
+
+    /**
+     * Checks whether the expression is compiled.
+     *
+     * @return True if the expression is compiled, otherwise false
+     */
+    [[nodiscard]] bool is_compiled() const noexcept;
+
+    /**
+     * Evaluates the block of contiguous records.
+     *
+     * @param records Beginning of the first record
+     * @param count   Number of records, not greater than block_size
+     * @param bits    Bitmap of at least (count + 63) / 64 words the results are
+     *                written to, the bits past the last record being cleared
+     *
+     * @return Number of records satisfying the expression
+     */
+    std::size_t evaluate(std::byte const* records, std::size_t count, uint64_t* bits) const;
+
+    /**
+     * Evaluates the block of contiguous records, deciding the comparisons of numeric
+     * fields from the bounds of their values and rejecting equalities by the Bloom
+     * filters of the fields where possible (see zone_map).
+     *
+     * @param records Beginning of the first record
+     * @param count   Number of records, not greater than block_size
+     * @param bits    Bitmap of at least (count + 63) / 64 words the results are
+     *                written to, the bits past the last record being cleared
+     * @param zones   Statistics of the fields
+     * @param first   Index of the first record within the statistics
+     *
+     * @return Number of records satisfying the expression
+     */
+    std::size_t evaluate(std::byte const* records, std::size_t count, uint64_t* bits,
+                         zone_map const& zones, std::size_t first) const;
+
+private:
+    struct node {
+        token::token_type op{ token::token_type::unknown };
+        typed_comparison comparison;
+        std::string_view name;
+        std::string_view literal;
+        double value{ std::numeric_limits<double>::quiet_NaN() };
+        std::size_t left{ 0 };
+        std::size_t right{ 0 };
+    };
+
+    [[nodiscard]] std::size_t compile(tree::tree_node const& node, binary_schema const& schema);
+
+    std::size_t evaluate(std::byte const* records, std::size_t count, uint64_t* bits,
+                         zone_map const* zones, std::size_t first) const;
+    void evaluate(node const& n, std::byte const* records, std::size_t count, uint64_t const* selected, uint64_t* bits,
+                  zone_map const* zones, std::size_t first) const;
+
+private:
+    std::vector<node> nodes_;
+    std::size_t record_size_{ 0 };
+};
+
+} // io
+
+} // booleval
+
+#endif // BOOLEVAL_BINARY_BATCH_H
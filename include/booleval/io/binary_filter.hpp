@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_BINARY_FILTER_H
+#define BOOLEVAL_BINARY_FILTER_H
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <ostream>
+#include <string_view>
+#include <booleval/evaluator.hpp>
+#include <booleval/io/binary_batch.hpp>
+#include <booleval/io/binary_record.hpp>
+#include <booleval/io/binary_schema.hpp>
+#include <booleval/utils/bitmap.hpp>
+#include <booleval/utils/bit_utils.hpp>
+
+namespace booleval {
+
+namespace io {
+
+/**
+ * class binary_filter
+ *
+ * Represents a filter of fixed-size binary records described by the schema.
+ * The fields are read directly from the records without decoding them. Buffers
+ * of contiguous records are evaluated in blocks, column by column (see binary_batch).
+ */
+class binary_filter {
+public:
+    binary_filter() = default;
+    binary_filter(binary_filter&& rhs) = default;
+    binary_filter(binary_filter const& rhs) = delete;
+
+    binary_filter(binary_schema schema)
+        : schema_(std::move(schema))
+    {}
+
+    binary_filter& operator=(binary_filter&& rhs) = default;
+    binary_filter& operator=(binary_filter const& rhs) = delete;
+
+    ~binary_filter() = default;
+
+    /**
+     * Sets the expression to be used for filtering. The expression is
+     * copied so it does not need to outlive the filter.
+     *
+     * @param expression Expression to be used for filtering
+     *
+     * @return True if the expression is valid, otherwise false
+     *
+     * @throws field_not_found If the expression references a field missing from the schema
+     */
+    [[nodiscard]] bool expression(std::string_view expression);
+
+    /**
+     * Checks whether the filtering is activated or not.
+     *
+     * @return True if the filtering is activated, otherwise false
+     */
+    [[nodiscard]] bool is_activated() const noexcept;
+
+    /**
+     * Gets the schema of the records.
+     *
+     * @return Schema of the records
+     */
+    [[nodiscard]] binary_schema const& schema() const noexcept;
+
+    /**
+     * Checks whether the binary record satisfies the expression.
+     *
+     * @param record Binary record
+     *
+     * @return True if the record satisfies the expression, otherwise false
+     */
+    [[nodiscard]] bool matches(binary_record const& record) const;
+
+    /**
+     * Evaluates the block of contiguous records at once.
+     *
+     * @param records Beginning of the first record
+     * @param count   Number of records, not greater than binary_batch::block_size
+     * @param bits    Bitmap of at least (count + 63) / 64 words the results are written to
+     *
+     * @return Number of records satisfying the expression
+     */
+    std::size_t evaluate_block(std::byte const* records, std::size_t count, uint64_t* bits) const;
+
+    /**
+     * Evaluates all records of the buffer block by block.
+     * Trailing bytes not forming a complete record are ignored.
+     *
+     * @param buffer Buffer containing contiguous records
+     * @param bits   Bitmap the results are written to, resized to the number of records
+     *
+     * @return Number of records satisfying the expression
+     */
+    std::size_t evaluate(std::string_view buffer, utils::bitmap& bits) const;
+
+    /**
+     * Evaluates all records of the buffer block by block, skipping the blocks
+     * decided by the statistics of the fields (see zone_map).
+     * Trailing bytes not forming a complete record are ignored.
+     *
+     * @param buffer Buffer containing contiguous records
+     * @param zones  Statistics of the fields, the first record of the buffer being row 0
+     * @param bits   Bitmap the results are written to, resized to the number of records
+     *
+     * @return Number of records satisfying the expression
+     */
+    std::size_t evaluate(std::string_view buffer, zone_map const& zones, utils::bitmap& bits) const;
+
+    /**
+     * Invokes the function for each record of the buffer satisfying the expression.
+     * Trailing bytes not forming a complete record are ignored.
+     *
+     * @param buffer Buffer containing contiguous records
+     * @param func   Function to invoke with the index and the matching record
+     *
+     * @return Number of matching records
+     */
+    template <typename F>
+    std::size_t for_each_match(std::string_view buffer, F&& func) const;
+
+    /**
+     * Gets the indices of the records satisfying the expression.
+     *
+     * @param buffer Buffer containing contiguous records
+     *
+     * @return Indices of the matching records
+     */
+    [[nodiscard]] std::vector<std::size_t> select(std::string_view buffer) const;
+
+    /**
+     * Writes the records satisfying the expression to the output stream.
+     *
+     * @param buffer Buffer containing contiguous records
+     * @param out    Output stream to write the matching records to
+     *
+     * @return Number of matching records
+     */
+    std::size_t filter(std::string_view buffer, std::ostream& out) const;
+
+private:
+    std::size_t evaluate(std::string_view buffer, zone_map const* zones, utils::bitmap& bits) const;
+
+private:
+    binary_schema schema_;
+    std::unique_ptr<std::string> expression_;
+    evaluator<binary_field> evaluator_;
+    binary_batch batch_;
+};
+
+template <typename F>
+std::size_t binary_filter::for_each_match(std::string_view buffer, F&& func) const {
+    auto const record_size = schema_.record_size();
+    if (!is_activated() || 0 == record_size) {
+        return 0;
+    }
+
+    std::size_t count{ 0 };
+    auto const records = buffer.size() / record_size;
+    auto const data = reinterpret_cast<std::byte const*>(buffer.data());
+
+    std::array<uint64_t, binary_batch::block_size / 64> bits;
+    for (std::size_t first = 0; first < records; first += binary_batch::block_size) {
+        auto const size = std::min(binary_batch::block_size, records - first);
+        if (0 == evaluate_block(data + first * record_size, size, bits.data())) {
+            continue;
+        }
+
+        for (std::size_t word = 0; word < (size + 63) / 64; ++word) {
+            for (auto b = bits[word]; 0 != b; b &= b - 1) {
+                auto const index = first + word * 64 + utils::count_trailing_zeros(b);
+                func(index, binary_record(data + index * record_size, record_size));
+                ++count;
+            }
+        }
+    }
+
+    return count;
+}
+
+} // io
+
+} // booleval
+
+#endif // BOOLEVAL_BINARY_FILTER_H
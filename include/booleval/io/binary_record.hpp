@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_BINARY_RECORD_H
+#define BOOLEVAL_BINARY_RECORD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <booleval/utils/any_value.hpp>
+#include <booleval/utils/bit_utils.hpp>
+
+#if __has_include(<span>)
+#include <span>
+#endif
+
+namespace booleval {
+
+namespace io {
+
+/**
+ * enum class binary_type
+ *
+ * Represents the type of a field stored in a binary record.
+ */
+enum class binary_type : uint8_t {
+    int8,
+    uint8,
+    int16,
+    uint16,
+    int32,
+    uint32,
+    int64,
+    uint64,
+    float32,
+    float64,
+    string
+};
+
+/**
+ * enum class byte_order
+ *
+ * Represents the order of bytes of a multi-byte field stored in a binary record.
+ */
+enum class byte_order : uint8_t {
+    little,
+    big
+};
+
+/**
+ * Gets the width of the fixed-size binary type.
+ *
+ * @param type Binary type
+ *
+ * @return Width in bytes or 0 for strings, whose width is variable
+ */
+[[nodiscard]] constexpr std::size_t binary_width(binary_type const type) noexcept {
+    switch (type) {
+        case binary_type::int8:
+        case binary_type::uint8:
+            return 1;
+        case binary_type::int16:
+        case binary_type::uint16:
+            return 2;
+        case binary_type::int32:
+        case binary_type::uint32:
+        case binary_type::float32:
+            return 4;
+        case binary_type::int64:
+        case binary_type::uint64:
+        case binary_type::float64:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * class binary_record
+ *
+ * Represents a non-owning view of a fixed-layout binary record.
+ */
+class binary_record {
+public:
+    binary_record() = default;
+    binary_record(binary_record&& rhs) = default;
+    binary_record(binary_record const& rhs) = default;
+
+    binary_record(void const* const data, std::size_t const size)
+        : data_(static_cast<std::byte const*>(data)),
+          size_(size)
+    {}
+
+#if defined(__cpp_lib_span)
+    binary_record(std::span<std::byte const> const data)
+        : data_(data.data()),
+          size_(data.size())
+    {}
+#endif
+
+    binary_record& operator=(binary_record&& rhs) = default;
+    binary_record& operator=(binary_record const& rhs) = default;
+
+    ~binary_record() = default;
+
+    [[nodiscard]] std::byte const* data() const noexcept {
+        return data_;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return size_;
+    }
+
+private:
+    std::byte const* data_{ nullptr };
+    std::size_t size_{ 0 };
+};
+
+/**
+ * class binary_field
+ *
+ * Represents an accessor of a field stored at the fixed offset of a binary
+ * record that can be used in evaluator's field map instead of a member
+ * function. String fields are padded with NUL characters or spaces.
+ */
+class binary_field {
+public:
+    binary_field() = default;
+    binary_field(binary_field&& rhs) = default;
+    binary_field(binary_field const& rhs) = default;
+
+    binary_field(std::size_t const offset, binary_type const type,
+                 byte_order const order = byte_order::little, std::size_t const width = 0)
+        : offset_(offset),
+          width_(binary_type::string == type ? width : binary_width(type)),
+          type_(type),
+          order_(order)
+    {}
+
+    binary_field& operator=(binary_field&& rhs) = default;
+    binary_field& operator=(binary_field const& rhs) = default;
+
+    ~binary_field() = default;
+
+    [[nodiscard]] std::size_t offset() const noexcept {
+        return offset_;
+    }
+
+    [[nodiscard]] std::size_t width() const noexcept {
+        return width_;
+    }
+
+    [[nodiscard]] binary_type type() const noexcept {
+        return type_;
+    }
+
+    [[nodiscard]] byte_order order() const noexcept {
+        return order_;
+    }
+
+    /**
+     * Gets the value of the field from the binary record.
+     *
+     * @param record Binary record to get the value from
+     *
+     * @return Value of the field or null value if the record is too short
+     */
+    [[nodiscard]] utils::any_value invoke(binary_record const& record) const {
+        if (offset_ + width_ > record.size()) {
+            return {};
+        }
+
+        switch (type_) {
+            case binary_type::int8:    return static_cast<int64_t>(static_cast<int8_t>(load<uint8_t>(record)));
+            case binary_type::uint8:   return static_cast<uint64_t>(load<uint8_t>(record));
+            case binary_type::int16:   return static_cast<int64_t>(static_cast<int16_t>(load<uint16_t>(record)));
+            case binary_type::uint16:  return static_cast<uint64_t>(load<uint16_t>(record));
+            case binary_type::int32:   return static_cast<int64_t>(static_cast<int32_t>(load<uint32_t>(record)));
+            case binary_type::uint32:  return static_cast<uint64_t>(load<uint32_t>(record));
+            case binary_type::int64:   return static_cast<int64_t>(load<uint64_t>(record));
+            case binary_type::uint64:  return load<uint64_t>(record);
+            case binary_type::float32: return load_floating_point<float, uint32_t>(record);
+            case binary_type::float64: return load_floating_point<double, uint64_t>(record);
+            default:                   return load_string(record);
+        }
+    }
+
+private:
+    template <typename U>
+    [[nodiscard]] U load(binary_record const& record) const noexcept {
+        U word;
+        std::memcpy(&word, record.data() + offset_, sizeof(U));
+        if ((byte_order::little == order_) != utils::is_little_endian) {
+            word = utils::byte_swap(word);
+        }
+        return word;
+    }
+
+    template <typename T, typename U>
+    [[nodiscard]] T load_floating_point(binary_record const& record) const noexcept {
+        static_assert(sizeof(T) == sizeof(U));
+
+        auto const word = load<U>(record);
+        T value;
+        std::memcpy(&value, &word, sizeof(T));
+        return value;
+    }
+
+    [[nodiscard]] std::string_view load_string(binary_record const& record) const noexcept {
+        std::string_view value(reinterpret_cast<char const*>(record.data() + offset_), width_);
+
+        auto const end = value.find_last_not_of(std::string_view("\0 ", 2));
+        value.remove_suffix(std::string_view::npos == end ? value.size() : value.size() - end - 1);
+        return value;
+    }
+
+private:
+    std::size_t offset_{ 0 };
+    std::size_t width_{ 0 };
+    binary_type type_{ binary_type::uint8 };
+    byte_order order_{ byte_order::little };
+};
+
+} // io
+
+} // booleval
+
+#endif // BOOLEVAL_BINARY_RECORD_H
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_BINARY_SCHEMA_H
+#define BOOLEVAL_BINARY_SCHEMA_H
+
+#include <string>
+#include <vector>
+#include <string_view>
+#include <booleval/io/binary_record.hpp>
+
+namespace booleval {
+
+namespace io {
+
+/**
+ * class binary_schema
+ *
+ * Represents the layout of fixed-size binary records, i.e. the offset,
+ * type, width and byte order of each named field.
+ */
+class binary_schema {
+public:
+    /**
+     * struct entry
+     *
+     * Represents the named field of the schema.
+     */
+    struct entry {
+        std::string name;
+        binary_field field;
+    };
+
+    binary_schema() = default;
+    binary_schema(binary_schema&& rhs) = default;
+    binary_schema(binary_schema const& rhs) = default;
+
+    binary_schema& operator=(binary_schema&& rhs) = default;
+    binary_schema& operator=(binary_schema const& rhs) = default;
+
+    ~binary_schema() = default;
+
+    /**
+     * Parses the textual schema description. Each line describes a single
+     * field by its name, type, offset and optional byte order (little endian
+     * by default), e.g. `price float64 8 big`. The supported types are
+     * int8, uint8, int16, uint16, int32, uint32, int64, uint64, float32,
+     * float64 and string[N]. The record size can be set by `record_size N`
+     * line. Everything following '#' is treated as a comment.
+     *
+     * @param description Textual schema description
+     *
+     * @return Parsed schema
+     *
+     * @throws schema_error If the description is not valid
+     */
+    [[nodiscard]] static binary_schema parse(std::string_view description);
+
+    /**
+     * Adds the field to the schema.
+     *
+     * @param name  Name of the field
+     * @param field Accessor of the field
+     *
+     * @return True if the field is added, false if the name is already used
+     *         or the field has no width
+     */
+    [[nodiscard]] bool add(std::string_view name, binary_field const& field);
+
+    /**
+     * Finds the field by its name.
+     *
+     * @param name Name of the field
+     *
+     * @return Pointer to the field accessor or nullptr if the field does not exist
+     */
+    [[nodiscard]] binary_field const* find(std::string_view name) const noexcept;
+
+    /**
+     * Gets the fields of the schema in the order they were added.
+     *
+     * @return Fields of the schema
+     */
+    [[nodiscard]] std::vector<entry> const& fields() const noexcept;
+
+    /**
+     * Sets the size of the records. The records cannot be smaller
+     * than the end of the last field.
+     *
+     * @param size Size of the records in bytes
+     */
+    void record_size(std::size_t size) noexcept;
+
+    /**
+     * Gets the size of the records.
+     *
+     * @return Size of the records in bytes
+     */
+    [[nodiscard]] std::size_t record_size() const noexcept;
+
+private:
+    std::vector<entry> fields_;
+    std::size_t fields_end_{ 0 };
+    std::size_t record_size_{ 0 };
+};
+
+} // io
+
+} // booleval
+
+#endif // BOOLEVAL_BINARY_SCHEMA_H
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_CSV_FILTER_H
+#define BOOLEVAL_CSV_FILTER_H
+
+#include <limits>
+#include <vector>
+#include <ostream>
+#include <string_view>
+#include <booleval/io/text_filter.hpp>
+#include <booleval/io/text_record.hpp>
+
+namespace booleval {
+
+namespace io {
+
+/**
+ * class csv_filter
+ *
+ * Represents a filter of delimiter-separated rows (CSV, TSV, ...). The columns
+ * are mapped to the fields referenced in the expression by the header line
+ * and only the referenced columns are tokenized, while the rest of each row
+ * is skipped. Quoting follows RFC 4180; quoted values containing doubled
+ * quotes are collapsed into the scratch buffers of the record. Empty
+ * unquoted values are treated as not present.
+ */
+class csv_filter {
+public:
+    csv_filter() = default;
+    csv_filter(csv_filter&& rhs) = default;
+    csv_filter(csv_filter const& rhs) = delete;
+
+    csv_filter(char const delimiter)
+        : delimiter_(delimiter)
+    {}
+
+    csv_filter& operator=(csv_filter&& rhs) = default;
+    csv_filter& operator=(csv_filter const& rhs) = delete;
+
+    ~csv_filter() = default;
+
+    /**
+     * Sets the expression to be used for filtering. The header line
+     * needs to be set afterwards.
+     *
+     * @param expression Expression to be used for filtering
+     *
+     * @return True if the expression is valid, otherwise false
+     */
+    [[nodiscard]] bool expression(std::string_view expression);
+
+    /**
+     * Checks whether the filtering is activated or not.
+     *
+     * @return True if the filtering is activated, otherwise false
+     */
+    [[nodiscard]] bool is_activated() const noexcept;
+
+    /**
+     * Gets the delimiter separating the values of a row.
+     *
+     * @return Delimiter
+     */
+    [[nodiscard]] char delimiter() const noexcept;
+
+    /**
+     * Maps the columns of the header line to the fields referenced in the
+     * expression. Referenced fields missing from the header are never present.
+     *
+     * @param line Header line
+     *
+     * @return True if all the referenced fields are found in the header, otherwise false
+     */
+    [[nodiscard]] bool header(std::string_view line);
+
+    /**
+     * Checks whether the row satisfies the expression.
+     *
+     * @param line   Row
+     * @param record Scratch text record created by make_record
+     *
+     * @return True if the row satisfies the expression, otherwise false
+     */
+    [[nodiscard]] bool matches(std::string_view line, text_record& record) const;
+
+    /**
+     * Creates a scratch text record used for matching.
+     *
+     * @return Empty text record
+     */
+    [[nodiscard]] text_record make_record() const;
+
+    /**
+     * Invokes the function for each row of the buffer satisfying the expression.
+     * Rows are indexed from zero in the order of appearance, skipping empty lines.
+     *
+     * @param rows Buffer containing the rows without the header line
+     * @param func Function to invoke with the index and the line of each matching row
+     *
+     * @return Number of matching rows
+     */
+    template <typename F>
+    std::size_t for_each_match(std::string_view rows, F&& func) const;
+
+    /**
+     * Gets the indices of the rows satisfying the expression.
+     *
+     * @param rows Buffer containing the rows without the header line
+     *
+     * @return Indices of the matching rows
+     */
+    [[nodiscard]] std::vector<std::size_t> select(std::string_view rows) const;
+
+    /**
+     * Writes the rows satisfying the expression to the output stream.
+     *
+     * @param rows Buffer containing the rows without the header line
+     * @param out  Output stream to write the matching rows to
+     *
+     * @return Number of matching rows
+     */
+    std::size_t filter(std::string_view rows, std::ostream& out) const;
+
+    /**
+     * Counts the rows of the buffer, skipping empty lines. Quoted values
+     * spanning several lines are part of a single row.
+     *
+     * @param rows Buffer containing the rows without the header line
+     *
+     * @return Number of rows
+     */
+    [[nodiscard]] std::size_t count_rows(std::string_view rows) const noexcept;
+
+    /**
+     * Gets the beginning of the row containing the position, so the buffer
+     * can be split into parts of complete rows. A row not terminated by
+     * a line break before the end of the buffer is not complete, so the
+     * beginning of the last row is returned for the end of the buffer.
+     *
+     * @param rows     Buffer beginning with a row
+     * @param position Position within the buffer
+     *
+     * @return Offset of the beginning of the row
+     */
+    [[nodiscard]] std::size_t row_boundary(std::string_view rows, std::size_t position) const noexcept;
+
+    /**
+     * Splits the buffer into the header line and the rows following it.
+     *
+     * @param buffer Buffer beginning with the header line, left with the rows only
+     *
+     * @return Header line
+     */
+    [[nodiscard]] static std::string_view split_header(std::string_view& buffer) noexcept;
+
+private:
+    /**
+     * Scans the row and extracts the values of the referenced columns.
+     * The columns following the last referenced one are skipped.
+     *
+     * @param first  Beginning of the row, moved to the beginning of the next row
+     * @param last   End of the input
+     * @param record Text record to store the extracted values to
+     *
+     * @return Row without the line break
+     */
+    std::string_view scan_row(char const*& first, char const* last, text_record& record) const;
+
+private:
+    static constexpr std::size_t unmapped{ std::numeric_limits<std::size_t>::max() };
+
+    char delimiter_{ ',' };
+    text_filter filter_;
+    std::vector<std::size_t> slots_;
+};
+
+template <typename F>
+std::size_t csv_filter::for_each_match(std::string_view rows, F&& func) const {
+    if (!is_activated()) {
+        return 0;
+    }
+
+    std::size_t count{ 0 };
+    std::size_t index{ 0 };
+    auto record = make_record();
+
+    auto first = rows.data();
+    auto const last = rows.data() + rows.size();
+    while (first != last) {
+        auto const line = scan_row(first, last, record);
+        if (line.empty()) {
+            continue;
+        }
+
+        if (filter_.evaluate(record)) {
+            func(index, line);
+            ++count;
+        }
+        ++index;
+    }
+
+    return count;
+}
+
+} // io
+
+} // booleval
+
+#endif // BOOLEVAL_CSV_FILTER_H
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_MAPPED_FILE_H
+#define BOOLEVAL_MAPPED_FILE_H
+
+#include <string>
+#include <string_view>
+
+namespace booleval {
+
+namespace io {
+
+/**
+ * class mapped_file
+ *
+ * Represents a read-only file mapped into memory. The content of the file
+ * can be accessed without copying it into user space buffers.
+ */
+class mapped_file {
+public:
+    mapped_file() = default;
+    mapped_file(mapped_file&& rhs) noexcept;
+    mapped_file(mapped_file const& rhs) = delete;
+
+    mapped_file& operator=(mapped_file&& rhs) noexcept;
+    mapped_file& operator=(mapped_file const& rhs) = delete;
+
+    ~mapped_file();
+
+    /**
+     * Maps the file into memory. Previously mapped file, if any, is unmapped.
+     *
+     * @param path Path to the file to be mapped
+     *
+     * @return True if the file is mapped successfully, otherwise false
+     */
+    [[nodiscard]] bool open(std::string const& path);
+
+    /**
+     * Unmaps the file from memory.
+     */
+    void close() noexcept;
+
+    /**
+     * Checks whether the file is mapped into memory or not.
+     *
+     * @return True if the file is mapped, otherwise false
+     */
+    [[nodiscard]] bool is_open() const noexcept;
+
+    /**
+     * Gets the content of the mapped file.
+     *
+     * @return Content of the mapped file
+     */
+    [[nodiscard]] std::string_view data() const noexcept;
+
+private:
+    bool is_open_{ false };
+    char const* data_{ nullptr };
+    std::size_t size_{ 0 };
+};
+
+} // io
+
+} // booleval
+
+#endif // BOOLEVAL_MAPPED_FILE_H
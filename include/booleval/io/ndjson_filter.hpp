@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_NDJSON_FILTER_H
+#define BOOLEVAL_NDJSON_FILTER_H
+
+#include <vector>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <booleval/io/text_filter.hpp>
+#include <booleval/io/text_record.hpp>
+
+namespace booleval {
+
+namespace io {
+
+/**
+ * class ndjson_filter
+ *
+ * Represents a filter of newline-delimited JSON records. Only the values of
+ * the fields referenced in the expression are extracted from each record,
+ * without building a document object model and without copying them.
+ * Nested object members are referenced by dotted paths (e.g. `http.status`).
+ * Strings containing escape sequences are decoded into the scratch buffers
+ * of the record, while numbers are compared as written or by their value
+ * (see text_field_value). The scanning of a record stops as soon as all the
+ * referenced fields are found, so the rest of the record is not validated.
+ */
+class ndjson_filter {
+public:
+    /**
+     * Maximum number of distinct fields that can be referenced in the expression.
+     */
+    static constexpr std::size_t max_fields{ 64 };
+
+    ndjson_filter() = default;
+    ndjson_filter(ndjson_filter&& rhs) = default;
+    ndjson_filter(ndjson_filter const& rhs) = delete;
+
+    ndjson_filter& operator=(ndjson_filter&& rhs) = default;
+    ndjson_filter& operator=(ndjson_filter const& rhs) = delete;
+
+    ~ndjson_filter() = default;
+
+    /**
+     * Sets the expression to be used for filtering.
+     *
+     * @param expression Expression to be used for filtering
+     *
+     * @return True if the expression is valid, otherwise false
+     */
+    [[nodiscard]] bool expression(std::string_view expression);
+
+    /**
+     * Checks whether the filtering is activated or not.
+     *
+     * @return True if the filtering is activated, otherwise false
+     */
+    [[nodiscard]] bool is_activated() const noexcept;
+
+    /**
+     * Extracts the referenced fields from the JSON record.
+     *
+     * @param line   JSON record
+     * @param record Text record to store the extracted values to
+     *
+     * @return True if the record is a valid JSON object, otherwise false
+     */
+    [[nodiscard]] bool extract(std::string_view line, text_record& record) const;
+
+    /**
+     * Checks whether the JSON record satisfies the expression.
+     *
+     * @param line   JSON record
+     * @param record Scratch text record created by make_record
+     *
+     * @return True if the record satisfies the expression, otherwise false
+     */
+    [[nodiscard]] bool matches(std::string_view line, text_record& record) const;
+
+    /**
+     * Creates a scratch text record used for matching.
+     *
+     * @return Empty text record
+     */
+    [[nodiscard]] text_record make_record() const;
+
+    /**
+     * Invokes the function for each line of the buffer satisfying the expression.
+     *
+     * @param buffer Buffer containing newline-delimited JSON records
+     * @param func   Function to invoke with each matching line
+     *
+     * @return Number of matching lines
+     */
+    template <typename F>
+    std::size_t for_each_match(std::string_view buffer, F&& func) const;
+
+    /**
+     * Writes the lines of the buffer satisfying the expression to the output stream.
+     *
+     * @param buffer Buffer containing newline-delimited JSON records
+     * @param out    Output stream to write the matching lines to
+     *
+     * @return Number of matching lines
+     */
+    std::size_t filter(std::string_view buffer, std::ostream& out) const;
+
+    /**
+     * Reads newline-delimited JSON records from the file descriptor until
+     * the end of file and writes the lines satisfying the expression to
+     * the output stream.
+     *
+     * @param fd  File descriptor to read the records from
+     * @param out Output stream to write the matching lines to
+     *
+     * @throws std::system_error if reading fails
+     *
+     * @return Number of matching lines
+     */
+    std::size_t filter(int fd, std::ostream& out) const;
+
+private:
+    /**
+     * struct field_path
+     *
+     * Represents the referenced field split into dotted path segments.
+     */
+    struct field_path {
+        std::vector<std::string_view> segments;
+    };
+
+    /**
+     * Scans the JSON object and extracts the values of the candidate fields.
+     * Scanning stops as soon as all the referenced fields are extracted.
+     *
+     * @param first      Position of the opening brace, moved past the scanned part
+     * @param last       End of the input
+     * @param depth      Nesting depth of the object
+     * @param candidates Slots of the fields whose path may continue within the object
+     * @param remaining  Slots of the fields not extracted yet
+     * @param record     Text record to store the extracted values to
+     *
+     * @return True if the scanned part of the object is valid, otherwise false
+     */
+    [[nodiscard]] bool scan_object(char const*& first, char const* last,
+                                   std::size_t depth, uint64_t candidates,
+                                   uint64_t& remaining, text_record& record) const;
+
+private:
+    text_filter filter_;
+    std::vector<field_path> paths_;
+};
+
+template <typename F>
+std::size_t ndjson_filter::for_each_match(std::string_view buffer, F&& func) const {
+    std::size_t count{ 0 };
+    auto record = make_record();
+
+    while (!buffer.empty()) {
+        auto const end = buffer.find('\n');
+        auto line = buffer.substr(0, end);
+        buffer.remove_prefix(std::string_view::npos == end ? buffer.size() : end + 1);
+
+        if (!line.empty() && '\r' == line.back()) {
+            line.remove_suffix(1);
+        }
+
+        if (!line.empty() && matches(line, record)) {
+            func(line);
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+} // io
+
+} // booleval
+
+#endif // BOOLEVAL_NDJSON_FILTER_H
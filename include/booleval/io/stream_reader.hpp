@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_STREAM_READER_H
+#define BOOLEVAL_STREAM_READER_H
+
+#include <vector>
+#include <string_view>
+
+namespace booleval {
+
+namespace io {
+
+/**
+ * class stream_reader
+ *
+ * Represents a buffered reader of a file descriptor (e.g. standard input)
+ * for inputs that cannot be mapped into memory. The bytes that are not
+ * consumed are kept in the buffer and followed by the newly read ones,
+ * so records crossing the chunk boundary can be processed as a whole.
+ */
+class stream_reader {
+public:
+    /**
+     * Default size of the chunks read from the file descriptor.
+     */
+    static constexpr std::size_t default_chunk_size{ 1 << 20 };
+
+    stream_reader(stream_reader&& rhs) = default;
+    stream_reader(stream_reader const& rhs) = delete;
+
+    stream_reader(int const fd, std::size_t const chunk_size = default_chunk_size)
+        : fd_(fd),
+          buffer_(0 == chunk_size ? default_chunk_size : chunk_size)
+    {}
+
+    stream_reader& operator=(stream_reader&& rhs) = default;
+    stream_reader& operator=(stream_reader const& rhs) = delete;
+
+    ~stream_reader() = default;
+
+    /**
+     * Reads the bytes available from the file descriptor, at most as many as
+     * fit in the buffer. Unlike filling the whole buffer, this does not wait
+     * for more input once some is available, so slow pipes (e.g. `tail -f`)
+     * are processed as the data arrives. If no byte was consumed since the
+     * previous read and the buffer is full, the buffer is grown.
+     *
+     * @throws std::system_error if reading fails
+     *
+     * @return True if any byte is read, otherwise false (end of file)
+     */
+    [[nodiscard]] bool read();
+
+    /**
+     * Gets the buffered bytes that are not consumed yet.
+     *
+     * @return Buffered bytes
+     */
+    [[nodiscard]] std::string_view data() const noexcept;
+
+    /**
+     * Consumes the bytes from the beginning of the buffered data.
+     *
+     * @param size Number of bytes to consume
+     */
+    void consume(std::size_t size) noexcept;
+
+private:
+    int fd_{ -1 };
+    std::vector<char> buffer_;
+    std::size_t begin_{ 0 };
+    std::size_t end_{ 0 };
+};
+
+} // io
+
+} // booleval
+
+#endif // BOOLEVAL_STREAM_READER_H
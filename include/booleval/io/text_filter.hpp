@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_TEXT_FILTER_H
+#define BOOLEVAL_TEXT_FILTER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <string_view>
+#include <booleval/evaluator.hpp>
+#include <booleval/io/text_record.hpp>
+
+namespace booleval {
+
+namespace io {
+
+/**
+ * class text_filter
+ *
+ * Represents the evaluation part shared by the filters of textual input
+ * formats. Each field referenced in the expression is assigned a slot
+ * in the text record which the format specific filters fill in.
+ */
+class text_filter {
+public:
+    text_filter() = default;
+    text_filter(text_filter&& rhs) = default;
+    text_filter(text_filter const& rhs) = delete;
+
+    text_filter& operator=(text_filter&& rhs) = default;
+    text_filter& operator=(text_filter const& rhs) = delete;
+
+    ~text_filter() = default;
+
+    /**
+     * Sets the expression to be used for filtering. The expression is
+     * copied so it does not need to outlive the filter.
+     *
+     * @param expression Expression to be used for filtering
+     *
+     * @return True if the expression is valid, otherwise false
+     */
+    [[nodiscard]] bool expression(std::string_view expression);
+
+    /**
+     * Checks whether the filtering is activated or not, i.e.
+     * if the expression is successfully set.
+     *
+     * @return True if the filtering is activated, otherwise false
+     */
+    [[nodiscard]] bool is_activated() const noexcept;
+
+    /**
+     * Gets the names of the fields referenced in the expression. The position
+     * of the field name represents the slot of the field in the text record.
+     *
+     * @return Referenced field names
+     */
+    [[nodiscard]] std::vector<std::string_view> const& fields() const noexcept;
+
+    /**
+     * Creates a text record with a slot for each referenced field.
+     *
+     * @return Empty text record
+     */
+    [[nodiscard]] text_record make_record() const;
+
+    /**
+     * Evaluates the expression for the text record.
+     *
+     * @param record Text record to be evaluated
+     *
+     * @return True if the record satisfies the expression, otherwise false
+     */
+    [[nodiscard]] bool evaluate(text_record const& record) const;
+
+private:
+    std::unique_ptr<std::string> expression_;
+    std::vector<std::string_view> fields_;
+    evaluator<text_field> evaluator_;
+};
+
+} // io
+
+} // booleval
+
+#endif // BOOLEVAL_TEXT_FILTER_H
@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_TEXT_RECORD_H
+#define BOOLEVAL_TEXT_RECORD_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <booleval/utils/string_utils.hpp>
+
+namespace booleval {
+
+namespace io {
+
+/**
+ * struct text_value
+ *
+ * Represents a field value extracted from a textual record. The value
+ * points directly into the input buffer or, if it has to be decoded,
+ * e.g. an escaped JSON string, into the scratch buffer of the record.
+ */
+struct text_value {
+    std::string_view text;
+    bool quoted{ false };
+    bool present{ false };
+};
+
+/**
+ * class text_record
+ *
+ * Represents a record of a textual input format (NDJSON, CSV, ...) reduced to
+ * the values of the fields referenced in the expression. Each referenced field
+ * is assigned a slot in the record. Values may refer to the scratch buffers
+ * of the record, so records can be moved but not copied.
+ */
+class text_record {
+public:
+    text_record() = default;
+    text_record(text_record&& rhs) = default;
+    text_record(text_record const& rhs) = delete;
+
+    text_record(std::size_t const size)
+        : values_(size),
+          buffers_(size)
+    {}
+
+    text_record& operator=(text_record&& rhs) = default;
+    text_record& operator=(text_record const& rhs) = delete;
+
+    ~text_record() = default;
+
+    /**
+     * Gets the number of slots in the record.
+     *
+     * @return Number of slots
+     */
+    [[nodiscard]] std::size_t size() const noexcept {
+        return values_.size();
+    }
+
+    /**
+     * Marks all the values as not present.
+     */
+    void clear() noexcept {
+        for (auto& value : values_) {
+            value.present = false;
+        }
+    }
+
+    [[nodiscard]] text_value& operator[](std::size_t const slot) noexcept {
+        return values_[slot];
+    }
+
+    [[nodiscard]] text_value const& operator[](std::size_t const slot) const noexcept {
+        return values_[slot];
+    }
+
+    /**
+     * Gets the scratch buffer of the slot holding the decoded text of its value.
+     * The buffer keeps its capacity between records, so decoding allocates
+     * only until the buffer fits the longest value.
+     *
+     * @param slot Slot of the record
+     *
+     * @return Scratch buffer of the slot
+     */
+    [[nodiscard]] std::string& buffer(std::size_t const slot) noexcept {
+        return buffers_[slot];
+    }
+
+private:
+    std::vector<text_value> values_;
+    std::vector<std::string> buffers_;
+};
+
+/**
+ * class text_field_value
+ *
+ * Represents the value of a text record slot as compared by the evaluator.
+ * The value refers to the text of the record, so nothing is copied or
+ * formatted. Quoted values are strings, while unquoted values are numbers
+ * whenever they can be parsed as such. A value is equal to the literal if
+ * its text is, or if both are numbers of the same value, e.g. 1.0 equals
+ * 1 and 1e2 equals 100. Numbers are ordered numerically, strings
+ * lexicographically.
+ */
+class text_field_value {
+public:
+    text_field_value() = default;
+    text_field_value(text_field_value&& rhs) = default;
+    text_field_value(text_field_value const& rhs) = default;
+
+    text_field_value(std::string_view const text, bool const quoted)
+        : text_(text),
+          is_null_(false)
+    {
+        if (!quoted) {
+            auto const number = utils::from_chars_exact<double>(text);
+            is_string_ = !number.has_value();
+            number_ = number.value_or(0);
+        }
+    }
+
+    text_field_value& operator=(text_field_value&& rhs) = default;
+    text_field_value& operator=(text_field_value const& rhs) = default;
+
+    ~text_field_value() = default;
+
+    [[nodiscard]] std::string_view str() const noexcept {
+        return text_;
+    }
+
+    /**
+     * Checks whether the value is null, i.e. the field is not present.
+     *
+     * @return True if the value is null, otherwise false
+     */
+    [[nodiscard]] bool is_null() const noexcept {
+        return is_null_;
+    }
+
+    /**
+     * Checks whether the value is ordered as a string rather than as a number.
+     *
+     * @return True if the value is a string, otherwise false
+     */
+    [[nodiscard]] bool is_string() const noexcept {
+        return is_string_;
+    }
+
+    [[nodiscard]] bool operator==(std::string_view const rhs) const {
+        if (text_ == rhs) {
+            return true;
+        }
+
+        if (is_string_) {
+            return false;
+        }
+
+        // Integers beyond the precision of double are compared exactly
+        if (is_integer(text_) && is_integer(rhs)) {
+            auto const lhs_integer = utils::from_chars_exact<int64_t>(text_);
+            auto const rhs_integer = utils::from_chars_exact<int64_t>(rhs);
+            if (lhs_integer && rhs_integer) {
+                return lhs_integer.value() == rhs_integer.value();
+            }
+        }
+
+        auto const number = utils::from_chars_exact<double>(rhs);
+        return number && number.value() == number_;
+    }
+
+    [[nodiscard]] bool operator!=(std::string_view const rhs) const {
+        return !(*this == rhs);
+    }
+
+    [[nodiscard]] bool operator<(std::string_view const rhs) const {
+        return compare(rhs, std::less<>());
+    }
+
+    [[nodiscard]] bool operator>(std::string_view const rhs) const {
+        return compare(rhs, std::greater<>());
+    }
+
+    [[nodiscard]] bool operator<=(std::string_view const rhs) const {
+        return compare(rhs, std::less_equal<>());
+    }
+
+    [[nodiscard]] bool operator>=(std::string_view const rhs) const {
+        return compare(rhs, std::greater_equal<>());
+    }
+
+private:
+    [[nodiscard]] static bool is_integer(std::string_view const text) noexcept {
+        return std::string_view::npos == text.find_first_of(".eEnN");
+    }
+
+    template <typename Compare>
+    [[nodiscard]] bool compare(std::string_view const rhs, Compare&& cmp) const {
+        if (is_string_) {
+            return cmp(text_, rhs);
+        }
+
+        auto const number = utils::from_chars<double>(rhs);
+        return number && cmp(number_, number.value());
+    }
+
+private:
+    std::string_view text_;
+    double number_{ 0 };
+    bool is_string_{ true };
+    bool is_null_{ true };
+};
+
+/**
+ * class text_field
+ *
+ * Represents an accessor of a single text record slot that can be used
+ * in evaluator's field map instead of a member function.
+ */
+class text_field {
+public:
+    text_field() = default;
+    text_field(text_field&& rhs) = default;
+    text_field(text_field const& rhs) = default;
+
+    text_field(std::size_t const slot)
+        : slot_(slot)
+    {}
+
+    text_field& operator=(text_field&& rhs) = default;
+    text_field& operator=(text_field const& rhs) = default;
+
+    ~text_field() = default;
+
+    /**
+     * Gets the slot of the text record accessed by this field.
+     *
+     * @return Slot of the text record
+     */
+    [[nodiscard]] std::size_t slot() const noexcept {
+        return slot_;
+    }
+
+    /**
+     * Gets the value of the field from the text record (see text_field_value).
+     *
+     * @param record Text record to get the value from
+     *
+     * @return Value of the field or null value if the field is not present
+     */
+    [[nodiscard]] text_field_value invoke(text_record const& record) const {
+        auto const& value = record[slot_];
+        if (!value.present) {
+            return {};
+        }
+
+        return { value.text, value.quoted };
+    }
+
+private:
+    std::size_t slot_{ 0 };
+};
+
+} // io
+
+} // booleval
+
+#endif // BOOLEVAL_TEXT_RECORD_H
@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_TYPED_COMPARISON_H
+#define BOOLEVAL_TYPED_COMPARISON_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <memory>
+#include <functional>
+#include <string_view>
+#include <booleval/token/token_type.hpp>
+#include <booleval/io/binary_record.hpp>
+#include <booleval/utils/bit_utils.hpp>
+#include <booleval/utils/string_matcher.hpp>
+
+namespace booleval {
+
+namespace io {
+
+namespace detail {
+
+/**
+ * Gets the mask of the bits of the bitmap word corresponding to the first count values.
+ *
+ * @param count Number of values
+ * @param word  Index of the bitmap word
+ *
+ * @return Mask of the valid bits of the word
+ */
+[[nodiscard]] inline uint64_t valid_mask(std::size_t const count, std::size_t const word) noexcept {
+    auto const valid = count - 64 * word;
+    return valid >= 64 ? ~uint64_t{ 0 } : (uint64_t{ 1 } << valid) - 1;
+}
+
+/**
+ * Invokes the function with the comparison function object of the relational operator.
+ *
+ * @param op   Relational operator
+ * @param func Function to invoke
+ */
+template <typename F>
+void with_comparison(token::token_type const op, F&& func) {
+    switch (op) {
+        case token::token_type::eq:  func(std::equal_to<>());      break;
+        case token::token_type::neq: func(std::not_equal_to<>());  break;
+        case token::token_type::gt:  func(std::greater<>());       break;
+        case token::token_type::lt:  func(std::less<>());          break;
+        case token::token_type::geq: func(std::greater_equal<>()); break;
+        default:                     func(std::less_equal<>());    break;
+    }
+}
+
+/**
+ * Sets one bit per value, 64 values at a time, so that the inner loop
+ * is a branch-free strided load and comparison.
+ *
+ * @param value     Pointer to the first value
+ * @param count     Number of values
+ * @param stride    Distance between the values in bytes
+ * @param bits      Bitmap of at least (count + 63) / 64 words
+ * @param predicate Predicate taking a pointer to the value
+ */
+template <typename Predicate>
+void scan_values(std::byte const* value, std::size_t const count, std::size_t const stride,
+                 uint64_t* bits, Predicate&& predicate) {
+    for (std::size_t first = 0; first < count; first += 64) {
+        auto const n = std::min<std::size_t>(64, count - first);
+
+        uint64_t word{ 0 };
+        for (std::size_t i = 0; i < n; ++i, value += stride) {
+            word |= static_cast<uint64_t>(predicate(value)) << i;
+        }
+        *bits++ = word;
+    }
+}
+
+} // detail
+
+/**
+ * class block_selection
+ *
+ * Represents the rows of a block an operand still has to evaluate, e.g. the rows
+ * accepted by the left operand of a logical and. The rows are given by a bitmap;
+ * when few of them are selected, their ascending indices are extracted as well,
+ * so that a scan loads and compares only the selected values rather than all
+ * the values of the block.
+ */
+class block_selection {
+public:
+    /**
+     * Maximum number of rows of a block.
+     */
+    static constexpr std::size_t max_rows{ 1024 };
+
+    /**
+     * Selections of at most one row in sparse_ratio are scanned through their indices.
+     */
+    static constexpr std::size_t sparse_ratio{ 8 };
+
+    /**
+     * Measures the density of the selection and extracts the indices of a sparse one.
+     * The bitmap is referred to, so it must outlive the selection.
+     *
+     * @param bits  Bitmap of the selected rows, the bits past the last row being cleared
+     * @param count Number of rows of the block, not greater than max_rows
+     */
+    block_selection(uint64_t const* const bits, std::size_t const count) noexcept
+        : bits_(bits),
+          count_(count) {
+        auto const words = (count + 63) / 64;
+        for (std::size_t i = 0; i < words; ++i) {
+            size_ += utils::popcount(bits[i]);
+        }
+
+        is_sparse_ = size_ * sparse_ratio <= count;
+        if (is_sparse_) {
+            std::size_t n{ 0 };
+            for (std::size_t i = 0; i < words; ++i) {
+                for (auto b = bits[i]; 0 != b; b &= b - 1) {
+                    indices_[n++] = static_cast<uint16_t>(i * 64 + utils::count_trailing_zeros(b));
+                }
+            }
+        }
+    }
+
+    block_selection(block_selection const& rhs) = delete;
+    block_selection& operator=(block_selection const& rhs) = delete;
+
+    ~block_selection() = default;
+
+    /**
+     * Gets the bitmap of the selected rows.
+     *
+     * @return Bitmap of the selected rows
+     */
+    [[nodiscard]] uint64_t const* bits() const noexcept {
+        return bits_;
+    }
+
+    /**
+     * Gets the number of rows of the block.
+     *
+     * @return Number of rows of the block
+     */
+    [[nodiscard]] std::size_t count() const noexcept {
+        return count_;
+    }
+
+    /**
+     * Gets the number of selected rows.
+     *
+     * @return Number of selected rows
+     */
+    [[nodiscard]] std::size_t size() const noexcept {
+        return size_;
+    }
+
+    /**
+     * Checks whether no row is selected.
+     *
+     * @return True if no row is selected, otherwise false
+     */
+    [[nodiscard]] bool empty() const noexcept {
+        return 0 == size_;
+    }
+
+    /**
+     * Checks whether the selected rows are scanned through their indices.
+     *
+     * @return True if the selection is sparse, otherwise false
+     */
+    [[nodiscard]] bool is_sparse() const noexcept {
+        return is_sparse_;
+    }
+
+    /**
+     * Tests the selected values by the predicate and sets one bit per selected
+     * value satisfying it, the bits of the other rows being cleared. A dense
+     * selection scans all the values and masks the result, a sparse one
+     * tests only the selected values.
+     *
+     * @param value     Pointer to the value of the first row
+     * @param stride    Distance between the values in bytes
+     * @param bits      Bitmap of at least (count() + 63) / 64 words
+     * @param predicate Predicate taking a pointer to the value
+     */
+    template <typename Predicate>
+    void scan(std::byte const* const value, std::size_t const stride, uint64_t* const bits, Predicate&& predicate) const {
+        auto const words = (count_ + 63) / 64;
+        if (!is_sparse_) {
+            detail::scan_values(value, count_, stride, bits, predicate);
+            for (std::size_t i = 0; i < words; ++i) {
+                bits[i] &= bits_[i];
+            }
+            return;
+        }
+
+        std::fill(bits, bits + words, 0);
+        for (std::size_t k = 0; k < size_; ++k) {
+            auto const i = static_cast<std::size_t>(indices_[k]);
+            bits[i / 64] |= static_cast<uint64_t>(predicate(value + i * stride)) << (i % 64);
+        }
+    }
+
+private:
+    uint64_t const* bits_{ nullptr };
+    std::size_t count_{ 0 };
+    std::size_t size_{ 0 };
+    bool is_sparse_{ false };
+    std::array<uint16_t, max_rows> indices_;
+};
+
+/**
+ * class typed_comparison
+ *
+ * Represents a comparison of the fixed-width values of a binary field with
+ * a literal, compiled so that it is evaluated on the typed values. The values
+ * are compared the same way as by the evaluator, i.e. through their string
+ * form: equality compares the shortest representation of the value with the
+ * literal, while ordering compares numbers parsed as double (strings
+ * lexicographically). Thus equality holds only for the literal that is the
+ * exact representation of a value of the field type, which turns into a typed
+ * (or, for floating point, bitwise) comparison. Comparisons that cannot be
+ * reproduced on the typed values (float32 ordering, NaN literals) convert
+ * each value as the evaluator does. Null tests are constant, since the values
+ * are always present. String matching operators match the padding-trimmed
+ * strings or the string form of the other values against the compiled pattern.
+ */
+class typed_comparison {
+public:
+    typed_comparison() = default;
+    typed_comparison(typed_comparison&& rhs) = default;
+    typed_comparison(typed_comparison const& rhs) = default;
+
+    /**
+     * Compiles the comparison. The literal is referred to,
+     * so it must outlive the comparison.
+     *
+     * @param op      Relational operator
+     * @param field   Field whose values are compared
+     * @param literal Literal the values are compared with
+     */
+    typed_comparison(token::token_type op, binary_field const& field, std::string_view literal);
+
+    /**
+     * Compiles the string matching of the field values.
+     *
+     * @param matcher Compiled pattern
+     * @param field   Field whose values are matched
+     */
+    typed_comparison(std::shared_ptr<utils::string_matcher const> matcher, binary_field const& field);
+
+    typed_comparison& operator=(typed_comparison&& rhs) = default;
+    typed_comparison& operator=(typed_comparison const& rhs) = default;
+
+    ~typed_comparison() = default;
+
+    [[nodiscard]] binary_field const& field() const noexcept {
+        return field_;
+    }
+
+    /**
+     * Compares the values and sets one bit per value.
+     *
+     * @param values Pointer to the first value (the field offset is not applied)
+     * @param stride Distance between the values in bytes
+     * @param count  Number of values
+     * @param bits   Bitmap of at least (count + 63) / 64 words, the bits
+     *               past the last value being cleared
+     */
+    void scan(std::byte const* values, std::size_t stride, std::size_t count, uint64_t* bits) const;
+
+    /**
+     * Compares the selected values and sets one bit per selected value
+     * satisfying the comparison, the bits of the other rows being cleared.
+     *
+     * @param values    Pointer to the value of the first row (the field offset is not applied)
+     * @param stride    Distance between the values in bytes
+     * @param selection Rows to compare
+     * @param bits      Bitmap of at least (selection.count() + 63) / 64 words
+     */
+    void scan(std::byte const* values, std::size_t stride, block_selection const& selection, uint64_t* bits) const;
+
+private:
+    enum class kind : uint8_t {
+        constant,
+        signed_integer,
+        unsigned_integer,
+        floating_point,
+        raw_bits,
+        string,
+        pattern,
+        fallback
+    };
+
+    template <typename Scanner>
+    void scan_with(Scanner&& scanner) const;
+
+private:
+    kind kind_{ kind::constant };
+    token::token_type op_{ token::token_type::unknown };
+    binary_field field_;
+    std::string_view literal_;
+    std::shared_ptr<utils::string_matcher const> matcher_;
+    int64_t signed_value_{ 0 };
+    uint64_t unsigned_value_{ 0 };
+    double floating_point_value_{ 0 };
+    bool result_{ false };
+};
+
+} // io
+
+} // booleval
+
+#endif // BOOLEVAL_TYPED_COMPARISON_H
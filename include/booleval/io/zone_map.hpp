@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_ZONE_MAP_H
+#define BOOLEVAL_ZONE_MAP_H
+
+#include <map>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+#include <booleval/token/token_type.hpp>
+#include <booleval/utils/bloom_filter.hpp>
+#include <booleval/utils/string_utils.hpp>
+
+namespace booleval {
+
+namespace io {
+
+/**
+ * enum class zone_match
+ *
+ * Represents how many values within some bounds satisfy a comparison.
+ */
+enum class zone_match : uint8_t {
+    none,
+    some,
+    all
+};
+
+/**
+ * class zone_map
+ *
+ * Represents per-zone statistics of columns, i.e. the bounds of the values
+ * of each zone of zone_size() consecutive rows. Column-wise evaluation decides
+ * the comparisons of a numeric column with a literal for a whole block of rows
+ * from these bounds: blocks none of whose values can satisfy a comparison are
+ * not scanned, and blocks all of whose values satisfy it are accepted at once.
+ * For data sorted by a column, e.g. time series by the timestamp, a range
+ * predicate on that column thus skips all the blocks outside the range.
+ * Columns can also have a Bloom filter per zone, holding the string forms of
+ * the values, which skips the blocks not containing the literal of an equality
+ * of any column, e.g. `user_id 123 and ...` over data not sorted by user_id.
+ *
+ * The bounds must include every value of the zone, except for null values.
+ * Zones containing NaN or whose bounds are unknown have NaN bounds.
+ */
+class zone_map {
+public:
+    /**
+     * struct bounds
+     *
+     * Represents the minimum and the maximum value of a zone.
+     */
+    struct bounds {
+        double min{ std::numeric_limits<double>::quiet_NaN() };
+        double max{ std::numeric_limits<double>::quiet_NaN() };
+    };
+
+    zone_map() = default;
+    zone_map(zone_map&& rhs) = default;
+    zone_map(zone_map const& rhs) = default;
+
+    /**
+     * Creates the statistics of zones of the size.
+     *
+     * @param zone_size Number of rows of each zone
+     */
+    explicit zone_map(std::size_t zone_size) noexcept;
+
+    zone_map& operator=(zone_map&& rhs) = default;
+    zone_map& operator=(zone_map const& rhs) = default;
+
+    ~zone_map() = default;
+
+    /**
+     * Gets the number of rows of each zone.
+     *
+     * @return Number of rows of each zone
+     */
+    [[nodiscard]] std::size_t zone_size() const noexcept;
+
+    /**
+     * Sets the statistics of the column, replacing the previous ones.
+     *
+     * @param column Name of the column
+     * @param zones  Bounds of the values of each zone, the first zone starting at row 0
+     */
+    void add(std::string_view column, std::vector<bounds> zones);
+
+    /**
+     * Computes the statistics of the column from its values.
+     *
+     * @param column Name of the column
+     * @param values Values of the column
+     */
+    template <typename T>
+    void add(std::string_view column, std::vector<T> const& values);
+
+    /**
+     * Gets the bounds of the values of the rows.
+     *
+     * @param column Name of the column
+     * @param first  Index of the first row
+     * @param count  Number of rows
+     *
+     * @return Bounds of the values or std::nullopt if some of the zones
+     *         covering the rows have no statistics
+     */
+    [[nodiscard]] std::optional<bounds> find(std::string_view column, std::size_t first, std::size_t count) const;
+
+    /**
+     * Sets the Bloom filters of the column, one per zone, replacing the previous ones.
+     * The filters hold the string forms of the values, i.e. the literals equal to them.
+     *
+     * @param column  Name of the column
+     * @param filters Bloom filter of each zone, the first zone starting at row 0
+     */
+    void add_bloom_filters(std::string_view column, std::vector<utils::bloom_filter> filters);
+
+    /**
+     * Builds the Bloom filters of the column from its values. Numbers are added
+     * in their shortest string form, strings as they are, i.e. the values
+     * of string fields without the padding.
+     *
+     * @param column         Name of the column
+     * @param values         Values of the column
+     * @param bits_per_value Number of bits of the filters per value
+     */
+    template <typename T>
+    void add_bloom_filters(std::string_view column, std::vector<T> const& values, std::size_t bits_per_value = 10);
+
+    /**
+     * Checks whether some of the rows may be equal to the literal.
+     *
+     * @param column  Name of the column
+     * @param first   Index of the first row
+     * @param count   Number of rows
+     * @param literal Literal the values are compared with
+     *
+     * @return False if the Bloom filters of all zones covering the rows
+     *         exclude the literal, otherwise true
+     */
+    [[nodiscard]] bool may_contain(std::string_view column, std::size_t first, std::size_t count, std::string_view literal) const;
+
+    /**
+     * Decides the comparison of the values of the rows with the literal
+     * by the bounds and the Bloom filters of the column, if it has any.
+     *
+     * @param column  Name of the column
+     * @param first   Index of the first row
+     * @param count   Number of rows
+     * @param op      Relational operator
+     * @param value   Literal parsed as a number or NaN if ordering the values is not decided by the bounds
+     * @param literal Literal the values are compared with
+     *
+     * @return Whether none, some or all of the values satisfy the comparison
+     */
+    [[nodiscard]] zone_match match(std::string_view column, std::size_t first, std::size_t count,
+                                   token::token_type op, double value, std::string_view literal) const;
+
+    /**
+     * Decides the comparison of the values within the bounds with the literal.
+     * Ordering compares numbers, equality holds only for the values
+     * numerically equal to the literal.
+     *
+     * @param op      Relational operator
+     * @param literal Literal the values are compared with
+     * @param b       Bounds of the values
+     *
+     * @return Whether none, some or all of the values satisfy the comparison
+     */
+    [[nodiscard]] static zone_match decide(token::token_type op, double literal, bounds const& b) noexcept;
+
+private:
+    std::size_t zone_size_{ 1024 };
+    std::map<std::string, std::vector<bounds>, std::less<>> columns_;
+    std::map<std::string, std::vector<utils::bloom_filter>, std::less<>> bloom_filters_;
+};
+
+template <typename T>
+void zone_map::add(std::string_view const column, std::vector<T> const& values) {
+    std::vector<bounds> zones((values.size() + zone_size_ - 1) / zone_size_);
+    for (std::size_t z = 0; z < zones.size(); ++z) {
+        auto const first = z * zone_size_;
+        auto const last = std::min(first + zone_size_, values.size());
+
+        bounds b{ std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity() };
+        for (auto i = first; i < last; ++i) {
+            auto const value = static_cast<double>(values[i]);
+            if (std::isnan(value)) {
+                b = bounds{};
+                break;
+            }
+            b.min = std::min(b.min, value);
+            b.max = std::max(b.max, value);
+        }
+        zones[z] = b;
+    }
+
+    add(column, std::move(zones));
+}
+
+template <typename T>
+void zone_map::add_bloom_filters(std::string_view const column, std::vector<T> const& values, std::size_t const bits_per_value) {
+    std::vector<utils::bloom_filter> filters;
+    filters.reserve((values.size() + zone_size_ - 1) / zone_size_);
+    for (std::size_t first = 0; first < values.size(); first += zone_size_) {
+        auto const last = std::min(first + zone_size_, values.size());
+
+        auto& filter = filters.emplace_back(last - first, bits_per_value);
+        for (auto i = first; i < last; ++i) {
+            if constexpr (std::is_floating_point_v<T>) {
+                std::array<char, utils::max_chars<T>> buffer;
+                filter.add(utils::to_chars(buffer, values[i]));
+            } else if constexpr (std::is_integral_v<T>) {
+                using wide = std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>;
+                std::array<char, utils::max_chars<wide>> buffer;
+                filter.add(utils::to_chars(buffer, static_cast<wide>(values[i])));
+            } else {
+                filter.add(std::string_view(values[i]));
+            }
+        }
+    }
+
+    add_bloom_filters(column, std::move(filters));
+}
+
+} // io
+
+} // booleval
+
+#endif // BOOLEVAL_ZONE_MAP_H
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_PARALLEL_FILTER_H
+#define BOOLEVAL_PARALLEL_FILTER_H
+
+#include <vector>
+#include <cstdint>
+#include <iterator>
+#include <algorithm>
+#include <booleval/evaluator.hpp>
+#include <booleval/utils/bitmap.hpp>
+#include <booleval/parallel/thread_pool.hpp>
+
+namespace booleval {
+
+namespace parallel {
+
+/**
+ * Default number of objects evaluated by a single task.
+ */
+constexpr std::size_t default_chunk_size{ 4096 };
+
+/**
+ * struct chunk_selection
+ *
+ * Represents the result of evaluating one chunk of the input range. Each chunk
+ * owns its bitmap and occupies its own cache lines so that the workers
+ * filling in different chunks never write to the same cache line.
+ */
+struct alignas(cache_line_size) chunk_selection {
+    std::size_t offset{ 0 };
+    std::size_t size{ 0 };
+    std::size_t count{ 0 };
+    utils::bitmap bits;
+
+    /**
+     * Checks whether the object at the specified position within the chunk is selected.
+     *
+     * @param index Position of the object within the chunk
+     *
+     * @return True if the object is selected, otherwise false
+     */
+    [[nodiscard]] bool test(std::size_t const index) const noexcept {
+        return bits.test(index);
+    }
+};
+
+/**
+ * Evaluates the objects from the range in chunks on the thread pool and
+ * returns per-chunk bitmaps of the objects satisfying the expression.
+ *
+ * The evaluator is any object whose evaluate member takes an object from
+ * the range and can be called from several threads at once, e.g. evaluator
+ * (profiled or not) or shared_evaluator.
+ *
+ * @param range      Random access range of objects to be evaluated
+ * @param evaluator  Evaluator with the expression already set
+ * @param pool       Thread pool to evaluate the chunks on
+ * @param chunk_size Number of objects evaluated by a single task
+ *
+ * @return Per-chunk bitmaps, ordered by chunk offset
+ */
+template <typename Range, typename Evaluator>
+[[nodiscard]] std::vector<chunk_selection> parallel_filter_chunks(Range const& range,
+                                                                 Evaluator const& evaluator,
+                                                                 thread_pool& pool,
+                                                                 std::size_t chunk_size = default_chunk_size) {
+    // Round the chunk size up to whole bitmap words
+    chunk_size = std::max<std::size_t>((chunk_size + 63) / 64 * 64, 64);
+
+    auto const first = std::begin(range);
+    auto const size = static_cast<std::size_t>(std::distance(first, std::end(range)));
+    auto const chunk_count = (size + chunk_size - 1) / chunk_size;
+
+    std::vector<chunk_selection> chunks(chunk_count);
+    for (std::size_t i = 0; i < chunk_count; ++i) {
+        auto& chunk = chunks[i];
+        chunk.offset = i * chunk_size;
+        chunk.size = std::min(chunk_size, size - chunk.offset);
+
+        pool.submit([&chunk, &evaluator, first] {
+            utils::bitmap bits(chunk.size);
+
+            auto it = std::next(first, chunk.offset);
+            for (std::size_t j = 0; j < chunk.size; ++j, ++it) {
+                if (evaluator.evaluate(*it)) {
+                    bits.set(j);
+                }
+            }
+
+            chunk.count = bits.count();
+            chunk.bits = std::move(bits);
+        });
+    }
+
+    pool.wait();
+    return chunks;
+}
+
+/**
+ * Evaluates the objects from the range in chunks on the thread pool and
+ * returns the merged selection vector, i.e. the ascending indices of the
+ * objects satisfying the expression. The evaluator is the same as for
+ * parallel_filter_chunks.
+ *
+ * @param range      Random access range of objects to be evaluated
+ * @param evaluator  Evaluator with the expression already set
+ * @param pool       Thread pool to evaluate the chunks on
+ * @param chunk_size Number of objects evaluated by a single task
+ *
+ * @return Indices of the objects satisfying the expression
+ */
+template <typename Range, typename Evaluator>
+[[nodiscard]] std::vector<std::size_t> parallel_filter(Range const& range,
+                                                      Evaluator const& evaluator,
+                                                      thread_pool& pool,
+                                                      std::size_t const chunk_size = default_chunk_size) {
+    auto const chunks = parallel_filter_chunks(range, evaluator, pool, chunk_size);
+
+    std::size_t total{ 0 };
+    for (auto const& chunk : chunks) {
+        total += chunk.count;
+    }
+
+    std::vector<std::size_t> selection;
+    selection.reserve(total);
+    for (auto const& chunk : chunks) {
+        chunk.bits.for_each([&selection, offset = chunk.offset](auto const index) {
+            selection.push_back(offset + index);
+        });
+    }
+
+    return selection;
+}
+
+} // parallel
+
+} // booleval
+
+#endif // BOOLEVAL_PARALLEL_FILTER_H
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_RCU_CELL_H
+#define BOOLEVAL_RCU_CELL_H
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <booleval/parallel/thread_pool.hpp>
+
+namespace booleval {
+
+namespace parallel {
+
+/**
+ * class rcu_cell
+ *
+ * Represents a read-copy-update holder of an immutable value. Readers access
+ * the current value without locking and without writing to shared cache lines,
+ * while writers publish a new value atomically. The replaced values are retired
+ * and reclaimed only after all the readers that could have seen them finish.
+ *
+ * Readers are counted in cache-line sized stripes, each stripe holding one
+ * counter per epoch parity. New readers enter the counter of the current epoch,
+ * so flipping the epoch lets the counters of the previous one drain.
+ */
+template <typename T>
+class rcu_cell {
+public:
+    /**
+     * Number of the reader counter stripes.
+     */
+    static constexpr std::size_t stripe_count{ 32 };
+
+    /**
+     * class read_guard
+     *
+     * Represents a read-side critical section. The value it points to
+     * stays alive at least until the guard is destroyed.
+     */
+    class read_guard {
+    public:
+        read_guard(read_guard&& rhs) noexcept
+            : cell_(std::exchange(rhs.cell_, nullptr)),
+              value_(std::exchange(rhs.value_, nullptr)),
+              stripe_(rhs.stripe_),
+              parity_(rhs.parity_)
+        {}
+
+        read_guard(read_guard const& rhs) = delete;
+
+        read_guard& operator=(read_guard&& rhs) = delete;
+        read_guard& operator=(read_guard const& rhs) = delete;
+
+        ~read_guard() {
+            if (nullptr != cell_) {
+                cell_->stripes_[stripe_].readers[parity_].fetch_sub(1, std::memory_order_seq_cst);
+            }
+        }
+
+        [[nodiscard]] T const* get() const noexcept {
+            return value_;
+        }
+
+        [[nodiscard]] T const& operator*() const noexcept {
+            return *value_;
+        }
+
+        [[nodiscard]] T const* operator->() const noexcept {
+            return value_;
+        }
+
+        [[nodiscard]] explicit operator bool() const noexcept {
+            return nullptr != value_;
+        }
+
+    private:
+        friend rcu_cell;
+
+        read_guard(rcu_cell const& cell) noexcept
+            : cell_(&cell),
+              stripe_(reader_stripe()),
+              parity_(static_cast<std::size_t>(cell.epoch_.load(std::memory_order_seq_cst) & 1)) {
+            cell_->stripes_[stripe_].readers[parity_].fetch_add(1, std::memory_order_seq_cst);
+            value_ = cell_->current_.load(std::memory_order_seq_cst);
+        }
+
+    private:
+        rcu_cell const* cell_{ nullptr };
+        T const* value_{ nullptr };
+        std::size_t stripe_{ 0 };
+        std::size_t parity_{ 0 };
+    };
+
+    rcu_cell() = default;
+    rcu_cell(rcu_cell&& rhs) = delete;
+    rcu_cell(rcu_cell const& rhs) = delete;
+
+    rcu_cell(std::unique_ptr<T> value)
+        : current_(value.release())
+    {}
+
+    rcu_cell& operator=(rcu_cell&& rhs) = delete;
+    rcu_cell& operator=(rcu_cell const& rhs) = delete;
+
+    /**
+     * Destroys the current and all the retired values.
+     * There must be no readers left.
+     */
+    ~rcu_cell() {
+        delete current_.load(std::memory_order_acquire);
+        for (auto& r : retired_) {
+            delete r.value;
+        }
+    }
+
+    /**
+     * Enters the read-side critical section.
+     *
+     * @return Guard pointing to the current value (nullptr if none is published)
+     */
+    [[nodiscard]] read_guard read() const noexcept {
+        return read_guard(*this);
+    }
+
+    /**
+     * Publishes the new value. The readers that already hold the previous
+     * value keep using it, while the subsequent ones get the new value.
+     * The previous value is retired and reclaimed once no reader can hold it.
+     * Neither readers nor the writer wait.
+     *
+     * @param value New value
+     */
+    void publish(std::unique_ptr<T> value) {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+
+        auto const previous = current_.exchange(value.release(), std::memory_order_seq_cst);
+        if (nullptr != previous) {
+            retired_.push_back({ previous, { false, false } });
+        }
+
+        reclaim_locked();
+    }
+
+    /**
+     * Reclaims the retired values no reader can hold anymore without waiting.
+     *
+     * @return Number of the retired values still waiting for reclamation
+     */
+    std::size_t reclaim() {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        return reclaim_locked();
+    }
+
+    /**
+     * Waits until all the retired values are reclaimed.
+     */
+    void synchronize() {
+        while (0 != reclaim()) {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    struct alignas(cache_line_size) stripe {
+        std::array<std::atomic<int64_t>, 2> readers{};
+    };
+
+    struct retired {
+        T const* value;
+        std::array<bool, 2> drained;
+    };
+
+    /**
+     * Gets the counter stripe of the calling thread.
+     */
+    [[nodiscard]] static std::size_t reader_stripe() noexcept {
+        static std::atomic<std::size_t> next_stripe{ 0 };
+        thread_local auto const stripe = next_stripe.fetch_add(1, std::memory_order_relaxed) % stripe_count;
+        return stripe;
+    }
+
+    [[nodiscard]] bool is_drained(std::size_t const parity) const noexcept {
+        for (auto const& s : stripes_) {
+            if (0 != s.readers[parity].load(std::memory_order_seq_cst)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * A retired value can be reclaimed once the reader counters of both parities
+     * have been observed zero after it was retired, since any reader holding it
+     * entered its counter before the value was replaced.
+     */
+    std::size_t reclaim_locked() {
+        if (retired_.empty()) {
+            return 0;
+        }
+
+        auto const active = static_cast<std::size_t>(epoch_.load(std::memory_order_seq_cst) & 1);
+        auto const inactive = active ^ 1;
+
+        for (auto const parity : { inactive, active }) {
+            if (is_drained(parity)) {
+                for (auto& r : retired_) {
+                    r.drained[parity] = true;
+                }
+            }
+        }
+
+        // Let the readers of the active parity drain by directing the new ones to the other
+        if (retired_.front().drained[inactive] && !retired_.front().drained[active]) {
+            epoch_.fetch_add(1, std::memory_order_seq_cst);
+        }
+
+        std::size_t remaining{ 0 };
+        for (auto& r : retired_) {
+            if (r.drained[0] && r.drained[1]) {
+                delete r.value;
+            } else {
+                retired_[remaining++] = r;
+            }
+        }
+        retired_.resize(remaining);
+
+        return remaining;
+    }
+
+private:
+    std::atomic<T const*> current_{ nullptr };
+    std::atomic<uint64_t> epoch_{ 0 };
+    mutable std::array<stripe, stripe_count> stripes_;
+
+    std::mutex writer_mutex_;
+    std::vector<retired> retired_;
+};
+
+} // parallel
+
+} // booleval
+
+#endif // BOOLEVAL_RCU_CELL_H
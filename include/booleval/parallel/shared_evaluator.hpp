@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_SHARED_EVALUATOR_H
+#define BOOLEVAL_SHARED_EVALUATOR_H
+
+#include <map>
+#include <string>
+#include <memory>
+#include <string_view>
+#include <booleval/evaluator.hpp>
+#include <booleval/parallel/rcu_cell.hpp>
+
+namespace booleval {
+
+namespace parallel {
+
+/**
+ * class shared_evaluator
+ *
+ * Represents an evaluator shared by multiple threads whose expression can be
+ * replaced while the other threads keep evaluating. A new expression is compiled
+ * aside and published atomically; the evaluations already in progress finish
+ * with the previous expression, which is reclaimed afterwards.
+ */
+template <typename MemFn = utils::any_mem_fn>
+class shared_evaluator {
+    using field_map = std::map<std::string_view, MemFn>;
+
+public:
+    /**
+     * struct compiled
+     *
+     * Represents an immutable compiled expression. It owns the expression string
+     * since the evaluator refers to the tokens within it.
+     */
+    struct compiled {
+        std::string text;
+        booleval::evaluator<MemFn> evaluator;
+    };
+
+    using snapshot = typename rcu_cell<compiled>::read_guard;
+
+    shared_evaluator() = default;
+    shared_evaluator(shared_evaluator&& rhs) = delete;
+    shared_evaluator(shared_evaluator const& rhs) = delete;
+
+    shared_evaluator(field_map const& fields)
+        : fields_(fields)
+    {}
+
+    shared_evaluator& operator=(shared_evaluator&& rhs) = delete;
+    shared_evaluator& operator=(shared_evaluator const& rhs) = delete;
+
+    ~shared_evaluator() = default;
+
+    /**
+     * Compiles and publishes the expression. If the expression is invalid,
+     * the previously published one stays in use. Safe to call concurrently
+     * with evaluation and with other calls of this method.
+     *
+     * @param expression Expression to be used for evaluation
+     *
+     * @return True if the expression is valid, otherwise false
+     */
+    [[nodiscard]] bool expression(std::string_view const expression) {
+        auto next = std::make_unique<compiled>();
+        next->text = expression;
+        next->evaluator.fields(fields_);
+
+        if (!next->evaluator.expression(next->text)) {
+            return false;
+        }
+
+        cell_.publish(std::move(next));
+        return true;
+    }
+
+    /**
+     * Checks whether the evaluation is activated, i.e. if a non-empty expression is published.
+     *
+     * @return True if the evaluation is activated, otherwise false
+     */
+    [[nodiscard]] bool is_activated() const noexcept {
+        auto const current = cell_.read();
+        return current && current->evaluator.is_activated();
+    }
+
+    /**
+     * Gets the currently published expression. The returned snapshot keeps
+     * the expression alive, so a batch of objects can be evaluated against
+     * the same expression without re-entering the read-side critical section.
+     *
+     * @return Snapshot of the current expression (empty if none is published)
+     */
+    [[nodiscard]] snapshot acquire() const noexcept {
+        return cell_.read();
+    }
+
+    /**
+     * Evaluates the currently published expression for the object passed in.
+     *
+     * @param obj Object to be evaluated
+     *
+     * @return True if the object's members satisfy the expression, otherwise false
+     */
+    template <typename T>
+    [[nodiscard]] bool evaluate(T const& obj) const {
+        auto const current = cell_.read();
+        return current && current->evaluator.evaluate(obj);
+    }
+
+    /**
+     * Reclaims the replaced expressions no evaluation uses anymore.
+     *
+     * @return Number of the replaced expressions still waiting for reclamation
+     */
+    std::size_t reclaim() {
+        return cell_.reclaim();
+    }
+
+    /**
+     * Waits until all the replaced expressions are reclaimed.
+     */
+    void synchronize() {
+        cell_.synchronize();
+    }
+
+private:
+    field_map const fields_;
+    rcu_cell<compiled> cell_;
+};
+
+} // parallel
+
+} // booleval
+
+#endif // BOOLEVAL_SHARED_EVALUATOR_H
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_THREAD_POOL_H
+#define BOOLEVAL_THREAD_POOL_H
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+namespace booleval {
+
+namespace parallel {
+
+/**
+ * Size of the cache line used for separating data written by different threads.
+ */
+constexpr std::size_t cache_line_size{ 64 };
+
+/**
+ * class thread_pool
+ *
+ * Represents a pool of worker threads executing submitted tasks. Each worker
+ * owns a task queue. Workers take tasks from the back of their own queue and,
+ * once it gets empty, steal tasks from the front of the other workers' queues.
+ */
+class thread_pool {
+public:
+    using task = std::function<void()>;
+
+    thread_pool();
+    thread_pool(std::size_t thread_count);
+
+    thread_pool(thread_pool&& rhs) = delete;
+    thread_pool(thread_pool const& rhs) = delete;
+
+    thread_pool& operator=(thread_pool&& rhs) = delete;
+    thread_pool& operator=(thread_pool const& rhs) = delete;
+
+    ~thread_pool();
+
+    /**
+     * Gets the number of worker threads.
+     *
+     * @return Number of worker threads
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * Submits the task for execution. Tasks submitted from one of the worker
+     * threads are pushed to that worker's queue, while the others are
+     * distributed among the workers in a round-robin fashion.
+     *
+     * @param t Task to be executed
+     */
+    void submit(task t);
+
+    /**
+     * Waits until all the submitted tasks are executed. The calling thread
+     * helps executing the queued tasks while waiting. If any of the tasks
+     * has thrown an exception, the first one is rethrown.
+     */
+    void wait();
+
+private:
+    struct alignas(cache_line_size) worker_queue {
+        std::mutex mutex;
+        std::deque<task> tasks;
+    };
+
+    /**
+     * Runs the worker loop.
+     *
+     * @param index Index of the worker
+     */
+    void run(std::size_t index);
+
+    /**
+     * Takes the task from the back of the specified worker's queue.
+     *
+     * @param index Index of the worker
+     * @param t     Taken task
+     *
+     * @return True if the task is taken, otherwise false
+     */
+    [[nodiscard]] bool pop(std::size_t index, task& t);
+
+    /**
+     * Steals the task from the front of any queue other than the specified one.
+     *
+     * @param index Index of the worker stealing the task
+     * @param t     Stolen task
+     *
+     * @return True if the task is stolen, otherwise false
+     */
+    [[nodiscard]] bool steal(std::size_t index, task& t);
+
+    /**
+     * Executes the task and marks it as finished.
+     *
+     * @param t Task to be executed
+     */
+    void execute(task& t) noexcept;
+
+private:
+    std::vector<std::unique_ptr<worker_queue>> queues_;
+    std::vector<std::thread> threads_;
+
+    std::atomic<std::size_t> next_queue_{ 0 };
+    std::atomic<std::size_t> queued_{ 0 };
+    std::atomic<std::size_t> pending_{ 0 };
+
+    std::mutex mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable work_done_;
+    std::exception_ptr exception_;
+    bool stop_{ false };
+};
+
+} // parallel
+
+} // booleval
+
+#endif // BOOLEVAL_THREAD_POOL_H
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_PATH_EVALUATOR_H
+#define BOOLEVAL_PATH_EVALUATOR_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <typeindex>
+#include <string_view>
+#include <booleval/evaluator.hpp>
+#include <booleval/utils/object_schema.hpp>
+
+namespace booleval {
+
+/**
+ * class path_evaluator
+ *
+ * Represents an evaluator of expressions over objects of type Root whose fields
+ * are referenced through dotted paths of nested members, e.g. 'customer.tier'.
+ * The paths are resolved against the object schema once the expression is set,
+ * so only the members of each type need to be registered.
+ */
+template <typename Root>
+class path_evaluator {
+public:
+    path_evaluator(utils::object_schema schema)
+        : schema_(std::move(schema))
+    {}
+
+    path_evaluator(path_evaluator&& rhs) = default;
+    path_evaluator(path_evaluator const& rhs) = delete;
+
+    path_evaluator& operator=(path_evaluator&& rhs) = default;
+    path_evaluator& operator=(path_evaluator const& rhs) = delete;
+
+    ~path_evaluator() = default;
+
+    /**
+     * Sets the expression and resolves the field paths referenced in it.
+     *
+     * @param expression Expression to be used for evaluation
+     *
+     * @return True if the expression is valid, otherwise false
+     *
+     * @throws field_not_found if a referenced path cannot be resolved
+     */
+    [[nodiscard]] bool expression(std::string_view const expression) {
+        expression_ = std::make_unique<std::string>(expression);
+
+        if (!evaluator_.expression(*expression_) || !evaluator_.is_activated()) {
+            return evaluator_.is_activated() || expression.empty();
+        }
+
+        try {
+            evaluator_.fields(schema_.compile(typeid(Root), evaluator_.referenced_fields()));
+        } catch (field_not_found const&) {
+            (void) evaluator_.expression("");
+            throw;
+        }
+
+        return true;
+    }
+
+    /**
+     * Checks whether the evaluation is activated or not, i.e.
+     * if the expression is successfully set.
+     *
+     * @return True if the evaluation is activated, otherwise false
+     */
+    [[nodiscard]] bool is_activated() const noexcept {
+        return evaluator_.is_activated();
+    }
+
+    /**
+     * Gets the object schema the paths are resolved against.
+     *
+     * @return Object schema
+     */
+    [[nodiscard]] utils::object_schema const& schema() const noexcept {
+        return schema_;
+    }
+
+    /**
+     * Evaluates the expression for the object passed in.
+     *
+     * @param obj Object to be evaluated
+     *
+     * @return True if the object's members satisfy the expression, otherwise false
+     */
+    [[nodiscard]] bool evaluate(Root const& obj) const {
+        utils::path_record const record{ &obj };
+        return evaluator_.evaluate(record);
+    }
+
+private:
+    utils::object_schema schema_;
+    std::unique_ptr<std::string> expression_;
+    evaluator<utils::path_field> evaluator_;
+};
+
+} // booleval
+
+#endif // BOOLEVAL_PATH_EVALUATOR_H
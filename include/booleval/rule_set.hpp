@@ -0,0 +1,650 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_RULE_SET_H
+#define BOOLEVAL_RULE_SET_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
+#include <string_view>
+#include <booleval/exceptions.hpp>
+#include <booleval/utils/any_mem_fn.hpp>
+#include <booleval/utils/bit_utils.hpp>
+#include <booleval/utils/aho_corasick.hpp>
+#include <booleval/utils/perfect_hash.hpp>
+#include <booleval/tree/result_visitor.hpp>
+#include <booleval/tree/expression_tree.hpp>
+#include <booleval/tree/conjunctive_core.hpp>
+
+namespace booleval {
+
+/**
+ * class rule_set
+ *
+ * Represents a class for evaluating many logical expressions (rules) against
+ * the same object, e.g. a routing table. The EQ and CONTAINS predicates of all
+ * the rules are indexed per field: the constants compared for equality are put
+ * into a perfect hash table and the substrings into an Aho-Corasick automaton.
+ * Each indexed field is therefore read and scanned once per object, which gives
+ * all of its satisfied predicates, and only the rules that can be satisfied by
+ * them, or the rules that do not depend on them at all, are evaluated.
+ *
+ * When only the first satisfied rule is needed, e.g. for mutually exclusive
+ * routing rules, the rules are also compiled into a decision tree. Its nodes
+ * branch on the value of the field which the EQ predicates required by the rules
+ * split best, and its leaves hold the few rules that can still be satisfied.
+ *
+ * The rule set keeps copies of the expressions, the trees of which refer to them,
+ * so it can be moved, but not copied.
+ */
+template <typename MemFn = utils::any_mem_fn>
+class rule_set {
+    using field_map = std::map<std::string_view, MemFn>;
+
+public:
+    rule_set() = default;
+    rule_set(rule_set&& rhs) = default;
+    rule_set(rule_set const& rhs) = delete;
+
+    rule_set(field_map const& fields) {
+        this->fields(fields);
+    }
+
+    rule_set& operator=(rule_set&& rhs) = default;
+    rule_set& operator=(rule_set const& rhs) = delete;
+
+    ~rule_set() = default;
+
+    /**
+     * Sets the key - member function map used for evaluation of the rules.
+     *
+     * @param fields Key - member function map
+     */
+    void fields(field_map const& fields) {
+        fields_ = fields;
+        result_visitor_.fields(fields);
+    }
+
+    /**
+     * Sets the rules and builds the index of their predicates. The rules are
+     * identified by their positions. An empty expression is a rule that is
+     * never satisfied.
+     *
+     * @param expressions Expressions of the rules
+     *
+     * @return True if all the expressions are valid, otherwise false and the set is empty
+     */
+    [[nodiscard]] bool rules(std::vector<std::string_view> const& expressions);
+
+    /**
+     * Gets the number of rules.
+     *
+     * @return Number of rules
+     */
+    [[nodiscard]] std::size_t size() const noexcept {
+        return trees_.size();
+    }
+
+    /**
+     * Gets the number of distinct indexed predicates, i.e. the EQ and CONTAINS
+     * predicates with different fields or constants.
+     *
+     * @return Number of indexed predicates
+     */
+    [[nodiscard]] std::size_t indexed_predicates() const noexcept {
+        return predicate_count_;
+    }
+
+    /**
+     * Evaluates the rules for the object passed in.
+     *
+     * @param obj Object to be evaluated
+     *
+     * @return Identifiers of the satisfied rules, in ascending order
+     */
+    template <typename T>
+    [[nodiscard]] std::vector<std::size_t> evaluate(T const& obj) const {
+        std::vector<std::size_t> matches;
+        evaluate(obj, matches);
+        return matches;
+    }
+
+    /**
+     * Evaluates the rules for the object passed in.
+     *
+     * @param obj     Object to be evaluated
+     * @param matches Identifiers of the satisfied rules, in ascending order
+     */
+    template <typename T>
+    void evaluate(T const& obj, std::vector<std::size_t>& matches) const;
+
+    /**
+     * Finds the first rule satisfied by the object passed in. The decision tree
+     * selects the rules the object can satisfy, which are evaluated in order.
+     *
+     * @param obj Object to be evaluated
+     *
+     * @return Identifier of the first satisfied rule if there is one, otherwise empty value
+     */
+    template <typename T>
+    [[nodiscard]] std::optional<std::size_t> first_match(T const& obj) const;
+
+    /**
+     * Gets the number of nodes of the decision tree used to find the first satisfied rule.
+     *
+     * @return Number of nodes of the decision tree
+     */
+    [[nodiscard]] std::size_t decision_nodes() const noexcept {
+        return decision_nodes_.size();
+    }
+
+private:
+    /**
+     * struct operation
+     *
+     * Represents an operation of the rule programs, which evaluate the rule
+     * trees in the postfix order with the indexed predicates already resolved.
+     */
+    struct operation {
+        enum class kind : uint8_t {
+            predicate,
+            node,
+            logical_and,
+            logical_or,
+            never
+        };
+
+        kind type{ kind::never };
+        uint32_t predicate{ 0 };
+        tree::tree_node const* node{ nullptr };
+    };
+
+    /**
+     * struct field_index
+     *
+     * Represents the indexed predicates of a single field. The predicates
+     * have consecutive identifiers, the EQ ones followed by the CONTAINS ones.
+     */
+    struct field_index {
+        std::string_view field;
+        std::vector<std::string_view> equal_constants;
+        std::vector<std::string_view> contains_constants;
+        std::map<std::string_view, uint32_t> equal_ids;
+        std::map<std::string_view, uint32_t> contains_ids;
+        utils::perfect_hash equal;
+        utils::aho_corasick contains;
+        uint32_t first_predicate{ 0 };
+    };
+
+    /**
+     * struct decision_node
+     *
+     * Represents a node of the decision tree. Inner nodes lead to the child of
+     * the constant equal to the field value, or to the fallback child if there
+     * is none. Leaves hold the range of the rules that can be satisfied.
+     */
+    struct decision_node {
+        std::string_view field;
+        utils::perfect_hash constants;
+        std::vector<uint32_t> children;
+        uint32_t fallback{ 0 };
+        uint32_t first_rule{ 0 };
+        uint32_t last_rule{ 0 };
+    };
+
+    using guard = std::optional<std::vector<uint32_t>>;
+    using requirements = std::map<std::string_view, std::string_view>;
+
+    [[nodiscard]] static bool is_indexed(tree::tree_node const& node) noexcept {
+        return nullptr != node.left && nullptr != node.right &&
+               node.token.is_one_of(token::token_type::eq, token::token_type::contains);
+    }
+
+    void collect_predicates(tree::tree_node const& node);
+    [[nodiscard]] uint32_t predicate(tree::tree_node const& node) const;
+    [[nodiscard]] guard compile(tree::tree_node const& node, std::size_t depth);
+
+    [[nodiscard]] static requirements required_equalities(tree::tree_node const& node);
+    uint32_t build_decision_tree(std::vector<uint32_t> const& rules, std::vector<requirements> const& required);
+
+    template <typename T>
+    [[nodiscard]] bool run(std::size_t rule, T const& obj, std::vector<uint64_t> const& satisfied, std::vector<uint8_t>& stack) const;
+
+    static void set_bit(std::vector<uint64_t>& bits, std::size_t const index) noexcept {
+        bits[index / 64] |= uint64_t{ 1 } << (index % 64);
+    }
+
+    [[nodiscard]] static bool test_bit(std::vector<uint64_t> const& bits, std::size_t const index) noexcept {
+        return 0 != (bits[index / 64] & (uint64_t{ 1 } << (index % 64)));
+    }
+
+private:
+    std::vector<std::string> expressions_;
+    std::vector<tree::expression_tree> trees_;
+    std::vector<field_index> indexes_;
+    std::vector<operation> operations_;
+    std::vector<std::size_t> programs_;
+    std::vector<uint32_t> first_guarded_;
+    std::vector<uint32_t> guarded_;
+    std::vector<uint64_t> unguarded_;
+    std::vector<decision_node> decision_nodes_;
+    std::vector<uint32_t> decision_rules_;
+    std::size_t predicate_count_{ 0 };
+    std::size_t max_depth_{ 0 };
+    field_map fields_;
+    tree::result_visitor<MemFn> result_visitor_;
+};
+
+template <typename MemFn>
+bool rule_set<MemFn>::rules(std::vector<std::string_view> const& expressions) {
+    expressions_.assign(std::begin(expressions), std::end(expressions));
+    trees_.assign(expressions.size(), tree::expression_tree{});
+    indexes_.clear();
+    operations_.clear();
+    programs_.clear();
+    first_guarded_.clear();
+    guarded_.clear();
+    unguarded_.clear();
+    decision_nodes_.clear();
+    decision_rules_.clear();
+    predicate_count_ = 0;
+    max_depth_ = 0;
+
+    for (std::size_t i = 0; i < expressions_.size(); ++i) {
+        if (!expressions_[i].empty() && !trees_[i].build(expressions_[i])) {
+            expressions_.clear();
+            trees_.clear();
+            return false;
+        }
+    }
+
+    for (auto const& tree : trees_) {
+        if (nullptr != tree.root()) {
+            collect_predicates(*tree.root());
+        }
+    }
+
+    for (auto& index : indexes_) {
+        index.first_predicate = static_cast<uint32_t>(predicate_count_);
+        index.equal = utils::perfect_hash{ index.equal_constants };
+        index.contains = utils::aho_corasick{ index.contains_constants };
+        predicate_count_ += index.equal_constants.size() + index.contains_constants.size();
+    }
+
+    // A rule is guarded by the predicates one of which has to be satisfied by
+    // the objects satisfying the rule. Unguarded rules are evaluated for every object.
+    std::vector<std::vector<uint32_t>> guarded(predicate_count_);
+    unguarded_.assign((trees_.size() + 63) / 64, 0);
+    for (std::size_t i = 0; i < trees_.size(); ++i) {
+        programs_.push_back(operations_.size());
+
+        guard rule_guard{ std::vector<uint32_t>{} };
+        if (nullptr != trees_[i].root()) {
+            rule_guard = compile(*trees_[i].root(), 1);
+        }
+
+        if (!rule_guard) {
+            set_bit(unguarded_, i);
+            continue;
+        }
+
+        for (auto const id : *rule_guard) {
+            guarded[id].push_back(static_cast<uint32_t>(i));
+        }
+    }
+    programs_.push_back(operations_.size());
+
+    for (auto& index : indexes_) {
+        index.equal_ids.clear();
+        index.contains_ids.clear();
+    }
+
+    for (auto const& rules : guarded) {
+        first_guarded_.push_back(static_cast<uint32_t>(guarded_.size()));
+        guarded_.insert(std::end(guarded_), std::begin(rules), std::end(rules));
+    }
+    first_guarded_.push_back(static_cast<uint32_t>(guarded_.size()));
+
+    std::vector<requirements> required(trees_.size());
+    std::vector<uint32_t> satisfiable;
+    for (std::size_t i = 0; i < trees_.size(); ++i) {
+        if (nullptr != trees_[i].root()) {
+            required[i] = required_equalities(*trees_[i].root());
+            satisfiable.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    [[maybe_unused]] auto const root = build_decision_tree(satisfiable, required);
+
+    return true;
+}
+
+template <typename MemFn>
+typename rule_set<MemFn>::requirements rule_set<MemFn>::required_equalities(tree::tree_node const& node) {
+    // Conflicting equalities make the rule unsatisfiable, so the field is left out
+    requirements required;
+    for (auto const& [field, literals] : tree::conjunctive_core(&node)) {
+        if (1 == literals.size()) {
+            required.emplace(field, literals.front());
+        }
+    }
+    return required;
+}
+
+template <typename MemFn>
+uint32_t rule_set<MemFn>::build_decision_tree(std::vector<uint32_t> const& rules, std::vector<requirements> const& required) {
+    // The field is chosen so that the largest set of rules left after branching
+    // is the smallest. The rules not requiring the field are kept in all the
+    // branches, so the split is refused if it copies them too many times.
+    std::optional<std::string_view> best_field;
+    std::size_t best_size{ rules.size() };
+    std::map<std::string_view, std::size_t> fields;
+    for (auto const rule : rules) {
+        for (auto const& [field, constant] : required[rule]) {
+            ++fields[field];
+        }
+    }
+
+    for (auto const& [field, count] : fields) {
+        std::map<std::string_view, std::size_t> groups;
+        for (auto const rule : rules) {
+            if (auto const iter = required[rule].find(field); required[rule].end() != iter) {
+                ++groups[iter->second];
+            }
+        }
+
+        auto const others = rules.size() - count;
+        std::size_t largest{ 0 };
+        for (auto const& [constant, size] : groups) {
+            largest = std::max(largest, size);
+        }
+
+        if (largest + others < best_size && count + groups.size() * others <= 4 * rules.size()) {
+            best_field = field;
+            best_size = largest + others;
+        }
+    }
+
+    auto const index = static_cast<uint32_t>(decision_nodes_.size());
+    decision_nodes_.emplace_back();
+
+    if (!best_field) {
+        decision_nodes_[index].first_rule = static_cast<uint32_t>(decision_rules_.size());
+        decision_rules_.insert(std::end(decision_rules_), std::begin(rules), std::end(rules));
+        decision_nodes_[index].last_rule = static_cast<uint32_t>(decision_rules_.size());
+        return index;
+    }
+
+    std::vector<std::string_view> constants;
+    std::map<std::string_view, std::vector<uint32_t>> branches;
+    std::vector<uint32_t> fallback;
+    for (auto const rule : rules) {
+        auto const iter = required[rule].find(*best_field);
+        if (required[rule].end() == iter) {
+            fallback.push_back(rule);
+            for (auto& [constant, branch] : branches) {
+                branch.push_back(rule);
+            }
+            continue;
+        }
+
+        auto [branch, inserted] = branches.emplace(iter->second, std::vector<uint32_t>{});
+        if (inserted) {
+            constants.push_back(iter->second);
+            branch->second = fallback;
+        }
+        branch->second.push_back(rule);
+    }
+
+    // Rules are kept in ascending order in every branch, as the first satisfied one is looked for
+    std::vector<uint32_t> children;
+    for (auto const constant : constants) {
+        children.push_back(build_decision_tree(branches[constant], required));
+    }
+    auto const fallback_child = build_decision_tree(fallback, required);
+
+    auto& n = decision_nodes_[index];
+    n.field = *best_field;
+    n.constants = utils::perfect_hash{ constants };
+    n.children = std::move(children);
+    n.fallback = fallback_child;
+    return index;
+}
+
+template <typename MemFn>
+void rule_set<MemFn>::collect_predicates(tree::tree_node const& node) {
+    if (nullptr == node.left || nullptr == node.right) {
+        return;
+    }
+
+    if (node.token.is_one_of(token::token_type::logical_and, token::token_type::logical_or)) {
+        collect_predicates(*node.left);
+        collect_predicates(*node.right);
+        return;
+    }
+
+    if (!is_indexed(node)) {
+        return;
+    }
+
+    auto const field = node.left->token.value();
+    auto index = std::find_if(std::begin(indexes_), std::end(indexes_), [field](auto const& i) {
+        return i.field == field;
+    });
+    if (std::end(indexes_) == index) {
+        index = indexes_.insert(std::end(indexes_), field_index{});
+        index->field = field;
+    }
+
+    auto const is_equal = node.token.is(token::token_type::eq);
+    auto& constants = is_equal ? index->equal_constants : index->contains_constants;
+    auto& ids = is_equal ? index->equal_ids : index->contains_ids;
+    if (ids.emplace(node.right->token.value(), static_cast<uint32_t>(constants.size())).second) {
+        constants.push_back(node.right->token.value());
+    }
+}
+
+template <typename MemFn>
+uint32_t rule_set<MemFn>::predicate(tree::tree_node const& node) const {
+    auto const field = node.left->token.value();
+    auto const& index = *std::find_if(std::begin(indexes_), std::end(indexes_), [field](auto const& i) {
+        return i.field == field;
+    });
+
+    if (node.token.is(token::token_type::eq)) {
+        return index.first_predicate + index.equal_ids.at(node.right->token.value());
+    }
+
+    return index.first_predicate + static_cast<uint32_t>(index.equal_constants.size()) +
+           index.contains_ids.at(node.right->token.value());
+}
+
+template <typename MemFn>
+typename rule_set<MemFn>::guard rule_set<MemFn>::compile(tree::tree_node const& node, std::size_t const depth) {
+    max_depth_ = std::max(max_depth_, depth);
+
+    if (nullptr == node.left || nullptr == node.right) {
+        operations_.push_back({ operation::kind::never, 0, nullptr });
+        return std::vector<uint32_t>{};
+    }
+
+    if (is_indexed(node)) {
+        auto const id = predicate(node);
+        operations_.push_back({ operation::kind::predicate, id, nullptr });
+        return std::vector<uint32_t>{ id };
+    }
+
+    if (!node.token.is_one_of(token::token_type::logical_and, token::token_type::logical_or)) {
+        operations_.push_back({ operation::kind::node, 0, &node });
+        return std::nullopt;
+    }
+
+    auto left  = compile(*node.left, depth);
+    auto right = compile(*node.right, depth + 1);
+
+    if (node.token.is(token::token_type::logical_and)) {
+        operations_.push_back({ operation::kind::logical_and, 0, nullptr });
+        if (left && (!right || left->size() <= right->size())) {
+            return left;
+        }
+        return right;
+    }
+
+    operations_.push_back({ operation::kind::logical_or, 0, nullptr });
+    if (!left || !right) {
+        return std::nullopt;
+    }
+
+    left->insert(std::end(*left), std::begin(*right), std::end(*right));
+    return left;
+}
+
+template <typename MemFn>
+template <typename T>
+void rule_set<MemFn>::evaluate(T const& obj, std::vector<std::size_t>& matches) const {
+    matches.clear();
+    if (trees_.empty()) {
+        return;
+    }
+
+    std::vector<uint64_t> satisfied((predicate_count_ + 63) / 64, 0);
+    for (auto const& index : indexes_) {
+        auto const iter = fields_.find(index.field);
+        if (iter == fields_.end()) {
+            throw field_not_found(index.field);
+        }
+
+        auto const field_value = iter->second.invoke(obj);
+        if (field_value.is_null()) {
+            continue;
+        }
+
+        auto const& value = field_value.str();
+        auto const equal = index.equal.find(value);
+        if (utils::perfect_hash::npos != equal) {
+            set_bit(satisfied, index.first_predicate + equal);
+        }
+
+        auto const first_contains = index.first_predicate + index.equal_constants.size();
+        index.contains.find(value, [&satisfied, first_contains](auto const pattern) {
+            set_bit(satisfied, first_contains + pattern);
+        });
+    }
+
+    auto candidates = unguarded_;
+    for (std::size_t word = 0; word < satisfied.size(); ++word) {
+        for (auto bits = satisfied[word]; 0 != bits; bits &= bits - 1) {
+            auto const id = word * 64 + utils::count_trailing_zeros(bits);
+            for (auto i = first_guarded_[id]; i != first_guarded_[id + 1]; ++i) {
+                set_bit(candidates, guarded_[i]);
+            }
+        }
+    }
+
+    std::vector<uint8_t> stack;
+    stack.reserve(max_depth_ + 1);
+    for (std::size_t word = 0; word < candidates.size(); ++word) {
+        for (auto bits = candidates[word]; 0 != bits; bits &= bits - 1) {
+            auto const rule = word * 64 + utils::count_trailing_zeros(bits);
+            if (run(rule, obj, satisfied, stack)) {
+                matches.push_back(rule);
+            }
+        }
+    }
+}
+
+template <typename MemFn>
+template <typename T>
+std::optional<std::size_t> rule_set<MemFn>::first_match(T const& obj) const {
+    if (decision_nodes_.empty()) {
+        return std::nullopt;
+    }
+
+    uint32_t index{ 0 };
+    while (!decision_nodes_[index].children.empty()) {
+        auto const& n = decision_nodes_[index];
+        auto const iter = fields_.find(n.field);
+        if (iter == fields_.end()) {
+            throw field_not_found(n.field);
+        }
+
+        auto const field_value = iter->second.invoke(obj);
+        auto const constant = field_value.is_null() ? utils::perfect_hash::npos : n.constants.find(field_value.str());
+        index = utils::perfect_hash::npos == constant ? n.fallback : n.children[constant];
+    }
+
+    auto const& leaf = decision_nodes_[index];
+    for (auto i = leaf.first_rule; i != leaf.last_rule; ++i) {
+        auto const rule = decision_rules_[i];
+        if (result_visitor_.visit(*trees_[rule].root(), obj)) {
+            return rule;
+        }
+    }
+
+    return std::nullopt;
+}
+
+template <typename MemFn>
+template <typename T>
+bool rule_set<MemFn>::run(std::size_t const rule, T const& obj, std::vector<uint64_t> const& satisfied, std::vector<uint8_t>& stack) const {
+    stack.clear();
+    for (auto i = programs_[rule]; i != programs_[rule + 1]; ++i) {
+        auto const& op = operations_[i];
+        switch (op.type) {
+        case operation::kind::predicate:
+            stack.push_back(test_bit(satisfied, op.predicate));
+            break;
+
+        case operation::kind::node:
+            stack.push_back(result_visitor_.visit(*op.node, obj));
+            break;
+
+        case operation::kind::logical_and:
+        case operation::kind::logical_or: {
+            auto const right = stack.back();
+            stack.pop_back();
+            stack.back() = operation::kind::logical_and == op.type ? (stack.back() && right) : (stack.back() || right);
+            break;
+        }
+
+        default:
+            stack.push_back(false);
+            break;
+        }
+    }
+
+    return !stack.empty() && stack.back();
+}
+
+} // booleval
+
+#endif // BOOLEVAL_RULE_SET_H
@@ -44,7 +44,8 @@ namespace token {
  * enum class token_type
  *
  * Represents a token type. Supported types are logical operators,
- * relational operators, parentheses and field.
+ * relational operators, parentheses, field, null tests and string
+ * matching operators.
  */
 enum class [[nodiscard]] token_type : uint8_t {
     unknown = 0,
@@ -64,10 +65,21 @@ enum class [[nodiscard]] token_type : uint8_t {
 
     // Parentheses
     lp = 10,
-    rp = 11
+    rp = 11,
+
+    // Null tests ("is null" and "is not null" following a field)
+    is_null     = 12,
+    is_not_null = 13,
+
+    // String matching operators
+    starts_with = 14,
+    ends_with   = 15,
+    contains    = 16,
+    like        = 17,
+    matches     = 18
 };
 
-constexpr std::size_t count_of_keyword_expressions{ 16 };
+constexpr std::size_t count_of_keyword_expressions{ 26 };
 constexpr std::array<
     std::pair<std::string_view, token_type>,
     count_of_keyword_expressions
@@ -87,7 +99,17 @@ constexpr std::array<
     { "geq", token_type::geq },
     { "GEQ", token_type::geq },
     { "leq", token_type::leq },
-    { "LEQ", token_type::leq }
+    { "LEQ", token_type::leq },
+    { "starts_with", token_type::starts_with },
+    { "STARTS_WITH", token_type::starts_with },
+    { "ends_with",   token_type::ends_with   },
+    { "ENDS_WITH",   token_type::ends_with   },
+    { "contains",    token_type::contains    },
+    { "CONTAINS",    token_type::contains    },
+    { "like",        token_type::like        },
+    { "LIKE",        token_type::like        },
+    { "matches",     token_type::matches     },
+    { "MATCHES",     token_type::matches     }
 }};
 
 constexpr std::size_t count_of_symbol_expressions{ 10 };
@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_CLOSURE_TREE_H
+#define BOOLEVAL_CLOSURE_TREE_H
+
+#include <map>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <booleval/exceptions.hpp>
+#include <booleval/tree/tree_node.hpp>
+#include <booleval/utils/any_mem_fn.hpp>
+#include <booleval/utils/string_utils.hpp>
+
+namespace booleval {
+
+namespace tree {
+
+/**
+ * class closure_tree
+ *
+ * Represents an expression tree compiled for objects of a known type into a tree
+ * of functions, each specialized for the operation of its node and the type of
+ * its literal. The functions are selected and the fields are resolved when the
+ * tree is compiled, so evaluation is a chain of direct calls with no dispatch on
+ * the token types and numeric literals are not parsed again. AND and OR operations
+ * evaluate their right operand only if it can change the result, so a missing
+ * field is not reported unless its operation is evaluated.
+ *
+ * The closure tree shares the nodes of the expression tree, while the literals
+ * refer to the expression, which has to outlive it.
+ */
+template <typename T, typename MemFn = utils::any_mem_fn>
+class closure_tree {
+    using field_map = std::map<std::string_view, MemFn>;
+
+public:
+    closure_tree() = default;
+    closure_tree(closure_tree&& rhs) = default;
+    closure_tree(closure_tree const& rhs) = default;
+
+    /**
+     * Compiles the expression tree.
+     *
+     * @param root   Root of the expression tree
+     * @param fields Key - member function map used for evaluation
+     */
+    closure_tree(std::shared_ptr<tree_node> const& root, field_map const& fields);
+
+    closure_tree& operator=(closure_tree&& rhs) = default;
+    closure_tree& operator=(closure_tree const& rhs) = default;
+
+    ~closure_tree() = default;
+
+    /**
+     * Checks whether the expression is compiled.
+     *
+     * @return True if the expression is compiled, otherwise false
+     */
+    [[nodiscard]] bool is_compiled() const noexcept {
+        return !nodes_.empty();
+    }
+
+    /**
+     * Evaluates the compiled expression for the object passed in.
+     *
+     * @param obj Object to be evaluated
+     *
+     * @return True if the object's members satisfy the expression, otherwise false
+     */
+    [[nodiscard]] bool evaluate(T const& obj) const {
+        return !nodes_.empty() && call(0, obj);
+    }
+
+private:
+    struct node;
+    using function = bool (*)(closure_tree const&, node const&, T const&);
+
+    /**
+     * struct node
+     *
+     * Represents a compiled node: the function evaluating it and its operands.
+     */
+    struct node {
+        function evaluate{ &never };
+        uint32_t left{ 0 };
+        uint32_t right{ 0 };
+        MemFn accessor;
+        std::string_view field;
+        std::string_view literal;
+        double number{ 0 };
+        utils::string_matcher const* matcher{ nullptr };
+    };
+
+    [[nodiscard]] bool call(uint32_t const index, T const& obj) const {
+        auto const& n = nodes_[index];
+        return n.evaluate(*this, n, obj);
+    }
+
+    [[nodiscard]] uint32_t compile(tree_node const& source, field_map const& fields);
+
+    template <typename Op>
+    [[nodiscard]] static function select_comparison(bool is_number) noexcept;
+
+    [[nodiscard]] static bool never(closure_tree const&, node const&, T const&) noexcept {
+        return false;
+    }
+
+    [[nodiscard]] static bool missing_field(closure_tree const&, node const& n, T const&) {
+        throw field_not_found(n.field);
+    }
+
+    [[nodiscard]] static bool logical_and(closure_tree const& c, node const& n, T const& obj) {
+        return c.call(n.left, obj) && c.call(n.right, obj);
+    }
+
+    [[nodiscard]] static bool logical_or(closure_tree const& c, node const& n, T const& obj) {
+        return c.call(n.left, obj) || c.call(n.right, obj);
+    }
+
+    template <typename Op>
+    [[nodiscard]] static bool compare_string(closure_tree const&, node const& n, T const& obj) {
+        auto const value = n.accessor.invoke(obj);
+        return !value.is_null() && Op{}(value.str(), n.literal);
+    }
+
+    template <typename Op>
+    [[nodiscard]] static bool compare_number(closure_tree const&, node const& n, T const& obj) {
+        auto const value = n.accessor.invoke(obj);
+        if (value.is_null()) {
+            return false;
+        }
+
+        if (value.is_string()) {
+            return Op{}(value.str(), n.literal);
+        }
+
+        auto const number = utils::from_chars<double>(value.str());
+        return number && Op{}(*number, n.number);
+    }
+
+    template <typename Op>
+    [[nodiscard]] static bool compare_not_number(closure_tree const&, node const& n, T const& obj) {
+        auto const value = n.accessor.invoke(obj);
+        return !value.is_null() && value.is_string() && Op{}(value.str(), n.literal);
+    }
+
+    template <bool IsNull>
+    [[nodiscard]] static bool null_test(closure_tree const&, node const& n, T const& obj) {
+        return IsNull == n.accessor.invoke(obj).is_null();
+    }
+
+    [[nodiscard]] static bool match(closure_tree const&, node const& n, T const& obj) {
+        auto const value = n.accessor.invoke(obj);
+        return !value.is_null() && n.matcher->matches(value.str());
+    }
+
+private:
+    std::shared_ptr<tree_node const> root_;
+    std::vector<node> nodes_;
+};
+
+template <typename T, typename MemFn>
+closure_tree<T, MemFn>::closure_tree(std::shared_ptr<tree_node> const& root, field_map const& fields)
+    : root_(root)
+{
+    if (nullptr != root) {
+        [[maybe_unused]] auto const index = compile(*root, fields);
+    }
+}
+
+template <typename T, typename MemFn>
+template <typename Op>
+typename closure_tree<T, MemFn>::function closure_tree<T, MemFn>::select_comparison(bool const is_number) noexcept {
+    return is_number ? &compare_number<Op> : &compare_not_number<Op>;
+}
+
+template <typename T, typename MemFn>
+uint32_t closure_tree<T, MemFn>::compile(tree_node const& source, field_map const& fields) {
+    auto const index = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+
+    if (nullptr == source.left || nullptr == source.right) {
+        return index;
+    }
+
+    auto const type = source.token.type();
+    if (token::token_type::logical_and == type || token::token_type::logical_or == type) {
+        auto const left = compile(*source.left, fields);
+        auto const right = compile(*source.right, fields);
+
+        auto& n = nodes_[index];
+        n.evaluate = token::token_type::logical_and == type ? &logical_and : &logical_or;
+        n.left = left;
+        n.right = right;
+        return index;
+    }
+
+    auto& n = nodes_[index];
+    n.field = source.left->token.value();
+    n.literal = source.right->token.value();
+
+    auto const iter = fields.find(n.field);
+    if (fields.end() == iter) {
+        n.evaluate = &missing_field;
+        return index;
+    }
+    n.accessor = iter->second;
+
+    auto const number = utils::from_chars<double>(n.literal);
+    n.number = number.value_or(0);
+
+    switch (type) {
+    case token::token_type::eq:
+        n.evaluate = &compare_string<std::equal_to<>>;
+        break;
+
+    case token::token_type::neq:
+        n.evaluate = &compare_string<std::not_equal_to<>>;
+        break;
+
+    case token::token_type::gt:
+        n.evaluate = select_comparison<std::greater<>>(number.has_value());
+        break;
+
+    case token::token_type::lt:
+        n.evaluate = select_comparison<std::less<>>(number.has_value());
+        break;
+
+    case token::token_type::geq:
+        n.evaluate = select_comparison<std::greater_equal<>>(number.has_value());
+        break;
+
+    case token::token_type::leq:
+        n.evaluate = select_comparison<std::less_equal<>>(number.has_value());
+        break;
+
+    case token::token_type::is_null:
+        n.evaluate = &null_test<true>;
+        break;
+
+    case token::token_type::is_not_null:
+        n.evaluate = &null_test<false>;
+        break;
+
+    case token::token_type::starts_with:
+    case token::token_type::ends_with:
+    case token::token_type::contains:
+    case token::token_type::like:
+    case token::token_type::matches:
+        n.matcher = source.matcher.get();
+        n.evaluate = nullptr == n.matcher ? &never : &match;
+        break;
+
+    default:
+        break;
+    }
+
+    return index;
+}
+
+} // tree
+
+} // booleval
+
+#endif // BOOLEVAL_CLOSURE_TREE_H
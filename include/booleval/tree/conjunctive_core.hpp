@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_CONJUNCTIVE_CORE_H
+#define BOOLEVAL_CONJUNCTIVE_CORE_H
+
+#include <map>
+#include <vector>
+#include <string_view>
+#include <booleval/tree/tree_node.hpp>
+
+namespace booleval {
+
+namespace tree {
+
+/**
+ * Equality conditions necessary for an expression to be satisfied: each field
+ * is mapped to the sorted literals one of which the field has to be equal to,
+ * e.g. `(a 1 or a 2) and b 3` requires a to be 1 or 2 and b to be 3. A field
+ * mapped to no literals cannot satisfy the expression at all, e.g. `a 1 and a 2`.
+ */
+using equality_conditions = std::map<std::string_view, std::vector<std::string_view>>;
+
+/**
+ * Extracts the equality conditions every object satisfying the expression
+ * satisfies as well, i.e. the conjunctive core of the expression. Storage
+ * layers can look the literals up in hash indexes or Bloom filters of the
+ * fields and skip the objects not having any of them before evaluating
+ * the expression. The literals are referred to, so the expression the tree
+ * is built from must outlive the conditions.
+ *
+ * @param root Root of the expression tree or nullptr if the tree is not built
+ *
+ * @return Necessary equality conditions
+ */
+[[nodiscard]] equality_conditions conjunctive_core(tree_node const* root);
+
+} // tree
+
+} // booleval
+
+#endif // BOOLEVAL_CONJUNCTIVE_CORE_H
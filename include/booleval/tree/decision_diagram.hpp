@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_DECISION_DIAGRAM_H
+#define BOOLEVAL_DECISION_DIAGRAM_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <booleval/tree/tree_node.hpp>
+
+namespace booleval {
+
+namespace tree {
+
+/**
+ * class decision_diagram
+ *
+ * Represents the logical structure of an expression tree compiled into a reduced
+ * ordered binary decision diagram over its predicates, i.e. its relational operations,
+ * null tests and string matching operations. The equal predicates are represented
+ * by a single variable and the variables are ordered by their first appearance in
+ * the expression. Evaluation follows a single path from the root to a terminal,
+ * so each predicate is evaluated at most once and only when its result matters.
+ *
+ * The diagram refers to the nodes of the tree, which has to outlive it. As the
+ * predicates are skipped when they cannot change the result, a missing field
+ * is not reported unless its predicate is evaluated.
+ */
+class decision_diagram {
+public:
+    /**
+     * Default maximum number of nodes created while compiling the diagram.
+     */
+    static constexpr std::size_t default_max_nodes{ 4096 };
+
+    decision_diagram() = default;
+    decision_diagram(decision_diagram&& rhs) = default;
+    decision_diagram(decision_diagram const& rhs) = default;
+
+    decision_diagram& operator=(decision_diagram&& rhs) = default;
+    decision_diagram& operator=(decision_diagram const& rhs) = default;
+
+    ~decision_diagram() = default;
+
+    /**
+     * Compiles the expression tree. The size of the diagram can grow exponentially
+     * with the number of predicates, so the compilation is abandoned once it
+     * creates more than the maximum number of nodes.
+     *
+     * @param root      Root of the expression tree
+     * @param max_nodes Maximum number of nodes created while compiling
+     *
+     * @return True if the diagram is compiled, otherwise false and the diagram is empty
+     */
+    [[nodiscard]] bool build(tree_node const* root, std::size_t max_nodes = default_max_nodes);
+
+    /**
+     * Discards the compiled diagram.
+     */
+    void clear() noexcept;
+
+    /**
+     * Checks whether the diagram is compiled.
+     *
+     * @return True if the diagram is compiled, otherwise false
+     */
+    [[nodiscard]] bool is_built() const noexcept {
+        return !nodes_.empty();
+    }
+
+    /**
+     * Gets the number of decision nodes, i.e. the nodes other than the terminals.
+     *
+     * @return Number of decision nodes
+     */
+    [[nodiscard]] std::size_t size() const noexcept {
+        return nodes_.empty() ? 0 : nodes_.size() - terminals;
+    }
+
+    /**
+     * Gets the number of distinct predicates of the expression.
+     *
+     * @return Number of variables
+     */
+    [[nodiscard]] std::size_t variables() const noexcept {
+        return variables_.size();
+    }
+
+    /**
+     * Evaluates the diagram.
+     *
+     * @param test Function evaluating the predicate of the tree node passed in
+     *
+     * @return Result of the expression
+     */
+    template <typename F>
+    [[nodiscard]] bool evaluate(F&& test) const {
+        auto index = root_;
+        while (index >= terminals) {
+            auto const& n = nodes_[index];
+            index = test(*variables_[n.variable]) ? n.high : n.low;
+        }
+
+        return true_terminal == index;
+    }
+
+private:
+    static constexpr uint32_t false_terminal{ 0 };
+    static constexpr uint32_t true_terminal{ 1 };
+    static constexpr uint32_t terminals{ 2 };
+
+    /**
+     * struct node
+     *
+     * Represents a decision node testing the variable and continuing to the high
+     * node if the predicate is satisfied, otherwise to the low node.
+     */
+    struct node {
+        uint32_t variable{ 0 };
+        uint32_t low{ false_terminal };
+        uint32_t high{ false_terminal };
+    };
+
+    std::vector<tree_node const*> variables_;
+    std::vector<node> nodes_;
+    uint32_t root_{ false_terminal };
+};
+
+} // tree
+
+} // booleval
+
+#endif // BOOLEVAL_DECISION_DIAGRAM_H
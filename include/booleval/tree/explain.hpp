@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_EXPLAIN_H
+#define BOOLEVAL_EXPLAIN_H
+
+#include <utility>
+#include <optional>
+#include <ostream>
+#include <functional>
+#include <string_view>
+#include <booleval/tree/tree_node.hpp>
+
+namespace booleval {
+
+namespace tree {
+
+/**
+ * Function checking whether the field is bound to an accessor.
+ */
+using binding_lookup = std::function<bool(std::string_view)>;
+
+/**
+ * Gets the range of the expression text covered by the token value.
+ * Quoted values are covered together with their quotes.
+ *
+ * @param expression Expression text
+ * @param value      Token value
+ *
+ * @return [begin, end) range or std::nullopt if the token is not a part
+ *         of the text (e.g. equality operator inserted between two fields)
+ */
+[[nodiscard]] std::optional<std::pair<std::size_t, std::size_t>> token_range(std::string_view expression,
+                                                                             std::string_view value) noexcept;
+
+/**
+ * Writes the human-readable description of the expression tree: the parsed
+ * tree with implicit operators marked, the types of the literals, the field
+ * bindings and the estimated cost of evaluating a single record.
+ *
+ * @param root       Root of the expression tree or nullptr if the tree is not built
+ * @param expression Expression the tree is built from
+ * @param is_bound   Function checking the field bindings or empty function if unknown
+ * @param out        Output stream to write the description to
+ */
+void explain(tree_node const* root, std::string_view expression,
+             binding_lookup const& is_bound, std::ostream& out);
+
+} // tree
+
+} // booleval
+
+#endif // BOOLEVAL_EXPLAIN_H
@@ -31,8 +31,12 @@
 #define BOOLEVAL_EXPRESSION_TREE_H
 
 #include <memory>
+#include <vector>
+#include <ostream>
 #include <string_view>
+#include <booleval/tree/explain.hpp>
 #include <booleval/tree/tree_node.hpp>
+#include <booleval/tree/conjunctive_core.hpp>
 #include <booleval/token/tokenizer.hpp>
 
 namespace booleval {
@@ -61,7 +65,14 @@ public:
      *
      * @return Root tree node
      */
-    [[nodiscard]] std::shared_ptr<tree::tree_node> root() noexcept;
+    [[nodiscard]] std::shared_ptr<tree::tree_node> const& root() const noexcept;
+
+    /**
+     * Gets the expression the tree was last built from.
+     *
+     * @return Expression the tree was last built from
+     */
+    [[nodiscard]] std::string_view expression() const noexcept;
 
     /**
      * Builds the expression tree.
@@ -72,6 +83,31 @@ public:
      */
     [[nodiscard]] bool build(std::string_view expression);
 
+    /**
+     * Gets the names of the fields referenced in the expression, in order
+     * of their first appearance and without duplicates.
+     *
+     * @return Referenced field names
+     */
+    [[nodiscard]] std::vector<std::string_view> referenced_fields() const;
+
+    /**
+     * Gets the equality conditions necessary for the expression to be satisfied
+     * (see tree::conjunctive_core).
+     *
+     * @return Necessary equality conditions
+     */
+    [[nodiscard]] equality_conditions conjunctive_core() const;
+
+    /**
+     * Writes the human-readable description of the expression tree
+     * (see tree::explain).
+     *
+     * @param out      Output stream to write the description to
+     * @param is_bound Function checking the field bindings or empty function if unknown
+     */
+    void explain(std::ostream& out, binding_lookup const& is_bound = {}) const;
+
 private:
     /**
      * Parses root expression by trying first to parse logical operation OR.
@@ -108,6 +144,15 @@ private:
      */
     [[nodiscard]] std::shared_ptr<tree::tree_node> parse_terminal();
 
+    /**
+     * Compiles the pattern of the string matching operation, if the node is one.
+     *
+     * @param node Relational operation node having both children
+     *
+     * @return False if the pattern is not valid, otherwise true
+     */
+    [[nodiscard]] static bool compile_matcher(tree::tree_node& node);
+
 private:
     token::tokenizer tokenizer_;
     std::shared_ptr<tree::tree_node> root_;
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_NODE_PROFILER_H
+#define BOOLEVAL_NODE_PROFILER_H
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <unordered_map>
+#include <booleval/tree/tree_node.hpp>
+#include <booleval/token/token_type.hpp>
+
+namespace booleval {
+
+namespace tree {
+
+/**
+ * struct node_profile
+ *
+ * Represents the statistics collected for a single expression tree node.
+ * The node covers the [begin, end) range of the expression text.
+ */
+struct node_profile {
+    token::token_type type{ token::token_type::unknown };
+    std::size_t depth{ 0 };
+    std::size_t begin{ 0 };
+    std::size_t end{ 0 };
+    uint64_t evaluations{ 0 };
+    uint64_t true_count{ 0 };
+    uint64_t accessor_nanoseconds{ 0 };
+    uint64_t accessor_cycles{ 0 };
+};
+
+/**
+ * class profile_report
+ *
+ * Represents the snapshot of the statistics collected for all the nodes
+ * of the expression tree, in the pre-order of the tree.
+ */
+class profile_report {
+public:
+    profile_report() = default;
+    profile_report(profile_report&& rhs) = default;
+    profile_report(profile_report const& rhs) = default;
+
+    profile_report(std::string_view expression, std::vector<node_profile> nodes)
+        : expression_(expression),
+          nodes_(std::move(nodes))
+    {}
+
+    profile_report& operator=(profile_report&& rhs) = default;
+    profile_report& operator=(profile_report const& rhs) = default;
+
+    ~profile_report() = default;
+
+    /**
+     * Gets the profiled expression.
+     *
+     * @return Profiled expression
+     */
+    [[nodiscard]] std::string_view expression() const noexcept {
+        return expression_;
+    }
+
+    /**
+     * Gets the statistics of the nodes in the pre-order of the tree.
+     *
+     * @return Node statistics
+     */
+    [[nodiscard]] std::vector<node_profile> const& nodes() const noexcept {
+        return nodes_;
+    }
+
+    /**
+     * Gets the part of the expression covered by the node.
+     *
+     * @param node Node statistics
+     *
+     * @return Part of the expression
+     */
+    [[nodiscard]] std::string_view text(node_profile const& node) const noexcept {
+        return std::string_view(expression_).substr(node.begin, node.end - node.begin);
+    }
+
+    /**
+     * Writes the statistics to the output stream, one node per line,
+     * with the part of the expression covered by the node underlined.
+     *
+     * @param out Output stream to write the statistics to
+     */
+    void dump(std::ostream& out) const;
+
+private:
+    std::string expression_;
+    std::vector<node_profile> nodes_;
+};
+
+/**
+ * class node_profiler
+ *
+ * Represents the collector of per-node evaluation statistics used by the
+ * result visitor in the profiling mode. The counters are updated atomically,
+ * so the profiled evaluator can be shared between threads.
+ */
+class node_profiler {
+public:
+    node_profiler() = default;
+    node_profiler(node_profiler&& rhs) = default;
+    node_profiler(node_profiler const& rhs) = delete;
+
+    node_profiler& operator=(node_profiler&& rhs) = default;
+    node_profiler& operator=(node_profiler const& rhs) = delete;
+
+    ~node_profiler() = default;
+
+    /**
+     * Prepares the counters for all the nodes of the expression tree.
+     * Previously collected statistics are discarded.
+     *
+     * @param root       Root of the expression tree
+     * @param expression Expression the tree is built from
+     */
+    void reset(tree_node const* root, std::string_view expression);
+
+    /**
+     * Resets all the counters to zero.
+     */
+    void clear() noexcept;
+
+    /**
+     * Records the evaluation of the node.
+     *
+     * @param node   Evaluated node
+     * @param result Result of the evaluation
+     */
+    void record(tree_node const& node, bool const result) const noexcept {
+        if (auto const c = find(node); nullptr != c) {
+            c->evaluations.fetch_add(1, std::memory_order_relaxed);
+            c->true_count.fetch_add(result ? 1 : 0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Records the time spent in the field accessor of the relational node.
+     *
+     * @param node        Evaluated relational node
+     * @param nanoseconds Time spent in the accessor
+     * @param cycles      Cycles spent in the accessor
+     */
+    void record_accessor(tree_node const& node, uint64_t const nanoseconds, uint64_t const cycles) const noexcept {
+        if (auto const c = find(node); nullptr != c) {
+            c->accessor_nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+            c->accessor_cycles.fetch_add(cycles, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Takes the snapshot of the collected statistics.
+     *
+     * @return Statistics of all the nodes
+     */
+    [[nodiscard]] profile_report report() const;
+
+private:
+    struct counters {
+        std::atomic<uint64_t> evaluations{ 0 };
+        std::atomic<uint64_t> true_count{ 0 };
+        std::atomic<uint64_t> accessor_nanoseconds{ 0 };
+        std::atomic<uint64_t> accessor_cycles{ 0 };
+    };
+
+    [[nodiscard]] counters* find(tree_node const& node) const noexcept {
+        auto const it = indices_.find(&node);
+        return indices_.end() == it ? nullptr : &counters_[it->second];
+    }
+
+private:
+    std::string_view expression_;
+    std::vector<node_profile> nodes_;
+    std::unordered_map<tree_node const*, std::size_t> indices_;
+    std::unique_ptr<counters[]> counters_;
+};
+
+/**
+ * struct no_profiler
+ *
+ * Represents the placeholder used by the result visitor instead
+ * of the node profiler when the profiling mode is off.
+ */
+struct no_profiler {};
+
+} // tree
+
+} // booleval
+
+#endif // BOOLEVAL_NODE_PROFILER_H
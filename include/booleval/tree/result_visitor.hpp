@@ -33,9 +33,12 @@
 #include <map>
 #include <functional>
 #include <string_view>
+#include <type_traits>
 #include <booleval/exceptions.hpp>
 #include <booleval/tree/tree_node.hpp>
+#include <booleval/tree/node_profiler.hpp>
 #include <booleval/utils/any_mem_fn.hpp>
+#include <booleval/utils/time_utils.hpp>
 
 namespace booleval {
 
@@ -46,8 +49,10 @@ namespace tree {
  *
  * Represents a visitor for expression tree nodes in order to get the
  * final result of the expression based on the fields of an object being passed.
+ * If Profile is true, evaluation count, true count and time spent in the field
+ * accessors are recorded for each node. Otherwise, no profiling code is compiled in.
  */
-template <typename MemFn = utils::any_mem_fn>
+template <typename MemFn = utils::any_mem_fn, bool Profile = false>
 class result_visitor {
     using field_map = std::map<std::string_view, MemFn>;
 
@@ -70,6 +75,26 @@ public:
         fields_ = fields;
     }
 
+    /**
+     * Gets the key - member function map used for evaluation of expression tree.
+     *
+     * @return Key - member function map
+     */
+    [[nodiscard]] field_map const& fields() const noexcept {
+        return fields_;
+    }
+
+    /**
+     * Checks whether the member function is set for the key.
+     *
+     * @param key Key to be checked
+     *
+     * @return True if the key is bound to a member function, otherwise false
+     */
+    [[nodiscard]] bool has_field(std::string_view const key) const {
+        return fields_.end() != fields_.find(key);
+    }
+
     /**
      * Visits tree node by checking token type and passing node itself
      * to specialized visitor's function.
@@ -79,10 +104,51 @@ public:
      * @return ReturnType
      */
     template <typename T>
-    [[nodiscard]] constexpr bool visit(tree_node const& node, T const& obj);
+    [[nodiscard]] constexpr bool visit(tree_node const& node, T const& obj) const;
+
+    /**
+     * Prepares the profiling of the expression tree. Previously collected
+     * statistics are discarded. Available in the profiling mode only.
+     *
+     * @param root       Root of the expression tree
+     * @param expression Expression the tree is built from
+     */
+    void reset_profile(tree_node const* root, std::string_view expression) {
+        static_assert(Profile, "Profiling mode is off");
+        profiler_.reset(root, expression);
+    }
+
+    /**
+     * Resets the statistics collected so far. Available in the profiling mode only.
+     */
+    void clear_profile() noexcept {
+        static_assert(Profile, "Profiling mode is off");
+        profiler_.clear();
+    }
+
+    /**
+     * Gets the statistics collected so far. Available in the profiling mode only.
+     *
+     * @return Statistics of all the nodes
+     */
+    [[nodiscard]] profile_report report() const {
+        static_assert(Profile, "Profiling mode is off");
+        return profiler_.report();
+    }
 
 private:
 
+    /**
+     * Visits tree node without recording the evaluation.
+     *
+     * @param node Currently visited tree node
+     * @param obj  Object to be evaluated
+     *
+     * @return Result of the node evaluation
+     */
+    template <typename T>
+    [[nodiscard]] constexpr bool visit_node(tree_node const& node, T const& obj) const;
+
     /**
      * Visits tree node representing one of logical operations.
      *
@@ -93,12 +159,15 @@ private:
      * @return Result of logical operation
      */
     template <typename T, typename F>
-    [[nodiscard]] constexpr bool visit_logical(tree_node const& node, T const& obj, F&& func) {
+    [[nodiscard]] constexpr bool visit_logical(tree_node const& node, T const& obj, F&& func) const {
         return func(visit(*node.left, obj), visit(*node.right, obj));
     }
 
     /**
-     * Visits tree node representing one of relational operations.
+     * Visits tree node representing one of relational operations. Comparison
+     * with a null field value is unknown and evaluates to false. As AND and OR
+     * are monotonic, this gives the same result as the three-valued logic
+     * where only the expressions evaluated to true are satisfied.
      *
      * @param node Currently visited tree node
      * @param obj  Object to be evaluated
@@ -107,7 +176,58 @@ private:
      * @return Result of relational operation
      */
     template <typename T, typename F>
-    [[nodiscard]] constexpr bool visit_relational(tree_node const& node, T const& obj, F&& func) {
+    [[nodiscard]] constexpr bool visit_relational(tree_node const& node, T const& obj, F&& func) const {
+        auto field_value = invoke(node, obj);
+        if (field_value.is_null()) {
+            return false;
+        }
+
+        return func(field_value, node.right->token.value());
+    }
+
+    /**
+     * Visits tree node representing one of null tests.
+     *
+     * @param node    Currently visited tree node
+     * @param obj     Object to be evaluated
+     * @param is_null True if the field value is expected to be null
+     *
+     * @return Result of null test
+     */
+    template <typename T>
+    [[nodiscard]] constexpr bool visit_null_test(tree_node const& node, T const& obj, bool const is_null) const {
+        return is_null == invoke(node, obj).is_null();
+    }
+
+    /**
+     * Visits tree node representing one of string matching operations.
+     * The pattern is compiled when the tree is built.
+     *
+     * @param node Currently visited tree node
+     * @param obj  Object to be evaluated
+     *
+     * @return Result of string matching operation
+     */
+    template <typename T>
+    [[nodiscard]] constexpr bool visit_match(tree_node const& node, T const& obj) const {
+        if (nullptr == node.matcher) {
+            return false;
+        }
+
+        auto const field_value = invoke(node, obj);
+        return !field_value.is_null() && node.matcher->matches(field_value.str());
+    }
+
+    /**
+     * Gets the value of the field the relational operation or null test refers to.
+     *
+     * @param node Currently visited tree node
+     * @param obj  Object to be evaluated
+     *
+     * @return Value of the field
+     */
+    template <typename T>
+    [[nodiscard]] auto invoke(tree_node const& node, T const& obj) const {
         auto key = node.left->token;
 
         auto iter = fields_.find(key.value());
@@ -115,17 +235,38 @@ private:
             throw field_not_found(key.value());
         }
 
-        auto value = node.right->token;
-        return func(iter->second.invoke(obj), value.value());
+        if constexpr (Profile) {
+            auto const start_nanoseconds = utils::read_nanoseconds();
+            auto const start_cycles = utils::read_cycle_counter();
+            auto field_value = iter->second.invoke(obj);
+            auto const cycles = utils::read_cycle_counter() - start_cycles;
+            profiler_.record_accessor(node, utils::read_nanoseconds() - start_nanoseconds, cycles);
+            return field_value;
+        } else {
+            return iter->second.invoke(obj);
+        }
     }
 
 private:
     field_map fields_;
+    std::conditional_t<Profile, node_profiler, no_profiler> profiler_;
 };
 
-template <typename MemFn>
+template <typename MemFn, bool Profile>
+template <typename T>
+constexpr bool result_visitor<MemFn, Profile>::visit(tree_node const& node, T const& obj) const {
+    if constexpr (Profile) {
+        auto const result = visit_node(node, obj);
+        profiler_.record(node, result);
+        return result;
+    } else {
+        return visit_node(node, obj);
+    }
+}
+
+template <typename MemFn, bool Profile>
 template <typename T>
-constexpr bool result_visitor<MemFn>::visit(tree_node const& node, T const& obj) {
+constexpr bool result_visitor<MemFn, Profile>::visit_node(tree_node const& node, T const& obj) const {
     if (nullptr == node.left || nullptr == node.right) {
         return false;
     }
@@ -155,6 +296,19 @@ constexpr bool result_visitor<MemFn>::visit(tree_node const& node, T const& obj)
     case token::token_type::leq:
         return visit_relational(node, obj, std::less_equal<>());
 
+    case token::token_type::is_null:
+        return visit_null_test(node, obj, true);
+
+    case token::token_type::is_not_null:
+        return visit_null_test(node, obj, false);
+
+    case token::token_type::starts_with:
+    case token::token_type::ends_with:
+    case token::token_type::contains:
+    case token::token_type::like:
+    case token::token_type::matches:
+        return visit_match(node, obj);
+
     default:
         return false;
     }
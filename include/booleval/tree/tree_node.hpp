@@ -33,6 +33,7 @@
 #include <memory>
 #include <booleval/token/token.hpp>
 #include <booleval/token/token_type.hpp>
+#include <booleval/utils/string_matcher.hpp>
 
 namespace booleval {
 
@@ -43,11 +44,14 @@ namespace tree {
  *
  * Represents the tree node containing references to left and right child nodes
  * as well as the token that the node represents in the actual expression tree.
+ * Nodes of string matching operators also hold the pattern compiled when the
+ * tree is built.
  */
 struct tree_node {
     token::token token{ token::token_type::unknown };
     std::shared_ptr<tree_node> left;
     std::shared_ptr<tree_node> right;
+    std::shared_ptr<utils::string_matcher const> matcher;
 
     constexpr tree_node() = default;
 
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_TYPED_EVALUATOR_H
+#define BOOLEVAL_TYPED_EVALUATOR_H
+
+#include <map>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <booleval/exceptions.hpp>
+#include <booleval/utils/typed_mem_fn.hpp>
+#include <booleval/tree/expression_tree.hpp>
+
+namespace booleval {
+
+/**
+ * class typed_evaluator
+ *
+ * Represents a class for evaluating logical expressions on objects of a type known
+ * at compile time. The fields are bound to the members of the type directly (see
+ * utils::typed_mem_fn), so neither the objects nor the field values are type-erased.
+ * Once the expression is set, it is compiled into a program whose operations are
+ * functions instantiated for the types of the members and the literals parsed in
+ * advance. AND and OR operations evaluate their right operand only if it can change
+ * the result, so a missing field is not reported unless its operation is evaluated.
+ * Alternatively, the missing fields can be treated as null (see missing_fields_null).
+ */
+template <typename T>
+class typed_evaluator {
+    using field_map = std::map<std::string_view, utils::typed_mem_fn<T>>;
+
+public:
+    typed_evaluator() = default;
+    typed_evaluator(typed_evaluator&& rhs) = default;
+    typed_evaluator(typed_evaluator const& rhs) = default;
+
+    typed_evaluator(field_map const& fields)
+        : fields_(fields)
+    {}
+
+    typed_evaluator& operator=(typed_evaluator&& rhs) = default;
+    typed_evaluator& operator=(typed_evaluator const& rhs) = default;
+
+    ~typed_evaluator() = default;
+
+    /**
+     * Sets the key - member map used for evaluation of the expression.
+     *
+     * @param fields Key - member map
+     */
+    void fields(field_map const& fields) {
+        fields_ = fields;
+        compile();
+    }
+
+    /**
+     * Sets whether the fields missing from the key - member map are null, which
+     * lets the same expression be evaluated on types lacking some of its fields.
+     * Otherwise, they are reported by field_not_found when evaluated.
+     *
+     * @param is_null True if the missing fields are null, otherwise false
+     */
+    void missing_fields_null(bool const is_null) {
+        missing_fields_null_ = is_null;
+        compile();
+    }
+
+    /**
+     * Checks whether the evaluation is activated or not, i.e.
+     * if the expression tree is successfully built.
+     *
+     * @return True if the evaluation is activated, otherwise false
+     */
+    [[nodiscard]] bool is_activated() const noexcept {
+        return is_activated_;
+    }
+
+    /**
+     * Sets the expression to be used for evaluation.
+     *
+     * @param expression Expression to be used for evaluation
+     *
+     * @return True if the expression is valid, otherwise false
+     */
+    [[nodiscard]] bool expression(std::string_view expression);
+
+    /**
+     * Sets the expression tree to be used for evaluation, e.g. one built once
+     * for the evaluators of several types. The tree is shared, not copied, and
+     * must not be rebuilt while it is in use.
+     *
+     * @param expression_tree Expression tree, activating the evaluation if it is built successfully
+     */
+    void expression_tree(std::shared_ptr<tree::expression_tree const> expression_tree) {
+        expression_tree_ = std::move(expression_tree);
+        is_activated_ = nullptr != expression_tree_->root();
+        compile();
+    }
+
+    /**
+     * Gets the names of the fields referenced in the expression.
+     *
+     * @return Referenced field names if the evaluation is activated, otherwise empty collection
+     */
+    [[nodiscard]] std::vector<std::string_view> referenced_fields() const {
+        if (is_activated_) {
+            return expression_tree_->referenced_fields();
+        }
+
+        return {};
+    }
+
+    /**
+     * Evaluates the expression for the object passed in.
+     *
+     * @param obj Object to be evaluated
+     *
+     * @return True if the object's members satisfy the expression, otherwise false
+     */
+    [[nodiscard]] bool evaluate(T const& obj) const {
+        return is_activated_ && call(0, obj);
+    }
+
+    /**
+     * Writes the human-readable description of the expression (see evaluator::explain).
+     *
+     * @param out Output stream to write the description to
+     */
+    void explain(std::ostream& out) const {
+        tree::explain(is_activated_ ? expression_tree_->root().get() : nullptr,
+                      expression_tree_->expression(),
+                      [this](std::string_view const field) {
+                          return fields_.end() != fields_.find(field);
+                      },
+                      out);
+    }
+
+private:
+    struct node;
+    using function = bool (*)(typed_evaluator const&, node const&, T const&);
+
+    /**
+     * struct node
+     *
+     * Represents an operation of the compiled program.
+     */
+    struct node {
+        function evaluate{ &never };
+        uint32_t left{ 0 };
+        uint32_t right{ 0 };
+        std::string_view field;
+        typename utils::typed_mem_fn<T>::predicate predicate;
+    };
+
+    [[nodiscard]] bool call(uint32_t const index, T const& obj) const {
+        auto const& n = nodes_[index];
+        return n.evaluate(*this, n, obj);
+    }
+
+    void compile();
+    [[nodiscard]] uint32_t compile(tree::tree_node const& source);
+
+    [[nodiscard]] static bool never(typed_evaluator const&, node const&, T const&) noexcept {
+        return false;
+    }
+
+    [[nodiscard]] static bool always(typed_evaluator const&, node const&, T const&) noexcept {
+        return true;
+    }
+
+    [[nodiscard]] static bool missing_field(typed_evaluator const&, node const& n, T const&) {
+        throw field_not_found(n.field);
+    }
+
+    [[nodiscard]] static bool logical_and(typed_evaluator const& e, node const& n, T const& obj) {
+        return e.call(n.left, obj) && e.call(n.right, obj);
+    }
+
+    [[nodiscard]] static bool logical_or(typed_evaluator const& e, node const& n, T const& obj) {
+        return e.call(n.left, obj) || e.call(n.right, obj);
+    }
+
+    [[nodiscard]] static bool test(typed_evaluator const&, node const& n, T const& obj) {
+        return n.predicate.evaluate(n.predicate, obj);
+    }
+
+private:
+    bool is_activated_{ false };
+    bool missing_fields_null_{ false };
+    field_map fields_;
+    std::shared_ptr<tree::expression_tree const> expression_tree_{ std::make_shared<tree::expression_tree>() };
+    std::vector<node> nodes_;
+};
+
+template <typename T>
+bool typed_evaluator<T>::expression(std::string_view expression) {
+    auto built_tree = std::make_shared<tree::expression_tree>();
+    auto const is_built = !expression.empty() && built_tree->build(expression);
+
+    expression_tree(std::move(built_tree));
+    return is_built || expression.empty();
+}
+
+template <typename T>
+void typed_evaluator<T>::compile() {
+    nodes_.clear();
+    if (is_activated_) {
+        [[maybe_unused]] auto const root = compile(*expression_tree_->root());
+    }
+}
+
+template <typename T>
+uint32_t typed_evaluator<T>::compile(tree::tree_node const& source) {
+    auto const index = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+
+    if (nullptr == source.left || nullptr == source.right) {
+        return index;
+    }
+
+    auto const type = source.token.type();
+    if (token::token_type::logical_and == type || token::token_type::logical_or == type) {
+        auto const left = compile(*source.left);
+        auto const right = compile(*source.right);
+
+        auto& n = nodes_[index];
+        n.evaluate = token::token_type::logical_and == type ? &logical_and : &logical_or;
+        n.left = left;
+        n.right = right;
+        return index;
+    }
+
+    auto& n = nodes_[index];
+    n.field = source.left->token.value();
+
+    auto const iter = fields_.find(n.field);
+    if (fields_.end() == iter) {
+        // A null value satisfies its null test only
+        if (!missing_fields_null_) {
+            n.evaluate = &missing_field;
+        } else if (token::token_type::is_null == type) {
+            n.evaluate = &always;
+        }
+        return index;
+    }
+
+    n.predicate = iter->second.compile(type, source.right->token.value(), source.matcher.get());
+    n.evaluate = &test;
+    return index;
+}
+
+} // booleval
+
+#endif // BOOLEVAL_TYPED_EVALUATOR_H
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_AHO_CORASICK_H
+#define BOOLEVAL_AHO_CORASICK_H
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <string_view>
+
+namespace booleval {
+
+namespace utils {
+
+/**
+ * class aho_corasick
+ *
+ * Represents the Aho-Corasick automaton searching a value for many literal
+ * patterns at once. The patterns are stored in a trie whose nodes are linked
+ * to their longest proper suffixes present in the trie, so the value is
+ * scanned once, regardless of the number of patterns.
+ */
+class aho_corasick {
+public:
+    aho_corasick() = default;
+    aho_corasick(aho_corasick&& rhs) = default;
+    aho_corasick(aho_corasick const& rhs) = default;
+
+    /**
+     * Builds the automaton for the patterns.
+     *
+     * @param patterns Patterns to be searched for
+     */
+    aho_corasick(std::vector<std::string_view> const& patterns);
+
+    aho_corasick& operator=(aho_corasick&& rhs) = default;
+    aho_corasick& operator=(aho_corasick const& rhs) = default;
+
+    ~aho_corasick() = default;
+
+    /**
+     * Gets the number of patterns the automaton has been built for.
+     *
+     * @return Number of patterns
+     */
+    [[nodiscard]] std::size_t size() const noexcept {
+        return pattern_count_;
+    }
+
+    /**
+     * Searches the value for the patterns. The function is called with the
+     * index of the pattern for each of its occurrences, ordered by their end.
+     * An empty pattern is reported once, before any other pattern.
+     *
+     * @param value    Value to be searched
+     * @param on_match Function called for each occurrence
+     */
+    template <typename F>
+    void find(std::string_view value, F&& on_match) const;
+
+private:
+    static constexpr uint32_t none{ static_cast<uint32_t>(-1) };
+
+    /**
+     * struct node
+     *
+     * Represents a node of the trie. The children are stored in the edges,
+     * ordered by their byte, and the patterns ending at the node in the outputs.
+     */
+    struct node {
+        uint32_t first_edge{ 0 };
+        uint32_t last_edge{ 0 };
+        uint32_t first_output{ 0 };
+        uint32_t last_output{ 0 };
+        uint32_t failure{ 0 };
+        uint32_t dictionary{ none };
+    };
+
+    [[nodiscard]] uint32_t child(uint32_t parent, unsigned char byte) const noexcept;
+    [[nodiscard]] uint32_t next(uint32_t state, unsigned char byte) const noexcept;
+
+    template <typename F>
+    void report(uint32_t state, F&& on_match) const;
+
+private:
+    std::vector<node> nodes_;
+    std::vector<unsigned char> edge_bytes_;
+    std::vector<uint32_t> edge_targets_;
+    std::vector<uint32_t> outputs_;
+    std::array<uint32_t, 256> root_{};
+    std::size_t pattern_count_{ 0 };
+};
+
+inline uint32_t aho_corasick::child(uint32_t const parent, unsigned char const byte) const noexcept {
+    auto const& n = nodes_[parent];
+    auto const first = std::begin(edge_bytes_) + n.first_edge;
+    auto const last  = std::begin(edge_bytes_) + n.last_edge;
+    auto const edge  = std::lower_bound(first, last, byte);
+    if (last == edge || byte != *edge) {
+        return none;
+    }
+
+    return edge_targets_[static_cast<std::size_t>(edge - std::begin(edge_bytes_))];
+}
+
+inline uint32_t aho_corasick::next(uint32_t state, unsigned char const byte) const noexcept {
+    while (0 != state) {
+        auto const target = child(state, byte);
+        if (none != target) {
+            return target;
+        }
+        state = nodes_[state].failure;
+    }
+
+    return root_[byte];
+}
+
+template <typename F>
+void aho_corasick::report(uint32_t const state, F&& on_match) const {
+    auto const& n = nodes_[state];
+    for (auto output = n.first_output; output != n.last_output; ++output) {
+        on_match(static_cast<std::size_t>(outputs_[output]));
+    }
+}
+
+template <typename F>
+void aho_corasick::find(std::string_view const value, F&& on_match) const {
+    if (nodes_.empty()) {
+        return;
+    }
+
+    report(0, on_match);
+
+    uint32_t state{ 0 };
+    for (auto const c : value) {
+        state = next(state, static_cast<unsigned char>(c));
+        auto output = nodes_[state].first_output != nodes_[state].last_output ? state : nodes_[state].dictionary;
+        for (; none != output; output = nodes_[output].dictionary) {
+            report(output, on_match);
+        }
+    }
+}
+
+} // utils
+
+} // booleval
+
+#endif // BOOLEVAL_AHO_CORASICK_H
@@ -32,6 +32,7 @@
 
 #include <any>
 #include <functional>
+#include <type_traits>
 #include <booleval/utils/any_value.hpp>
 
 namespace booleval {
@@ -41,7 +42,7 @@ namespace utils {
 /**
  * class any_mem_fn
  *
- * Represents class member function of any signature.
+ * Represents class member function of any signature or class data member.
  */
 class any_mem_fn {
 public:
@@ -63,13 +64,21 @@ public:
         };
     }
 
+    template <typename Ret, typename C,
+              typename std::enable_if_t<!std::is_function_v<Ret>>* = nullptr>
+    any_mem_fn(Ret C::*m) {
+        fn_ = [m](std::any const& a) {
+            return std::any_cast<C const&>(a).*m;
+        };
+    }
+
     any_mem_fn& operator=(any_mem_fn&& rhs) = default;
     any_mem_fn& operator=(any_mem_fn const& rhs) = default;
 
     ~any_mem_fn() = default;
 
     template <typename T>
-    any_value invoke(T obj) {
+    any_value invoke(T obj) const {
         try {
             return fn_(obj);
         } catch (std::bad_any_cast const&) {
@@ -85,7 +94,7 @@ private:
  * class any_mem_fn_bool
  *
  * Represents class member function returning any signature taking a bool&
- * is_valid parameter. If is_valid is set to false, the evaluation will fail.
+ * is_valid parameter. If is_valid is set to false, the field value is null.
  */
 class any_mem_fn_bool
 {
@@ -114,7 +123,7 @@ public:
     ~any_mem_fn_bool() = default;
 
     template <typename T>
-    any_value invoke(T obj) {
+    any_value invoke(T obj) const {
         try {
             bool is_valid = false;
             auto ret = fn_(obj, is_valid);
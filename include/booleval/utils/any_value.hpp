@@ -30,6 +30,7 @@
 #ifndef BOOLEVAL_ANY_VALUE_H
 #define BOOLEVAL_ANY_VALUE_H
 
+#include <array>
 #include <string>
 #include <type_traits>
 #include <booleval/utils/string_utils.hpp>
@@ -42,7 +43,9 @@ namespace utils {
  * class any_value
  *
  * Represents the class that accepts any type of value through its constructor
- * or assignment operator and internally stores its string version.
+ * or assignment operator and internally stores its string version. A default
+ * constructed value is null, which is how the field accessors report missing
+ * or invalid values.
  */
 class any_value {
 public:
@@ -123,26 +126,48 @@ public:
         return value_;
     }
 
+    /**
+     * Checks whether the value is null, i.e. no value has been assigned to it.
+     *
+     * @return True if the value is null, otherwise false
+     */
+    [[nodiscard]] bool is_null() const noexcept {
+        return is_null_;
+    }
+
+    /**
+     * Checks whether a string has been assigned to the value, in which case
+     * it is ordered as a string rather than as a number.
+     *
+     * @return True if the value is a string, otherwise false
+     */
+    [[nodiscard]] bool is_string() const noexcept {
+        return use_string_comparison_;
+    }
+
     friend bool operator==(any_value const& lhs, any_value const& rhs);
     friend bool operator!=(any_value const& lhs, any_value const& rhs);
 
 private:
     std::string value_;
     bool use_string_comparison_{ false };
+    bool is_null_{ true };
 };
 
 template <typename T,
           typename std::enable_if_t<std::is_arithmetic_v<T>>*>
 any_value::any_value(T const rhs)
     : value_(utils::to_chars<T>(rhs)),
-      use_string_comparison_(false)
+      use_string_comparison_(false),
+      is_null_(false)
 {}
 
 template <typename T,
           typename std::enable_if_t<std::is_constructible_v<std::string, T>>*>
 any_value::any_value(T const rhs)
     : value_(rhs),
-      use_string_comparison_(true)
+      use_string_comparison_(true),
+      is_null_(false)
 {}
 
 template <typename T,
@@ -150,6 +175,7 @@ template <typename T,
 any_value& any_value::operator=(T const rhs) {
     value_ = utils::to_chars<T>(rhs);
     use_string_comparison_ = false;
+    is_null_ = false;
     return *this;
 }
 
@@ -158,13 +184,15 @@ template <typename T,
 any_value& any_value::operator=(T const rhs) {
     value_ = rhs;
     use_string_comparison_ = true;
+    is_null_ = false;
     return *this;
 }
 
 template <typename T,
           typename std::enable_if_t<std::is_arithmetic_v<T>>*>
 bool any_value::operator==(T const rhs) {
-    return value_ == utils::to_chars<T>(rhs);
+    std::array<char, utils::max_chars<T>> buffer;
+    return value_ == utils::to_chars(buffer, rhs);
 }
 
 template <typename T,
@@ -176,7 +204,8 @@ bool any_value::operator==(T const rhs) {
 template <typename T,
           typename std::enable_if_t<std::is_arithmetic_v<T>>*>
 bool any_value::operator!=(T const rhs) {
-    return value_ != utils::to_chars<T>(rhs);
+    std::array<char, utils::max_chars<T>> buffer;
+    return value_ != utils::to_chars(buffer, rhs);
 }
 
 template <typename T,
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_BIT_UTILS_H
+#define BOOLEVAL_BIT_UTILS_H
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <stdlib.h>
+#endif
+
+namespace booleval {
+
+namespace utils {
+
+/**
+ * Indicates whether the target stores multi-byte values
+ * with the least significant byte first.
+ */
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr bool is_little_endian{ false };
+#else
+constexpr bool is_little_endian{ true };
+#endif
+
+/**
+ * Counts the number of set bits in the word.
+ *
+ * @param word Word to count the bits in
+ *
+ * @return Number of set bits
+ */
+[[nodiscard]] inline std::size_t popcount(uint64_t const word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(__builtin_popcountll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<std::size_t>(__popcnt64(word));
+#else
+    std::size_t count{ 0 };
+    for (auto w = word; 0 != w; w &= w - 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+/**
+ * Counts the number of trailing zero bits in the word.
+ * The word must not be zero.
+ *
+ * @param word Non-zero word to count the trailing zeros in
+ *
+ * @return Index of the lowest set bit
+ */
+[[nodiscard]] inline std::size_t count_trailing_zeros(uint64_t const word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(__builtin_ctzll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index{ 0 };
+    _BitScanForward64(&index, word);
+    return static_cast<std::size_t>(index);
+#else
+    std::size_t index{ 0 };
+    while (0 == (word & (uint64_t{ 1 } << index))) {
+        ++index;
+    }
+    return index;
+#endif
+}
+
+/**
+ * Reverses the order of bytes in the word.
+ *
+ * @param word Word to reverse the bytes of
+ *
+ * @return Word with the reversed order of bytes
+ */
+[[nodiscard]] inline uint8_t byte_swap(uint8_t const word) noexcept {
+    return word;
+}
+
+[[nodiscard]] inline uint16_t byte_swap(uint16_t const word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap16(word);
+#elif defined(_MSC_VER)
+    return _byteswap_ushort(word);
+#else
+    return static_cast<uint16_t>((word << 8) | (word >> 8));
+#endif
+}
+
+[[nodiscard]] inline uint32_t byte_swap(uint32_t const word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap32(word);
+#elif defined(_MSC_VER)
+    return _byteswap_ulong(word);
+#else
+    return (word << 24) | ((word << 8) & 0x00FF0000U) | ((word >> 8) & 0x0000FF00U) | (word >> 24);
+#endif
+}
+
+[[nodiscard]] inline uint64_t byte_swap(uint64_t const word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap64(word);
+#elif defined(_MSC_VER)
+    return _byteswap_uint64(word);
+#else
+    return (static_cast<uint64_t>(byte_swap(static_cast<uint32_t>(word))) << 32) |
+           byte_swap(static_cast<uint32_t>(word >> 32));
+#endif
+}
+
+} // utils
+
+} // booleval
+
+#endif // BOOLEVAL_BIT_UTILS_H
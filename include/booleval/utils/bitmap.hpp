@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_BITMAP_H
+#define BOOLEVAL_BITMAP_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <booleval/utils/bit_utils.hpp>
+
+namespace booleval {
+
+namespace utils {
+
+/**
+ * class bitmap
+ *
+ * Represents a fixed-size set of bits stored in 64-bit words, one bit per row
+ * in the least significant bit order. The bits past the size are kept cleared,
+ * so the logical operations and the population count work on whole words
+ * without masking, in loops simple enough for the compiler to vectorize.
+ * Operands of different sizes behave as if the shorter one was padded with
+ * cleared bits.
+ */
+class bitmap {
+public:
+    bitmap() = default;
+    bitmap(bitmap&& rhs) = default;
+    bitmap(bitmap const& rhs) = default;
+
+    /**
+     * Creates the bitmap with all bits set to the value.
+     *
+     * @param size  Number of bits
+     * @param value Value of the bits
+     */
+    explicit bitmap(std::size_t const size, bool const value = false)
+        : words_((size + 63) / 64, value ? ~uint64_t{ 0 } : 0),
+          size_(size) {
+        clear_tail();
+    }
+
+    /**
+     * Creates the bitmap from the words. The bits past the size are cleared.
+     *
+     * @param words Words of the bitmap, at least (size + 63) / 64
+     * @param size  Number of bits
+     */
+    bitmap(std::vector<uint64_t> words, std::size_t const size)
+        : words_(std::move(words)),
+          size_(size) {
+        words_.resize((size + 63) / 64, 0);
+        clear_tail();
+    }
+
+    bitmap& operator=(bitmap&& rhs) = default;
+    bitmap& operator=(bitmap const& rhs) = default;
+
+    ~bitmap() = default;
+
+    /**
+     * Gets the number of bits.
+     *
+     * @return Number of bits
+     */
+    [[nodiscard]] std::size_t size() const noexcept {
+        return size_;
+    }
+
+    /**
+     * Gets the number of words.
+     *
+     * @return Number of words
+     */
+    [[nodiscard]] std::size_t word_count() const noexcept {
+        return words_.size();
+    }
+
+    /**
+     * Gets the words of the bitmap.
+     *
+     * @return Pointer to the first word
+     */
+    [[nodiscard]] uint64_t* data() noexcept {
+        return words_.data();
+    }
+
+    [[nodiscard]] uint64_t const* data() const noexcept {
+        return words_.data();
+    }
+
+    /**
+     * Resizes the bitmap. The added bits are cleared.
+     *
+     * @param size Number of bits
+     */
+    void resize(std::size_t const size) {
+        words_.resize((size + 63) / 64, 0);
+        size_ = size;
+        clear_tail();
+    }
+
+    /**
+     * Resizes the bitmap and sets all bits to the value.
+     *
+     * @param size  Number of bits
+     * @param value Value of the bits
+     */
+    void assign(std::size_t const size, bool const value = false) {
+        words_.assign((size + 63) / 64, value ? ~uint64_t{ 0 } : 0);
+        size_ = size;
+        clear_tail();
+    }
+
+    /**
+     * Moves the words out of the bitmap, leaving it empty.
+     *
+     * @return Words of the bitmap
+     */
+    [[nodiscard]] std::vector<uint64_t> release() noexcept {
+        size_ = 0;
+        return std::move(words_);
+    }
+
+    /**
+     * Checks whether the bit is set.
+     *
+     * @param index Index of the bit, less than size()
+     *
+     * @return True if the bit is set, otherwise false
+     */
+    [[nodiscard]] bool test(std::size_t const index) const noexcept {
+        return 0 != (words_[index / 64] & (uint64_t{ 1 } << (index % 64)));
+    }
+
+    /**
+     * Sets the bit.
+     *
+     * @param index Index of the bit, less than size()
+     */
+    void set(std::size_t const index) noexcept {
+        words_[index / 64] |= uint64_t{ 1 } << (index % 64);
+    }
+
+    /**
+     * Clears the bit.
+     *
+     * @param index Index of the bit, less than size()
+     */
+    void reset(std::size_t const index) noexcept {
+        words_[index / 64] &= ~(uint64_t{ 1 } << (index % 64));
+    }
+
+    /**
+     * Counts the set bits.
+     *
+     * @return Number of set bits
+     */
+    [[nodiscard]] std::size_t count() const noexcept {
+        std::size_t count{ 0 };
+        for (auto const word : words_) {
+            count += popcount(word);
+        }
+        return count;
+    }
+
+    /**
+     * Checks whether any bit is set.
+     *
+     * @return True if any bit is set, otherwise false
+     */
+    [[nodiscard]] bool any() const noexcept {
+        return std::any_of(words_.begin(), words_.end(), [](auto const word) { return 0 != word; });
+    }
+
+    /**
+     * Checks whether all bits are set.
+     *
+     * @return True if all bits are set, otherwise false
+     */
+    [[nodiscard]] bool all() const noexcept {
+        return count() == size_;
+    }
+
+    /**
+     * Intersects the bitmap with another one.
+     *
+     * @param rhs Bitmap to intersect with
+     *
+     * @return Reference to this bitmap
+     */
+    bitmap& operator&=(bitmap const& rhs) noexcept {
+        auto const common = std::min(words_.size(), rhs.words_.size());
+        auto const lhs_words = words_.data();
+        auto const rhs_words = rhs.words_.data();
+        for (std::size_t i = 0; i < common; ++i) {
+            lhs_words[i] &= rhs_words[i];
+        }
+        std::fill(words_.begin() + static_cast<std::ptrdiff_t>(common), words_.end(), 0);
+        return *this;
+    }
+
+    /**
+     * Unites the bitmap with another one. The bitmap grows to the size of
+     * the other one if it is larger.
+     *
+     * @param rhs Bitmap to unite with
+     *
+     * @return Reference to this bitmap
+     */
+    bitmap& operator|=(bitmap const& rhs) {
+        if (rhs.size_ > size_) {
+            resize(rhs.size_);
+        }
+
+        auto const lhs_words = words_.data();
+        auto const rhs_words = rhs.words_.data();
+        for (std::size_t i = 0; i < rhs.words_.size(); ++i) {
+            lhs_words[i] |= rhs_words[i];
+        }
+        return *this;
+    }
+
+    /**
+     * Clears the bits set in another bitmap.
+     *
+     * @param rhs Bitmap of the bits to clear
+     *
+     * @return Reference to this bitmap
+     */
+    bitmap& and_not(bitmap const& rhs) noexcept {
+        auto const common = std::min(words_.size(), rhs.words_.size());
+        auto const lhs_words = words_.data();
+        auto const rhs_words = rhs.words_.data();
+        for (std::size_t i = 0; i < common; ++i) {
+            lhs_words[i] &= ~rhs_words[i];
+        }
+        return *this;
+    }
+
+    /**
+     * Inverts all bits.
+     *
+     * @return Reference to this bitmap
+     */
+    bitmap& flip() noexcept {
+        for (auto& word : words_) {
+            word = ~word;
+        }
+        clear_tail();
+        return *this;
+    }
+
+    [[nodiscard]] friend bitmap operator&(bitmap lhs, bitmap const& rhs) noexcept {
+        return lhs &= rhs;
+    }
+
+    [[nodiscard]] friend bitmap operator|(bitmap lhs, bitmap const& rhs) {
+        return lhs |= rhs;
+    }
+
+    [[nodiscard]] friend bool operator==(bitmap const& lhs, bitmap const& rhs) noexcept {
+        return lhs.size_ == rhs.size_ && lhs.words_ == rhs.words_;
+    }
+
+    [[nodiscard]] friend bool operator!=(bitmap const& lhs, bitmap const& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    /**
+     * Invokes the function with the index of each set bit, in ascending order.
+     *
+     * @param func Function to invoke with the index
+     */
+    template <typename F>
+    void for_each(F&& func) const {
+        for (std::size_t word = 0; word < words_.size(); ++word) {
+            for (auto bits = words_[word]; 0 != bits; bits &= bits - 1) {
+                func(word * 64 + count_trailing_zeros(bits));
+            }
+        }
+    }
+
+    /**
+     * Converts the bitmap into a selection vector.
+     *
+     * @param offset Offset added to each index
+     *
+     * @return Ascending indices of the set bits
+     */
+    [[nodiscard]] std::vector<std::size_t> indices(std::size_t const offset = 0) const {
+        std::vector<std::size_t> result;
+        result.reserve(count());
+        for_each([&result, offset](auto const index) {
+            result.push_back(offset + index);
+        });
+        return result;
+    }
+
+private:
+    void clear_tail() noexcept {
+        if (0 != size_ % 64) {
+            words_.back() &= (uint64_t{ 1 } << (size_ % 64)) - 1;
+        }
+    }
+
+private:
+    std::vector<uint64_t> words_;
+    std::size_t size_{ 0 };
+};
+
+} // utils
+
+} // booleval
+
+#endif // BOOLEVAL_BITMAP_H
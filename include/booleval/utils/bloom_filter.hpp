@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_BLOOM_FILTER_H
+#define BOOLEVAL_BLOOM_FILTER_H
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace booleval {
+
+namespace utils {
+
+/**
+ * class bloom_filter
+ *
+ * Represents a split block Bloom filter of strings. Each string sets 8 bits
+ * within a single block of 256 bits, one bit in each of its 32-bit words, so
+ * adding and looking a string up hashes it once and touches one cache line.
+ * With 10 bits per string about 1% of the strings not added are reported
+ * as possibly contained. A filter that has not been built may contain
+ * any string.
+ */
+class bloom_filter {
+public:
+    bloom_filter() = default;
+    bloom_filter(bloom_filter&& rhs) = default;
+    bloom_filter(bloom_filter const& rhs) = default;
+
+    /**
+     * Creates an empty filter sized for the number of strings.
+     *
+     * @param count          Expected number of strings
+     * @param bits_per_value Number of bits per string
+     */
+    explicit bloom_filter(std::size_t count, std::size_t bits_per_value = 10);
+
+    bloom_filter& operator=(bloom_filter&& rhs) = default;
+    bloom_filter& operator=(bloom_filter const& rhs) = default;
+
+    ~bloom_filter() = default;
+
+    /**
+     * Adds the string to the filter.
+     *
+     * @param value String to add
+     */
+    void add(std::string_view value) noexcept;
+
+    /**
+     * Checks whether the string may have been added to the filter.
+     *
+     * @param value String to look up
+     *
+     * @return False if the string has not been added, true if it may have been
+     */
+    [[nodiscard]] bool may_contain(std::string_view value) const noexcept;
+
+    /**
+     * Gets the number of bytes taken by the bits of the filter.
+     *
+     * @return Number of bytes
+     */
+    [[nodiscard]] std::size_t size_in_bytes() const noexcept;
+
+private:
+    using block = std::array<uint32_t, 8>;
+
+    [[nodiscard]] std::size_t block_index(uint64_t hash) const noexcept;
+    [[nodiscard]] static block mask(uint64_t hash) noexcept;
+
+private:
+    std::vector<block> blocks_;
+};
+
+} // utils
+
+} // booleval
+
+#endif // BOOLEVAL_BLOOM_FILTER_H
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_MEMBER_FIELD_H
+#define BOOLEVAL_MEMBER_FIELD_H
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <booleval/utils/any_value.hpp>
+
+namespace booleval {
+
+namespace utils {
+
+/**
+ * class member_field
+ *
+ * Represents an accessor of a data member of objects of type C that can be used
+ * in evaluator's field map instead of a member function. Unlike any_mem_fn, the
+ * object is neither copied nor type-erased; the member is read through its pointer
+ * and converted into any_value.
+ *
+ * Nested members are accessed through a path of member pointers known at compile
+ * time, e.g. member_field<order>::path<&order::header, &header::timestamp>().
+ * Member functions are accepted in the path as well and get called; the objects
+ * they return by value live until the value at the end of the path is read.
+ */
+template <typename C>
+class member_field {
+    struct probe {};
+    using member_storage = std::array<std::byte, sizeof(int probe::*)>;
+    using loader = any_value (*)(C const&, member_storage const&);
+
+public:
+    member_field() = default;
+    member_field(member_field&& rhs) = default;
+    member_field(member_field const& rhs) = default;
+
+    template <typename Ret,
+              typename std::enable_if_t<!std::is_function_v<Ret>>* = nullptr>
+    member_field(Ret C::*m)
+        : load_(&load_member<Ret>) {
+        static_assert(sizeof(m) == sizeof(member_storage), "Unsupported data member pointer representation");
+        std::memcpy(member_.data(), &m, sizeof(m));
+    }
+
+    member_field& operator=(member_field&& rhs) = default;
+    member_field& operator=(member_field const& rhs) = default;
+
+    ~member_field() = default;
+
+    /**
+     * Creates an accessor of a nested member. Each member pointer
+     * is applied to the result of the previous one.
+     *
+     * @tparam Members Path of member pointers starting with a member of C
+     *
+     * @return Accessor of the nested member
+     */
+    template <auto... Members>
+    [[nodiscard]] static member_field path() noexcept {
+        static_assert(sizeof...(Members) > 0, "Member path is empty");
+
+        member_field field;
+        field.load_ = &load_path<Members...>;
+        return field;
+    }
+
+    /**
+     * Gets the value of the member from the object.
+     *
+     * @param obj Object to get the value from
+     *
+     * @return Value of the member or empty value if the accessor is not set
+     */
+    [[nodiscard]] any_value invoke(C const& obj) const {
+        if (nullptr == load_) {
+            return {};
+        }
+
+        return load_(obj, member_);
+    }
+
+private:
+    template <typename V>
+    [[nodiscard]] static any_value make_value(V const& value) {
+        if constexpr (std::is_enum_v<V>) {
+            return static_cast<std::underlying_type_t<V>>(value);
+        } else {
+            return value;
+        }
+    }
+
+    template <typename Ret>
+    [[nodiscard]] static any_value load_member(C const& obj, member_storage const& member) {
+        Ret C::*m;
+        std::memcpy(&m, member.data(), sizeof(m));
+        return make_value(obj.*m);
+    }
+
+    /**
+     * Reads the rest of the path within the same full-expression, so that
+     * temporaries returned by member functions outlive the reads.
+     */
+    template <auto Member, auto... Rest, typename Obj>
+    [[nodiscard]] static any_value apply_path(Obj const& obj) {
+        if constexpr (0 == sizeof...(Rest)) {
+            if constexpr (std::is_member_function_pointer_v<decltype(Member)>) {
+                return make_value((obj.*Member)());
+            } else {
+                return make_value(obj.*Member);
+            }
+        } else if constexpr (std::is_member_function_pointer_v<decltype(Member)>) {
+            return apply_path<Rest...>((obj.*Member)());
+        } else {
+            return apply_path<Rest...>(obj.*Member);
+        }
+    }
+
+    template <auto... Members>
+    [[nodiscard]] static any_value load_path(C const& obj, member_storage const&) {
+        return apply_path<Members...>(obj);
+    }
+
+private:
+    loader load_{ nullptr };
+    member_storage member_{};
+};
+
+} // utils
+
+} // booleval
+
+#endif // BOOLEVAL_MEMBER_FIELD_H
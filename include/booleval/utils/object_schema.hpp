@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_OBJECT_SCHEMA_H
+#define BOOLEVAL_OBJECT_SCHEMA_H
+
+#include <map>
+#include <array>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <typeindex>
+#include <string_view>
+#include <type_traits>
+#include <booleval/utils/any_value.hpp>
+
+namespace booleval {
+
+namespace utils {
+
+/**
+ * class path_record
+ *
+ * Represents an object being evaluated through dotted field paths. It memoizes
+ * the sub-objects reached by the path prefixes so that the paths sharing
+ * a prefix traverse it only once per object.
+ */
+class path_record {
+public:
+    /**
+     * Number of the path prefixes that can be memoized.
+     */
+    static constexpr std::size_t memo_capacity{ 64 };
+
+    path_record(void const* root) noexcept
+        : root_(root)
+    {}
+
+    [[nodiscard]] void const* root() const noexcept {
+        return root_;
+    }
+
+    /**
+     * Gets the sub-object memoized in the slot.
+     *
+     * @param slot   Memo slot of the path prefix
+     * @param object Sub-object, set if memoized
+     *
+     * @return True if the sub-object is memoized, otherwise false
+     */
+    [[nodiscard]] bool recall(std::size_t const slot, void const*& object) const noexcept {
+        if (slot >= memo_capacity || 0 == (known_ & (uint64_t{ 1 } << slot))) {
+            return false;
+        }
+
+        object = memo_[slot];
+        return true;
+    }
+
+    /**
+     * Memoizes the sub-object in the slot.
+     *
+     * @param slot   Memo slot of the path prefix
+     * @param object Sub-object reached by the path prefix
+     */
+    void memoize(std::size_t const slot, void const* object) const noexcept {
+        if (slot < memo_capacity) {
+            memo_[slot] = object;
+            known_ |= uint64_t{ 1 } << slot;
+        }
+    }
+
+private:
+    void const* root_;
+    mutable uint64_t known_{ 0 };
+    mutable std::array<void const*, memo_capacity> memo_;
+};
+
+class path_field;
+
+/**
+ * class object_schema
+ *
+ * Represents the members of nested object types that can be referenced in
+ * expressions through dotted field paths, e.g. 'customer.address.city'. Each type
+ * registers only its own members, while the paths are resolved once the expression
+ * is set. Members holding or returning other objects (by reference or pointer) are
+ * navigated without copying, while the rest are loaded as values.
+ */
+class object_schema {
+    using member_storage = std::array<std::byte, 2 * sizeof(void*)>;
+
+public:
+    /**
+     * struct member
+     *
+     * Represents a registered member of an object type.
+     */
+    struct member {
+        std::type_index target{ typeid(void) };
+        void const* (*navigate)(void const*, member_storage const&){ nullptr };
+        any_value (*load)(void const*, member_storage const&){ nullptr };
+        member_storage pointer{};
+
+        /**
+         * Checks whether the member holds an object that can be navigated into.
+         *
+         * @return True if the member leads to another object, otherwise false
+         */
+        [[nodiscard]] bool is_object() const noexcept {
+            return nullptr != navigate;
+        }
+    };
+
+    /**
+     * struct step
+     *
+     * Represents one step of a resolved path along with the memo slot
+     * of the path prefix ending with it.
+     */
+    struct step {
+        member const* target{ nullptr };
+        std::size_t slot{ 0 };
+    };
+
+    object_schema() = default;
+    object_schema(object_schema&& rhs) = default;
+    object_schema(object_schema const& rhs) = default;
+
+    object_schema& operator=(object_schema&& rhs) = default;
+    object_schema& operator=(object_schema const& rhs) = default;
+
+    ~object_schema() = default;
+
+    /**
+     * Registers a data member or a member function taking no arguments.
+     *
+     * @param name Name of the member within its type
+     * @param m    Member pointer
+     *
+     * @return True if the member is registered, false if the name is already taken
+     */
+    template <typename M, typename C>
+    bool add(std::string_view name, M C::*m);
+
+    /**
+     * Finds the registered member of the type.
+     *
+     * @param owner Type of the object the member belongs to
+     * @param name  Name of the member
+     *
+     * @return Pointer to the member if found, otherwise nullptr
+     */
+    [[nodiscard]] member const* find(std::type_index owner, std::string_view name) const;
+
+    /**
+     * Resolves the dotted path starting at the type into a chain of members.
+     * All the members but the last one must lead to other objects.
+     *
+     * @param root Type of the object the path starts at
+     * @param path Dotted path of member names
+     *
+     * @return Chain of members if the path is valid, otherwise empty collection
+     */
+    [[nodiscard]] std::vector<member const*> resolve(std::type_index root, std::string_view path) const;
+
+    /**
+     * Resolves the dotted paths starting at the type into field accessors. The path
+     * prefixes shared by multiple paths are assigned the same memo slot, so they
+     * are traversed only once per evaluated object. The accessors refer to the
+     * members of this schema.
+     *
+     * @param root  Type of the object the paths start at
+     * @param paths Dotted paths of member names
+     *
+     * @return Path - field accessor map
+     *
+     * @throws field_not_found if any of the paths cannot be resolved
+     */
+    [[nodiscard]] std::map<std::string_view, path_field> compile(std::type_index root,
+                                                                 std::vector<std::string_view> const& paths) const;
+
+private:
+    template <typename V>
+    static constexpr bool is_value_v = std::is_arithmetic_v<V> ||
+                                       std::is_enum_v<V> ||
+                                       std::is_constructible_v<std::string, V>;
+
+    template <typename V>
+    [[nodiscard]] static any_value make_value(V const& value) {
+        if constexpr (std::is_enum_v<V>) {
+            return static_cast<std::underlying_type_t<V>>(value);
+        } else {
+            return value;
+        }
+    }
+
+    template <typename M, typename C>
+    [[nodiscard]] static decltype(auto) apply(void const* object, member_storage const& pointer) {
+        M C::*m;
+        std::memcpy(&m, pointer.data(), sizeof(m));
+
+        auto const& obj = *static_cast<C const*>(object);
+        if constexpr (std::is_function_v<M>) {
+            return (obj.*m)();
+        } else {
+            return (obj.*m);
+        }
+    }
+
+private:
+    std::map<std::type_index, std::map<std::string, member, std::less<>>> members_;
+};
+
+template <typename M, typename C>
+bool object_schema::add(std::string_view const name, M C::*m) {
+    static_assert(sizeof(m) <= sizeof(member_storage), "Unsupported member pointer representation");
+
+    using result = decltype(apply<M, C>(nullptr, {}));
+    using value = std::remove_cv_t<std::remove_reference_t<result>>;
+
+    member entry;
+    std::memcpy(entry.pointer.data(), &m, sizeof(m));
+
+    if constexpr (is_value_v<value>) {
+        entry.load = [](void const* object, member_storage const& pointer) {
+            return make_value(apply<M, C>(object, pointer));
+        };
+    } else if constexpr (std::is_pointer_v<value> && std::is_class_v<std::remove_pointer_t<value>>) {
+        entry.target = typeid(std::remove_cv_t<std::remove_pointer_t<value>>);
+        entry.navigate = [](void const* object, member_storage const& pointer) -> void const* {
+            return apply<M, C>(object, pointer);
+        };
+    } else {
+        static_assert(std::is_class_v<value>, "Member type is not supported");
+        static_assert(std::is_reference_v<result>, "Objects returned by value cannot be navigated without copying");
+        entry.target = typeid(value);
+        entry.navigate = [](void const* object, member_storage const& pointer) -> void const* {
+            return &apply<M, C>(object, pointer);
+        };
+    }
+
+    return members_[typeid(C)].emplace(name, entry).second;
+}
+
+/**
+ * class path_field
+ *
+ * Represents an accessor of a dotted field path resolved by the object schema
+ * that can be used in evaluator's field map instead of a member function.
+ */
+class path_field {
+public:
+    path_field() = default;
+    path_field(path_field&& rhs) = default;
+    path_field(path_field const& rhs) = default;
+
+    path_field(std::vector<object_schema::step> prefix, object_schema::member const* leaf)
+        : prefix_(std::move(prefix)),
+          leaf_(leaf)
+    {}
+
+    path_field& operator=(path_field&& rhs) = default;
+    path_field& operator=(path_field const& rhs) = default;
+
+    ~path_field() = default;
+
+    /**
+     * Gets the value at the end of the path. Sub-objects reached by the path
+     * prefixes are memoized in the record.
+     *
+     * @param record Object being evaluated
+     *
+     * @return Value at the end of the path or empty value if a pointer on the way is null
+     */
+    [[nodiscard]] any_value invoke(path_record const& record) const {
+        auto object = record.root();
+        for (auto const& s : prefix_) {
+            if (!record.recall(s.slot, object)) {
+                object = s.target->navigate(object, s.target->pointer);
+                record.memoize(s.slot, object);
+            }
+
+            if (nullptr == object) {
+                return {};
+            }
+        }
+
+        if (nullptr == leaf_) {
+            return {};
+        }
+
+        return leaf_->load(object, leaf_->pointer);
+    }
+
+private:
+    std::vector<object_schema::step> prefix_;
+    object_schema::member const* leaf_{ nullptr };
+};
+
+} // utils
+
+} // booleval
+
+#endif // BOOLEVAL_OBJECT_SCHEMA_H
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_PERFECT_HASH_H
+#define BOOLEVAL_PERFECT_HASH_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace booleval {
+
+namespace utils {
+
+/**
+ * class perfect_hash
+ *
+ * Represents a static set of strings indexed by a perfect hash function built
+ * by the hash and displace method: the keys are distributed into small buckets
+ * and each bucket gets a displacement which places all of its keys into free
+ * slots. Looking a string up therefore hashes it once and compares it with
+ * a single key at most.
+ */
+class perfect_hash {
+public:
+    /**
+     * Index returned for the strings not in the set.
+     */
+    static constexpr std::size_t npos{ static_cast<std::size_t>(-1) };
+
+    perfect_hash() = default;
+    perfect_hash(perfect_hash&& rhs) = default;
+    perfect_hash(perfect_hash const& rhs) = default;
+
+    /**
+     * Builds the hash function for the keys. A duplicated key is found
+     * at the index of its first occurrence.
+     *
+     * @param keys Keys of the set
+     */
+    perfect_hash(std::vector<std::string_view> const& keys);
+
+    perfect_hash& operator=(perfect_hash&& rhs) = default;
+    perfect_hash& operator=(perfect_hash const& rhs) = default;
+
+    ~perfect_hash() = default;
+
+    /**
+     * Gets the number of keys the set has been built for.
+     *
+     * @return Number of keys
+     */
+    [[nodiscard]] std::size_t size() const noexcept {
+        return keys_.size();
+    }
+
+    /**
+     * Looks the string up.
+     *
+     * @param key String to be looked up
+     *
+     * @return Index of the key equal to the string if there is one, otherwise npos
+     */
+    [[nodiscard]] std::size_t find(std::string_view key) const noexcept;
+
+    /**
+     * Hashes the string with the seed.
+     *
+     * @param key  String to be hashed
+     * @param seed Seed of the hash function
+     *
+     * @return 64-bit hash of the string
+     */
+    [[nodiscard]] static uint64_t hash(std::string_view key, uint64_t seed) noexcept;
+
+private:
+    [[nodiscard]] static uint64_t mix(uint64_t value) noexcept;
+
+    [[nodiscard]] bool place(std::vector<std::size_t> const& unique, uint64_t seed, std::size_t slot_count);
+
+private:
+    std::vector<std::string> keys_;
+    std::vector<uint32_t> displacements_;
+    std::vector<uint32_t> slots_;
+    uint64_t seed_{ 0 };
+};
+
+} // utils
+
+} // booleval
+
+#endif // BOOLEVAL_PERFECT_HASH_H
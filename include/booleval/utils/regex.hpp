@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_REGEX_H
+#define BOOLEVAL_REGEX_H
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace booleval {
+
+namespace utils {
+
+/**
+ * class regex
+ *
+ * Represents a regular expression compiled into a deterministic finite automaton,
+ * so that searching a value runs in linear time, without backtracking and without
+ * allocation. The value matches if the expression matches any part of it, unless
+ * anchored by ^ (beginning of the value) or $ (end of the value).
+ *
+ * Supported syntax is a practical subset of ECMAScript and POSIX extended expressions:
+ * literals, ., character classes ([a-z], [^0-9]), escapes (\d, \w, \s and their negations,
+ * \t, \n, \r, \f, \v, \xHH and escaped punctuation), groups ((...) and (?:...)), alternation,
+ * quantifiers (*, +, ?, {m}, {m,} and {m,n}; the lazy ones match the same values)
+ * and the anchors. Back-references, lookarounds and word boundaries are not supported.
+ * The values are matched byte by byte.
+ */
+class regex {
+public:
+    /**
+     * Maximum number of states of the automaton. Expressions requiring more
+     * states, e.g. large counted repetitions of alternatives, are not valid.
+     */
+    static constexpr std::size_t max_states{ 4096 };
+
+    regex() = default;
+    regex(regex&& rhs) = default;
+    regex(regex const& rhs) = default;
+
+    /**
+     * Compiles the regular expression.
+     *
+     * @param pattern Regular expression
+     */
+    regex(std::string_view pattern);
+
+    regex& operator=(regex&& rhs) = default;
+    regex& operator=(regex const& rhs) = default;
+
+    ~regex() = default;
+
+    /**
+     * Checks whether the regular expression has been compiled successfully.
+     *
+     * @return True if the regular expression is valid, otherwise false
+     */
+    [[nodiscard]] bool is_valid() const noexcept {
+        return 0 != states_;
+    }
+
+    /**
+     * Gets the number of states of the automaton.
+     *
+     * @return Number of states
+     */
+    [[nodiscard]] std::size_t states() const noexcept {
+        return states_;
+    }
+
+    /**
+     * Checks whether the regular expression matches the value.
+     *
+     * @param value Value to be checked
+     *
+     * @return True if the regular expression matches the value, otherwise false
+     */
+    [[nodiscard]] bool matches(std::string_view value) const noexcept;
+
+private:
+    /**
+     * The states are numbered so that the states deciding the result on their own,
+     * i.e. the accepting ones and the dead one, come last. The transitions lead to
+     * the offsets of the rows of the table, so that a single comparison per byte
+     * detects the end of the search.
+     */
+    std::array<uint8_t, 256> classes_{};
+    std::size_t class_count_{ 0 };
+    std::vector<uint32_t> transitions_;
+    std::vector<bool> accepting_at_end_;
+    uint32_t start_{ 0 };
+    uint32_t terminal_{ 0 };
+    uint32_t dead_{ 0 };
+    std::size_t states_{ 0 };
+    bool empty_match_{ false };
+};
+
+} // utils
+
+} // booleval
+
+#endif // BOOLEVAL_REGEX_H
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_ROARING_BITMAP_H
+#define BOOLEVAL_ROARING_BITMAP_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <booleval/utils/bitmap.hpp>
+#include <booleval/utils/bit_utils.hpp>
+
+namespace booleval {
+
+namespace utils {
+
+/**
+ * class roaring_bitmap
+ *
+ * Represents a compressed set of 32-bit indices in the roaring layout. The indices
+ * are partitioned by their upper 16 bits into containers, each storing the lower
+ * 16 bits either as a sorted array, while it holds at most array_limit values,
+ * or as a bitmap of 65536 bits otherwise. Sparse results therefore take two bytes
+ * per index, dense ones one bit per row, and the logical operations work
+ * container by container, skipping the ranges missing from either operand.
+ */
+class roaring_bitmap {
+public:
+    /**
+     * Maximum number of values held by an array container.
+     */
+    static constexpr std::size_t array_limit{ 4096 };
+
+    roaring_bitmap() = default;
+    roaring_bitmap(roaring_bitmap&& rhs) = default;
+    roaring_bitmap(roaring_bitmap const& rhs) = default;
+
+    /**
+     * Compresses the bitmap.
+     *
+     * @param bits Bitmap of at most 2^32 bits
+     */
+    explicit roaring_bitmap(bitmap const& bits);
+
+    roaring_bitmap& operator=(roaring_bitmap&& rhs) = default;
+    roaring_bitmap& operator=(roaring_bitmap const& rhs) = default;
+
+    ~roaring_bitmap() = default;
+
+    /**
+     * Adds the index to the set.
+     *
+     * @param index Index to add
+     */
+    void add(uint32_t index);
+
+    /**
+     * Checks whether the index is in the set.
+     *
+     * @param index Index to look up
+     *
+     * @return True if the index is in the set, otherwise false
+     */
+    [[nodiscard]] bool contains(uint32_t index) const noexcept;
+
+    /**
+     * Gets the number of indices in the set.
+     *
+     * @return Number of indices
+     */
+    [[nodiscard]] std::size_t cardinality() const noexcept;
+
+    /**
+     * Checks whether the set is empty.
+     *
+     * @return True if the set is empty, otherwise false
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+    /**
+     * Gets the number of containers, i.e. of the non-empty ranges of 65536 indices.
+     *
+     * @return Number of containers
+     */
+    [[nodiscard]] std::size_t container_count() const noexcept;
+
+    /**
+     * Gets the number of bytes taken by the values of the containers.
+     *
+     * @return Number of bytes
+     */
+    [[nodiscard]] std::size_t size_in_bytes() const noexcept;
+
+    roaring_bitmap& operator&=(roaring_bitmap const& rhs);
+    roaring_bitmap& operator|=(roaring_bitmap const& rhs);
+
+    /**
+     * Removes the indices of another set.
+     *
+     * @param rhs Set of the indices to remove
+     *
+     * @return Reference to this set
+     */
+    roaring_bitmap& and_not(roaring_bitmap const& rhs);
+
+    [[nodiscard]] friend roaring_bitmap operator&(roaring_bitmap lhs, roaring_bitmap const& rhs) {
+        return lhs &= rhs;
+    }
+
+    [[nodiscard]] friend roaring_bitmap operator|(roaring_bitmap lhs, roaring_bitmap const& rhs) {
+        return lhs |= rhs;
+    }
+
+    [[nodiscard]] friend bool operator==(roaring_bitmap const& lhs, roaring_bitmap const& rhs) noexcept {
+        return lhs.containers_ == rhs.containers_;
+    }
+
+    [[nodiscard]] friend bool operator!=(roaring_bitmap const& lhs, roaring_bitmap const& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    /**
+     * Invokes the function with each index of the set, in ascending order.
+     *
+     * @param func Function to invoke with the index
+     */
+    template <typename F>
+    void for_each(F&& func) const;
+
+    /**
+     * Converts the set into a selection vector.
+     *
+     * @return Ascending indices of the set
+     */
+    [[nodiscard]] std::vector<std::size_t> indices() const;
+
+    /**
+     * Decompresses the set into a bitmap.
+     *
+     * @param size Number of bits of the bitmap, the indices not below it are dropped
+     *
+     * @return Bitmap of the set
+     */
+    [[nodiscard]] bitmap to_bitmap(std::size_t size) const;
+
+private:
+    /**
+     * struct container
+     *
+     * Represents the lower 16 bits of the indices sharing the upper 16 bits,
+     * stored either as sorted values or, when there are more than
+     * array_limit of them, as 1024 words of bits.
+     */
+    struct container {
+        uint16_t key{ 0 };
+        uint32_t cardinality{ 0 };
+        std::vector<uint16_t> values;
+        std::vector<uint64_t> bits;
+
+        [[nodiscard]] bool is_bitmap() const noexcept {
+            return !bits.empty();
+        }
+
+        [[nodiscard]] friend bool operator==(container const& lhs, container const& rhs) noexcept {
+            return lhs.key == rhs.key && lhs.values == rhs.values && lhs.bits == rhs.bits;
+        }
+    };
+
+    static void to_bitmap_container(container& c);
+    static void normalize(container& c);
+
+    [[nodiscard]] static container intersect(container const& lhs, container const& rhs);
+    [[nodiscard]] static container unite(container const& lhs, container const& rhs);
+    [[nodiscard]] static container subtract(container const& lhs, container const& rhs);
+
+private:
+    std::vector<container> containers_;
+};
+
+template <typename F>
+void roaring_bitmap::for_each(F&& func) const {
+    for (auto const& c : containers_) {
+        auto const high = static_cast<uint32_t>(c.key) << 16;
+        if (c.is_bitmap()) {
+            for (std::size_t word = 0; word < c.bits.size(); ++word) {
+                for (auto b = c.bits[word]; 0 != b; b &= b - 1) {
+                    func(high | static_cast<uint32_t>(word * 64 + count_trailing_zeros(b)));
+                }
+            }
+        } else {
+            for (auto const value : c.values) {
+                func(high | value);
+            }
+        }
+    }
+}
+
+} // utils
+
+} // booleval
+
+#endif // BOOLEVAL_ROARING_BITMAP_H
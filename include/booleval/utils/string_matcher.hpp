@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_STRING_MATCHER_H
+#define BOOLEVAL_STRING_MATCHER_H
+
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+#include <booleval/utils/regex.hpp>
+
+namespace booleval {
+
+namespace utils {
+
+/**
+ * enum class match_kind
+ *
+ * Represents the kind of the string matching.
+ */
+enum class [[nodiscard]] match_kind : uint8_t {
+    prefix,
+    suffix,
+    substring,
+    like,
+    regex
+};
+
+/**
+ * class string_matcher
+ *
+ * Represents a string pattern compiled once so that matching a value neither
+ * allocates nor analyzes the pattern again. The pattern is split into literal
+ * segments, which are either anchored at the beginning or the end of the value
+ * or searched for by the Boyer-Moore-Horspool algorithm, from left to right.
+ *
+ * LIKE patterns follow SQL: % matches any sequence of characters, _ matches any
+ * single character and backslash escapes the following character. Regular
+ * expressions are compiled into an automaton (see utils::regex). The other
+ * kinds take the pattern literally.
+ */
+class string_matcher {
+public:
+    string_matcher() = default;
+    string_matcher(string_matcher&& rhs) = default;
+    string_matcher(string_matcher const& rhs) = default;
+
+    /**
+     * Compiles the pattern.
+     *
+     * @param kind    Kind of the matching
+     * @param pattern Pattern to be matched
+     */
+    string_matcher(match_kind kind, std::string_view pattern);
+
+    string_matcher& operator=(string_matcher&& rhs) = default;
+    string_matcher& operator=(string_matcher const& rhs) = default;
+
+    ~string_matcher() = default;
+
+    /**
+     * Checks whether the pattern has been compiled successfully, which fails
+     * for invalid regular expressions only.
+     *
+     * @return True if the pattern is valid, otherwise false
+     */
+    [[nodiscard]] bool is_valid() const noexcept {
+        return match_kind::regex != kind_ || regex_.is_valid();
+    }
+
+    /**
+     * Checks whether the value matches the pattern.
+     *
+     * @param value Value to be checked
+     *
+     * @return True if the value matches the pattern, otherwise false
+     */
+    [[nodiscard]] bool matches(std::string_view value) const noexcept;
+
+private:
+    struct segment {
+        std::string text;
+        std::string wildcards;
+        std::array<uint32_t, 256> shift{};
+    };
+
+    [[nodiscard]] static bool equal_at(std::string_view value, std::size_t position, segment const& s) noexcept;
+    [[nodiscard]] static std::size_t find(std::string_view value, segment const& s) noexcept;
+
+    void add_segment(std::string text, std::string wildcards);
+
+private:
+    match_kind kind_{ match_kind::substring };
+    utils::regex regex_;
+    std::vector<segment> segments_;
+    bool anchored_begin_{ false };
+    bool anchored_end_{ false };
+};
+
+} // utils
+
+} // booleval
+
+#endif // BOOLEVAL_STRING_MATCHER_H
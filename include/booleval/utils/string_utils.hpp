@@ -31,14 +31,18 @@
 #define BOOLEVAL_STRING_UTILS_H
 
 #include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <limits>
 #include <string>
+#include <cstdint>
 #include <numeric>
-#include <sstream>
 #include <charconv>
 #include <optional>
 #include <algorithm>
 #include <string_view>
+#include <type_traits>
 
 namespace booleval {
 
@@ -220,122 +224,562 @@ template <typename InputIt>
 }
 
 /**
- * Converts from string view to arithmetic value.
- * If value cannot be parsed, std::nullopt is returned.
+ * Floating point versions of std::from_chars and std::to_chars are used
+ * whenever the standard library provides them (MSVC, libstdc++ 11+).
+ * Otherwise, the bundled implementation from the detail namespace is used.
+ * Defining BOOLEVAL_BUNDLED_FLOAT_CHARCONV forces the bundled implementation.
+ */
+#if defined(_MSC_VER) || (defined(__cpp_lib_to_chars) && !defined(BOOLEVAL_BUNDLED_FLOAT_CHARCONV))
+#define BOOLEVAL_STD_FLOAT_CHARCONV 1
+#endif
+
+/**
+ * Maximum number of characters needed to represent an arithmetic value.
+ * Floating point values are represented in fixed notation, so they need
+ * space for sign, leading zero and decimal point on top of the digits
+ * of the largest value or of the smallest subnormal one.
+ */
+template <typename T>
+constexpr std::size_t max_chars = std::is_floating_point_v<T>
+    ? 3 + std::numeric_limits<T>::max_digits10 + std::max(std::numeric_limits<T>::max_exponent10,
+                                                          std::numeric_limits<T>::max_digits10 - std::numeric_limits<T>::min_exponent10)
+    : std::numeric_limits<T>::digits10 + 2;  // +1 for minus, +1 for digits10
+
+namespace detail {
+
+/**
+ * struct float_traits
  *
- * NOTE: Floating point version of std::from_chars is
- * implemented only on MSVC and not on GCC/CLANG.
+ * Represents the limits within which a decimal number can be converted
+ * to the floating point value exactly, i.e. with a single rounding
+ * (Clinger's fast path).
+ */
+template <typename T>
+struct float_traits {
+    static constexpr uint64_t max_exact_mantissa{ uint64_t{ 1 } << 53 };
+    static constexpr int max_exact_exponent{ 22 };
+};
+
+template <>
+struct float_traits<float> {
+    static constexpr uint64_t max_exact_mantissa{ uint64_t{ 1 } << 24 };
+    static constexpr int max_exact_exponent{ 10 };
+};
+
+constexpr std::array<double, 23> exact_powers_of_ten = {{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+}};
+
+/**
+ * Maximum number of significant digits passed to the C library by the slow
+ * path of the parser. Correct rounding of a double never depends on more
+ * than 767 digits, so the remaining ones only matter by being zero or not.
+ */
+constexpr std::size_t max_significant_digits{ 768 };
+
+/**
+ * Converts the digits of the decimal string to the floating point value by the
+ * C library. The string has no decimal point, so the conversion does not depend
+ * on the decimal point of the C locale.
+ */
+template <typename T>
+[[nodiscard]] T convert_decimal(char const* digits) noexcept {
+    if constexpr (std::is_same_v<T, float>) {
+        return std::strtof(digits, nullptr);
+    } else if constexpr (std::is_same_v<T, double>) {
+        return std::strtod(digits, nullptr);
+    } else {
+        return std::strtold(digits, nullptr);
+    }
+}
+
+/**
+ * Parses the number which is out of the exactly representable range. Its
+ * significant digits are copied into a buffer on the stack as an integer
+ * followed by the exponent, e.g. 1234e-3 for 1.234, and converted by the
+ * C library.
  *
- * @param strv String view to convert to arithmetic value
+ * @param first    Beginning of the number without the sign
+ * @param last     End of the number, i.e. of the parsed characters
+ * @param negative Whether the number is negative
  *
- * @return Optional value
+ * @return Optional floating point value, nothing if the value overflows
+ */
+template <typename T>
+[[nodiscard]] std::optional<T> parse_decimal(char const* first, char const* const last, bool const negative) noexcept {
+    std::array<char, max_significant_digits + 16> buffer;
+    std::size_t size{ 0 };
+    if (negative) {
+        buffer[size++] = '-';
+    }
+
+    auto const digits_begin = size;
+    int64_t exponent{ 0 };
+    bool fraction{ false };
+    bool sticky{ false };
+    for (; first != last && 'e' != *first && 'E' != *first; ++first) {
+        if ('.' == *first) {
+            fraction = true;
+            continue;
+        }
+
+        if (fraction) {
+            --exponent;
+        }
+
+        if (size == digits_begin && '0' == *first) {
+            continue;
+        }
+
+        if (size - digits_begin < max_significant_digits - 1) {
+            buffer[size++] = *first;
+        } else {
+            // Dropped digits only decide whether the value is above the kept ones
+            sticky = sticky || '0' != *first;
+            ++exponent;
+        }
+    }
+
+    if (sticky) {
+        buffer[size++] = '1';
+        --exponent;
+    }
+
+    if (size == digits_begin) {
+        return negative ? -T{ 0 } : T{ 0 };
+    }
+
+    if (first != last) {
+        ++first;
+        bool const negative_exponent = '-' == *first;
+        if ('-' == *first || '+' == *first) {
+            ++first;
+        }
+
+        int64_t explicit_exponent{ 0 };
+        for (; first != last; ++first) {
+            if (explicit_exponent < 100000) {
+                explicit_exponent = explicit_exponent * 10 + (*first - '0');
+            }
+        }
+        exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+    }
+
+    buffer[size++] = 'e';
+    auto const result = std::to_chars(buffer.data() + size, buffer.data() + buffer.size() - 1, exponent);
+    *result.ptr = '\0';
+
+    auto const value = convert_decimal<T>(buffer.data());
+    if (std::isinf(value)) {
+        return std::nullopt;
+    }
+
+    return value;
+}
+
+/**
+ * Parses floating point value from the string view without allocating
+ * and independently of the global locale. Values whose mantissa and
+ * exponent fit into the exactly representable range are computed directly,
+ * while the rest (long mantissas and large exponents) are converted by the
+ * C library from a copy of their digits on the stack (see parse_decimal).
+ * Values that overflow are not parsed.
+ *
+ * @param strv   String view to parse
+ * @param length Number of characters forming the parsed value
+ *
+ * @return Optional floating point value
  */
-#if defined(__GNUC__) || defined(__clang__)
 template <typename T,
-          typename std::enable_if_t<std::is_integral_v<T>>* = nullptr>
-#elif defined(_MSC_VER)
+          typename std::enable_if_t<std::is_floating_point_v<T>>* = nullptr>
+[[nodiscard]] std::optional<T> parse_floating_point(std::string_view strv, std::size_t& length) {
+    length = 0;
+    auto first = strv.data();
+    auto const last = strv.data() + strv.size();
+
+    bool const negative = first != last && '-' == *first;
+    if (negative) {
+        ++first;
+    }
+
+    uint64_t mantissa{ 0 };
+    int exponent{ 0 };
+    std::size_t digits{ 0 };
+    bool truncated{ false };
+
+    auto const accumulate = [&](char const c) {
+        if (mantissa < uint64_t{ 1000000000000000000 }) {  // 10^18
+            mantissa = mantissa * 10 + static_cast<uint64_t>(c - '0');
+            return true;
+        }
+        truncated = truncated || '0' != c;
+        return false;
+    };
+
+    for (; first != last && '0' <= *first && *first <= '9'; ++first, ++digits) {
+        if (!accumulate(*first)) {
+            ++exponent;
+        }
+    }
+
+    if (first != last && '.' == *first) {
+        for (++first; first != last && '0' <= *first && *first <= '9'; ++first, ++digits) {
+            if (accumulate(*first)) {
+                --exponent;
+            }
+        }
+    }
+
+    if (0 == digits) {
+        auto const rest = std::string_view(first, last - first);
+        if ("inf" == rest.substr(0, 3)) {
+            auto const infinity = std::numeric_limits<T>::infinity();
+            length = static_cast<std::size_t>(first - strv.data()) + 3;
+            return negative ? -infinity : infinity;
+        } else if ("nan" == rest.substr(0, 3)) {
+            length = static_cast<std::size_t>(first - strv.data()) + 3;
+            return std::numeric_limits<T>::quiet_NaN();
+        }
+        return std::nullopt;
+    }
+
+    if (first != last && ('e' == *first || 'E' == *first)) {
+        auto exp_first = std::next(first);
+        bool const negative_exponent = exp_first != last && '-' == *exp_first;
+        if (exp_first != last && ('-' == *exp_first || '+' == *exp_first)) {
+            ++exp_first;
+        }
+
+        if (exp_first != last && '0' <= *exp_first && *exp_first <= '9') {
+            int explicit_exponent{ 0 };
+            for (first = exp_first; first != last && '0' <= *first && *first <= '9'; ++first) {
+                if (explicit_exponent < 100000) {
+                    explicit_exponent = explicit_exponent * 10 + (*first - '0');
+                }
+            }
+            exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+        }
+    }
+
+    length = static_cast<std::size_t>(first - strv.data());
+    auto const parsed_last = first;
+
+    using traits = float_traits<T>;
+    if (!truncated &&
+        mantissa <= traits::max_exact_mantissa &&
+        -traits::max_exact_exponent <= exponent &&
+        exponent <= traits::max_exact_exponent) {
+        auto value = static_cast<T>(mantissa);
+        auto const power = static_cast<T>(exact_powers_of_ten[exponent < 0 ? -exponent : exponent]);
+        value = exponent < 0 ? value / power : value * power;
+        return negative ? -value : value;
+    }
+
+    auto const value = parse_decimal<T>(strv.data() + (negative ? 1 : 0), parsed_last, negative);
+    if (!value) {
+        length = 0;
+    }
+
+    return value;
+}
+
+/**
+ * Parses floating point value from the string view without allocating
+ * and independently of the global locale.
+ *
+ * @param strv String view to parse
+ *
+ * @return Optional floating point value
+ */
 template <typename T,
-          typename std::enable_if_t<std::is_arithmetic_v<T>>* = nullptr>
-#endif
-[[nodiscard]] std::optional<T> from_chars(std::string_view strv) {
-    T value{};
+          typename std::enable_if_t<std::is_floating_point_v<T>>* = nullptr>
+[[nodiscard]] std::optional<T> parse_floating_point(std::string_view strv) {
+    std::size_t length{ 0 };
+    return parse_floating_point<T>(strv, length);
+}
 
-    auto const result = std::from_chars(
-        strv.data(),
-        strv.data() + strv.size(),
-        value
-    );
+/**
+ * Replaces the decimal point of the number formatted by snprintf with '.'.
+ * Any characters other than the sign, the digits and the exponent form the
+ * decimal point of the C locale.
+ *
+ * @param number Formatted number
+ * @param length Length of the formatted number
+ *
+ * @return Length of the number with the decimal point replaced
+ */
+[[nodiscard]] inline int normalize_decimal_point(char* const number, int const length) noexcept {
+    int size{ 0 };
+    bool decimal_point{ false };
+    for (int i = 0; i < length; ++i) {
+        auto const c = number[i];
+        if (('0' <= c && c <= '9') || '-' == c || '+' == c || 'e' == c) {
+            number[size++] = c;
+            decimal_point = false;
+        } else if (!decimal_point) {
+            number[size++] = '.';
+            decimal_point = true;
+        }
+    }
+    return size;
+}
 
-    if (std::errc() == result.ec) {
-        return value;
+/**
+ * Formats floating point value into the shortest representation in fixed
+ * notation which parses back to the same value, i.e. the same as
+ * std::to_chars with std::chars_format::fixed. The significant digits are
+ * formatted by snprintf in scientific notation, whose decimal point, which
+ * depends on the C locale and may take several bytes, is replaced by '.',
+ * so the representation is the same no matter what the global locale is.
+ * Neither the formatting nor the parsing of the candidates allocates.
+ *
+ * @param first Beginning of the output buffer
+ * @param last  End of the output buffer
+ * @param value Floating point value to format
+ *
+ * @return Pointer past the last written character or nullptr on failure
+ */
+template <typename T,
+          typename std::enable_if_t<std::is_floating_point_v<T>>* = nullptr>
+[[nodiscard]] char* format_floating_point(char* first, char* last, T const value) noexcept {
+    if (std::isnan(value) || std::isinf(value)) {
+        std::string_view const special = std::isnan(value) ? "nan" : (value < 0 ? "-inf" : "inf");
+        if (last - first < static_cast<std::ptrdiff_t>(special.size())) {
+            return nullptr;
+        }
+        return std::copy(std::begin(special), std::end(special), first);
     }
 
-    return std::nullopt;
+    // Decimals of up to digits10 digits parse back to the same normal value, so
+    // the shorter candidates are those with trailing zeros, which are removed below
+    auto const is_normal = std::numeric_limits<T>::min() <= std::abs(value);
+    std::array<char, std::numeric_limits<T>::max_digits10 + 16> buffer{};
+    int length{ 0 };
+    for (auto precision = is_normal ? std::numeric_limits<T>::digits10 - 1 : 0;
+         precision < std::numeric_limits<T>::max_digits10;
+         ++precision) {
+        if constexpr (std::is_same_v<T, long double>) {
+            length = std::snprintf(buffer.data(), buffer.size(), "%.*Le", precision, value);
+        } else {
+            length = std::snprintf(buffer.data(), buffer.size(), "%.*e", precision, static_cast<double>(value));
+        }
+
+        if (length <= 0 || static_cast<std::size_t>(length) >= buffer.size()) {
+            return nullptr;
+        }
+
+        length = normalize_decimal_point(buffer.data(), length);
+
+        auto const parsed = parse_floating_point<T>(std::string_view(buffer.data(), length));
+        if (parsed && parsed.value() == value) {
+            break;
+        }
+    }
+
+    // Splits [-]d.ddde[+-]xx into the significant digits and the decimal exponent
+    std::array<char, std::numeric_limits<T>::max_digits10 + 1> digits{};
+    int count{ 0 };
+    int position{ 0 };
+    bool const negative = '-' == buffer[0];
+    for (position = negative ? 1 : 0; 'e' != buffer[position]; ++position) {
+        if ('.' != buffer[position]) {
+            digits[count++] = buffer[position];
+        }
+    }
+
+    int exponent{ 0 };
+    std::from_chars(buffer.data() + position + ('+' == buffer[position + 1] ? 2 : 1), buffer.data() + length, exponent);
+
+    while (count > 1 && '0' == digits[count - 1]) {
+        --count;
+    }
+
+    // Integers take the same number of digits whichever of them parse back to
+    // the value, so the value is written exactly, as std::to_chars does
+    auto const fraction_digits = std::max(count - exponent - 1, 0);
+    if (0 == fraction_digits) {
+        if constexpr (std::is_same_v<T, long double>) {
+            length = std::snprintf(first, static_cast<std::size_t>(last - first), "%.0Lf", value);
+        } else {
+            length = std::snprintf(first, static_cast<std::size_t>(last - first), "%.0f", static_cast<double>(value));
+        }
+
+        if (length <= 0 || length >= last - first) {
+            return nullptr;
+        }
+
+        return first + length;
+    }
+
+    // Integer part is followed by the fraction, whose leading zeros precede the digits
+    auto const integer_digits = std::max(exponent + 1, 1);
+    auto const size = (negative ? 1 : 0) + integer_digits + (0 == fraction_digits ? 0 : 1 + fraction_digits);
+    if (last - first < size) {
+        return nullptr;
+    }
+
+    if (negative) {
+        *first++ = '-';
+    }
+
+    for (auto weight = std::max(exponent, 0); weight > -1 - fraction_digits; --weight) {
+        if (-1 == weight) {
+            *first++ = '.';
+        }
+
+        auto const index = exponent - weight;
+        *first++ = 0 <= index && index < count ? digits[index] : '0';
+    }
+
+    return first;
 }
 
+} // detail
+
 /**
  * Converts from string view to arithmetic value.
  * If value cannot be parsed, std::nullopt is returned.
  *
- * NOTE: Floating point version of std::from_chars is
- * implemented only on MSVC and not on GCC/CLANG.
+ * @param strv   String view to convert to arithmetic value
+ * @param length Number of characters forming the parsed value
+ *
+ * @return Optional value
+ */
+template <typename T,
+          typename std::enable_if_t<std::is_arithmetic_v<T>>* = nullptr>
+[[nodiscard]] std::optional<T> from_chars(std::string_view strv, std::size_t& length) {
+#ifndef BOOLEVAL_STD_FLOAT_CHARCONV
+    if constexpr (std::is_floating_point_v<T>) {
+        return detail::parse_floating_point<T>(strv, length);
+    } else
+#endif
+    {
+        T value{};
+
+        auto const result = std::from_chars(
+            strv.data(),
+            strv.data() + strv.size(),
+            value
+        );
+
+        if (std::errc() == result.ec) {
+            length = static_cast<std::size_t>(result.ptr - strv.data());
+            return value;
+        }
+
+        length = 0;
+        return std::nullopt;
+    }
+}
+
+/**
+ * Converts from string view to arithmetic value.
+ * If value cannot be parsed, std::nullopt is returned.
  *
  * @param strv String view to convert to arithmetic value
  *
  * @return Optional value
  */
-#if defined(__GNUC__) || defined(__clang__)
 template <typename T,
-          typename std::enable_if_t<std::is_floating_point_v<T>>* = nullptr>
+          typename std::enable_if_t<std::is_arithmetic_v<T>>* = nullptr>
 [[nodiscard]] std::optional<T> from_chars(std::string_view strv) {
-    T value{};
-
-    std::stringstream ss;
-    ss << strv;
-    ss >> value;
+    std::size_t length{ 0 };
+    return from_chars<T>(strv, length);
+}
 
-    if (ss.fail()) {
-        return std::nullopt;
+/**
+ * Converts from string view to arithmetic value, requiring the whole
+ * string view to form the value.
+ * If value cannot be parsed, std::nullopt is returned.
+ *
+ * @param strv String view to convert to arithmetic value
+ *
+ * @return Optional value
+ */
+template <typename T,
+          typename std::enable_if_t<std::is_arithmetic_v<T>>* = nullptr>
+[[nodiscard]] std::optional<T> from_chars_exact(std::string_view strv) {
+    std::size_t length{ 0 };
+    auto const value = from_chars<T>(strv, length);
+    if (value && length == strv.size()) {
+        return value;
     }
 
-    return value;
+    return std::nullopt;
 }
-#endif
 
 /**
- * Converts from arithmetic value to string.
- *
- * NOTE: Floating point version of std::to_chars is
- * implemented only on MSVC and not on GCC/CLANG.
+ * Converts from arithmetic value to its shortest string representation
+ * without allocating. Floating point values are represented in fixed
+ * notation, i.e. never with an exponent, so that the representation is
+ * the same on all platforms and equal values compare equal as strings
+ * with the literals written in the usual way, e.g. 0.0001.
  *
- * @param value Arithmetic value to convert to string
+ * @param first Beginning of the output buffer
+ * @param last  End of the output buffer
+ * @param value Arithmetic value to convert
  *
- * @return String representation of arithmetic value
+ * @return Pointer past the last written character or nullptr on failure
  */
-#if defined(__GNUC__) || defined(__clang__)
-template <typename T,
-          typename std::enable_if_t<std::is_integral_v<T>>* = nullptr>
-#elif defined(_MSC_VER)
 template <typename T,
           typename std::enable_if_t<std::is_arithmetic_v<T>>* = nullptr>
+[[nodiscard]] char* to_chars(char* first, char* last, T const value) noexcept {
+#ifndef BOOLEVAL_STD_FLOAT_CHARCONV
+    if constexpr (std::is_floating_point_v<T>) {
+        return detail::format_floating_point<T>(first, last, value);
+    } else
 #endif
-[[nodiscard]] std::string to_chars(T const value) {
-    constexpr std::size_t buffer_size = std::numeric_limits<T>::digits10 + 2;  // +1 for minus, +1 for digits10
-    std::array<char, buffer_size> buffer;
+    {
+        std::to_chars_result result;
+        if constexpr (std::is_floating_point_v<T>) {
+            result = std::to_chars(first, last, value, std::chars_format::fixed);
+        } else {
+            result = std::to_chars(first, last, value);
+        }
 
-    auto const result = std::to_chars(
-        buffer.data(),
-        buffer.data() + buffer.size(),
-        value
-    );
+        if (std::errc() == result.ec) {
+            return result.ptr;
+        }
+
+        return nullptr;
+    }
+}
 
-    if (std::errc() == result.ec) {
-        return std::string(buffer.data(), result.ptr - buffer.data());
+/**
+ * Converts from arithmetic value to string view pointing to the
+ * specified buffer.
+ *
+ * @param buffer Buffer to write the string representation to
+ * @param value  Arithmetic value to convert
+ *
+ * @return String view representation of arithmetic value
+ */
+template <typename T,
+          std::size_t N,
+          typename std::enable_if_t<std::is_arithmetic_v<T>>* = nullptr>
+[[nodiscard]] std::string_view to_chars(std::array<char, N>& buffer, T const value) noexcept {
+    auto const end = to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    if (nullptr == end) {
+        return {};
     }
 
-    return {};
+    return std::string_view(buffer.data(), end - buffer.data());
 }
 
 /**
  * Converts from arithmetic value to string.
  *
- * NOTE: Floating point version of std::to_chars is
- * implemented only on MSVC and not on GCC/CLANG.
- *
  * @param value Arithmetic value to convert to string
  *
  * @return String representation of arithmetic value
  */
-#if defined(__GNUC__) || defined(__clang__)
 template <typename T,
-          typename std::enable_if_t<std::is_floating_point_v<T>>* = nullptr>
+          typename std::enable_if_t<std::is_arithmetic_v<T>>* = nullptr>
 [[nodiscard]] std::string to_chars(T const value) {
-    auto str = std::to_string(value);
-    std::string_view strv{ str.c_str(), str.size() };
-    str = rtrim(strv, '0');
-    return str;
+    std::array<char, max_chars<T>> buffer;
+    return std::string(to_chars(buffer, value));
 }
-#endif
 
 } // utils
 
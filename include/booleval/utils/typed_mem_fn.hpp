@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_TYPED_MEM_FN_H
+#define BOOLEVAL_TYPED_MEM_FN_H
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+#include <booleval/token/token_type.hpp>
+#include <booleval/utils/string_utils.hpp>
+#include <booleval/utils/string_matcher.hpp>
+
+namespace booleval {
+
+namespace utils {
+
+/**
+ * class typed_mem_fn
+ *
+ * Represents a member function or a data member of a class known at compile time.
+ * Unlike any_mem_fn, neither the object nor the field value is type-erased: the
+ * member pointer is stored as it is and the predicates on the field are compiled
+ * into functions instantiated for the type of the member, which compare the value
+ * returned by the member with the literal parsed in advance.
+ *
+ * Member functions taking a bool& is_valid parameter are supported as well.
+ * If is_valid is set to false, the field value is null.
+ */
+template <typename T>
+class typed_mem_fn {
+    using storage = std::aligned_storage_t<sizeof(void (T::*)()), alignof(void (T::*)())>;
+
+public:
+    struct predicate;
+    using function = bool (*)(predicate const&, T const&);
+
+    /**
+     * struct predicate
+     *
+     * Represents a relational operation, null test or string matching operation
+     * on the field compiled for the type of the member and the literal.
+     */
+    struct predicate {
+        function evaluate{ &never };
+        storage member{};
+        std::string_view literal;
+        double number{ 0 };
+        uint64_t integer{ 0 };
+        string_matcher const* matcher{ nullptr };
+    };
+
+    typed_mem_fn() = default;
+    typed_mem_fn(typed_mem_fn&& rhs) = default;
+    typed_mem_fn(typed_mem_fn const& rhs) = default;
+
+    template <typename Ret>
+    typed_mem_fn(Ret (T::*m)() const) {
+        store<getter<Ret>>(m);
+    }
+
+    template <typename Ret>
+    typed_mem_fn(Ret (T::*m)(bool&) const) {
+        store<validated_getter<Ret>>(m);
+    }
+
+    template <typename Ret,
+              typename std::enable_if_t<!std::is_function_v<Ret>>* = nullptr>
+    typed_mem_fn(Ret T::*m) {
+        store<data_member<Ret>>(m);
+    }
+
+    typed_mem_fn& operator=(typed_mem_fn&& rhs) = default;
+    typed_mem_fn& operator=(typed_mem_fn const& rhs) = default;
+
+    ~typed_mem_fn() = default;
+
+    /**
+     * Compiles the predicate on the field.
+     *
+     * @param op      Relational operation, null test or string matching operation
+     * @param literal Literal the field value is compared with
+     * @param matcher Compiled pattern of the string matching operation, if any
+     *
+     * @return Compiled predicate, which is never satisfied if the operation is not supported
+     */
+    [[nodiscard]] predicate compile(token::token_type const op, std::string_view const literal,
+                                    string_matcher const* matcher) const {
+        if (nullptr == compile_) {
+            return {};
+        }
+
+        return compile_(member_, op, literal, matcher);
+    }
+
+private:
+    using compiler = predicate (*)(storage const&, token::token_type, std::string_view, string_matcher const*);
+
+    template <typename Ret>
+    struct getter {
+        using pointer = Ret (T::*)() const;
+        using value_type = std::decay_t<Ret>;
+        static constexpr bool nullable{ false };
+
+        [[nodiscard]] static Ret read(storage const& member, T const& obj, bool&) {
+            return (obj.*load<pointer>(member))();
+        }
+    };
+
+    template <typename Ret>
+    struct validated_getter {
+        using pointer = Ret (T::*)(bool&) const;
+        using value_type = std::decay_t<Ret>;
+        static constexpr bool nullable{ true };
+
+        [[nodiscard]] static Ret read(storage const& member, T const& obj, bool& is_valid) {
+            return (obj.*load<pointer>(member))(is_valid);
+        }
+    };
+
+    template <typename Ret>
+    struct data_member {
+        using pointer = Ret T::*;
+        using value_type = std::decay_t<Ret>;
+        static constexpr bool nullable{ false };
+
+        [[nodiscard]] static Ret const& read(storage const& member, T const& obj, bool&) {
+            return obj.*load<pointer>(member);
+        }
+    };
+
+    template <typename Access, typename Pointer>
+    void store(Pointer const m) noexcept {
+        static_assert(sizeof(Pointer) <= sizeof(storage), "Member pointer does not fit the storage");
+        static_assert(std::is_arithmetic_v<typename Access::value_type> ||
+                      std::is_constructible_v<std::string_view, typename Access::value_type const&>,
+                      "Member has to be of arithmetic or string type");
+        std::memcpy(&member_, &m, sizeof(m));
+        compile_ = &compile_for<Access>;
+    }
+
+    template <typename Pointer>
+    [[nodiscard]] static Pointer load(storage const& member) noexcept {
+        Pointer m;
+        std::memcpy(&m, &member, sizeof(m));
+        return m;
+    }
+
+    template <typename Access>
+    [[nodiscard]] static predicate compile_for(storage const& member, token::token_type op,
+                                               std::string_view literal, string_matcher const* matcher);
+
+    template <typename Access, typename Op>
+    [[nodiscard]] static function select_comparison(std::string_view literal, double& number);
+
+    template <typename Access, typename Op>
+    [[nodiscard]] static function select_equality(std::string_view literal, predicate& p);
+
+    [[nodiscard]] static bool never(predicate const&, T const&) noexcept {
+        return false;
+    }
+
+    template <typename Access, bool IsNull>
+    [[nodiscard]] static bool null_test(predicate const& p, T const& obj) {
+        auto is_valid = !Access::nullable;
+        [[maybe_unused]] auto const& value = Access::read(p.member, obj, is_valid);
+        return IsNull != is_valid;
+    }
+
+    /**
+     * Compares the string value with the literal.
+     */
+    template <typename Access, typename Op>
+    [[nodiscard]] static bool compare_string(predicate const& p, T const& obj) {
+        auto is_valid = !Access::nullable;
+        auto const& value = Access::read(p.member, obj, is_valid);
+        return is_valid && Op{}(std::string_view(value), p.literal);
+    }
+
+    /**
+     * Compares the arithmetic value with the number parsed from the literal.
+     */
+    template <typename Access, typename Op>
+    [[nodiscard]] static bool compare_number(predicate const& p, T const& obj) {
+        auto is_valid = !Access::nullable;
+        auto const value = Access::read(p.member, obj, is_valid);
+        return is_valid && Op{}(static_cast<double>(value), p.number);
+    }
+
+    /**
+     * Compares the integral value with the integer parsed from the literal.
+     */
+    template <typename Access, typename Op>
+    [[nodiscard]] static bool compare_integer(predicate const& p, T const& obj) {
+        using value_type = typename Access::value_type;
+
+        auto is_valid = !Access::nullable;
+        auto const value = Access::read(p.member, obj, is_valid);
+        return is_valid && Op{}(static_cast<value_type>(value), static_cast<value_type>(p.integer));
+    }
+
+    /**
+     * Compares the arithmetic value with the literal through its string representation,
+     * for the types whose representation does not convert to double exactly.
+     */
+    template <typename Access, typename Op>
+    [[nodiscard]] static bool compare_formatted(predicate const& p, T const& obj) {
+        auto is_valid = !Access::nullable;
+        auto const value = Access::read(p.member, obj, is_valid);
+        if (!is_valid) {
+            return false;
+        }
+
+        std::array<char, max_chars<typename Access::value_type>> buffer;
+        auto const text = to_chars(buffer, value);
+        if constexpr (std::is_same_v<Op, std::equal_to<>> || std::is_same_v<Op, std::not_equal_to<>>) {
+            return Op{}(text, p.literal);
+        } else {
+            auto const number = from_chars<double>(text);
+            return number && Op{}(*number, p.number);
+        }
+    }
+
+    /**
+     * Checks whether the value is non-null, for the comparisons decided by the literal alone.
+     */
+    template <typename Access>
+    [[nodiscard]] static bool is_not_null(predicate const& p, T const& obj) {
+        return null_test<Access, false>(p, obj);
+    }
+
+    template <typename Access>
+    [[nodiscard]] static bool match(predicate const& p, T const& obj) {
+        auto is_valid = !Access::nullable;
+        auto const& value = Access::read(p.member, obj, is_valid);
+        if (!is_valid) {
+            return false;
+        }
+
+        if constexpr (std::is_arithmetic_v<typename Access::value_type>) {
+            std::array<char, max_chars<typename Access::value_type>> buffer;
+            return p.matcher->matches(to_chars(buffer, value));
+        } else {
+            return p.matcher->matches(std::string_view(value));
+        }
+    }
+
+private:
+    storage member_{};
+    compiler compile_{ nullptr };
+};
+
+template <typename T>
+template <typename Access, typename Op>
+typename typed_mem_fn<T>::function typed_mem_fn<T>::select_equality(std::string_view const literal, predicate& p) {
+    using value_type = typename Access::value_type;
+    constexpr bool is_equal = std::is_same_v<Op, std::equal_to<>>;
+
+    if constexpr (!std::is_arithmetic_v<value_type>) {
+        return &compare_string<Access, Op>;
+    } else if constexpr (std::is_same_v<value_type, double> || (std::is_integral_v<value_type> && !std::is_same_v<value_type, bool>)) {
+        // Values are equal to the literal if their shortest representations are,
+        // which is the case only for the literals in the shortest representation
+        auto const parsed = from_chars_exact<value_type>(literal);
+        std::array<char, max_chars<value_type>> buffer;
+        if (!parsed || to_chars(buffer, *parsed) != literal) {
+            return is_equal ? &never : &is_not_null<Access>;
+        }
+
+        if constexpr (std::is_floating_point_v<value_type>) {
+            // Zeros of different signs are equal, but represented differently
+            if (std::isnan(*parsed) || 0 == *parsed) {
+                return &compare_formatted<Access, Op>;
+            }
+
+            p.number = *parsed;
+            return &compare_number<Access, Op>;
+        } else {
+            p.integer = static_cast<uint64_t>(*parsed);
+            return &compare_integer<Access, Op>;
+        }
+    } else {
+        return &compare_formatted<Access, Op>;
+    }
+}
+
+template <typename T>
+template <typename Access, typename Op>
+typename typed_mem_fn<T>::function typed_mem_fn<T>::select_comparison(std::string_view const literal, double& number) {
+    using value_type = typename Access::value_type;
+
+    if constexpr (!std::is_arithmetic_v<value_type>) {
+        return &compare_string<Access, Op>;
+    } else {
+        auto const parsed = from_chars<double>(literal);
+        if (!parsed) {
+            return &never;
+        }
+
+        number = *parsed;
+        if constexpr (std::is_same_v<value_type, double> || (std::is_integral_v<value_type> && !std::is_same_v<value_type, bool>)) {
+            // The shortest representation of a double converts back to the same value
+            // and the integers are converted to the nearest double either way
+            return &compare_number<Access, Op>;
+        } else {
+            return &compare_formatted<Access, Op>;
+        }
+    }
+}
+
+template <typename T>
+template <typename Access>
+typename typed_mem_fn<T>::predicate typed_mem_fn<T>::compile_for(storage const& member, token::token_type const op,
+                                                                 std::string_view const literal, string_matcher const* matcher) {
+    predicate p;
+    p.member = member;
+    p.literal = literal;
+    p.matcher = matcher;
+
+    switch (op) {
+    case token::token_type::eq:
+        p.evaluate = select_equality<Access, std::equal_to<>>(literal, p);
+        break;
+
+    case token::token_type::neq:
+        p.evaluate = select_equality<Access, std::not_equal_to<>>(literal, p);
+        break;
+
+    case token::token_type::gt:
+        p.evaluate = select_comparison<Access, std::greater<>>(literal, p.number);
+        break;
+
+    case token::token_type::lt:
+        p.evaluate = select_comparison<Access, std::less<>>(literal, p.number);
+        break;
+
+    case token::token_type::geq:
+        p.evaluate = select_comparison<Access, std::greater_equal<>>(literal, p.number);
+        break;
+
+    case token::token_type::leq:
+        p.evaluate = select_comparison<Access, std::less_equal<>>(literal, p.number);
+        break;
+
+    case token::token_type::is_null:
+        p.evaluate = &null_test<Access, true>;
+        break;
+
+    case token::token_type::is_not_null:
+        p.evaluate = &null_test<Access, false>;
+        break;
+
+    case token::token_type::starts_with:
+    case token::token_type::ends_with:
+    case token::token_type::contains:
+    case token::token_type::like:
+    case token::token_type::matches:
+        p.evaluate = nullptr == matcher ? &never : &match<Access>;
+        break;
+
+    default:
+        break;
+    }
+
+    return p;
+}
+
+} // utils
+
+} // booleval
+
+#endif // BOOLEVAL_TYPED_MEM_FN_H
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef BOOLEVAL_VARIANT_EVALUATOR_H
+#define BOOLEVAL_VARIANT_EVALUATOR_H
+
+#include <map>
+#include <tuple>
+#include <memory>
+#include <variant>
+#include <string_view>
+#include <booleval/typed_evaluator.hpp>
+
+namespace booleval {
+
+template <typename Variant>
+class variant_evaluator;
+
+/**
+ * class variant_evaluator
+ *
+ * Represents a class for evaluating logical expressions on the objects held by
+ * std::variant, e.g. a stream of different events. The expression is parsed once
+ * and its tree is compiled for each alternative separately (see typed_evaluator),
+ * the fields missing from an alternative being null, and each object is evaluated
+ * by the program of its alternative, selected by the index of the variant.
+ */
+template <typename... Ts>
+class variant_evaluator<std::variant<Ts...>> {
+    template <typename T>
+    using field_map = std::map<std::string_view, utils::typed_mem_fn<T>>;
+
+public:
+    variant_evaluator() {
+        (std::get<typed_evaluator<Ts>>(evaluators_).missing_fields_null(true), ...);
+    }
+
+    variant_evaluator(variant_evaluator&& rhs) = default;
+    variant_evaluator(variant_evaluator const& rhs) = default;
+
+    variant_evaluator& operator=(variant_evaluator&& rhs) = default;
+    variant_evaluator& operator=(variant_evaluator const& rhs) = default;
+
+    ~variant_evaluator() = default;
+
+    /**
+     * Sets the key - member map of the alternative.
+     *
+     * @param fields Key - member map of the alternative
+     */
+    template <typename T>
+    void fields(field_map<T> const& fields) {
+        std::get<typed_evaluator<T>>(evaluators_).fields(fields);
+    }
+
+    /**
+     * Checks whether the evaluation is activated or not, i.e.
+     * if the expression tree is successfully built.
+     *
+     * @return True if the evaluation is activated, otherwise false
+     */
+    [[nodiscard]] bool is_activated() const noexcept {
+        return std::get<0>(evaluators_).is_activated();
+    }
+
+    /**
+     * Sets the expression to be used for evaluation of all the alternatives.
+     *
+     * @param expression Expression to be used for evaluation
+     *
+     * @return True if the expression is valid, otherwise false
+     */
+    [[nodiscard]] bool expression(std::string_view const expression) {
+        auto expression_tree = std::make_shared<tree::expression_tree>();
+        auto const is_built = !expression.empty() && expression_tree->build(expression);
+
+        (std::get<typed_evaluator<Ts>>(evaluators_).expression_tree(expression_tree), ...);
+        return is_built || expression.empty();
+    }
+
+    /**
+     * Evaluates the expression for the object held by the variant.
+     *
+     * @param obj Variant holding the object to be evaluated
+     *
+     * @return True if the object's members satisfy the expression, otherwise false
+     */
+    [[nodiscard]] bool evaluate(std::variant<Ts...> const& obj) const {
+        return std::visit([this](auto const& alternative) {
+            using type = std::decay_t<decltype(alternative)>;
+            return std::get<typed_evaluator<type>>(evaluators_).evaluate(alternative);
+        }, obj);
+    }
+
+    /**
+     * Gets the evaluator of the alternative.
+     *
+     * @return Evaluator of the alternative
+     */
+    template <typename T>
+    [[nodiscard]] typed_evaluator<T> const& alternative() const noexcept {
+        return std::get<typed_evaluator<T>>(evaluators_);
+    }
+
+private:
+    std::tuple<typed_evaluator<Ts>...> evaluators_;
+};
+
+} // booleval
+
+#endif // BOOLEVAL_VARIANT_EVALUATOR_H
@@ -0,0 +1,448 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <booleval/exceptions.hpp>
+#include <booleval/io/arrow_filter.hpp>
+#include <booleval/utils/bit_utils.hpp>
+#include <booleval/utils/string_utils.hpp>
+#include <booleval/tree/expression_tree.hpp>
+
+namespace booleval {
+
+namespace io {
+
+namespace {
+
+    constexpr std::size_t block_words{ arrow_filter::block_size / 64 };
+
+    /**
+     * Reads the bits of the bitmap starting at an arbitrary bit position
+     * without reading past the last byte holding the requested bits.
+     */
+    void read_bits(uint8_t const* const bitmap, std::size_t const position, std::size_t const count, uint64_t* bits) {
+        for (std::size_t w = 0; w * 64 < count; ++w) {
+            auto const n = std::min<std::size_t>(64, count - w * 64);
+            auto const start = position + w * 64;
+            auto const shift = start % 8;
+            auto const first_byte = start / 8;
+            auto const last_byte = (start + n - 1) / 8;
+
+            uint64_t word{ 0 };
+            for (auto b = first_byte; b <= last_byte; ++b) {
+                auto const byte = static_cast<uint64_t>(bitmap[b]);
+                auto const bit = (b - first_byte) * 8;
+                word |= bit >= shift ? byte << (bit - shift) : byte >> (shift - bit);
+            }
+
+            bits[w] = word & detail::valid_mask(n, 0);
+        }
+    }
+
+    /**
+     * Clears the bits of the null values of the array, if it has any.
+     */
+    void apply_validity(ArrowArray const& array, std::size_t const first, std::size_t const count, uint64_t* bits) {
+        if (0 == array.null_count || array.n_buffers < 1 || nullptr == array.buffers[0]) {
+            return;
+        }
+
+        std::array<uint64_t, block_words> validity;
+        read_bits(static_cast<uint8_t const*>(array.buffers[0]), static_cast<std::size_t>(array.offset) + first, count, validity.data());
+        for (std::size_t i = 0; i < (count + 63) / 64; ++i) {
+            bits[i] &= validity[i];
+        }
+    }
+
+    [[nodiscard]] binary_type fixed_type(char const format) noexcept {
+        switch (format) {
+            case 'c': return binary_type::int8;
+            case 'C': return binary_type::uint8;
+            case 's': return binary_type::int16;
+            case 'S': return binary_type::uint16;
+            case 'i': return binary_type::int32;
+            case 'I': return binary_type::uint32;
+            case 'l': return binary_type::int64;
+            case 'L': return binary_type::uint64;
+            case 'f': return binary_type::float32;
+            default:  return binary_type::float64;
+        }
+    }
+
+    /**
+     * Tests the strings of a variable-size binary layout by the predicate taking a string view.
+     */
+    template <typename Offset, typename Predicate>
+    void scan_strings(ArrowArray const& array, std::size_t const first, block_selection const& selection,
+                      uint64_t* bits, Predicate&& predicate) {
+        auto const offsets = static_cast<Offset const*>(array.buffers[1]) + array.offset + first;
+        auto const data = static_cast<char const*>(array.buffers[2]);
+
+        selection.scan(reinterpret_cast<std::byte const*>(offsets), sizeof(Offset), bits,
+                       [&](std::byte const* offset) {
+            Offset begin;
+            Offset end;
+            std::memcpy(&begin, offset, sizeof(Offset));
+            std::memcpy(&end, offset + sizeof(Offset), sizeof(Offset));
+            return predicate(std::string_view(data + begin, static_cast<std::size_t>(end - begin)));
+        });
+    }
+
+    /**
+     * Compares the strings of a variable-size binary layout with the literal
+     * or matches them against the compiled pattern, if there is one.
+     */
+    template <typename Offset>
+    void scan_strings(ArrowArray const& array, std::size_t const first, block_selection const& selection,
+                      token::token_type const op, std::string_view const literal,
+                      utils::string_matcher const* matcher, uint64_t* bits) {
+        if (nullptr != matcher) {
+            scan_strings<Offset>(array, first, selection, bits, [matcher](std::string_view const value) {
+                return matcher->matches(value);
+            });
+            return;
+        }
+
+        detail::with_comparison(op, [&](auto const cmp) {
+            scan_strings<Offset>(array, first, selection, bits, [&](std::string_view const value) {
+                return cmp(value, literal);
+            });
+        });
+    }
+
+    struct exported_bitmap {
+        std::vector<uint64_t> bits;
+        std::array<void const*, 2> buffers{};
+    };
+
+} // namespace
+
+arrow_filter::arrow_filter(ArrowSchema const& schema) {
+    if (nullptr == schema.format || std::string_view("+s") != schema.format) {
+        throw schema_error("Record batch schema is not a struct");
+    }
+
+    columns_.reserve(static_cast<std::size_t>(schema.n_children));
+    for (int64_t i = 0; i < schema.n_children; ++i) {
+        auto const& child = *schema.children[i];
+
+        column c;
+        c.name = nullptr == child.name ? "" : child.name;
+
+        std::string_view const format = nullptr == child.format ? "" : child.format;
+        if (nullptr == child.dictionary && 1 == format.size()) {
+            if (std::string_view("cCsSiIlLfg").find(format[0]) != std::string_view::npos) {
+                c.kind = column_kind::fixed;
+                c.type = fixed_type(format[0]);
+            } else if ('b' == format[0]) {
+                c.kind = column_kind::boolean;
+                c.type = binary_type::uint8;
+            } else if ('u' == format[0]) {
+                c.kind = column_kind::string;
+            } else if ('U' == format[0]) {
+                c.kind = column_kind::large_string;
+            }
+        }
+
+        columns_.push_back(std::move(c));
+    }
+}
+
+bool arrow_filter::expression(std::string_view expression) {
+    nodes_.clear();
+    expression_ = std::make_unique<std::string>(expression);
+
+    tree::expression_tree tree;
+    if (expression.empty() || !tree.build(*expression_)) {
+        return expression.empty();
+    }
+
+    for (auto const name : tree.referenced_fields()) {
+        auto const c = find(name);
+        if (nullptr == c || column_kind::unsupported == c->kind) {
+            throw field_not_found(name);
+        }
+    }
+
+    (void) compile(*tree.root());
+    return true;
+}
+
+bool arrow_filter::is_activated() const noexcept {
+    return !nodes_.empty();
+}
+
+arrow_filter::column const* arrow_filter::find(std::string_view const name) const noexcept {
+    auto const it = std::find_if(columns_.begin(), columns_.end(), [name](auto const& c) {
+        return c.name == name;
+    });
+
+    return columns_.end() == it ? nullptr : &*it;
+}
+
+std::size_t arrow_filter::compile(tree::tree_node const& tree_node) {
+    node n;
+    auto const type = tree_node.token.type();
+
+    if (nullptr != tree_node.left && nullptr != tree_node.right) {
+        if (token::token_type::logical_and == type || token::token_type::logical_or == type) {
+            n.op = type;
+            n.left = compile(*tree_node.left);
+            n.right = compile(*tree_node.right);
+        } else if ((type >= token::token_type::eq && type <= token::token_type::leq) ||
+                   tree_node.token.is_one_of(token::token_type::is_null, token::token_type::is_not_null) ||
+                   nullptr != tree_node.matcher) {
+            auto const c = find(tree_node.left->token.value());
+            n.op = type;
+            n.column = static_cast<std::size_t>(c - columns_.data());
+            n.literal = tree_node.right->token.value();
+            n.matcher = tree_node.matcher;
+
+            if (column_kind::boolean == c->kind) {
+                if ("true" == n.literal) {
+                    n.literal = "1";
+                } else if ("false" == n.literal) {
+                    n.literal = "0";
+                }
+            }
+
+            if (column_kind::fixed == c->kind || column_kind::boolean == c->kind) {
+                n.comparison = nullptr != n.matcher
+                    ? typed_comparison(n.matcher, binary_field(0, c->type))
+                    : typed_comparison(type, binary_field(0, c->type), n.literal);
+            }
+
+            // float32 values compare through their shortest representation, which
+            // the bounds of the widened values do not account for
+            if (column_kind::fixed == c->kind && binary_type::float32 != c->type && nullptr == n.matcher) {
+                n.value = utils::from_chars<double>(n.literal).value_or(n.value);
+            }
+        }
+    }
+
+    nodes_.push_back(n);
+    return nodes_.size() - 1;
+}
+
+std::size_t arrow_filter::evaluate(ArrowArray const& batch, std::vector<uint64_t>& bits) const {
+    utils::bitmap result(std::move(bits), 0);
+    auto const matches = evaluate(batch, result);
+    bits = result.release();
+    return matches;
+}
+
+std::size_t arrow_filter::evaluate(ArrowArray const& batch, utils::bitmap& bits) const {
+    return evaluate(batch, nullptr, bits);
+}
+
+std::size_t arrow_filter::evaluate(ArrowArray const& batch, zone_map const& zones, utils::bitmap& bits) const {
+    return evaluate(batch, &zones, bits);
+}
+
+std::size_t arrow_filter::evaluate(ArrowArray const& batch, zone_map const* const zones, utils::bitmap& bits) const {
+    auto const length = static_cast<std::size_t>(std::max<int64_t>(batch.length, 0));
+    bits.assign(length);
+
+    if (nodes_.empty() || 0 == length) {
+        return 0;
+    }
+
+    if (batch.n_children != static_cast<int64_t>(columns_.size())) {
+        throw schema_error("Record batch does not match the schema");
+    }
+
+    std::size_t matches{ 0 };
+    for (std::size_t first = 0; first < length; first += block_size) {
+        auto const count = std::min(block_size, length - first);
+        auto const block = bits.data() + first / 64;
+
+        // Null rows of the record batch are not evaluated at all
+        std::array<uint64_t, block_words> selected{};
+        for (std::size_t i = 0; i < (count + 63) / 64; ++i) {
+            selected[i] = detail::valid_mask(count, i);
+        }
+        apply_validity(batch, first, count, selected.data());
+
+        evaluate(nodes_.back(), batch, first, count, selected.data(), block, zones);
+
+        for (std::size_t i = 0; i < (count + 63) / 64; ++i) {
+            matches += utils::popcount(block[i]);
+        }
+    }
+
+    return matches;
+}
+
+void arrow_filter::evaluate(node const& n, ArrowArray const& batch, std::size_t const first, std::size_t const count,
+                            uint64_t const* const selected, uint64_t* const bits, zone_map const* const zones) const {
+    auto const words = (count + 63) / 64;
+    auto const is_and = token::token_type::logical_and == n.op;
+    if (!is_and && token::token_type::logical_or != n.op) {
+        auto const& array = *batch.children[n.column];
+        auto const position = static_cast<std::size_t>(batch.offset) + first;
+
+        auto match = zone_match::some;
+        if (nullptr != zones && nullptr == n.matcher) {
+            match = zones->match(columns_[n.column].name, first, count, n.op, n.value, n.literal);
+        }
+
+        // The bounds do not include null values, which never satisfy a comparison
+        if (zone_match::all == match) {
+            std::copy(selected, selected + words, bits);
+            apply_validity(array, position, count, bits);
+            return;
+        }
+
+        block_selection const selection(selected, count);
+        if (zone_match::none == match || selection.empty()) {
+            std::fill(bits, bits + words, 0);
+            return;
+        }
+
+        scan(n, array, position, selection, bits);
+        return;
+    }
+
+    evaluate(nodes_[n.left], batch, first, count, selected, bits, zones);
+
+    // The right operand of a logical and evaluates the rows accepted by the left one,
+    // the right operand of a logical or those selected but not accepted yet
+    std::array<uint64_t, block_words> remaining;
+    for (std::size_t i = 0; i < words; ++i) {
+        remaining[i] = is_and ? bits[i] : selected[i] & ~bits[i];
+    }
+
+    std::array<uint64_t, block_words> right;
+    evaluate(nodes_[n.right], batch, first, count, remaining.data(), right.data(), zones);
+
+    for (std::size_t i = 0; i < words; ++i) {
+        bits[i] = is_and ? right[i] : bits[i] | right[i];
+    }
+}
+
+void arrow_filter::scan(node const& n, ArrowArray const& array, std::size_t const first,
+                        block_selection const& selection, uint64_t* const bits) const {
+    auto const& c = columns_[n.column];
+    auto const count = selection.count();
+    auto const position = static_cast<std::size_t>(array.offset) + first;
+
+    // Null tests are answered by the validity bitmap alone
+    if (token::token_type::is_null == n.op || token::token_type::is_not_null == n.op) {
+        auto const words = (count + 63) / 64;
+        std::fill(bits, bits + words, ~uint64_t{ 0 });
+        apply_validity(array, first, count, bits);
+        for (std::size_t i = 0; i < words; ++i) {
+            bits[i] = (token::token_type::is_null == n.op ? ~bits[i] : bits[i]) & selection.bits()[i];
+        }
+        return;
+    }
+
+    switch (c.kind) {
+        case column_kind::fixed: {
+            auto const width = binary_width(c.type);
+            auto const values = static_cast<std::byte const*>(array.buffers[1]) + position * width;
+            n.comparison.scan(values, width, selection, bits);
+            break;
+        }
+
+        case column_kind::boolean: {
+            std::array<uint64_t, block_words> values;
+            read_bits(static_cast<uint8_t const*>(array.buffers[1]), position, count, values.data());
+
+            std::array<uint8_t, block_size> bytes;
+            for (std::size_t i = 0; i < count; ++i) {
+                bytes[i] = static_cast<uint8_t>((values[i / 64] >> (i % 64)) & 1);
+            }
+            n.comparison.scan(reinterpret_cast<std::byte const*>(bytes.data()), 1, selection, bits);
+            break;
+        }
+
+        case column_kind::string:
+            scan_strings<int32_t>(array, first, selection, n.op, n.literal, n.matcher.get(), bits);
+            break;
+
+        default:
+            scan_strings<int64_t>(array, first, selection, n.op, n.literal, n.matcher.get(), bits);
+            break;
+    }
+
+    apply_validity(array, first, count, bits);
+}
+
+std::vector<std::size_t> arrow_filter::select(ArrowArray const& batch) const {
+    utils::bitmap bits;
+    (void) evaluate(batch, bits);
+    return bits.indices();
+}
+
+void arrow_filter::export_bitmap(std::vector<uint64_t> bits, int64_t const length, ArrowArray& array, ArrowSchema& schema) {
+    // Arrow bitmaps are sequences of bytes in the least significant bit order
+    if constexpr (!utils::is_little_endian) {
+        for (auto& word : bits) {
+            word = utils::byte_swap(word);
+        }
+    }
+
+    auto exported = std::make_unique<exported_bitmap>();
+    exported->bits = std::move(bits);
+    exported->buffers = { nullptr, exported->bits.data() };
+
+    array.length = length;
+    array.null_count = 0;
+    array.offset = 0;
+    array.n_buffers = 2;
+    array.n_children = 0;
+    array.buffers = exported->buffers.data();
+    array.children = nullptr;
+    array.dictionary = nullptr;
+    array.release = [](ArrowArray* released) {
+        delete static_cast<exported_bitmap*>(released->private_data);
+        released->release = nullptr;
+    };
+    array.private_data = exported.release();
+
+    schema.format = "b";
+    schema.name = "";
+    schema.metadata = nullptr;
+    schema.flags = 0;
+    schema.n_children = 0;
+    schema.children = nullptr;
+    schema.dictionary = nullptr;
+    schema.release = [](ArrowSchema* released) {
+        released->release = nullptr;
+    };
+    schema.private_data = nullptr;
+}
+
+} // io
+
+} // booleval
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <array>
+#include <cmath>
+#include <booleval/io/binary_batch.hpp>
+#include <booleval/utils/bit_utils.hpp>
+#include <booleval/utils/string_utils.hpp>
+
+namespace booleval {
+
+namespace io {
+
+namespace {
+
+    constexpr std::size_t block_words{ binary_batch::block_size / 64 };
+
+} // namespace
+
+binary_batch::binary_batch(tree::tree_node const& root, binary_schema const& schema)
+    : record_size_(schema.record_size()) {
+    (void) compile(root, schema);
+}
+
+bool binary_batch::is_compiled() const noexcept {
+    return !nodes_.empty();
+}
+
+std::size_t binary_batch::compile(tree::tree_node const& tree_node, binary_schema const& schema) {
+    node n;
+    auto const type = tree_node.token.type();
+
+    if (nullptr != tree_node.left && nullptr != tree_node.right) {
+        if (token::token_type::logical_and == type || token::token_type::logical_or == type) {
+            n.op = type;
+            n.left = compile(*tree_node.left, schema);
+            n.right = compile(*tree_node.right, schema);
+        } else if (nullptr != tree_node.matcher) {
+            auto const field = schema.find(tree_node.left->token.value());
+            if (nullptr != field) {
+                n.comparison = typed_comparison(tree_node.matcher, *field);
+            }
+        } else if ((type >= token::token_type::eq && type <= token::token_type::leq) ||
+                   tree_node.token.is_one_of(token::token_type::is_null, token::token_type::is_not_null)) {
+            auto const field = schema.find(tree_node.left->token.value());
+            if (nullptr != field) {
+                n.op = type;
+                n.comparison = typed_comparison(type, *field, tree_node.right->token.value());
+                n.name = tree_node.left->token.value();
+                n.literal = tree_node.right->token.value();
+
+                // float32 values compare through their shortest representation, which
+                // the bounds of the widened values do not account for
+                if (binary_type::string != field->type() && binary_type::float32 != field->type()) {
+                    n.value = utils::from_chars<double>(n.literal).value_or(n.value);
+                }
+            }
+        }
+    }
+
+    nodes_.push_back(n);
+    return nodes_.size() - 1;
+}
+
+std::size_t binary_batch::evaluate(std::byte const* const records, std::size_t const count, uint64_t* const bits) const {
+    return evaluate(records, count, bits, nullptr, 0);
+}
+
+std::size_t binary_batch::evaluate(std::byte const* const records, std::size_t const count, uint64_t* const bits,
+                                   zone_map const& zones, std::size_t const first) const {
+    return evaluate(records, count, bits, &zones, first);
+}
+
+std::size_t binary_batch::evaluate(std::byte const* const records, std::size_t const count, uint64_t* const bits,
+                                   zone_map const* const zones, std::size_t const first) const {
+    auto const words = (count + 63) / 64;
+    if (nodes_.empty() || 0 == count) {
+        std::fill(bits, bits + words, 0);
+        return 0;
+    }
+
+    std::array<uint64_t, block_words> all{};
+    for (std::size_t i = 0; i < words; ++i) {
+        all[i] = detail::valid_mask(count, i);
+    }
+
+    evaluate(nodes_.back(), records, count, all.data(), bits, zones, first);
+
+    std::size_t matches{ 0 };
+    for (std::size_t i = 0; i < words; ++i) {
+        matches += utils::popcount(bits[i]);
+    }
+
+    return matches;
+}
+
+void binary_batch::evaluate(node const& n, std::byte const* const records, std::size_t const count,
+                            uint64_t const* const selected, uint64_t* const bits,
+                            zone_map const* const zones, std::size_t const first) const {
+    auto const words = (count + 63) / 64;
+    auto const is_and = token::token_type::logical_and == n.op;
+    if (!is_and && token::token_type::logical_or != n.op) {
+        auto match = zone_match::some;
+        if (nullptr != zones && !n.name.empty()) {
+            match = zones->match(n.name, first, count, n.op, n.value, n.literal);
+        }
+
+        if (zone_match::all == match) {
+            std::copy(selected, selected + words, bits);
+            return;
+        }
+
+        block_selection const selection(selected, count);
+        if (zone_match::none == match || selection.empty()) {
+            std::fill(bits, bits + words, 0);
+            return;
+        }
+
+        n.comparison.scan(records + n.comparison.field().offset(), record_size_, selection, bits);
+        return;
+    }
+
+    evaluate(nodes_[n.left], records, count, selected, bits, zones, first);
+
+    // The right operand of a logical and evaluates the records accepted by the left one,
+    // the right operand of a logical or those selected but not accepted yet
+    std::array<uint64_t, block_words> remaining;
+    for (std::size_t i = 0; i < words; ++i) {
+        remaining[i] = is_and ? bits[i] : selected[i] & ~bits[i];
+    }
+
+    std::array<uint64_t, block_words> right;
+    evaluate(nodes_[n.right], records, count, remaining.data(), right.data(), zones, first);
+
+    for (std::size_t i = 0; i < words; ++i) {
+        bits[i] = is_and ? right[i] : bits[i] | right[i];
+    }
+}
+
+} // io
+
+} // booleval
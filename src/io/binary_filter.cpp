@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <map>
+#include <algorithm>
+#include <booleval/exceptions.hpp>
+#include <booleval/io/binary_filter.hpp>
+
+namespace booleval {
+
+namespace io {
+
+bool binary_filter::expression(std::string_view expression) {
+    batch_ = {};
+    expression_ = std::make_unique<std::string>(expression);
+
+    if (!evaluator_.expression(*expression_)) {
+        return false;
+    }
+
+    if (!evaluator_.is_activated()) {
+        return true;
+    }
+
+    std::map<std::string_view, binary_field> field_map;
+    for (auto const name : evaluator_.referenced_fields()) {
+        auto const field = schema_.find(name);
+        if (nullptr == field) {
+            (void) evaluator_.expression("");
+            throw field_not_found(name);
+        }
+        field_map.emplace(name, *field);
+    }
+    evaluator_.fields(field_map);
+
+    batch_ = binary_batch(*evaluator_.root(), schema_);
+    return true;
+}
+
+bool binary_filter::is_activated() const noexcept {
+    return evaluator_.is_activated();
+}
+
+binary_schema const& binary_filter::schema() const noexcept {
+    return schema_;
+}
+
+bool binary_filter::matches(binary_record const& record) const {
+    return evaluator_.evaluate(record);
+}
+
+std::size_t binary_filter::evaluate_block(std::byte const* const records, std::size_t const count, uint64_t* const bits) const {
+    if (batch_.is_compiled()) {
+        return batch_.evaluate(records, count, bits);
+    }
+
+    auto const record_size = schema_.record_size();
+    std::fill(bits, bits + (count + 63) / 64, 0);
+
+    std::size_t matches{ 0 };
+    for (std::size_t i = 0; i < count; ++i) {
+        if (evaluator_.evaluate(binary_record(records + i * record_size, record_size))) {
+            bits[i / 64] |= uint64_t{ 1 } << (i % 64);
+            ++matches;
+        }
+    }
+
+    return matches;
+}
+
+std::size_t binary_filter::evaluate(std::string_view buffer, utils::bitmap& bits) const {
+    return evaluate(buffer, nullptr, bits);
+}
+
+std::size_t binary_filter::evaluate(std::string_view buffer, zone_map const& zones, utils::bitmap& bits) const {
+    return evaluate(buffer, &zones, bits);
+}
+
+std::size_t binary_filter::evaluate(std::string_view buffer, zone_map const* const zones, utils::bitmap& bits) const {
+    auto const record_size = schema_.record_size();
+    if (!is_activated() || 0 == record_size) {
+        bits.assign(0);
+        return 0;
+    }
+
+    auto const records = buffer.size() / record_size;
+    auto const data = reinterpret_cast<std::byte const*>(buffer.data());
+    bits.assign(records);
+
+    // Blocks start at word boundaries, so each one is written in place
+    std::size_t matches{ 0 };
+    for (std::size_t first = 0; first < records; first += binary_batch::block_size) {
+        auto const size = std::min(binary_batch::block_size, records - first);
+        auto const block = bits.data() + first / 64;
+        matches += nullptr != zones && batch_.is_compiled()
+            ? batch_.evaluate(data + first * record_size, size, block, *zones, first)
+            : evaluate_block(data + first * record_size, size, block);
+    }
+
+    return matches;
+}
+
+std::vector<std::size_t> binary_filter::select(std::string_view buffer) const {
+    utils::bitmap bits;
+    (void) evaluate(buffer, bits);
+    return bits.indices();
+}
+
+std::size_t binary_filter::filter(std::string_view buffer, std::ostream& out) const {
+    return for_each_match(buffer, [&out](auto const, auto const& record) {
+        out.write(reinterpret_cast<char const*>(record.data()), static_cast<std::streamsize>(record.size()));
+    });
+}
+
+} // io
+
+} // booleval
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <sstream>
+#include <algorithm>
+#include <booleval/exceptions.hpp>
+#include <booleval/io/binary_schema.hpp>
+#include <booleval/utils/string_utils.hpp>
+
+namespace booleval {
+
+namespace io {
+
+namespace {
+
+struct type_name {
+    std::string_view name;
+    binary_type type;
+};
+
+constexpr type_name type_names[] = {
+    { "int8",    binary_type::int8    },
+    { "uint8",   binary_type::uint8   },
+    { "int16",   binary_type::int16   },
+    { "uint16",  binary_type::uint16  },
+    { "int32",   binary_type::int32   },
+    { "uint32",  binary_type::uint32  },
+    { "int64",   binary_type::int64   },
+    { "uint64",  binary_type::uint64  },
+    { "float32", binary_type::float32 },
+    { "float64", binary_type::float64 }
+};
+
+/**
+ * Parses the non-negative number.
+ *
+ * @param strv String to be parsed
+ * @param line Number of the line being parsed
+ * @param what Description of the number used in the error message
+ *
+ * @return Parsed number
+ */
+[[nodiscard]] std::size_t parse_size(std::string_view strv, std::size_t line, char const* what) {
+    auto const size = utils::from_chars_exact<uint64_t>(strv);
+    if (!size) {
+        throw schema_error(line, "invalid " + std::string(what) + " '" + std::string(strv) + "'");
+    }
+    return static_cast<std::size_t>(size.value());
+}
+
+} // namespace
+
+binary_schema binary_schema::parse(std::string_view description) {
+    binary_schema schema;
+
+    std::istringstream lines{ std::string(description) };
+    std::string text;
+    for (std::size_t line = 1; std::getline(lines, text); ++line) {
+        if (auto const comment = text.find('#'); std::string::npos != comment) {
+            text.resize(comment);
+        }
+
+        std::istringstream words(text);
+        std::string name, type, offset, order, rest;
+        words >> name >> type >> offset >> order >> rest;
+
+        if (name.empty()) {
+            continue;
+        }
+
+        if ("record_size" == name) {
+            if (type.empty() || !offset.empty()) {
+                throw schema_error(line, "expected 'record_size <size>'");
+            }
+            schema.record_size_ = parse_size(type, line, "record size");
+            continue;
+        }
+
+        if (offset.empty() || !rest.empty()) {
+            throw schema_error(line, "expected '<name> <type> <offset> [little|big]'");
+        }
+
+        auto byte_order = byte_order::little;
+        if ("big" == order) {
+            byte_order = byte_order::big;
+        } else if (!order.empty() && "little" != order) {
+            throw schema_error(line, "invalid byte order '" + order + "'");
+        }
+
+        binary_field field;
+        auto const offset_value = parse_size(offset, line, "offset");
+        auto const known = std::find_if(std::begin(type_names), std::end(type_names), [&type](auto const& t) {
+            return t.name == type;
+        });
+
+        if (std::end(type_names) != known) {
+            field = binary_field(offset_value, known->type, byte_order);
+        } else if (0 == type.compare(0, 7, "string[") && ']' == type.back()) {
+            auto const width = parse_size(std::string_view(type).substr(7, type.size() - 8), line, "string width");
+            field = binary_field(offset_value, binary_type::string, byte_order, width);
+        } else {
+            throw schema_error(line, "invalid type '" + type + "'");
+        }
+
+        if (!schema.add(name, field)) {
+            throw schema_error(line, "field '" + name + "' is duplicated or empty");
+        }
+    }
+
+    if (0 != schema.record_size_ && schema.record_size_ < schema.fields_end_) {
+        throw schema_error("record size " + std::to_string(schema.record_size_) +
+                           " is smaller than the end of the last field");
+    }
+
+    if (0 == schema.record_size()) {
+        throw schema_error("schema does not describe any field");
+    }
+
+    return schema;
+}
+
+bool binary_schema::add(std::string_view name, binary_field const& field) {
+    if (name.empty() || 0 == field.width() || nullptr != find(name)) {
+        return false;
+    }
+
+    fields_.push_back({ std::string(name), field });
+    fields_end_ = std::max(fields_end_, field.offset() + field.width());
+    return true;
+}
+
+binary_field const* binary_schema::find(std::string_view name) const noexcept {
+    auto const it = std::find_if(fields_.begin(), fields_.end(), [name](auto const& e) {
+        return e.name == name;
+    });
+    return fields_.end() == it ? nullptr : &it->field;
+}
+
+std::vector<binary_schema::entry> const& binary_schema::fields() const noexcept {
+    return fields_;
+}
+
+void binary_schema::record_size(std::size_t const size) noexcept {
+    record_size_ = size;
+}
+
+std::size_t binary_schema::record_size() const noexcept {
+    return std::max(record_size_, fields_end_);
+}
+
+} // io
+
+} // booleval
@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string>
+#include <cstring>
+#include <optional>
+#include <algorithm>
+#include <booleval/io/csv_filter.hpp>
+
+namespace booleval {
+
+namespace io {
+
+namespace {
+
+/**
+ * Byte order mark that may precede the header line of UTF-8 encoded files.
+ */
+constexpr std::string_view utf8_bom{ "\xEF\xBB\xBF" };
+
+[[nodiscard]] inline char const* find(char const* first, char const* last, char const c) noexcept {
+    auto const found = static_cast<char const*>(std::memchr(first, c, static_cast<std::size_t>(last - first)));
+    return nullptr == found ? last : found;
+}
+
+/**
+ * Scans the value starting at the beginning of the column. Quoted values
+ * may contain delimiters and line breaks, in which case the end of the row
+ * is moved to the line break following the closing quote.
+ *
+ * @param first     Beginning of the column, moved to the delimiter or to the end of the row
+ * @param row_end   End of the row (line break or end of the input)
+ * @param last      End of the input
+ * @param delimiter Delimiter separating the values of a row
+ *
+ * @return Value of the column
+ */
+[[nodiscard]] text_value scan_value(char const*& first, char const*& row_end,
+                                    char const* last, char const delimiter) noexcept {
+    text_value value;
+
+    if (first != row_end && '"' == *first) {
+        auto const begin = ++first;
+        while (true) {
+            auto const quote = find(first, last, '"');
+            if (last == quote) {
+                // Unterminated quoted value spans the rest of the input
+                value = { std::string_view(begin, static_cast<std::size_t>(last - begin)), true, true };
+                first = row_end = last;
+                return value;
+            }
+
+            if (quote + 1 != last && '"' == *(quote + 1)) {
+                first = quote + 2;
+                continue;
+            }
+
+            value = { std::string_view(begin, static_cast<std::size_t>(quote - begin)), true, true };
+            first = quote + 1;
+            break;
+        }
+
+        if (first > row_end) {
+            row_end = find(first, last, '\n');
+        }
+
+        first = find(first, row_end, delimiter);
+        return value;
+    }
+
+    auto const end = find(first, row_end, delimiter);
+    value.text = std::string_view(first, static_cast<std::size_t>(end - first));
+    if (end == row_end && !value.text.empty() && '\r' == value.text.back()) {
+        value.text.remove_suffix(1);
+    }
+    value.present = !value.text.empty();
+
+    first = end;
+    return value;
+}
+
+/**
+ * Skips the row, tokenizing its columns only if it contains quoted values,
+ * which might span multiple lines.
+ *
+ * @param first     Beginning of the row, moved to the beginning of the next row
+ * @param last      End of the input
+ * @param delimiter Delimiter separating the values of a row
+ *
+ * @return Row without the line break, or nothing if the row is not terminated
+ */
+[[nodiscard]] std::optional<std::string_view> skip_row(char const*& first, char const* last, char const delimiter) noexcept {
+    auto const begin = first;
+    auto row_end = find(first, last, '\n');
+    if (find(first, row_end, '"') != row_end) {
+        while (true) {
+            (void) scan_value(first, row_end, last, delimiter);
+            if (first == row_end) {
+                break;
+            }
+            ++first;
+        }
+    }
+
+    first = row_end == last ? last : row_end + 1;
+    if (row_end == last) {
+        return std::nullopt;
+    }
+
+    auto line = std::string_view(begin, static_cast<std::size_t>(row_end - begin));
+    if (!line.empty() && '\r' == line.back()) {
+        line.remove_suffix(1);
+    }
+    return line;
+}
+
+/**
+ * Collapses the doubled quotes of a quoted value.
+ *
+ * @param text Content of the quoted value
+ * @param out  Buffer receiving the value
+ */
+void unquote(std::string_view text, std::string& out) {
+    out.clear();
+    while (true) {
+        auto const quote = text.find("\"\"");
+        if (std::string_view::npos == quote) {
+            out.append(text);
+            return;
+        }
+
+        out.append(text.substr(0, quote + 1));
+        text.remove_prefix(quote + 2);
+    }
+}
+
+} // namespace
+
+bool csv_filter::expression(std::string_view expression) {
+    slots_.clear();
+    return filter_.expression(expression);
+}
+
+bool csv_filter::is_activated() const noexcept {
+    return filter_.is_activated();
+}
+
+char csv_filter::delimiter() const noexcept {
+    return delimiter_;
+}
+
+bool csv_filter::header(std::string_view line) {
+    slots_.clear();
+
+    if (0 == line.compare(0, utf8_bom.size(), utf8_bom)) {
+        line.remove_prefix(utf8_bom.size());
+    }
+
+    auto const& fields = filter_.fields();
+    std::vector<bool> found(fields.size(), false);
+
+    auto first = line.data();
+    auto const last = line.data() + line.size();
+    auto row_end = find(first, last, '\n');
+
+    std::vector<std::size_t> slots;
+    while (true) {
+        auto const name = scan_value(first, row_end, last, delimiter_).text;
+
+        auto slot = unmapped;
+        auto const field = std::find(fields.begin(), fields.end(), name);
+        if (fields.end() != field) {
+            auto const candidate = static_cast<std::size_t>(field - fields.begin());
+            if (!found[candidate]) {
+                found[candidate] = true;
+                slot = candidate;
+            }
+        }
+        slots.push_back(slot);
+
+        if (first == row_end) {
+            break;
+        }
+        ++first;
+    }
+
+    // Columns following the last referenced one do not need to be tokenized
+    while (!slots.empty() && unmapped == slots.back()) {
+        slots.pop_back();
+    }
+    slots_ = std::move(slots);
+
+    return std::all_of(found.begin(), found.end(), [](auto const f) { return f; });
+}
+
+bool csv_filter::matches(std::string_view line, text_record& record) const {
+    if (!is_activated()) {
+        return false;
+    }
+
+    auto first = line.data();
+    scan_row(first, line.data() + line.size(), record);
+    return filter_.evaluate(record);
+}
+
+text_record csv_filter::make_record() const {
+    return filter_.make_record();
+}
+
+std::vector<std::size_t> csv_filter::select(std::string_view rows) const {
+    std::vector<std::size_t> indices;
+    for_each_match(rows, [&indices](auto const index, auto const) {
+        indices.push_back(index);
+    });
+    return indices;
+}
+
+std::size_t csv_filter::filter(std::string_view rows, std::ostream& out) const {
+    return for_each_match(rows, [&out](auto const, auto const line) {
+        out.write(line.data(), static_cast<std::streamsize>(line.size()));
+        out.put('\n');
+    });
+}
+
+std::size_t csv_filter::count_rows(std::string_view const rows) const noexcept {
+    std::size_t count{ 0 };
+
+    auto first = rows.data();
+    auto const last = rows.data() + rows.size();
+    while (first != last) {
+        auto const row_begin = first;
+        auto const line = skip_row(first, last, delimiter_);
+
+        // The last row does not need to be terminated by the line break
+        auto const empty = line
+            ? line->empty()
+            : row_begin == last || (1 == last - row_begin && '\r' == *row_begin);
+        if (!empty) {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+std::size_t csv_filter::row_boundary(std::string_view const rows, std::size_t const position) const noexcept {
+    auto first = rows.data();
+    auto const last = rows.data() + rows.size();
+    auto const target = rows.data() + std::min(position, rows.size());
+
+    auto boundary = first;
+    while (first < target) {
+        if (!skip_row(first, last, delimiter_) || first > target) {
+            break;
+        }
+        boundary = first;
+    }
+
+    return static_cast<std::size_t>(boundary - rows.data());
+}
+
+std::string_view csv_filter::split_header(std::string_view& buffer) noexcept {
+    auto const end = buffer.find('\n');
+    auto const header = buffer.substr(0, end);
+    buffer.remove_prefix(std::string_view::npos == end ? buffer.size() : end + 1);
+    return header;
+}
+
+std::string_view csv_filter::scan_row(char const*& first, char const* last, text_record& record) const {
+    record.clear();
+
+    auto const begin = first;
+    auto row_end = find(first, last, '\n');
+
+    auto done = false;
+    for (std::size_t column = 0; column < slots_.size() && !done; ++column) {
+        auto value = scan_value(first, row_end, last, delimiter_);
+        if (unmapped != slots_[column]) {
+            // Doubled quotes are collapsed in the buffer of the slot
+            if (value.quoted && std::string_view::npos != value.text.find("\"\"")) {
+                auto& buffer = record.buffer(slots_[column]);
+                unquote(value.text, buffer);
+                value.text = buffer;
+            }
+            record[slots_[column]] = value;
+        }
+
+        done = first == row_end;
+        if (!done) {
+            ++first;
+        }
+    }
+
+    // The remaining columns need to be scanned only if they contain quoted
+    // values which might span multiple lines
+    if (!done && find(first, row_end, '"') != row_end) {
+        while (true) {
+            (void) scan_value(first, row_end, last, delimiter_);
+            if (first == row_end) {
+                break;
+            }
+            ++first;
+        }
+    }
+
+    first = row_end == last ? last : row_end + 1;
+
+    auto line = std::string_view(begin, static_cast<std::size_t>(row_end - begin));
+    if (!line.empty() && '\r' == line.back()) {
+        line.remove_suffix(1);
+    }
+    return line;
+}
+
+} // io
+
+} // booleval
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <utility>
+#include <booleval/io/mapped_file.hpp>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace booleval {
+
+namespace io {
+
+mapped_file::mapped_file(mapped_file&& rhs) noexcept
+    : is_open_(std::exchange(rhs.is_open_, false)),
+      data_(std::exchange(rhs.data_, nullptr)),
+      size_(std::exchange(rhs.size_, 0))
+{}
+
+mapped_file& mapped_file::operator=(mapped_file&& rhs) noexcept {
+    if (this != &rhs) {
+        close();
+        is_open_ = std::exchange(rhs.is_open_, false);
+        data_ = std::exchange(rhs.data_, nullptr);
+        size_ = std::exchange(rhs.size_, 0);
+    }
+    return *this;
+}
+
+mapped_file::~mapped_file() {
+    close();
+}
+
+#if defined(_WIN32)
+
+bool mapped_file::open(std::string const& path) {
+    close();
+
+    auto file = CreateFileA(
+        path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+    );
+    if (INVALID_HANDLE_VALUE == file) {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    if (0 == size.QuadPart) {
+        CloseHandle(file);
+        is_open_ = true;
+        return true;
+    }
+
+    auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (nullptr == mapping) {
+        return false;
+    }
+
+    auto data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (nullptr == data) {
+        return false;
+    }
+
+    is_open_ = true;
+    data_ = static_cast<char const*>(data);
+    size_ = static_cast<std::size_t>(size.QuadPart);
+    return true;
+}
+
+void mapped_file::close() noexcept {
+    if (nullptr != data_) {
+        UnmapViewOfFile(data_);
+    }
+
+    is_open_ = false;
+    data_ = nullptr;
+    size_ = 0;
+}
+
+#else
+
+bool mapped_file::open(std::string const& path) {
+    close();
+
+    auto const fd = ::open(path.c_str(), O_RDONLY);
+    if (-1 == fd) {
+        return false;
+    }
+
+    struct stat st;
+    if (-1 == ::fstat(fd, &st)) {
+        ::close(fd);
+        return false;
+    }
+
+    if (0 == st.st_size) {
+        ::close(fd);
+        is_open_ = true;
+        return true;
+    }
+
+    auto data = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (MAP_FAILED == data) {
+        return false;
+    }
+
+    ::madvise(data, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+
+    is_open_ = true;
+    data_ = static_cast<char const*>(data);
+    size_ = static_cast<std::size_t>(st.st_size);
+    return true;
+}
+
+void mapped_file::close() noexcept {
+    if (nullptr != data_) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+
+    is_open_ = false;
+    data_ = nullptr;
+    size_ = 0;
+}
+
+#endif
+
+bool mapped_file::is_open() const noexcept {
+    return is_open_;
+}
+
+std::string_view mapped_file::data() const noexcept {
+    return std::string_view(data_, size_);
+}
+
+} // io
+
+} // booleval
@@ -0,0 +1,468 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <booleval/io/ndjson_filter.hpp>
+#include <booleval/io/stream_reader.hpp>
+#include <booleval/utils/bit_utils.hpp>
+#include <booleval/utils/split_range.hpp>
+
+namespace booleval {
+
+namespace io {
+
+namespace {
+
+[[nodiscard]] inline bool is_whitespace(char const c) noexcept {
+    return ' ' == c || '\t' == c || '\n' == c || '\r' == c;
+}
+
+inline void skip_whitespace(char const*& first, char const* last) noexcept {
+    while (first != last && is_whitespace(*first)) {
+        ++first;
+    }
+}
+
+/**
+ * Scans the JSON string starting at the opening quote.
+ *
+ * @param first Position of the opening quote, moved past the closing quote
+ * @param last  End of the input
+ * @param value Raw content of the string without the quotes
+ *
+ * @return True if the string is terminated, otherwise false
+ */
+[[nodiscard]] bool scan_string(char const*& first, char const* last, std::string_view& value) noexcept {
+    auto const begin = ++first;
+    while (first != last) {
+        auto const quote = static_cast<char const*>(std::memchr(first, '"', last - first));
+        if (nullptr == quote) {
+            break;
+        }
+
+        // Count the backslashes preceding the quote to check whether it is escaped
+        std::size_t backslashes{ 0 };
+        for (auto c = quote; c != begin && '\\' == *(c - 1); --c) {
+            ++backslashes;
+        }
+
+        first = quote + 1;
+        if (0 == backslashes % 2) {
+            value = std::string_view(begin, quote - begin);
+            return true;
+        }
+    }
+
+    first = last;
+    return false;
+}
+
+/**
+ * Parses the 4 hexadecimal digits of a \\u escape sequence.
+ *
+ * @param text Text starting with the digits
+ *
+ * @return Code unit or nothing if the digits are malformed
+ */
+[[nodiscard]] std::optional<uint32_t> parse_code_unit(std::string_view const text) noexcept {
+    if (text.size() < 4) {
+        return std::nullopt;
+    }
+
+    uint32_t unit{ 0 };
+    for (std::size_t i = 0; i < 4; ++i) {
+        auto const c = text[i];
+        unit <<= 4;
+        if (c >= '0' && c <= '9') {
+            unit |= static_cast<uint32_t>(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            unit |= static_cast<uint32_t>(c - 'a' + 10);
+        } else if (c >= 'A' && c <= 'F') {
+            unit |= static_cast<uint32_t>(c - 'A' + 10);
+        } else {
+            return std::nullopt;
+        }
+    }
+    return unit;
+}
+
+/**
+ * Appends the code point encoded as UTF-8.
+ */
+void append_utf8(std::string& out, uint32_t const code_point) {
+    if (code_point < 0x80) {
+        out.push_back(static_cast<char>(code_point));
+    } else if (code_point < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else if (code_point < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+}
+
+/**
+ * Decodes the escape sequences of the raw content of a JSON string.
+ * Malformed escape sequences are kept as they are.
+ *
+ * @param text Raw content of the string
+ * @param out  Buffer receiving the decoded string
+ */
+void unescape(std::string_view text, std::string& out) {
+    out.clear();
+    while (!text.empty()) {
+        auto const backslash = text.find('\\');
+        out.append(text.substr(0, backslash));
+        if (std::string_view::npos == backslash || backslash + 1 == text.size()) {
+            if (std::string_view::npos != backslash) {
+                out.push_back('\\');
+            }
+            return;
+        }
+
+        auto const escaped = text[backslash + 1];
+        text.remove_prefix(backslash + 2);
+        switch (escaped) {
+        case '"':  out.push_back('"');  break;
+        case '\\': out.push_back('\\'); break;
+        case '/':  out.push_back('/');  break;
+        case 'b':  out.push_back('\b'); break;
+        case 'f':  out.push_back('\f'); break;
+        case 'n':  out.push_back('\n'); break;
+        case 'r':  out.push_back('\r'); break;
+        case 't':  out.push_back('\t'); break;
+
+        case 'u': {
+            auto const unit = parse_code_unit(text);
+            if (!unit) {
+                out.append("\\u");
+                break;
+            }
+            text.remove_prefix(4);
+
+            auto code_point = unit.value();
+            if (code_point >= 0xD800 && code_point < 0xDC00 && text.size() >= 6 && '\\' == text[0] && 'u' == text[1]) {
+                // High surrogate followed by the low one
+                auto const low = parse_code_unit(text.substr(2));
+                if (low && low.value() >= 0xDC00 && low.value() < 0xE000) {
+                    code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low.value() - 0xDC00);
+                    text.remove_prefix(6);
+                }
+            }
+            append_utf8(out, code_point);
+            break;
+        }
+
+        default:
+            out.push_back('\\');
+            out.push_back(escaped);
+            break;
+        }
+    }
+}
+
+/**
+ * Scans the JSON scalar (number, true, false or null).
+ *
+ * @param first Beginning of the scalar, moved past its end
+ * @param last  End of the input
+ * @param value Text of the scalar
+ *
+ * @return True if the scalar is not empty, otherwise false
+ */
+[[nodiscard]] bool scan_scalar(char const*& first, char const* last, std::string_view& value) noexcept {
+    auto const begin = first;
+    while (first != last && ',' != *first && '}' != *first && ']' != *first && !is_whitespace(*first)) {
+        ++first;
+    }
+
+    value = std::string_view(begin, first - begin);
+    return !value.empty();
+}
+
+/**
+ * Skips the JSON value of any kind.
+ *
+ * @param first Beginning of the value, moved past its end
+ * @param last  End of the input
+ *
+ * @return True if the value is well-formed enough to be skipped, otherwise false
+ */
+[[nodiscard]] bool skip_value(char const*& first, char const* last) noexcept {
+    std::string_view value;
+    if ('"' == *first) {
+        return scan_string(first, last, value);
+    }
+
+    if ('{' != *first && '[' != *first) {
+        return scan_scalar(first, last, value);
+    }
+
+    std::size_t depth{ 0 };
+    while (first != last) {
+        switch (*first) {
+        case '"':
+            if (!scan_string(first, last, value)) {
+                return false;
+            }
+            continue;
+
+        case '{':
+        case '[':
+            ++depth;
+            break;
+
+        case '}':
+        case ']':
+            if (0 == --depth) {
+                ++first;
+                return true;
+            }
+            break;
+
+        default:
+            break;
+        }
+        ++first;
+    }
+
+    return false;
+}
+
+} // namespace
+
+bool ndjson_filter::expression(std::string_view expression) {
+    paths_.clear();
+
+    if (!filter_.expression(expression) || filter_.fields().size() > max_fields) {
+        return false;
+    }
+
+    for (auto const field : filter_.fields()) {
+        field_path path;
+        for (auto const& [quoted, index, segment] : utils::split_range<>(field, ".")) {
+            path.segments.push_back(segment);
+        }
+        paths_.push_back(std::move(path));
+    }
+
+    return true;
+}
+
+bool ndjson_filter::is_activated() const noexcept {
+    return filter_.is_activated() && paths_.size() == filter_.fields().size();
+}
+
+text_record ndjson_filter::make_record() const {
+    return filter_.make_record();
+}
+
+bool ndjson_filter::extract(std::string_view line, text_record& record) const {
+    record.clear();
+
+    auto first = line.data();
+    auto const last = line.data() + line.size();
+
+    skip_whitespace(first, last);
+    if (first == last || '{' != *first) {
+        return false;
+    }
+
+    auto const candidates = paths_.size() == max_fields
+        ? ~uint64_t{ 0 }
+        : (uint64_t{ 1 } << paths_.size()) - 1;
+
+    auto remaining = candidates;
+    return 0 == candidates || scan_object(first, last, 0, candidates, remaining, record);
+}
+
+bool ndjson_filter::matches(std::string_view line, text_record& record) const {
+    return is_activated() && extract(line, record) && filter_.evaluate(record);
+}
+
+std::size_t ndjson_filter::filter(std::string_view buffer, std::ostream& out) const {
+    return for_each_match(buffer, [&out](auto const line) {
+        out.write(line.data(), static_cast<std::streamsize>(line.size()));
+        out.put('\n');
+    });
+}
+
+std::size_t ndjson_filter::filter(int fd, std::ostream& out) const {
+    std::size_t count{ 0 };
+
+    stream_reader reader(fd);
+    while (reader.read()) {
+        auto const data = reader.data();
+        auto const newline = data.rfind('\n');
+        if (std::string_view::npos != newline) {
+            count += filter(data.substr(0, newline + 1), out);
+            reader.consume(newline + 1);
+        }
+    }
+
+    // The last line is not terminated by the line break
+    count += filter(reader.data(), out);
+
+    return count;
+}
+
+bool ndjson_filter::scan_object(char const*& first, char const* last,
+                                std::size_t depth, uint64_t candidates,
+                                uint64_t& remaining, text_record& record) const {
+    // Skip the opening brace
+    ++first;
+
+    skip_whitespace(first, last);
+    if (first != last && '}' == *first) {
+        ++first;
+        return true;
+    }
+
+    while (true) {
+        std::string_view key;
+        skip_whitespace(first, last);
+        if (first == last || '"' != *first || !scan_string(first, last, key)) {
+            return false;
+        }
+
+        skip_whitespace(first, last);
+        if (first == last || ':' != *first) {
+            return false;
+        }
+
+        ++first;
+        skip_whitespace(first, last);
+        if (first == last) {
+            return false;
+        }
+
+        uint64_t leaves{ 0 };
+        uint64_t nested{ 0 };
+        for (auto bits = candidates; 0 != bits; bits &= bits - 1) {
+            auto const slot = utils::count_trailing_zeros(bits);
+            auto const& segments = paths_[slot].segments;
+            if (segments.size() > depth && segments[depth] == key) {
+                if (segments.size() == depth + 1) {
+                    leaves |= uint64_t{ 1 } << slot;
+                } else {
+                    nested |= uint64_t{ 1 } << slot;
+                }
+            }
+        }
+
+        if (0 != nested && '{' == *first) {
+            auto const begin = first;
+            if (!scan_object(first, last, depth + 1, nested, remaining, record)) {
+                return false;
+            }
+
+            // The leaves are still remaining, so the whole object has been scanned
+            if (0 != leaves) {
+                text_value value;
+                value.text = std::string_view(begin, first - begin);
+                value.quoted = true;
+                value.present = true;
+                for (auto bits = leaves; 0 != bits; bits &= bits - 1) {
+                    record[utils::count_trailing_zeros(bits)] = value;
+                }
+                remaining &= ~leaves;
+            }
+
+            if (0 == remaining) {
+                return true;
+            }
+        } else if (0 != leaves) {
+            text_value value;
+            auto const begin = first;
+            if ('"' == *first) {
+                value.quoted = true;
+                if (!scan_string(first, last, value.text)) {
+                    return false;
+                }
+            } else if ('{' == *first || '[' == *first) {
+                // Nested objects and arrays are compared by their raw text
+                value.quoted = true;
+                if (!skip_value(first, last)) {
+                    return false;
+                }
+                value.text = std::string_view(begin, first - begin);
+            } else if (!scan_scalar(first, last, value.text)) {
+                return false;
+            }
+
+            value.present = value.quoted || "null" != value.text;
+
+            // Escaped strings are decoded into the buffer of the first slot referring to them
+            if ('"' == *begin && std::string_view::npos != value.text.find('\\')) {
+                auto& buffer = record.buffer(utils::count_trailing_zeros(leaves));
+                unescape(value.text, buffer);
+                value.text = buffer;
+            }
+
+            for (auto bits = leaves; 0 != bits; bits &= bits - 1) {
+                record[utils::count_trailing_zeros(bits)] = value;
+            }
+
+            remaining &= ~leaves;
+            if (0 == remaining) {
+                return true;
+            }
+        } else if (!skip_value(first, last)) {
+            return false;
+        }
+
+        skip_whitespace(first, last);
+        if (first == last) {
+            return false;
+        }
+
+        if ('}' == *first) {
+            ++first;
+            return true;
+        }
+
+        if (',' != *first) {
+            return false;
+        }
+        ++first;
+    }
+}
+
+} // io
+
+} // booleval
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <system_error>
+#include <booleval/io/stream_reader.hpp>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace booleval {
+
+namespace io {
+
+bool stream_reader::read() {
+    if (0 != begin_) {
+        std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+        end_ -= begin_;
+        begin_ = 0;
+    }
+
+    if (end_ == buffer_.size()) {
+        // The unconsumed data fills the whole buffer
+        buffer_.resize(buffer_.size() * 2);
+    }
+
+    while (true) {
+#if defined(_WIN32)
+        auto const n = ::_read(fd_, buffer_.data() + end_, static_cast<unsigned int>(buffer_.size() - end_));
+#else
+        auto const n = ::read(fd_, buffer_.data() + end_, buffer_.size() - end_);
+#endif
+
+        if (n < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "Cannot read the input");
+        }
+
+        end_ += static_cast<std::size_t>(n);
+        return 0 != n;
+    }
+}
+
+std::string_view stream_reader::data() const noexcept {
+    return std::string_view(buffer_.data() + begin_, end_ - begin_);
+}
+
+void stream_reader::consume(std::size_t const size) noexcept {
+    begin_ += std::min(size, end_ - begin_);
+}
+
+} // io
+
+} // booleval
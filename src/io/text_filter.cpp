@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <map>
+#include <booleval/io/text_filter.hpp>
+
+namespace booleval {
+
+namespace io {
+
+bool text_filter::expression(std::string_view expression) {
+    fields_.clear();
+    expression_ = std::make_unique<std::string>(expression);
+
+    if (!evaluator_.expression(*expression_) || !evaluator_.is_activated()) {
+        return false;
+    }
+
+    fields_ = evaluator_.referenced_fields();
+
+    std::map<std::string_view, text_field> field_map;
+    for (std::size_t slot = 0; slot < fields_.size(); ++slot) {
+        field_map.emplace(fields_[slot], text_field(slot));
+    }
+    evaluator_.fields(field_map);
+
+    return true;
+}
+
+bool text_filter::is_activated() const noexcept {
+    return evaluator_.is_activated();
+}
+
+std::vector<std::string_view> const& text_filter::fields() const noexcept {
+    return fields_;
+}
+
+text_record text_filter::make_record() const {
+    return text_record(fields_.size());
+}
+
+bool text_filter::evaluate(text_record const& record) const {
+    return evaluator_.evaluate(record);
+}
+
+} // io
+
+} // booleval
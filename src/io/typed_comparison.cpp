@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <optional>
+#include <utility>
+#include <type_traits>
+#include <booleval/io/typed_comparison.hpp>
+#include <booleval/utils/bit_utils.hpp>
+#include <booleval/utils/string_utils.hpp>
+
+namespace booleval {
+
+namespace io {
+
+namespace {
+
+    [[nodiscard]] bool is_equality(token::token_type const type) noexcept {
+        return token::token_type::eq == type || token::token_type::neq == type;
+    }
+
+    [[nodiscard]] bool is_signed(binary_type const type) noexcept {
+        return binary_type::int8 == type || binary_type::int16 == type ||
+               binary_type::int32 == type || binary_type::int64 == type;
+    }
+
+    [[nodiscard]] bool is_nan_literal(std::string_view const literal) noexcept {
+        return "nan" == literal || "-nan" == literal;
+    }
+
+    template <typename U, bool Swap>
+    [[nodiscard]] U load_word(std::byte const* const data) noexcept {
+        U word;
+        std::memcpy(&word, data, sizeof(U));
+        if constexpr (Swap) {
+            word = utils::byte_swap(word);
+        }
+        return word;
+    }
+
+    /**
+     * Scans the fixed-width values by the scanner, converting each loaded
+     * word by the conversion function before passing it to the predicate.
+     */
+    template <typename U, typename Scanner, typename Convert, typename Predicate>
+    void scan_words(Scanner&& scanner, bool const swap, Convert&& convert, Predicate&& predicate) {
+        if (swap) {
+            scanner([&](std::byte const* data) {
+                return predicate(convert(load_word<U, true>(data)));
+            });
+        } else {
+            scanner([&](std::byte const* data) {
+                return predicate(convert(load_word<U, false>(data)));
+            });
+        }
+    }
+
+    /**
+     * Invokes the function with a zero value of the unsigned word type of the binary type width.
+     */
+    template <typename F>
+    void with_word(binary_type const type, F&& func) {
+        switch (binary_width(type)) {
+            case 1:  func(uint8_t{ 0 });  break;
+            case 2:  func(uint16_t{ 0 }); break;
+            case 4:  func(uint32_t{ 0 }); break;
+            default: func(uint64_t{ 0 }); break;
+        }
+    }
+
+    /**
+     * Parses the literal as the shortest representation of a floating point value,
+     * i.e. the only literal equal to the string form of a field holding that value.
+     */
+    template <typename T>
+    [[nodiscard]] std::optional<T> parse_canonical(std::string_view const literal) {
+        auto const value = utils::from_chars_exact<T>(literal);
+        if (!value || std::isnan(value.value())) {
+            return std::nullopt;
+        }
+
+        std::array<char, utils::max_chars<T>> buffer;
+        if (utils::to_chars(buffer, value.value()) != literal) {
+            return std::nullopt;
+        }
+
+        return value;
+    }
+
+    [[nodiscard]] std::string_view trim_padding(std::byte const* const data, std::size_t const width) noexcept {
+        std::string_view value(reinterpret_cast<char const*>(data), width);
+
+        auto const end = value.find_last_not_of(std::string_view("\0 ", 2));
+        value.remove_suffix(std::string_view::npos == end ? value.size() : value.size() - end - 1);
+        return value;
+    }
+
+} // namespace
+
+typed_comparison::typed_comparison(token::token_type const op, binary_field const& field, std::string_view const literal)
+    : op_(op),
+      field_(field),
+      literal_(literal) {
+    auto const constant = [this, op](bool const equal) {
+        kind_ = kind::constant;
+        result_ = token::token_type::eq == op ? equal : !equal;
+    };
+
+    // Fixed-width values are never null
+    if (token::token_type::is_null == op || token::token_type::is_not_null == op) {
+        kind_ = kind::constant;
+        result_ = token::token_type::is_not_null == op;
+        return;
+    }
+
+    switch (field.type()) {
+        case binary_type::string:
+            kind_ = kind::string;
+            break;
+
+        case binary_type::float32:
+        case binary_type::float64: {
+            auto const is_float32 = binary_type::float32 == field.type();
+            if (is_nan_literal(literal)) {
+                kind_ = kind::fallback;
+                break;
+            }
+
+            if (is_equality(op)) {
+                if (is_float32) {
+                    auto const value = parse_canonical<float>(literal);
+                    if (!value) {
+                        constant(false);
+                        break;
+                    }
+                    uint32_t bits;
+                    std::memcpy(&bits, &value.value(), sizeof(bits));
+                    unsigned_value_ = bits;
+                } else {
+                    auto const value = parse_canonical<double>(literal);
+                    if (!value) {
+                        constant(false);
+                        break;
+                    }
+                    std::memcpy(&unsigned_value_, &value.value(), sizeof(unsigned_value_));
+                }
+                kind_ = kind::raw_bits;
+                break;
+            }
+
+            // Ordering of float32 values goes through their shortest float representation
+            // parsed as double, which the widened value does not match
+            if (is_float32) {
+                kind_ = kind::fallback;
+                break;
+            }
+
+            auto const value = utils::from_chars<double>(literal);
+            if (!value) {
+                kind_ = kind::constant;
+                result_ = false;
+                break;
+            }
+            kind_ = kind::floating_point;
+            floating_point_value_ = value.value();
+            break;
+        }
+
+        default: {
+            auto const is_signed_type = is_signed(field.type());
+            if (is_equality(op)) {
+                if (is_signed_type) {
+                    auto const value = utils::from_chars_exact<int64_t>(literal);
+                    if (!value || utils::to_chars(value.value()) != literal) {
+                        constant(false);
+                        break;
+                    }
+                    signed_value_ = value.value();
+                } else {
+                    auto const value = utils::from_chars_exact<uint64_t>(literal);
+                    if (!value || utils::to_chars(value.value()) != literal) {
+                        constant(false);
+                        break;
+                    }
+                    unsigned_value_ = value.value();
+                }
+            } else {
+                auto const value = utils::from_chars<double>(literal);
+                if (!value) {
+                    kind_ = kind::constant;
+                    result_ = false;
+                    break;
+                }
+                floating_point_value_ = value.value();
+            }
+
+            kind_ = is_signed_type ? kind::signed_integer : kind::unsigned_integer;
+            break;
+        }
+    }
+}
+
+typed_comparison::typed_comparison(std::shared_ptr<utils::string_matcher const> matcher, binary_field const& field)
+    : kind_(kind::pattern),
+      field_(field),
+      matcher_(std::move(matcher)) {
+}
+
+void typed_comparison::scan(std::byte const* const values, std::size_t const stride,
+                            std::size_t const count, uint64_t* const bits) const {
+    if (kind::constant == kind_) {
+        for (std::size_t i = 0; i < (count + 63) / 64; ++i) {
+            bits[i] = result_ ? detail::valid_mask(count, i) : 0;
+        }
+        return;
+    }
+
+    scan_with([&](auto&& predicate) {
+        detail::scan_values(values, count, stride, bits, predicate);
+    });
+}
+
+void typed_comparison::scan(std::byte const* const values, std::size_t const stride,
+                            block_selection const& selection, uint64_t* const bits) const {
+    if (kind::constant == kind_) {
+        auto const selected = selection.bits();
+        for (std::size_t i = 0; i < (selection.count() + 63) / 64; ++i) {
+            bits[i] = result_ ? selected[i] : 0;
+        }
+        return;
+    }
+
+    scan_with([&](auto&& predicate) {
+        selection.scan(values, stride, bits, predicate);
+    });
+}
+
+template <typename Scanner>
+void typed_comparison::scan_with(Scanner&& scanner) const {
+    auto const swap = (byte_order::little == field_.order()) != utils::is_little_endian;
+
+    switch (kind_) {
+        case kind::signed_integer:
+            detail::with_comparison(op_, [&](auto const cmp) {
+                with_word(field_.type(), [&](auto zero) {
+                    using word = decltype(zero);
+                    auto const convert = [](word const w) {
+                        return static_cast<int64_t>(static_cast<std::make_signed_t<word>>(w));
+                    };
+                    if (is_equality(op_)) {
+                        scan_words<word>(scanner, swap, convert,
+                                         [&](int64_t const v) { return cmp(v, signed_value_); });
+                    } else {
+                        scan_words<word>(scanner, swap, convert,
+                                         [&](int64_t const v) { return cmp(static_cast<double>(v), floating_point_value_); });
+                    }
+                });
+            });
+            break;
+
+        case kind::unsigned_integer:
+            detail::with_comparison(op_, [&](auto const cmp) {
+                with_word(field_.type(), [&](auto zero) {
+                    using word = decltype(zero);
+                    auto const convert = [](word const w) {
+                        return static_cast<uint64_t>(w);
+                    };
+                    if (is_equality(op_)) {
+                        scan_words<word>(scanner, swap, convert,
+                                         [&](uint64_t const v) { return cmp(v, unsigned_value_); });
+                    } else {
+                        scan_words<word>(scanner, swap, convert,
+                                         [&](uint64_t const v) { return cmp(static_cast<double>(v), floating_point_value_); });
+                    }
+                });
+            });
+            break;
+
+        case kind::floating_point:
+            detail::with_comparison(op_, [&](auto const cmp) {
+                auto const convert = [](uint64_t const w) {
+                    double value;
+                    std::memcpy(&value, &w, sizeof(value));
+                    return value;
+                };
+                scan_words<uint64_t>(scanner, swap, convert,
+                                     [&](double const v) { return cmp(v, floating_point_value_); });
+            });
+            break;
+
+        case kind::raw_bits:
+            detail::with_comparison(op_, [&](auto const cmp) {
+                with_word(field_.type(), [&](auto zero) {
+                    using word = decltype(zero);
+                    auto const expected = static_cast<word>(unsigned_value_);
+                    scan_words<word>(scanner, swap, [](word const w) { return w; },
+                                     [&](word const w) { return cmp(w, expected); });
+                });
+            });
+            break;
+
+        case kind::string:
+            detail::with_comparison(op_, [&](auto const cmp) {
+                scanner([&](std::byte const* data) {
+                    return cmp(trim_padding(data, field_.width()), literal_);
+                });
+            });
+            break;
+
+        case kind::pattern: {
+            if (binary_type::string == field_.type()) {
+                scanner([&](std::byte const* data) {
+                    return matcher_->matches(trim_padding(data, field_.width()));
+                });
+                break;
+            }
+
+            binary_field const value_field(0, field_.type(), field_.order(), field_.width());
+            scanner([&](std::byte const* data) {
+                return matcher_->matches(value_field.invoke(binary_record(data, field_.width())).str());
+            });
+            break;
+        }
+
+        case kind::fallback:
+        default: {
+            binary_field const value_field(0, field_.type(), field_.order(), field_.width());
+            detail::with_comparison(op_, [&](auto const cmp) {
+                scanner([&](std::byte const* data) {
+                    return cmp(value_field.invoke(binary_record(data, field_.width())), literal_);
+                });
+            });
+            break;
+        }
+    }
+}
+
+} // io
+
+} // booleval
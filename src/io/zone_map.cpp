@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <booleval/io/zone_map.hpp>
+
+namespace booleval {
+
+namespace io {
+
+zone_map::zone_map(std::size_t const zone_size) noexcept
+    : zone_size_(std::max<std::size_t>(zone_size, 1)) {
+}
+
+std::size_t zone_map::zone_size() const noexcept {
+    return zone_size_;
+}
+
+void zone_map::add(std::string_view const column, std::vector<bounds> zones) {
+    auto const it = columns_.find(column);
+    if (std::end(columns_) != it) {
+        it->second = std::move(zones);
+        return;
+    }
+
+    columns_.emplace(column, std::move(zones));
+}
+
+std::optional<zone_map::bounds> zone_map::find(std::string_view const column, std::size_t const first, std::size_t const count) const {
+    auto const it = columns_.find(column);
+    if (std::end(columns_) == it || 0 == count) {
+        return std::nullopt;
+    }
+
+    auto const& zones = it->second;
+    auto const last_zone = (first + count - 1) / zone_size_;
+    if (last_zone >= zones.size()) {
+        return std::nullopt;
+    }
+
+    bounds result{ zones[first / zone_size_] };
+    for (auto z = first / zone_size_; z <= last_zone; ++z) {
+        auto const& b = zones[z];
+        if (std::isnan(b.min) || std::isnan(b.max)) {
+            return std::nullopt;
+        }
+        result.min = std::min(result.min, b.min);
+        result.max = std::max(result.max, b.max);
+    }
+
+    return result;
+}
+
+void zone_map::add_bloom_filters(std::string_view const column, std::vector<utils::bloom_filter> filters) {
+    auto const it = bloom_filters_.find(column);
+    if (std::end(bloom_filters_) != it) {
+        it->second = std::move(filters);
+        return;
+    }
+
+    bloom_filters_.emplace(column, std::move(filters));
+}
+
+bool zone_map::may_contain(std::string_view const column, std::size_t const first, std::size_t const count,
+                           std::string_view const literal) const {
+    auto const it = bloom_filters_.find(column);
+    if (std::end(bloom_filters_) == it || 0 == count) {
+        return true;
+    }
+
+    auto const& filters = it->second;
+    auto const last_zone = (first + count - 1) / zone_size_;
+    if (last_zone >= filters.size()) {
+        return true;
+    }
+
+    for (auto z = first / zone_size_; z <= last_zone; ++z) {
+        if (filters[z].may_contain(literal)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+zone_match zone_map::match(std::string_view const column, std::size_t const first, std::size_t const count,
+                           token::token_type const op, double const value, std::string_view const literal) const {
+    if (token::token_type::eq == op && !may_contain(column, first, count, literal)) {
+        return zone_match::none;
+    }
+
+    if (std::isnan(value)) {
+        return zone_match::some;
+    }
+
+    auto const b = find(column, first, count);
+    return b ? decide(op, value, b.value()) : zone_match::some;
+}
+
+zone_match zone_map::decide(token::token_type const op, double const literal, bounds const& b) noexcept {
+    if (std::isnan(literal) || std::isnan(b.min) || std::isnan(b.max)) {
+        return zone_match::some;
+    }
+
+    auto const outside = literal < b.min || literal > b.max;
+    switch (op) {
+        case token::token_type::eq:
+            return outside ? zone_match::none : zone_match::some;
+
+        case token::token_type::neq:
+            return outside ? zone_match::all : zone_match::some;
+
+        case token::token_type::gt:
+            return b.max <= literal ? zone_match::none : (b.min > literal ? zone_match::all : zone_match::some);
+
+        case token::token_type::lt:
+            return b.min >= literal ? zone_match::none : (b.max < literal ? zone_match::all : zone_match::some);
+
+        case token::token_type::geq:
+            return b.max < literal ? zone_match::none : (b.min >= literal ? zone_match::all : zone_match::some);
+
+        case token::token_type::leq:
+            return b.min > literal ? zone_match::none : (b.max <= literal ? zone_match::all : zone_match::some);
+
+        default:
+            return zone_match::some;
+    }
+}
+
+} // io
+
+} // booleval
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <algorithm>
+#include <booleval/parallel/thread_pool.hpp>
+
+namespace booleval {
+
+namespace parallel {
+
+namespace {
+
+/**
+ * Pool and index of the worker the current thread belongs to, if any.
+ */
+thread_local thread_pool const* current_pool{ nullptr };
+thread_local std::size_t current_index{ 0 };
+
+} // namespace
+
+thread_pool::thread_pool()
+    : thread_pool(std::thread::hardware_concurrency())
+{}
+
+thread_pool::thread_pool(std::size_t thread_count) {
+    thread_count = std::max<std::size_t>(thread_count, 1);
+
+    queues_.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        queues_.push_back(std::make_unique<worker_queue>());
+    }
+
+    threads_.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        threads_.emplace_back([this, i] { run(i); });
+    }
+}
+
+thread_pool::~thread_pool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    work_available_.notify_all();
+
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+std::size_t thread_pool::size() const noexcept {
+    return threads_.size();
+}
+
+void thread_pool::submit(task t) {
+    auto index = this == current_pool
+        ? current_index
+        : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    {
+        // Counted under the queue lock, so the task cannot be taken before it is counted
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(t));
+        queued_.fetch_add(1, std::memory_order_release);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        work_available_.notify_one();
+    }
+}
+
+void thread_pool::wait() {
+    task t;
+    while (0 != pending_.load(std::memory_order_acquire)) {
+        if (steal(queues_.size(), t)) {
+            execute(t);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        work_done_.wait(lock, [this] {
+            return 0 == pending_.load(std::memory_order_acquire) ||
+                   0 != queued_.load(std::memory_order_acquire);
+        });
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (nullptr != exception_) {
+        auto exception = exception_;
+        exception_ = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+void thread_pool::run(std::size_t index) {
+    current_pool = this;
+    current_index = index;
+
+    task t;
+    while (true) {
+        if (pop(index, t) || steal(index, t)) {
+            execute(t);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        work_available_.wait(lock, [this] {
+            return stop_ || 0 != queued_.load(std::memory_order_acquire);
+        });
+
+        if (stop_ && 0 == queued_.load(std::memory_order_acquire)) {
+            return;
+        }
+    }
+}
+
+bool thread_pool::pop(std::size_t index, task& t) {
+    auto& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+
+    t = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool thread_pool::steal(std::size_t index, task& t) {
+    for (std::size_t i = 1; i <= queues_.size(); ++i) {
+        auto const victim = (index + i) % queues_.size();
+        if (victim == index) {
+            continue;
+        }
+
+        auto& queue = *queues_[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            t = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void thread_pool::execute(task& t) noexcept {
+    try {
+        t();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (nullptr == exception_) {
+            exception_ = std::current_exception();
+        }
+    }
+    t = nullptr;
+
+    if (1 == pending_.fetch_sub(1, std::memory_order_acq_rel)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        work_done_.notify_all();
+    }
+}
+
+} // parallel
+
+} // booleval
@@ -35,6 +35,33 @@ namespace booleval {
 
 namespace token {
 
+namespace {
+
+using word = std::pair<bool, std::string_view>;
+
+[[nodiscard]] bool is_keyword(word const& w, std::string_view lower, std::string_view upper) noexcept {
+    return !w.first && (lower == w.second || upper == w.second);
+}
+
+[[nodiscard]] bool is_string_matching(token_type const type) noexcept {
+    return token_type::starts_with == type ||
+           token_type::ends_with   == type ||
+           token_type::contains    == type ||
+           token_type::like        == type ||
+           token_type::matches     == type;
+}
+
+[[nodiscard]] bool is_operand(word const& w) {
+    if (w.first) {
+        return true;
+    }
+
+    auto const type = map_to_token_type(w.second);
+    return token_type::field == type || is_string_matching(type);
+}
+
+} // namespace
+
 tokenizer::tokenizer(std::string_view expression) noexcept
     : expression_(expression) {
 }
@@ -76,9 +103,44 @@ void tokenizer::tokenize() {
     auto delims = utils::join(std::begin(parenthesis_symbols), std::end(parenthesis_symbols));
     auto tokens_range = utils::split_range<options>(expression_, delims);
 
+    std::vector<word> words;
     for (auto const& [quoted, index, value] : tokens_range) {
+        words.emplace_back(quoted, value);
+    }
+
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        auto const [quoted, value] = words[i];
+
+        // "is null" and "is not null" are recognized only right after a field so that
+        // the words remain usable as field names and values; "null" is kept as the operand
+        if (!tokens_.empty() && tokens_.back().is(token_type::field) && is_keyword(words[i], "is", "IS")) {
+            auto const is_not_null =
+                i + 2 < words.size() &&
+                is_keyword(words[i + 1], "not", "NOT") &&
+                is_keyword(words[i + 2], "null", "NULL");
+            auto const is_null = i + 1 < words.size() && is_keyword(words[i + 1], "null", "NULL");
+
+            if (is_null || is_not_null) {
+                auto const null = words[i + (is_null ? 1 : 2)].second;
+                auto const length = static_cast<std::size_t>(null.data() + null.size() - value.data());
+                tokens_.emplace_back(is_null ? token_type::is_null : token_type::is_not_null,
+                                     std::string_view(value.data(), length));
+                tokens_.emplace_back(token_type::field, null);
+                i += is_null ? 1 : 2;
+                continue;
+            }
+        }
+
         auto type = quoted ? token_type::field : map_to_token_type(value);
 
+        // String matching operators are recognized only between a field and an operand
+        // so that the words remain usable as field names and values, like "is null"
+        if (is_string_matching(type) &&
+            (tokens_.empty() || !tokens_.back().is(token_type::field) ||
+             i + 1 == words.size() || !is_operand(words[i + 1]))) {
+            type = token_type::field;
+        }
+
         if (token_type::field == type) {
             if (!tokens_.empty() && tokens_.back().is(token_type::field)) {
                 tokens_.emplace_back(token_type::eq, map_to_token_value(token_type::eq));
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <iterator>
+#include <algorithm>
+#include <booleval/tree/conjunctive_core.hpp>
+
+namespace booleval {
+
+namespace tree {
+
+equality_conditions conjunctive_core(tree_node const* const root) {
+    if (nullptr == root || nullptr == root->left || nullptr == root->right) {
+        return {};
+    }
+
+    if (root->token.is(token::token_type::eq)) {
+        return { { root->left->token.value(), { root->right->token.value() } } };
+    }
+
+    if (root->token.is(token::token_type::logical_and)) {
+        // Both operands are necessary, so the field has to satisfy the conditions of both
+        auto conditions = conjunctive_core(root->left.get());
+        for (auto& [field, literals] : conjunctive_core(root->right.get())) {
+            auto const [it, inserted] = conditions.emplace(field, literals);
+            if (!inserted) {
+                std::vector<std::string_view> common;
+                std::set_intersection(std::begin(it->second), std::end(it->second),
+                                      std::begin(literals), std::end(literals),
+                                      std::back_inserter(common));
+                it->second = std::move(common);
+            }
+        }
+        return conditions;
+    }
+
+    if (root->token.is(token::token_type::logical_or)) {
+        // Either operand is enough, so only the fields constrained by both remain
+        auto const left = conjunctive_core(root->left.get());
+        auto const right = conjunctive_core(root->right.get());
+
+        equality_conditions conditions;
+        for (auto const& [field, literals] : left) {
+            if (auto const it = right.find(field); std::end(right) != it) {
+                std::vector<std::string_view> any;
+                std::set_union(std::begin(literals), std::end(literals),
+                               std::begin(it->second), std::end(it->second),
+                               std::back_inserter(any));
+                conditions.emplace(field, std::move(any));
+            }
+        }
+        return conditions;
+    }
+
+    return {};
+}
+
+} // tree
+
+} // booleval
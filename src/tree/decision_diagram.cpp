@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <map>
+#include <tuple>
+#include <utility>
+#include <string_view>
+#include <unordered_map>
+#include <booleval/tree/decision_diagram.hpp>
+
+namespace booleval {
+
+namespace tree {
+
+namespace {
+
+    constexpr uint32_t none{ static_cast<uint32_t>(-1) };
+    constexpr uint32_t false_index{ 0 };
+    constexpr uint32_t true_index{ 1 };
+
+    /**
+     * class builder
+     *
+     * Represents the construction of the diagram by applying the logical operations
+     * of the tree to the diagrams of their children. Equal nodes are shared through
+     * the unique table and the results of the operations are cached.
+     */
+    class builder {
+    public:
+        struct entry {
+            uint32_t variable;
+            uint32_t low;
+            uint32_t high;
+        };
+
+        builder(std::size_t const max_nodes)
+            : max_nodes_(max_nodes)
+        {
+            entries.push_back({ none, false_index, false_index });
+            entries.push_back({ none, true_index, true_index });
+        }
+
+        [[nodiscard]] uint32_t compile(tree_node const* node) {
+            if (nullptr == node || nullptr == node->left || nullptr == node->right) {
+                return false_index;
+            }
+
+            auto const is_and = node->token.is(token::token_type::logical_and);
+            if (is_and || node->token.is(token::token_type::logical_or)) {
+                auto const left = compile(node->left.get());
+                if (none == left) {
+                    return none;
+                }
+
+                auto const right = compile(node->right.get());
+                if (none == right) {
+                    return none;
+                }
+
+                return apply(is_and, left, right);
+            }
+
+            return make(variable(node), false_index, true_index);
+        }
+
+    public:
+        std::vector<tree_node const*> variables;
+        std::vector<entry> entries;
+
+    private:
+        using predicate_key = std::tuple<token::token_type, std::string_view, std::string_view>;
+
+        [[nodiscard]] static uint64_t pair_key(uint32_t const first, uint32_t const second) noexcept {
+            return (static_cast<uint64_t>(first) << 32) | second;
+        }
+
+        [[nodiscard]] uint32_t variable(tree_node const* node) {
+            predicate_key const key{ node->token.type(), node->left->token.value(), node->right->token.value() };
+            auto const [iter, inserted] = predicates_.emplace(key, static_cast<uint32_t>(variables.size()));
+            if (inserted) {
+                variables.push_back(node);
+                unique_.emplace_back();
+            }
+
+            return iter->second;
+        }
+
+        [[nodiscard]] uint32_t make(uint32_t const variable, uint32_t const low, uint32_t const high) {
+            if (low == high) {
+                return low;
+            }
+
+            auto& table = unique_[variable];
+            auto const iter = table.find(pair_key(low, high));
+            if (table.end() != iter) {
+                return iter->second;
+            }
+
+            if (entries.size() - 2 >= max_nodes_) {
+                return none;
+            }
+
+            auto const index = static_cast<uint32_t>(entries.size());
+            entries.push_back({ variable, low, high });
+            table.emplace(pair_key(low, high), index);
+            return index;
+        }
+
+        [[nodiscard]] uint32_t apply(bool const is_and, uint32_t lhs, uint32_t rhs) {
+            auto const absorbing = is_and ? false_index : true_index;
+            auto const neutral = is_and ? true_index : false_index;
+            if (absorbing == lhs || absorbing == rhs) {
+                return absorbing;
+            }
+            if (neutral == lhs || lhs == rhs) {
+                return rhs;
+            }
+            if (neutral == rhs) {
+                return lhs;
+            }
+
+            // Both operations are commutative
+            if (lhs > rhs) {
+                std::swap(lhs, rhs);
+            }
+
+            auto& cache = is_and ? and_cache_ : or_cache_;
+            if (auto const iter = cache.find(pair_key(lhs, rhs)); cache.end() != iter) {
+                return iter->second;
+            }
+
+            auto const lhs_entry = entries[lhs];
+            auto const rhs_entry = entries[rhs];
+            auto const top = std::min(lhs_entry.variable, rhs_entry.variable);
+            auto const cofactors = [top](entry const& e, uint32_t const index) {
+                return top == e.variable ? std::make_pair(e.low, e.high) : std::make_pair(index, index);
+            };
+            auto const [lhs_low, lhs_high] = cofactors(lhs_entry, lhs);
+            auto const [rhs_low, rhs_high] = cofactors(rhs_entry, rhs);
+
+            auto const low = apply(is_and, lhs_low, rhs_low);
+            if (none == low) {
+                return none;
+            }
+
+            auto const high = apply(is_and, lhs_high, rhs_high);
+            if (none == high) {
+                return none;
+            }
+
+            auto const result = make(top, low, high);
+            if (none != result) {
+                cache.emplace(pair_key(lhs, rhs), result);
+            }
+            return result;
+        }
+
+    private:
+        std::size_t max_nodes_;
+        std::map<predicate_key, uint32_t> predicates_;
+        std::vector<std::unordered_map<uint64_t, uint32_t>> unique_;
+        std::unordered_map<uint64_t, uint32_t> and_cache_;
+        std::unordered_map<uint64_t, uint32_t> or_cache_;
+    };
+
+} // namespace
+
+bool decision_diagram::build(tree_node const* root, std::size_t const max_nodes) {
+    clear();
+
+    builder b{ max_nodes };
+    auto const result = b.compile(root);
+    if (none == result) {
+        return false;
+    }
+
+    // Only the nodes reachable from the root are kept, numbered in the pre-order
+    // so that a path through the diagram mostly moves forward in memory
+    std::vector<uint32_t> position(b.entries.size(), none);
+    position[false_index] = false_terminal;
+    position[true_index] = true_terminal;
+    nodes_.resize(terminals);
+
+    std::vector<uint32_t> pending{ result };
+    while (!pending.empty()) {
+        auto const index = pending.back();
+        pending.pop_back();
+        if (none != position[index]) {
+            continue;
+        }
+
+        position[index] = static_cast<uint32_t>(nodes_.size());
+        nodes_.push_back({ b.entries[index].variable, b.entries[index].low, b.entries[index].high });
+        pending.push_back(b.entries[index].low);
+        pending.push_back(b.entries[index].high);
+    }
+
+    for (auto i = terminals; i < nodes_.size(); ++i) {
+        nodes_[i].low = position[nodes_[i].low];
+        nodes_[i].high = position[nodes_[i].high];
+    }
+
+    variables_ = std::move(b.variables);
+    root_ = position[result];
+    return true;
+}
+
+void decision_diagram::clear() noexcept {
+    variables_.clear();
+    nodes_.clear();
+    root_ = false_terminal;
+}
+
+} // tree
+
+} // booleval
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <map>
+#include <cmath>
+#include <string>
+#include <booleval/tree/explain.hpp>
+#include <booleval/token/token_type.hpp>
+#include <booleval/utils/string_utils.hpp>
+
+namespace booleval {
+
+namespace tree {
+
+namespace {
+
+/**
+ * Estimated costs of the evaluation steps, relative to a comparison of two short strings.
+ */
+constexpr std::size_t accessor_cost{ 8 };
+constexpr std::size_t string_comparison_cost{ 1 };
+constexpr std::size_t numeric_comparison_cost{ 6 };
+
+/**
+ * struct explain_context
+ *
+ * Represents the state shared while describing the tree.
+ */
+struct explain_context {
+    std::string_view expression;
+    binding_lookup const& is_bound;
+    std::ostream& out;
+    std::map<std::string_view, std::size_t> references;
+    std::size_t relational_nodes{ 0 };
+    std::size_t numeric_comparisons{ 0 };
+    std::size_t string_comparisons{ 0 };
+};
+
+[[nodiscard]] bool is_quoted(std::string_view expression, std::string_view value) noexcept {
+    auto const range = token_range(expression, value);
+    return range && range->second - range->first == value.size() + 2;
+}
+
+[[nodiscard]] std::string_view literal_type(std::string_view expression, std::string_view value) {
+    if (is_quoted(expression, value)) {
+        return "quoted string";
+    } else if (utils::from_chars_exact<int64_t>(value)) {
+        return "integer";
+    } else if (utils::from_chars_exact<double>(value)) {
+        return "floating point";
+    }
+    return "string";
+}
+
+[[nodiscard]] bool is_ordering(token::token_type const type) noexcept {
+    return token::token_type::gt  == type || token::token_type::lt  == type ||
+           token::token_type::geq == type || token::token_type::leq == type;
+}
+
+void write_line(explain_context& context, std::string const& prefix, bool const last, std::string const& text) {
+    context.out << prefix << (last ? "`-- " : "|-- ") << text << '\n';
+}
+
+void explain_node(explain_context& context, tree_node const* node, std::string const& prefix, bool const last, bool const root) {
+    if (nullptr == node) {
+        return;
+    }
+
+    auto const type = node->token.type();
+    auto const value = node->token.value();
+
+    auto const is_logical = node->token.is_one_of(token::token_type::logical_and, token::token_type::logical_or);
+    auto const is_relational = nullptr != node->left && nullptr != node->right && !is_logical;
+
+    // Equality operators inserted by the tokenizer are not a part of the expression text
+    auto text = is_logical || token_range(context.expression, value)
+        ? std::string(is_logical ? token::map_to_token_value(type) : value)
+        : std::string(token::map_to_token_value(type)) + " (implicit)";
+
+    if (root) {
+        context.out << text << '\n';
+    } else {
+        write_line(context, prefix, last, text);
+    }
+
+    if (!is_relational) {
+        auto const child_prefix = root ? std::string{} : prefix + (last ? "    " : "|   ");
+        explain_node(context, node->left.get(), child_prefix, false, false);
+        explain_node(context, node->right.get(), child_prefix, true, false);
+        return;
+    }
+
+    auto const field = node->left->token.value();
+
+    ++context.relational_nodes;
+    ++context.references[field];
+
+    auto const child_prefix = root ? std::string{} : prefix + (last ? "    " : "|   ");
+    std::string binding;
+    if (context.is_bound) {
+        binding = context.is_bound(field) ? "  [bound]" : "  [not bound]";
+    }
+
+    // Null tests check the field value only, so no comparison is made
+    if (node->token.is_one_of(token::token_type::is_null, token::token_type::is_not_null)) {
+        write_line(context, child_prefix, true, "field " + std::string(field) + binding);
+        return;
+    }
+
+    auto const literal = node->right->token.value();
+    auto const type_name = nullptr != node->matcher ? "pattern" : literal_type(context.expression, literal);
+    if (is_ordering(type) && "string" != type_name && "quoted string" != type_name) {
+        ++context.numeric_comparisons;
+    } else {
+        ++context.string_comparisons;
+    }
+
+    write_line(context, child_prefix, false, "field " + std::string(field) + binding);
+    write_line(context, child_prefix, true, "literal " + std::string(literal) + "  <" + std::string(type_name) + ">");
+}
+
+} // namespace
+
+std::optional<std::pair<std::size_t, std::size_t>> token_range(std::string_view expression,
+                                                              std::string_view value) noexcept {
+    auto const first = expression.data();
+    auto const last = expression.data() + expression.size();
+    if (value.empty() || value.data() < first || value.data() + value.size() > last) {
+        return std::nullopt;
+    }
+
+    auto begin = static_cast<std::size_t>(value.data() - first);
+    auto end = begin + value.size();
+
+    if (0 != begin && end < expression.size() &&
+        ('"' == expression[begin - 1] || '\'' == expression[begin - 1]) &&
+        expression[begin - 1] == expression[end]) {
+        --begin;
+        ++end;
+    }
+
+    return std::make_pair(begin, end);
+}
+
+void explain(tree_node const* root, std::string_view expression,
+             binding_lookup const& is_bound, std::ostream& out) {
+    out << "Expression: " << expression << '\n';
+    if (nullptr == root) {
+        out << "Expression tree is not built\n";
+        return;
+    }
+
+    explain_context context{ expression, is_bound, out, {} };
+
+    out << "\nParsed tree:\n";
+    explain_node(context, root, {}, true, true);
+
+    out << "\nField bindings:\n";
+    for (auto const& [field, references] : context.references) {
+        out << "  " << field;
+        if (is_bound) {
+            out << (is_bound(field) ? "  bound" : "  not bound");
+        }
+        out << "  (" << references << (1 == references ? " reference" : " references") << ")\n";
+    }
+
+    // Both operands of logical operations are always evaluated
+    auto const lookup_cost = static_cast<std::size_t>(std::ceil(std::log2(context.references.size() + 1)));
+    auto const cost = context.relational_nodes * (lookup_cost * string_comparison_cost + accessor_cost) +
+                      context.numeric_comparisons * numeric_comparison_cost +
+                      context.string_comparisons * string_comparison_cost;
+
+    out << "\nEstimated cost per record: " << cost << " units\n"
+        << "  field lookups and accessor calls: " << context.relational_nodes << '\n'
+        << "  numeric comparisons:              " << context.numeric_comparisons << '\n'
+        << "  string comparisons:               " << context.string_comparisons << '\n'
+        << "  (1 unit is roughly a comparison of two short strings; both operands\n"
+        << "   of logical operators are always evaluated)\n";
+}
+
+} // tree
+
+} // booleval
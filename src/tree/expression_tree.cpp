@@ -27,6 +27,7 @@
  *
  */
 
+#include <algorithm>
 #include <booleval/token/token_type.hpp>
 #include <booleval/tree/expression_tree.hpp>
 
@@ -34,10 +35,14 @@ namespace booleval {
 
 namespace tree {
 
-std::shared_ptr<tree::tree_node> expression_tree::root() noexcept {
+std::shared_ptr<tree::tree_node> const& expression_tree::root() const noexcept {
     return root_;
 }
 
+std::string_view expression_tree::expression() const noexcept {
+    return tokenizer_.expression();
+}
+
 bool expression_tree::build(std::string_view expression) {
     tokenizer_.reset();
     tokenizer_.expression(expression);
@@ -54,6 +59,44 @@ bool expression_tree::build(std::string_view expression) {
     return true;
 }
 
+std::vector<std::string_view> expression_tree::referenced_fields() const {
+    std::vector<std::string_view> fields;
+    if (nullptr == root_) {
+        return fields;
+    }
+
+    std::vector<tree::tree_node const*> nodes{ root_.get() };
+    while (!nodes.empty()) {
+        auto node = nodes.back();
+        nodes.pop_back();
+
+        if (nullptr == node->left || nullptr == node->right) {
+            continue;
+        }
+
+        if (node->token.is_one_of(token::token_type::logical_and, token::token_type::logical_or)) {
+            // Push right child first so that the fields are visited from left to right
+            nodes.push_back(node->right.get());
+            nodes.push_back(node->left.get());
+        } else {
+            auto const field = node->left->token.value();
+            if (std::end(fields) == std::find(std::begin(fields), std::end(fields), field)) {
+                fields.push_back(field);
+            }
+        }
+    }
+
+    return fields;
+}
+
+equality_conditions expression_tree::conjunctive_core() const {
+    return tree::conjunctive_core(root_.get());
+}
+
+void expression_tree::explain(std::ostream& out, binding_lookup const& is_bound) const {
+    tree::explain(root_.get(), tokenizer_.expression(), is_bound, out);
+}
+
 std::shared_ptr<tree::tree_node> expression_tree::parse_expression() {
     auto left = parse_and_operation();
 
@@ -65,7 +108,14 @@ std::shared_ptr<tree::tree_node> expression_tree::parse_expression() {
             token::token_type::gt,
             token::token_type::lt,
             token::token_type::geq,
-            token::token_type::leq
+            token::token_type::leq,
+            token::token_type::is_null,
+            token::token_type::is_not_null,
+            token::token_type::starts_with,
+            token::token_type::ends_with,
+            token::token_type::contains,
+            token::token_type::like,
+            token::token_type::matches
         );
 
     if (is_relational_operator) {
@@ -141,12 +191,45 @@ std::shared_ptr<tree::tree_node> expression_tree::parse_relational_operation() {
         auto right = parse_terminal();
         operation->left  = left;
         operation->right = right;
+        if (nullptr != right && !compile_matcher(*operation)) {
+            return nullptr;
+        }
         return operation;
     }
 
     return nullptr;
 }
 
+bool expression_tree::compile_matcher(tree::tree_node& node) {
+    auto const pattern = node.right->token.value();
+    switch (node.token.type()) {
+        case token::token_type::starts_with:
+            node.matcher = std::make_shared<utils::string_matcher const>(utils::match_kind::prefix, pattern);
+            break;
+
+        case token::token_type::ends_with:
+            node.matcher = std::make_shared<utils::string_matcher const>(utils::match_kind::suffix, pattern);
+            break;
+
+        case token::token_type::contains:
+            node.matcher = std::make_shared<utils::string_matcher const>(utils::match_kind::substring, pattern);
+            break;
+
+        case token::token_type::like:
+            node.matcher = std::make_shared<utils::string_matcher const>(utils::match_kind::like, pattern);
+            break;
+
+        case token::token_type::matches:
+            node.matcher = std::make_shared<utils::string_matcher const>(utils::match_kind::regex, pattern);
+            break;
+
+        default:
+            break;
+    }
+
+    return nullptr == node.matcher || node.matcher->is_valid();
+}
+
 std::shared_ptr<tree::tree_node> expression_tree::parse_terminal() {
     if (tokenizer_.has_tokens()) {
         auto token = tokenizer_.next_token();
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <iomanip>
+#include <algorithm>
+#include <booleval/tree/explain.hpp>
+#include <booleval/tree/node_profiler.hpp>
+#include <booleval/utils/time_utils.hpp>
+
+namespace booleval {
+
+namespace tree {
+
+namespace {
+
+constexpr auto npos = std::string_view::npos;
+
+/**
+ * Extends the range so that it contains balanced parentheses.
+ */
+void balance_parentheses(std::string_view expression, std::size_t& begin, std::size_t& end) noexcept {
+    auto const text = [&] { return expression.substr(begin, end - begin); };
+    auto open = std::count(text().begin(), text().end(), '(');
+    auto close = std::count(text().begin(), text().end(), ')');
+
+    while (close > open && 0 != begin) {
+        if ('(' == expression[--begin]) {
+            ++open;
+        }
+    }
+
+    while (open > close && end < expression.size()) {
+        if (')' == expression[end++]) {
+            ++close;
+        }
+    }
+}
+
+/**
+ * Collects the inner nodes of the tree (logical and relational operations)
+ * in pre-order together with their depths and the ranges of the expression
+ * text they cover. Leaves (fields and values) are never visited on their own.
+ */
+void collect(tree_node const* node, std::size_t depth, std::string_view expression,
+             std::vector<tree_node const*>& nodes, std::vector<node_profile>& profiles,
+             std::size_t& begin, std::size_t& end) {
+    begin = end = npos;
+    if (nullptr == node) {
+        return;
+    }
+
+    if (nullptr == node->left && nullptr == node->right) {
+        if (auto const range = token_range(expression, node->token.value()); range) {
+            begin = range->first;
+            end = range->second;
+        }
+        return;
+    }
+
+    auto const index = profiles.size();
+    nodes.push_back(node);
+    profiles.push_back({ node->token.type(), depth });
+
+    std::size_t left_begin, left_end, right_begin, right_end;
+    collect(node->left.get(), depth + 1, expression, nodes, profiles, left_begin, left_end);
+    collect(node->right.get(), depth + 1, expression, nodes, profiles, right_begin, right_end);
+
+    if (npos == left_begin || npos == right_begin) {
+        begin = npos == left_begin ? right_begin : left_begin;
+        end = npos == left_begin ? right_end : left_end;
+    } else {
+        begin = std::min(left_begin, right_begin);
+        end = std::max(left_end, right_end);
+    }
+
+    if (npos != begin) {
+        balance_parentheses(expression, begin, end);
+    }
+
+    profiles[index].begin = begin;
+    profiles[index].end = end;
+}
+
+} // namespace
+
+void profile_report::dump(std::ostream& out) const {
+    auto const width = std::max<std::size_t>(expression_.size(), 10);
+    auto const flags = out.flags();
+
+    out << std::left << std::setw(static_cast<int>(width)) << expression_ << std::right
+        << std::setw(14) << "evaluations"
+        << std::setw(14) << "true"
+        << std::setw(10) << "pass %"
+        << std::setw(14) << "accessor ns";
+    if (utils::has_cycle_counter) {
+        out << std::setw(16) << "accessor cycles";
+    }
+    out << '\n';
+
+    for (auto const& node : nodes_) {
+        std::string underline(width, ' ');
+        if (node.end <= expression_.size() && node.begin < node.end) {
+            std::fill_n(underline.begin() + static_cast<std::ptrdiff_t>(node.begin), node.end - node.begin, '^');
+        }
+
+        auto const pass_rate = 0 == node.evaluations
+            ? 0.0
+            : 100.0 * static_cast<double>(node.true_count) / static_cast<double>(node.evaluations);
+
+        out << underline
+            << std::setw(14) << node.evaluations
+            << std::setw(14) << node.true_count
+            << std::setw(10) << std::fixed << std::setprecision(2) << pass_rate;
+
+        if (0 != node.evaluations && 0 != node.accessor_nanoseconds + node.accessor_cycles) {
+            auto const evaluations = static_cast<double>(node.evaluations);
+            out << std::setw(14) << std::setprecision(1) << static_cast<double>(node.accessor_nanoseconds) / evaluations;
+            if (utils::has_cycle_counter) {
+                out << std::setw(16) << std::setprecision(1) << static_cast<double>(node.accessor_cycles) / evaluations;
+            }
+        }
+        out << '\n';
+    }
+
+    out.flags(flags);
+}
+
+void node_profiler::reset(tree_node const* root, std::string_view expression) {
+    expression_ = expression;
+    nodes_.clear();
+    indices_.clear();
+
+    std::vector<tree_node const*> nodes;
+    std::size_t begin, end;
+    collect(root, 0, expression, nodes, nodes_, begin, end);
+
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        indices_.emplace(nodes[i], i);
+    }
+    counters_ = std::make_unique<counters[]>(nodes_.size());
+}
+
+void node_profiler::clear() noexcept {
+    for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        counters_[i].evaluations.store(0, std::memory_order_relaxed);
+        counters_[i].true_count.store(0, std::memory_order_relaxed);
+        counters_[i].accessor_nanoseconds.store(0, std::memory_order_relaxed);
+        counters_[i].accessor_cycles.store(0, std::memory_order_relaxed);
+    }
+}
+
+profile_report node_profiler::report() const {
+    auto nodes = nodes_;
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i].evaluations = counters_[i].evaluations.load(std::memory_order_relaxed);
+        nodes[i].true_count = counters_[i].true_count.load(std::memory_order_relaxed);
+        nodes[i].accessor_nanoseconds = counters_[i].accessor_nanoseconds.load(std::memory_order_relaxed);
+        nodes[i].accessor_cycles = counters_[i].accessor_cycles.load(std::memory_order_relaxed);
+    }
+    return profile_report(expression_, std::move(nodes));
+}
+
+} // tree
+
+} // booleval
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <map>
+#include <booleval/utils/aho_corasick.hpp>
+
+namespace booleval {
+
+namespace utils {
+
+aho_corasick::aho_corasick(std::vector<std::string_view> const& patterns)
+    : pattern_count_(patterns.size())
+{
+    // The trie is built with ordered children first and then laid out
+    // in the breadth-first order, in which the failure links are computed
+    std::vector<std::map<unsigned char, uint32_t>> children(1);
+    std::vector<std::vector<uint32_t>> matches(1);
+    for (std::size_t i = 0; i < patterns.size(); ++i) {
+        uint32_t state{ 0 };
+        for (auto const c : patterns[i]) {
+            auto const byte = static_cast<unsigned char>(c);
+            auto const iter = children[state].find(byte);
+            if (std::end(children[state]) != iter) {
+                state = iter->second;
+                continue;
+            }
+
+            auto const created = static_cast<uint32_t>(children.size());
+            children[state].emplace(byte, created);
+            children.emplace_back();
+            matches.emplace_back();
+            state = created;
+        }
+        matches[state].push_back(static_cast<uint32_t>(i));
+    }
+
+    std::vector<uint32_t> order{ 0 };
+    std::vector<uint32_t> position(children.size(), 0);
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        for (auto const& [byte, target] : children[order[i]]) {
+            position[target] = static_cast<uint32_t>(order.size());
+            order.push_back(target);
+        }
+    }
+
+    nodes_.resize(order.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        auto& n = nodes_[i];
+        n.first_edge = static_cast<uint32_t>(edge_bytes_.size());
+        for (auto const& [byte, target] : children[order[i]]) {
+            edge_bytes_.push_back(byte);
+            edge_targets_.push_back(position[target]);
+        }
+        n.last_edge = static_cast<uint32_t>(edge_bytes_.size());
+
+        n.first_output = static_cast<uint32_t>(outputs_.size());
+        outputs_.insert(std::end(outputs_), std::begin(matches[order[i]]), std::end(matches[order[i]]));
+        n.last_output = static_cast<uint32_t>(outputs_.size());
+    }
+
+    for (auto edge = nodes_[0].first_edge; edge != nodes_[0].last_edge; ++edge) {
+        root_[edge_bytes_[edge]] = edge_targets_[edge];
+    }
+
+    // Parents precede their children, so the links of shorter suffixes are known
+    for (uint32_t parent = 0; parent < nodes_.size(); ++parent) {
+        for (auto edge = nodes_[parent].first_edge; edge != nodes_[parent].last_edge; ++edge) {
+            auto& n = nodes_[edge_targets_[edge]];
+            n.failure = 0 == parent ? 0 : next(nodes_[parent].failure, edge_bytes_[edge]);
+
+            auto const& failure = nodes_[n.failure];
+            if (0 != n.failure && failure.first_output != failure.last_output) {
+                n.dictionary = n.failure;
+            } else {
+                n.dictionary = failure.dictionary;
+            }
+        }
+    }
+}
+
+} // utils
+
+} // booleval
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <algorithm>
+#include <booleval/utils/bloom_filter.hpp>
+#include <booleval/utils/perfect_hash.hpp>
+
+namespace booleval {
+
+namespace utils {
+
+namespace {
+
+    constexpr uint64_t seed{ 0x5bd1e995 };
+
+    /**
+     * Odd multipliers selecting the bit of each word of the block.
+     */
+    constexpr std::array<uint32_t, 8> salts{
+        0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+        0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+    };
+
+} // namespace
+
+bloom_filter::bloom_filter(std::size_t const count, std::size_t const bits_per_value)
+    : blocks_(std::max<std::size_t>((count * bits_per_value + 255) / 256, 1)) {
+    for (auto& b : blocks_) {
+        b.fill(0);
+    }
+}
+
+void bloom_filter::add(std::string_view const value) noexcept {
+    if (blocks_.empty()) {
+        return;
+    }
+
+    auto const hash = perfect_hash::hash(value, seed);
+    auto& b = blocks_[block_index(hash)];
+    auto const m = mask(hash);
+    for (std::size_t i = 0; i < b.size(); ++i) {
+        b[i] |= m[i];
+    }
+}
+
+bool bloom_filter::may_contain(std::string_view const value) const noexcept {
+    if (blocks_.empty()) {
+        return true;
+    }
+
+    auto const hash = perfect_hash::hash(value, seed);
+    auto const& b = blocks_[block_index(hash)];
+    auto const m = mask(hash);
+
+    uint32_t missing{ 0 };
+    for (std::size_t i = 0; i < b.size(); ++i) {
+        missing |= m[i] & ~b[i];
+    }
+    return 0 == missing;
+}
+
+std::size_t bloom_filter::size_in_bytes() const noexcept {
+    return blocks_.size() * sizeof(block);
+}
+
+std::size_t bloom_filter::block_index(uint64_t const hash) const noexcept {
+    // Maps the upper half of the hash onto the blocks without a division
+    return static_cast<std::size_t>(((hash >> 32) * blocks_.size()) >> 32);
+}
+
+bloom_filter::block bloom_filter::mask(uint64_t const hash) noexcept {
+    auto const key = static_cast<uint32_t>(hash);
+
+    block m;
+    for (std::size_t i = 0; i < m.size(); ++i) {
+        m[i] = uint32_t{ 1 } << ((key * salts[i]) >> 27);
+    }
+    return m;
+}
+
+} // utils
+
+} // booleval
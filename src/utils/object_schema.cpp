@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <booleval/exceptions.hpp>
+#include <booleval/utils/object_schema.hpp>
+
+namespace booleval {
+
+namespace utils {
+
+object_schema::member const* object_schema::find(std::type_index const owner, std::string_view const name) const {
+    auto const type = members_.find(owner);
+    if (members_.end() == type) {
+        return nullptr;
+    }
+
+    auto const entry = type->second.find(name);
+    if (type->second.end() == entry) {
+        return nullptr;
+    }
+
+    return &entry->second;
+}
+
+std::vector<object_schema::member const*> object_schema::resolve(std::type_index owner, std::string_view path) const {
+    std::vector<member const*> chain;
+
+    while (true) {
+        auto const dot = path.find('.');
+        auto const entry = find(owner, path.substr(0, dot));
+        if (nullptr == entry) {
+            return {};
+        }
+
+        chain.push_back(entry);
+        if (std::string_view::npos == dot) {
+            break;
+        }
+
+        if (!entry->is_object()) {
+            return {};
+        }
+
+        owner = entry->target;
+        path.remove_prefix(dot + 1);
+    }
+
+    if (chain.back()->is_object()) {
+        return {};
+    }
+
+    return chain;
+}
+
+std::map<std::string_view, path_field> object_schema::compile(std::type_index const root,
+                                                              std::vector<std::string_view> const& paths) const {
+    std::map<std::string_view, std::size_t> prefix_slots;
+    std::map<std::string_view, path_field> fields;
+
+    for (auto const path : paths) {
+        auto const chain = resolve(root, path);
+        if (chain.empty()) {
+            throw field_not_found(path);
+        }
+
+        std::vector<step> prefix;
+        std::size_t end{ 0 };
+        for (std::size_t i = 0; i + 1 < chain.size(); ++i) {
+            end = path.find('.', end);
+            auto const slot = prefix_slots.emplace(path.substr(0, end), prefix_slots.size()).first->second;
+            prefix.push_back({ chain[i], slot });
+            ++end;
+        }
+
+        fields.emplace(path, path_field{ std::move(prefix), chain.back() });
+    }
+
+    return fields;
+}
+
+} // utils
+
+} // booleval
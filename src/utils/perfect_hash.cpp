@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <cstring>
+#include <numeric>
+#include <algorithm>
+#include <booleval/utils/perfect_hash.hpp>
+
+namespace booleval {
+
+namespace utils {
+
+namespace {
+
+    constexpr uint32_t empty_slot{ static_cast<uint32_t>(-1) };
+    constexpr uint32_t max_displacement{ 1U << 16 };
+    constexpr std::size_t keys_per_bucket{ 4 };
+
+} // namespace
+
+perfect_hash::perfect_hash(std::vector<std::string_view> const& keys)
+    : keys_(std::begin(keys), std::end(keys))
+{
+    if (keys.empty()) {
+        return;
+    }
+
+    std::vector<std::size_t> indices(keys.size());
+    std::iota(std::begin(indices), std::end(indices), 0);
+    std::sort(std::begin(indices), std::end(indices), [&keys](auto const lhs, auto const rhs) {
+        return keys[lhs] < keys[rhs] || (keys[lhs] == keys[rhs] && lhs < rhs);
+    });
+
+    std::vector<std::size_t> unique;
+    for (auto const index : indices) {
+        if (unique.empty() || keys[unique.back()] != keys[index]) {
+            unique.push_back(index);
+        }
+    }
+
+    // Tighter tables are tried first; failures are rare and fall back to larger ones
+    auto slot_count = unique.size() + unique.size() / 4 + 1;
+    for (uint64_t seed = 0; !place(unique, seed, slot_count); ++seed) {
+        if (3 == seed % 4) {
+            slot_count += slot_count / 2;
+        }
+    }
+}
+
+std::size_t perfect_hash::find(std::string_view const key) const noexcept {
+    if (displacements_.empty()) {
+        return npos;
+    }
+
+    auto const h = hash(key, seed_);
+    auto const displacement = displacements_[(h >> 32) % displacements_.size()];
+    auto const index = slots_[mix(h + displacement) % slots_.size()];
+    if (empty_slot == index || keys_[index] != key) {
+        return npos;
+    }
+
+    return index;
+}
+
+uint64_t perfect_hash::hash(std::string_view const key, uint64_t const seed) noexcept {
+    constexpr uint64_t multiplier{ 0x9e3779b97f4a7c15ULL };
+
+    auto h = (seed + key.size()) * multiplier;
+    auto data = key.data();
+    auto size = key.size();
+    for (; size >= sizeof(uint64_t); data += sizeof(uint64_t), size -= sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        h = (h ^ word) * multiplier;
+        h ^= h >> 29;
+    }
+
+    if (size > 0) {
+        uint64_t word{ 0 };
+        std::memcpy(&word, data, size);
+        h = (h ^ word) * multiplier;
+    }
+
+    return mix(h);
+}
+
+uint64_t perfect_hash::mix(uint64_t value) noexcept {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+bool perfect_hash::place(std::vector<std::size_t> const& unique, uint64_t const seed, std::size_t const slot_count) {
+    auto const bucket_count = (unique.size() + keys_per_bucket - 1) / keys_per_bucket;
+
+    std::vector<uint64_t> hashes(keys_.size());
+    std::vector<std::vector<std::size_t>> buckets(bucket_count);
+    for (auto const index : unique) {
+        hashes[index] = hash(keys_[index], seed);
+        buckets[(hashes[index] >> 32) % bucket_count].push_back(index);
+    }
+
+    std::vector<std::size_t> order(bucket_count);
+    std::iota(std::begin(order), std::end(order), 0);
+    std::stable_sort(std::begin(order), std::end(order), [&buckets](auto const lhs, auto const rhs) {
+        return buckets[lhs].size() > buckets[rhs].size();
+    });
+
+    displacements_.assign(bucket_count, 0);
+    slots_.assign(slot_count, empty_slot);
+
+    // The largest buckets are placed first, while most of the slots are still free
+    std::vector<std::size_t> positions;
+    for (auto const bucket : order) {
+        auto const& members = buckets[bucket];
+        if (members.empty()) {
+            break;
+        }
+
+        auto placed = false;
+        for (uint32_t displacement = 0; !placed && displacement < max_displacement; ++displacement) {
+            positions.clear();
+            for (auto const index : members) {
+                auto const position = mix(hashes[index] + displacement) % slot_count;
+                if (empty_slot != slots_[position] ||
+                    std::end(positions) != std::find(std::begin(positions), std::end(positions), position)) {
+                    break;
+                }
+                positions.push_back(position);
+            }
+
+            if (positions.size() == members.size()) {
+                for (std::size_t i = 0; i < members.size(); ++i) {
+                    slots_[positions[i]] = static_cast<uint32_t>(members[i]);
+                }
+                displacements_[bucket] = displacement;
+                placed = true;
+            }
+        }
+
+        if (!placed) {
+            return false;
+        }
+    }
+
+    seed_ = seed;
+    return true;
+}
+
+} // utils
+
+} // booleval
@@ -0,0 +1,754 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <map>
+#include <bitset>
+#include <utility>
+#include <optional>
+#include <algorithm>
+#include <booleval/utils/regex.hpp>
+
+namespace booleval {
+
+namespace utils {
+
+namespace {
+
+    using byte_set = std::bitset<256>;
+
+    constexpr std::size_t unbounded{ static_cast<std::size_t>(-1) };
+    constexpr std::size_t max_repetition{ 1000 };
+    constexpr std::size_t max_nfa_states{ 65536 };
+
+    /**
+     * struct syntax_node
+     *
+     * Represents a node of the parsed regular expression.
+     */
+    struct syntax_node {
+        enum class kind : uint8_t {
+            set,
+            begin,
+            end,
+            concatenation,
+            alternation,
+            repetition
+        };
+
+        kind type{ kind::concatenation };
+        byte_set set;
+        std::size_t min{ 0 };
+        std::size_t max{ 0 };
+        std::vector<syntax_node> children;
+    };
+
+    [[nodiscard]] byte_set range(unsigned char const first, unsigned char const last) {
+        byte_set set;
+        for (auto c = static_cast<unsigned>(first); c <= last; ++c) {
+            set.set(c);
+        }
+        return set;
+    }
+
+    [[nodiscard]] int hex_digit(char const c) noexcept {
+        if (c >= '0' && c <= '9') {
+            return c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            return c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            return c - 'A' + 10;
+        }
+        return -1;
+    }
+
+    /**
+     * class parser
+     *
+     * Represents a recursive descent parser of the regular expressions.
+     */
+    class parser {
+    public:
+        parser(std::string_view pattern) noexcept
+            : pattern_(pattern) {
+        }
+
+        [[nodiscard]] std::optional<syntax_node> parse() {
+            auto root = parse_alternation();
+            if (!root || !done()) {
+                return std::nullopt;
+            }
+            return root;
+        }
+
+    private:
+        [[nodiscard]] bool done() const noexcept {
+            return position_ >= pattern_.size();
+        }
+
+        [[nodiscard]] char peek() const noexcept {
+            return pattern_[position_];
+        }
+
+        [[nodiscard]] std::optional<syntax_node> parse_alternation() {
+            auto first = parse_concatenation();
+            if (!first || done() || '|' != peek()) {
+                return first;
+            }
+
+            syntax_node node;
+            node.type = syntax_node::kind::alternation;
+            node.children.push_back(std::move(*first));
+            while (!done() && '|' == peek()) {
+                ++position_;
+                auto next = parse_concatenation();
+                if (!next) {
+                    return std::nullopt;
+                }
+                node.children.push_back(std::move(*next));
+            }
+
+            return node;
+        }
+
+        [[nodiscard]] std::optional<syntax_node> parse_concatenation() {
+            syntax_node node;
+            while (!done() && '|' != peek() && ')' != peek()) {
+                auto repetition = parse_repetition();
+                if (!repetition) {
+                    return std::nullopt;
+                }
+                node.children.push_back(std::move(*repetition));
+            }
+
+            return node;
+        }
+
+        [[nodiscard]] std::optional<syntax_node> parse_repetition() {
+            auto atom = parse_atom();
+            while (atom && !done()) {
+                std::size_t min{ 0 };
+                std::size_t max{ unbounded };
+                switch (peek()) {
+                    case '*': ++position_; break;
+                    case '+': ++position_; min = 1; break;
+                    case '?': ++position_; max = 1; break;
+                    case '{':
+                        if (!parse_bounds(min, max)) {
+                            return std::nullopt;
+                        }
+                        break;
+                    default:
+                        return atom;
+                }
+
+                // Lazy quantifiers match the same values
+                if (!done() && '?' == peek()) {
+                    ++position_;
+                }
+
+                if (syntax_node::kind::begin == atom->type || syntax_node::kind::end == atom->type) {
+                    return std::nullopt;
+                }
+
+                syntax_node node;
+                node.type = syntax_node::kind::repetition;
+                node.min = min;
+                node.max = max;
+                node.children.push_back(std::move(*atom));
+                atom = std::move(node);
+            }
+
+            return atom;
+        }
+
+        [[nodiscard]] bool parse_number(std::size_t& number) {
+            auto const first = position_;
+            number = 0;
+            while (!done() && peek() >= '0' && peek() <= '9' && number <= max_repetition) {
+                number = number * 10 + static_cast<std::size_t>(peek() - '0');
+                ++position_;
+            }
+            return first != position_;
+        }
+
+        [[nodiscard]] bool parse_bounds(std::size_t& min, std::size_t& max) {
+            ++position_;
+            if (!parse_number(min)) {
+                return false;
+            }
+
+            max = min;
+            if (!done() && ',' == peek()) {
+                ++position_;
+                if (!parse_number(max)) {
+                    max = unbounded;
+                }
+            }
+
+            if (done() || '}' != peek()) {
+                return false;
+            }
+            ++position_;
+
+            return min <= max_repetition && (unbounded == max || (min <= max && max <= max_repetition));
+        }
+
+        [[nodiscard]] std::optional<syntax_node> parse_atom() {
+            syntax_node node;
+            node.type = syntax_node::kind::set;
+
+            auto const c = pattern_[position_++];
+            switch (c) {
+                case '(': {
+                    if (pattern_.substr(position_, 2) == "?:") {
+                        position_ += 2;
+                    }
+
+                    auto group = parse_alternation();
+                    if (!group || done() || ')' != peek()) {
+                        return std::nullopt;
+                    }
+                    ++position_;
+                    return group;
+                }
+
+                case '*':
+                case '+':
+                case '?':
+                case '{':
+                    return std::nullopt;
+
+                case '[':
+                    if (!parse_class(node.set)) {
+                        return std::nullopt;
+                    }
+                    return node;
+
+                case '.':
+                    node.set.set();
+                    node.set.reset('\n');
+                    return node;
+
+                case '^':
+                    node.type = syntax_node::kind::begin;
+                    return node;
+
+                case '$':
+                    node.type = syntax_node::kind::end;
+                    return node;
+
+                case '\\':
+                    if (!parse_escape(node.set)) {
+                        return std::nullopt;
+                    }
+                    return node;
+
+                default:
+                    node.set.set(static_cast<unsigned char>(c));
+                    return node;
+            }
+        }
+
+        [[nodiscard]] bool parse_escape(byte_set& set) {
+            if (done()) {
+                return false;
+            }
+
+            auto const c = pattern_[position_++];
+            switch (c) {
+                case 'd': set |= range('0', '9'); break;
+                case 'D': set |= ~range('0', '9'); break;
+                case 'w': set |= word(); break;
+                case 'W': set |= ~word(); break;
+                case 's': set |= space(); break;
+                case 'S': set |= ~space(); break;
+                case 't': set.set('\t'); break;
+                case 'n': set.set('\n'); break;
+                case 'r': set.set('\r'); break;
+                case 'f': set.set('\f'); break;
+                case 'v': set.set('\v'); break;
+                case 'x': {
+                    if (position_ + 2 > pattern_.size()) {
+                        return false;
+                    }
+                    auto const high = hex_digit(pattern_[position_]);
+                    auto const low = hex_digit(pattern_[position_ + 1]);
+                    if (high < 0 || low < 0) {
+                        return false;
+                    }
+                    position_ += 2;
+                    set.set(static_cast<std::size_t>(high * 16 + low));
+                    break;
+                }
+                default:
+                    // Escaped letters and digits are reserved for the unsupported features
+                    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) {
+                        return false;
+                    }
+                    set.set(static_cast<unsigned char>(c));
+                    break;
+            }
+
+            return true;
+        }
+
+        [[nodiscard]] bool parse_class(byte_set& set) {
+            auto const negated = !done() && '^' == peek();
+            if (negated) {
+                ++position_;
+            }
+
+            for (auto first = true; ; first = false) {
+                if (done()) {
+                    return false;
+                }
+
+                if (']' == peek() && !first) {
+                    ++position_;
+                    break;
+                }
+
+                std::optional<unsigned char> lower;
+                if (!parse_class_atom(set, lower)) {
+                    return false;
+                }
+                if (!lower) {
+                    continue;
+                }
+
+                auto const is_range = position_ + 1 < pattern_.size() && '-' == peek() && ']' != pattern_[position_ + 1];
+                if (!is_range) {
+                    set.set(*lower);
+                    continue;
+                }
+
+                ++position_;
+                byte_set escaped;
+                std::optional<unsigned char> upper;
+                if (!parse_class_atom(escaped, upper) || !upper || *upper < *lower) {
+                    return false;
+                }
+                set |= range(*lower, *upper);
+            }
+
+            if (negated) {
+                set.flip();
+            }
+
+            return true;
+        }
+
+        /**
+         * Parses a single character of the class, or adds the escaped class, e.g. \d, to the set.
+         */
+        [[nodiscard]] bool parse_class_atom(byte_set& set, std::optional<unsigned char>& c) {
+            if ('\\' != peek()) {
+                c = static_cast<unsigned char>(pattern_[position_++]);
+                return true;
+            }
+
+            ++position_;
+            byte_set escaped;
+            if (!parse_escape(escaped)) {
+                return false;
+            }
+
+            if (1 == escaped.count()) {
+                for (std::size_t i = 0; i < escaped.size(); ++i) {
+                    if (escaped.test(i)) {
+                        c = static_cast<unsigned char>(i);
+                    }
+                }
+            } else {
+                set |= escaped;
+            }
+
+            return true;
+        }
+
+        [[nodiscard]] static byte_set word() {
+            auto set = range('a', 'z') | range('A', 'Z') | range('0', '9');
+            set.set('_');
+            return set;
+        }
+
+        [[nodiscard]] static byte_set space() {
+            byte_set set;
+            for (auto const c : { ' ', '\t', '\n', '\r', '\f', '\v' }) {
+                set.set(static_cast<unsigned char>(c));
+            }
+            return set;
+        }
+
+    private:
+        std::string_view pattern_;
+        std::size_t position_{ 0 };
+    };
+
+    /**
+     * class nfa
+     *
+     * Represents the Thompson automaton of the regular expression.
+     */
+    class nfa {
+    public:
+        enum class kind : uint8_t {
+            split,
+            set,
+            begin,
+            end,
+            accept
+        };
+
+        struct state {
+            kind type{ kind::split };
+            byte_set set;
+            std::size_t next{ 0 };
+            std::vector<std::size_t> epsilon;
+        };
+
+        /**
+         * Builds the automaton.
+         *
+         * @return True if the automaton is not too large, otherwise false
+         */
+        [[nodiscard]] bool build(syntax_node const& root) {
+            auto const [first, last] = emit(root);
+            if (states_.size() >= max_nfa_states) {
+                return false;
+            }
+
+            start_ = first;
+            accept_ = add(kind::accept);
+            states_[last].epsilon.push_back(accept_);
+            return true;
+        }
+
+        [[nodiscard]] std::vector<state> const& states() const noexcept {
+            return states_;
+        }
+
+        [[nodiscard]] std::size_t start() const noexcept {
+            return start_;
+        }
+
+        [[nodiscard]] std::size_t accept() const noexcept {
+            return accept_;
+        }
+
+        /**
+         * Gets the states reachable from the given ones without consuming any byte.
+         * Only the states consuming bytes, end assertions and the accepting state
+         * are kept, as the others do not affect the following steps.
+         */
+        [[nodiscard]] std::vector<std::size_t> closure(std::vector<std::size_t> const& from,
+                                                       bool const at_begin, bool const at_end) const {
+            std::vector<std::size_t> result;
+            std::vector<bool> visited(states_.size(), false);
+            std::vector<std::size_t> pending(from.rbegin(), from.rend());
+
+            while (!pending.empty()) {
+                auto const index = pending.back();
+                pending.pop_back();
+                if (visited[index]) {
+                    continue;
+                }
+                visited[index] = true;
+
+                auto const& s = states_[index];
+                switch (s.type) {
+                    case kind::split:
+                        pending.insert(pending.end(), s.epsilon.rbegin(), s.epsilon.rend());
+                        break;
+                    case kind::begin:
+                        if (at_begin) {
+                            pending.push_back(s.next);
+                        }
+                        break;
+                    case kind::end:
+                        result.push_back(index);
+                        if (at_end) {
+                            pending.push_back(s.next);
+                        }
+                        break;
+                    default:
+                        result.push_back(index);
+                        break;
+                }
+            }
+
+            std::sort(result.begin(), result.end());
+            return result;
+        }
+
+    private:
+        std::size_t add(kind const type) {
+            states_.emplace_back();
+            states_.back().type = type;
+            return states_.size() - 1;
+        }
+
+        std::pair<std::size_t, std::size_t> emit(syntax_node const& node) {
+            if (states_.size() >= max_nfa_states) {
+                auto const s = add(kind::split);
+                return { s, s };
+            }
+
+            switch (node.type) {
+                case syntax_node::kind::set:
+                case syntax_node::kind::begin:
+                case syntax_node::kind::end: {
+                    auto const first = add(syntax_node::kind::set == node.type ? kind::set
+                                         : syntax_node::kind::begin == node.type ? kind::begin : kind::end);
+                    auto const last = add(kind::split);
+                    states_[first].set = node.set;
+                    states_[first].next = last;
+                    return { first, last };
+                }
+
+                case syntax_node::kind::concatenation: {
+                    auto const first = add(kind::split);
+                    auto last = first;
+                    for (auto const& child : node.children) {
+                        auto const [child_first, child_last] = emit(child);
+                        states_[last].epsilon.push_back(child_first);
+                        last = child_last;
+                    }
+                    return { first, last };
+                }
+
+                case syntax_node::kind::alternation: {
+                    auto const first = add(kind::split);
+                    auto const last = add(kind::split);
+                    for (auto const& child : node.children) {
+                        auto const [child_first, child_last] = emit(child);
+                        states_[first].epsilon.push_back(child_first);
+                        states_[child_last].epsilon.push_back(last);
+                    }
+                    return { first, last };
+                }
+
+                default: {
+                    auto const first = add(kind::split);
+                    auto const last = add(kind::split);
+                    auto current = first;
+                    auto const& child = node.children.front();
+
+                    for (std::size_t i = 0; i < node.min && states_.size() < max_nfa_states; ++i) {
+                        auto const [child_first, child_last] = emit(child);
+                        states_[current].epsilon.push_back(child_first);
+                        current = child_last;
+                    }
+
+                    if (unbounded == node.max) {
+                        auto const loop = add(kind::split);
+                        auto const [child_first, child_last] = emit(child);
+                        states_[current].epsilon.push_back(loop);
+                        states_[loop].epsilon.push_back(child_first);
+                        states_[loop].epsilon.push_back(last);
+                        states_[child_last].epsilon.push_back(loop);
+                        return { first, last };
+                    }
+
+                    for (auto i = node.min; i < node.max && states_.size() < max_nfa_states; ++i) {
+                        auto const [child_first, child_last] = emit(child);
+                        states_[current].epsilon.push_back(child_first);
+                        states_[current].epsilon.push_back(last);
+                        current = child_last;
+                    }
+                    states_[current].epsilon.push_back(last);
+                    return { first, last };
+                }
+            }
+        }
+
+    private:
+        std::vector<state> states_;
+        std::size_t start_{ 0 };
+        std::size_t accept_{ 0 };
+    };
+
+    [[nodiscard]] bool contains(std::vector<std::size_t> const& states, std::size_t const state) {
+        return std::binary_search(states.begin(), states.end(), state);
+    }
+
+} // namespace
+
+regex::regex(std::string_view const pattern) {
+    auto const root = parser(pattern).parse();
+    nfa automaton;
+    if (!root || !automaton.build(*root)) {
+        return;
+    }
+
+    auto const& states = automaton.states();
+
+    // Bytes that no set of the expression distinguishes share a class, keeping the table small
+    std::array<std::size_t, 256> classes{};
+    std::size_t class_count{ 1 };
+    for (auto const& s : states) {
+        if (nfa::kind::set != s.type) {
+            continue;
+        }
+
+        std::map<std::pair<std::size_t, bool>, std::size_t> refined;
+        for (std::size_t c = 0; c < classes.size(); ++c) {
+            auto const key = std::make_pair(classes[c], s.set.test(c));
+            classes[c] = refined.emplace(key, refined.size()).first->second;
+        }
+        class_count = refined.size();
+    }
+
+    std::vector<unsigned char> representatives(class_count);
+    for (std::size_t c = classes.size(); c-- > 0;) {
+        classes_[c] = static_cast<uint8_t>(classes[c]);
+        representatives[classes[c]] = static_cast<unsigned char>(c);
+    }
+    class_count_ = class_count;
+
+    empty_match_ = contains(automaton.closure({ automaton.start() }, true, true), automaton.accept());
+
+    // Subset construction; the search of the match at any position is the start state
+    // joining every step, and the accepting states end the search, so they need no transitions
+    enum class acceptance : uint8_t {
+        rejecting,
+        accepting,
+        accepting_at_end,
+        dead
+    };
+
+    auto const restart = automaton.closure({ automaton.start() }, false, false);
+    std::vector<std::vector<std::size_t>> subsets{ automaton.closure({ automaton.start() }, true, false) };
+    std::map<std::vector<std::size_t>, std::size_t> ids{ { subsets.front(), 0 } };
+
+    std::vector<std::size_t> transitions;
+    std::vector<acceptance> acceptances;
+    for (std::size_t id = 0; id < subsets.size(); ++id) {
+        auto const subset = subsets[id];
+        if (subset.empty()) {
+            acceptances.push_back(acceptance::dead);
+        } else if (contains(subset, automaton.accept())) {
+            acceptances.push_back(acceptance::accepting);
+        } else if (contains(automaton.closure(subset, false, true), automaton.accept())) {
+            acceptances.push_back(acceptance::accepting_at_end);
+        } else {
+            acceptances.push_back(acceptance::rejecting);
+        }
+
+        for (std::size_t k = 0; k < class_count; ++k) {
+            if (acceptance::accepting == acceptances.back() || acceptance::dead == acceptances.back()) {
+                transitions.push_back(id);
+                continue;
+            }
+
+            std::vector<std::size_t> next;
+            for (auto const index : subset) {
+                if (nfa::kind::set == states[index].type && states[index].set.test(representatives[k])) {
+                    next.push_back(states[index].next);
+                }
+            }
+
+            auto target = automaton.closure(next, false, false);
+            target.insert(target.end(), restart.begin(), restart.end());
+            std::sort(target.begin(), target.end());
+            target.erase(std::unique(target.begin(), target.end()), target.end());
+
+            auto const [it, inserted] = ids.emplace(target, subsets.size());
+            if (inserted) {
+                if (subsets.size() >= max_states) {
+                    return;
+                }
+                subsets.push_back(std::move(target));
+            }
+            transitions.push_back(it->second);
+        }
+    }
+
+    // Renumber the states: the undecided ones first, then the accepting ones and the dead one
+    std::vector<std::size_t> order(subsets.size());
+    std::size_t numbered{ 0 };
+    auto const number = [&](auto const predicate) {
+        for (std::size_t id = 0; id < subsets.size(); ++id) {
+            if (predicate(acceptances[id])) {
+                order[id] = numbered++;
+            }
+        }
+    };
+
+    number([](acceptance const a) { return acceptance::rejecting == a || acceptance::accepting_at_end == a; });
+    auto const undecided = numbered;
+    number([](acceptance const a) { return acceptance::accepting == a; });
+    auto const dead = numbered;
+    number([](acceptance const a) { return acceptance::dead == a; });
+
+    transitions_.resize(undecided * class_count);
+    accepting_at_end_.resize(undecided);
+    for (std::size_t id = 0; id < subsets.size(); ++id) {
+        if (order[id] >= undecided) {
+            continue;
+        }
+
+        accepting_at_end_[order[id]] = acceptance::accepting_at_end == acceptances[id];
+        for (std::size_t k = 0; k < class_count; ++k) {
+            transitions_[order[id] * class_count + k] = static_cast<uint32_t>(order[transitions[id * class_count + k]] * class_count);
+        }
+    }
+
+    start_ = static_cast<uint32_t>(order[0] * class_count);
+    terminal_ = static_cast<uint32_t>(undecided * class_count);
+    dead_ = static_cast<uint32_t>(dead * class_count);
+    states_ = subsets.size();
+}
+
+bool regex::matches(std::string_view const value) const noexcept {
+    if (0 == states_) {
+        return false;
+    } else if (value.empty()) {
+        return empty_match_;
+    }
+
+    auto const transitions = transitions_.data();
+    auto state = start_;
+    if (state >= terminal_) {
+        return state < dead_;
+    }
+
+    for (auto const c : value) {
+        state = transitions[state + classes_[static_cast<unsigned char>(c)]];
+        if (state >= terminal_) {
+            return state < dead_;
+        }
+    }
+
+    return accepting_at_end_[state / class_count_];
+}
+
+} // utils
+
+} // booleval
@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <iterator>
+#include <algorithm>
+#include <booleval/utils/roaring_bitmap.hpp>
+
+namespace booleval {
+
+namespace utils {
+
+namespace {
+
+    constexpr std::size_t container_words{ 65536 / 64 };
+
+    [[nodiscard]] bool test_bit(std::vector<uint64_t> const& bits, uint16_t const value) noexcept {
+        return 0 != (bits[value / 64] & (uint64_t{ 1 } << (value % 64)));
+    }
+
+} // namespace
+
+roaring_bitmap::roaring_bitmap(bitmap const& bits) {
+    auto const words = bits.data();
+    for (std::size_t first = 0; first < bits.word_count(); first += container_words) {
+        auto const last = std::min(first + container_words, bits.word_count());
+
+        std::size_t cardinality{ 0 };
+        for (auto i = first; i < last; ++i) {
+            cardinality += popcount(words[i]);
+        }
+        if (0 == cardinality) {
+            continue;
+        }
+
+        container c;
+        c.key = static_cast<uint16_t>(first / container_words);
+        c.cardinality = static_cast<uint32_t>(cardinality);
+        if (cardinality > array_limit) {
+            c.bits.assign(container_words, 0);
+            std::copy(words + first, words + last, c.bits.begin());
+        } else {
+            c.values.reserve(cardinality);
+            for (auto i = first; i < last; ++i) {
+                for (auto b = words[i]; 0 != b; b &= b - 1) {
+                    c.values.push_back(static_cast<uint16_t>((i - first) * 64 + count_trailing_zeros(b)));
+                }
+            }
+        }
+        containers_.push_back(std::move(c));
+    }
+}
+
+void roaring_bitmap::add(uint32_t const index) {
+    auto const key = static_cast<uint16_t>(index >> 16);
+    auto const value = static_cast<uint16_t>(index & 0xFFFF);
+
+    auto it = std::lower_bound(std::begin(containers_), std::end(containers_), key, [](auto const& c, auto const k) {
+        return c.key < k;
+    });
+    if (std::end(containers_) == it || it->key != key) {
+        it = containers_.insert(it, container{});
+        it->key = key;
+    }
+
+    if (it->is_bitmap()) {
+        auto& word = it->bits[value / 64];
+        auto const bit = uint64_t{ 1 } << (value % 64);
+        if (0 == (word & bit)) {
+            word |= bit;
+            ++it->cardinality;
+        }
+        return;
+    }
+
+    auto const position = std::lower_bound(std::begin(it->values), std::end(it->values), value);
+    if (std::end(it->values) != position && *position == value) {
+        return;
+    }
+
+    it->values.insert(position, value);
+    ++it->cardinality;
+    normalize(*it);
+}
+
+bool roaring_bitmap::contains(uint32_t const index) const noexcept {
+    auto const key = static_cast<uint16_t>(index >> 16);
+    auto const value = static_cast<uint16_t>(index & 0xFFFF);
+
+    auto const it = std::lower_bound(std::begin(containers_), std::end(containers_), key, [](auto const& c, auto const k) {
+        return c.key < k;
+    });
+    if (std::end(containers_) == it || it->key != key) {
+        return false;
+    }
+
+    return it->is_bitmap()
+        ? test_bit(it->bits, value)
+        : std::binary_search(std::begin(it->values), std::end(it->values), value);
+}
+
+std::size_t roaring_bitmap::cardinality() const noexcept {
+    std::size_t cardinality{ 0 };
+    for (auto const& c : containers_) {
+        cardinality += c.cardinality;
+    }
+    return cardinality;
+}
+
+bool roaring_bitmap::empty() const noexcept {
+    return containers_.empty();
+}
+
+std::size_t roaring_bitmap::container_count() const noexcept {
+    return containers_.size();
+}
+
+std::size_t roaring_bitmap::size_in_bytes() const noexcept {
+    std::size_t size{ 0 };
+    for (auto const& c : containers_) {
+        size += c.values.size() * sizeof(uint16_t) + c.bits.size() * sizeof(uint64_t);
+    }
+    return size;
+}
+
+roaring_bitmap& roaring_bitmap::operator&=(roaring_bitmap const& rhs) {
+    std::vector<container> result;
+    auto lhs_it = std::begin(containers_);
+    auto rhs_it = std::begin(rhs.containers_);
+    while (std::end(containers_) != lhs_it && std::end(rhs.containers_) != rhs_it) {
+        if (lhs_it->key < rhs_it->key) {
+            ++lhs_it;
+        } else if (rhs_it->key < lhs_it->key) {
+            ++rhs_it;
+        } else {
+            auto c = intersect(*lhs_it++, *rhs_it++);
+            if (0 != c.cardinality) {
+                result.push_back(std::move(c));
+            }
+        }
+    }
+
+    containers_ = std::move(result);
+    return *this;
+}
+
+roaring_bitmap& roaring_bitmap::operator|=(roaring_bitmap const& rhs) {
+    std::vector<container> result;
+    result.reserve(containers_.size() + rhs.containers_.size());
+
+    auto lhs_it = std::begin(containers_);
+    auto rhs_it = std::begin(rhs.containers_);
+    while (std::end(containers_) != lhs_it || std::end(rhs.containers_) != rhs_it) {
+        if (std::end(rhs.containers_) == rhs_it || (std::end(containers_) != lhs_it && lhs_it->key < rhs_it->key)) {
+            result.push_back(std::move(*lhs_it++));
+        } else if (std::end(containers_) == lhs_it || rhs_it->key < lhs_it->key) {
+            result.push_back(*rhs_it++);
+        } else {
+            result.push_back(unite(*lhs_it++, *rhs_it++));
+        }
+    }
+
+    containers_ = std::move(result);
+    return *this;
+}
+
+roaring_bitmap& roaring_bitmap::and_not(roaring_bitmap const& rhs) {
+    std::vector<container> result;
+    result.reserve(containers_.size());
+
+    auto rhs_it = std::begin(rhs.containers_);
+    for (auto& c : containers_) {
+        while (std::end(rhs.containers_) != rhs_it && rhs_it->key < c.key) {
+            ++rhs_it;
+        }
+
+        if (std::end(rhs.containers_) == rhs_it || rhs_it->key != c.key) {
+            result.push_back(std::move(c));
+            continue;
+        }
+
+        auto difference = subtract(c, *rhs_it);
+        if (0 != difference.cardinality) {
+            result.push_back(std::move(difference));
+        }
+    }
+
+    containers_ = std::move(result);
+    return *this;
+}
+
+std::vector<std::size_t> roaring_bitmap::indices() const {
+    std::vector<std::size_t> result;
+    result.reserve(cardinality());
+    for_each([&result](auto const index) {
+        result.push_back(index);
+    });
+    return result;
+}
+
+bitmap roaring_bitmap::to_bitmap(std::size_t const size) const {
+    bitmap result(size);
+    for (auto const& c : containers_) {
+        auto const first = static_cast<std::size_t>(c.key) * container_words;
+        if (first * 64 >= size) {
+            break;
+        }
+
+        if (c.is_bitmap()) {
+            auto const last = std::min(first + container_words, result.word_count());
+            std::copy(std::begin(c.bits), std::begin(c.bits) + static_cast<std::ptrdiff_t>(last - first), result.data() + first);
+        } else {
+            auto const high = first * 64;
+            for (auto const value : c.values) {
+                if (high + value >= size) {
+                    break;
+                }
+                result.set(high + value);
+            }
+        }
+    }
+
+    // Clear the bits past the size copied with the last bitmap container
+    result.resize(size);
+    return result;
+}
+
+void roaring_bitmap::to_bitmap_container(container& c) {
+    if (c.is_bitmap()) {
+        return;
+    }
+
+    c.bits.assign(container_words, 0);
+    for (auto const value : c.values) {
+        c.bits[value / 64] |= uint64_t{ 1 } << (value % 64);
+    }
+    c.values.clear();
+    c.values.shrink_to_fit();
+}
+
+void roaring_bitmap::normalize(container& c) {
+    if (!c.is_bitmap() && c.cardinality > array_limit) {
+        to_bitmap_container(c);
+    } else if (c.is_bitmap() && c.cardinality <= array_limit) {
+        c.values.clear();
+        c.values.reserve(c.cardinality);
+        for (std::size_t word = 0; word < container_words; ++word) {
+            for (auto b = c.bits[word]; 0 != b; b &= b - 1) {
+                c.values.push_back(static_cast<uint16_t>(word * 64 + count_trailing_zeros(b)));
+            }
+        }
+        c.bits.clear();
+        c.bits.shrink_to_fit();
+    }
+}
+
+roaring_bitmap::container roaring_bitmap::intersect(container const& lhs, container const& rhs) {
+    container result;
+    result.key = lhs.key;
+
+    if (lhs.is_bitmap() && rhs.is_bitmap()) {
+        result.bits.resize(container_words);
+        std::size_t cardinality{ 0 };
+        for (std::size_t i = 0; i < container_words; ++i) {
+            result.bits[i] = lhs.bits[i] & rhs.bits[i];
+            cardinality += popcount(result.bits[i]);
+        }
+        result.cardinality = static_cast<uint32_t>(cardinality);
+        normalize(result);
+    } else if (lhs.is_bitmap() || rhs.is_bitmap()) {
+        auto const& array = lhs.is_bitmap() ? rhs : lhs;
+        auto const& bits = lhs.is_bitmap() ? lhs.bits : rhs.bits;
+        std::copy_if(std::begin(array.values), std::end(array.values), std::back_inserter(result.values), [&bits](auto const value) {
+            return test_bit(bits, value);
+        });
+        result.cardinality = static_cast<uint32_t>(result.values.size());
+    } else {
+        std::set_intersection(std::begin(lhs.values), std::end(lhs.values),
+                              std::begin(rhs.values), std::end(rhs.values),
+                              std::back_inserter(result.values));
+        result.cardinality = static_cast<uint32_t>(result.values.size());
+    }
+
+    return result;
+}
+
+roaring_bitmap::container roaring_bitmap::unite(container const& lhs, container const& rhs) {
+    container result;
+    result.key = lhs.key;
+
+    if (!lhs.is_bitmap() && !rhs.is_bitmap() && lhs.cardinality + rhs.cardinality <= array_limit) {
+        std::set_union(std::begin(lhs.values), std::end(lhs.values),
+                       std::begin(rhs.values), std::end(rhs.values),
+                       std::back_inserter(result.values));
+        result.cardinality = static_cast<uint32_t>(result.values.size());
+        return result;
+    }
+
+    result.bits.assign(container_words, 0);
+    for (auto const* c : { &lhs, &rhs }) {
+        if (c->is_bitmap()) {
+            for (std::size_t i = 0; i < container_words; ++i) {
+                result.bits[i] |= c->bits[i];
+            }
+        } else {
+            for (auto const value : c->values) {
+                result.bits[value / 64] |= uint64_t{ 1 } << (value % 64);
+            }
+        }
+    }
+
+    std::size_t cardinality{ 0 };
+    for (auto const word : result.bits) {
+        cardinality += popcount(word);
+    }
+    result.cardinality = static_cast<uint32_t>(cardinality);
+    normalize(result);
+    return result;
+}
+
+roaring_bitmap::container roaring_bitmap::subtract(container const& lhs, container const& rhs) {
+    container result;
+    result.key = lhs.key;
+
+    if (lhs.is_bitmap()) {
+        result.bits = lhs.bits;
+        if (rhs.is_bitmap()) {
+            for (std::size_t i = 0; i < container_words; ++i) {
+                result.bits[i] &= ~rhs.bits[i];
+            }
+        } else {
+            for (auto const value : rhs.values) {
+                result.bits[value / 64] &= ~(uint64_t{ 1 } << (value % 64));
+            }
+        }
+
+        std::size_t cardinality{ 0 };
+        for (auto const word : result.bits) {
+            cardinality += popcount(word);
+        }
+        result.cardinality = static_cast<uint32_t>(cardinality);
+        normalize(result);
+    } else if (rhs.is_bitmap()) {
+        std::copy_if(std::begin(lhs.values), std::end(lhs.values), std::back_inserter(result.values), [&rhs](auto const value) {
+            return !test_bit(rhs.bits, value);
+        });
+        result.cardinality = static_cast<uint32_t>(result.values.size());
+    } else {
+        std::set_difference(std::begin(lhs.values), std::end(lhs.values),
+                            std::begin(rhs.values), std::end(rhs.values),
+                            std::back_inserter(result.values));
+        result.cardinality = static_cast<uint32_t>(result.values.size());
+    }
+
+    return result;
+}
+
+} // utils
+
+} // booleval
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <cstring>
+#include <algorithm>
+#include <booleval/utils/string_matcher.hpp>
+
+namespace booleval {
+
+namespace utils {
+
+string_matcher::string_matcher(match_kind const kind, std::string_view const pattern)
+    : kind_(kind) {
+    switch (kind) {
+        case match_kind::prefix:
+            anchored_begin_ = true;
+            add_segment(std::string(pattern), {});
+            return;
+
+        case match_kind::suffix:
+            anchored_end_ = true;
+            add_segment(std::string(pattern), {});
+            return;
+
+        case match_kind::substring:
+            add_segment(std::string(pattern), {});
+            return;
+
+        case match_kind::regex:
+            regex_ = utils::regex(pattern);
+            return;
+
+        default:
+            break;
+    }
+
+    anchored_begin_ = pattern.empty() || '%' != pattern.front();
+    anchored_end_ = true;
+
+    std::string text;
+    std::string wildcards;
+    auto has_wildcards{ false };
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+        auto c = pattern[i];
+        if ('%' == c) {
+            add_segment(std::move(text), has_wildcards ? std::move(wildcards) : std::string{});
+            text.clear();
+            wildcards.clear();
+            has_wildcards = false;
+            anchored_end_ = false;
+            continue;
+        }
+
+        auto wildcard{ false };
+        if ('\\' == c && i + 1 < pattern.size()) {
+            c = pattern[++i];
+        } else if ('_' == c) {
+            wildcard = true;
+            has_wildcards = true;
+        }
+
+        text.push_back(c);
+        wildcards.push_back(static_cast<char>(wildcard));
+        anchored_end_ = true;
+    }
+
+    add_segment(std::move(text), has_wildcards ? std::move(wildcards) : std::string{});
+}
+
+void string_matcher::add_segment(std::string text, std::string wildcards) {
+    if (text.empty()) {
+        return;
+    }
+
+    segment s;
+    s.text = std::move(text);
+    s.wildcards = std::move(wildcards);
+
+    // Horspool shifts, where a wildcard limits the shift of every character
+    auto const last = s.text.size() - 1;
+    auto base = static_cast<uint32_t>(s.text.size());
+    for (std::size_t i = 0; i < last && !s.wildcards.empty(); ++i) {
+        if (0 != s.wildcards[i]) {
+            base = static_cast<uint32_t>(last - i);
+        }
+    }
+
+    s.shift.fill(base);
+    for (std::size_t i = 0; i < last; ++i) {
+        auto& shift = s.shift[static_cast<uint8_t>(s.text[i])];
+        shift = std::min(shift, static_cast<uint32_t>(last - i));
+    }
+
+    segments_.push_back(std::move(s));
+}
+
+bool string_matcher::equal_at(std::string_view const value, std::size_t const position, segment const& s) noexcept {
+    if (s.wildcards.empty()) {
+        return 0 == std::memcmp(value.data() + position, s.text.data(), s.text.size());
+    }
+
+    for (std::size_t i = 0; i < s.text.size(); ++i) {
+        if (0 == s.wildcards[i] && value[position + i] != s.text[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::size_t string_matcher::find(std::string_view const value, segment const& s) noexcept {
+    auto const size = s.text.size();
+    if (size > value.size()) {
+        return std::string_view::npos;
+    }
+
+    for (std::size_t position = 0; position + size <= value.size();
+         position += s.shift[static_cast<uint8_t>(value[position + size - 1])]) {
+        if (equal_at(value, position, s)) {
+            return position;
+        }
+    }
+
+    return std::string_view::npos;
+}
+
+bool string_matcher::matches(std::string_view const value) const noexcept {
+    if (match_kind::regex == kind_) {
+        return regex_.matches(value);
+    } else if (segments_.empty()) {
+        return !(anchored_begin_ && anchored_end_) || value.empty();
+    }
+
+    std::size_t begin{ 0 };
+    std::size_t end{ value.size() };
+    auto first = segments_.begin();
+    auto last = segments_.end();
+
+    if (anchored_begin_) {
+        if (first->text.size() > end || !equal_at(value, 0, *first)) {
+            return false;
+        }
+
+        begin = first->text.size();
+        if (++first == last) {
+            return !anchored_end_ || begin == end;
+        }
+    }
+
+    if (anchored_end_) {
+        --last;
+        if (last->text.size() > end - begin || !equal_at(value, end - last->text.size(), *last)) {
+            return false;
+        }
+
+        end -= last->text.size();
+    }
+
+    // Leftmost occurrences leave the most room for the following segments
+    for (; first != last; ++first) {
+        auto const position = find(value.substr(begin, end - begin), *first);
+        if (std::string_view::npos == position) {
+            return false;
+        }
+
+        begin += position + first->text.size();
+    }
+
+    return true;
+}
+
+} // utils
+
+} // booleval
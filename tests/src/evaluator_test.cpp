@@ -442,3 +442,150 @@ TEST_F(EvaluatorTest, FieldNotValid) {
     EXPECT_TRUE(evaluator.is_activated());
     EXPECT_FALSE(evaluator.evaluate(foo));
 }
+
+TEST_F(EvaluatorTest, StringMatching) {
+    booleval::evaluator<> evaluator({
+        { "field_a", &multi_obj<std::string, unsigned>::value_a },
+        { "field_b", &multi_obj<std::string, unsigned>::value_b }
+    });
+
+    multi_obj<std::string, unsigned> foo{ "api.example.com", 8080 };
+    multi_obj<std::string, unsigned> bar{ "www.example.org", 443 };
+
+    EXPECT_TRUE(evaluator.expression("field_a starts_with api."));
+    EXPECT_TRUE(evaluator.evaluate(foo));
+    EXPECT_FALSE(evaluator.evaluate(bar));
+
+    EXPECT_TRUE(evaluator.expression("field_a ENDS_WITH .org or field_b starts_with 80"));
+    EXPECT_TRUE(evaluator.evaluate(foo));
+    EXPECT_TRUE(evaluator.evaluate(bar));
+
+    EXPECT_TRUE(evaluator.expression("field_a contains example and field_b contains 4"));
+    EXPECT_FALSE(evaluator.evaluate(foo));
+    EXPECT_TRUE(evaluator.evaluate(bar));
+
+    EXPECT_TRUE(evaluator.expression("field_a like \"%.example.___\""));
+    EXPECT_TRUE(evaluator.evaluate(foo));
+    EXPECT_TRUE(evaluator.evaluate(bar));
+
+    EXPECT_TRUE(evaluator.expression("field_a LIKE \"www._xample%\""));
+    EXPECT_FALSE(evaluator.evaluate(foo));
+    EXPECT_TRUE(evaluator.evaluate(bar));
+
+    EXPECT_TRUE(evaluator.expression("field_a matches \"^(api|www)\\.[a-z]+\\.com$\" or field_b MATCHES ^4"));
+    EXPECT_TRUE(evaluator.evaluate(foo));
+    EXPECT_TRUE(evaluator.evaluate(bar));
+
+    EXPECT_TRUE(evaluator.expression("field_b matches \"^\\d{4}$\""));
+    EXPECT_TRUE(evaluator.evaluate(foo));
+    EXPECT_FALSE(evaluator.evaluate(bar));
+
+    EXPECT_FALSE(evaluator.expression("field_a matches \"(api\""));
+    EXPECT_FALSE(evaluator.is_activated());
+}
+
+TEST_F(EvaluatorTest, StringMatchingWordsAsValues) {
+    booleval::evaluator<> evaluator({
+        { "field_a", &obj<std::string>::value_a }
+    });
+
+    obj<std::string> foo{ "like" };
+    obj<std::string> bar{ "contains" };
+
+    EXPECT_TRUE(evaluator.expression("field_a == like"));
+    EXPECT_TRUE(evaluator.evaluate(foo));
+    EXPECT_FALSE(evaluator.evaluate(bar));
+
+    EXPECT_TRUE(evaluator.expression("field_a contains"));
+    EXPECT_FALSE(evaluator.evaluate(foo));
+    EXPECT_TRUE(evaluator.evaluate(bar));
+
+    EXPECT_TRUE(evaluator.expression("field_a starts_with like"));
+    EXPECT_TRUE(evaluator.evaluate(foo));
+    EXPECT_FALSE(evaluator.evaluate(bar));
+
+    EXPECT_TRUE(evaluator.expression("field_a != MATCHES and field_a matches ^[a-z]+$"));
+    EXPECT_TRUE(evaluator.evaluate(foo));
+    EXPECT_TRUE(evaluator.evaluate(bar));
+}
+
+TEST_F(EvaluatorTest, FloatingPointMagnitudes) {
+    booleval::evaluator<> evaluator({
+        { "field_d", &obj<double>::value_a },
+        { "field_f", &obj<float>::value_a }
+    });
+
+    EXPECT_TRUE(evaluator.expression("field_d 0.0001"));
+    EXPECT_TRUE(evaluator.evaluate(obj<double>{ 0.0001 }));
+    EXPECT_FALSE(evaluator.evaluate(obj<double>{ 0.001 }));
+
+    EXPECT_TRUE(evaluator.expression("field_d == 0.00001 or field_d == -0.0000025"));
+    EXPECT_TRUE(evaluator.evaluate(obj<double>{ 0.00001 }));
+    EXPECT_TRUE(evaluator.evaluate(obj<double>{ -2.5e-6 }));
+
+    EXPECT_TRUE(evaluator.expression("field_f 0.0001"));
+    EXPECT_TRUE(evaluator.evaluate(obj<float>{ 0.0001F }));
+
+    EXPECT_TRUE(evaluator.expression("field_d 123456789012345680"));
+    EXPECT_TRUE(evaluator.evaluate(obj<double>{ 1.2345678901234568e17 }));
+
+    EXPECT_TRUE(evaluator.expression("field_d neq 100000000000000000000"));
+    EXPECT_FALSE(evaluator.evaluate(obj<double>{ 1e20 }));
+}
+
+TEST_F(EvaluatorTest, NullFieldValue) {
+    obj<std::string> foo{ "foo" };
+
+    booleval::evaluator<booleval::utils::any_mem_fn_bool> evaluator({
+        { "field_a_valid", &obj<std::string>::value_a_valid },
+        { "field_a_not_valid", &obj<std::string>::value_a_notvalid }
+    });
+
+    EXPECT_TRUE(evaluator.expression("field_a_not_valid neq foo"));
+    EXPECT_FALSE(evaluator.evaluate(foo));
+
+    EXPECT_TRUE(evaluator.expression("field_a_not_valid is null"));
+    EXPECT_TRUE(evaluator.evaluate(foo));
+
+    EXPECT_TRUE(evaluator.expression("field_a_not_valid IS NOT NULL"));
+    EXPECT_FALSE(evaluator.evaluate(foo));
+
+    EXPECT_TRUE(evaluator.expression("field_a_valid is not null and field_a_valid foo"));
+    EXPECT_TRUE(evaluator.evaluate(foo));
+
+    EXPECT_TRUE(evaluator.expression("field_a_not_valid foo or field_a_valid is null"));
+    EXPECT_FALSE(evaluator.evaluate(foo));
+
+    EXPECT_TRUE(evaluator.expression("(field_a_not_valid neq bar or field_a_valid foo) and field_a_not_valid is null"));
+    EXPECT_TRUE(evaluator.evaluate(foo));
+
+    EXPECT_FALSE(evaluator.expression("field_a_valid is null foo"));
+}
+
+TEST_F(EvaluatorTest, DecisionDiagram) {
+    booleval::evaluator<> evaluator({
+        { "field_a", &multi_obj<std::string, unsigned>::value_a },
+        { "field_b", &multi_obj<std::string, unsigned>::value_b }
+    });
+
+    EXPECT_FALSE(evaluator.compile_decision_diagram());
+
+    EXPECT_TRUE(evaluator.expression("(field_a foo or field_b > 10) and (field_a foo or field_b < 20 or field_a contains o)"));
+    EXPECT_TRUE(evaluator.compile_decision_diagram());
+    EXPECT_EQ(evaluator.decision_diagram().variables(), 4);
+
+    EXPECT_TRUE(evaluator.evaluate(multi_obj<std::string, unsigned>{ "foo", 1 }));
+    EXPECT_TRUE(evaluator.evaluate(multi_obj<std::string, unsigned>{ "bar", 15 }));
+    EXPECT_TRUE(evaluator.evaluate(multi_obj<std::string, unsigned>{ "boo", 25 }));
+    EXPECT_FALSE(evaluator.evaluate(multi_obj<std::string, unsigned>{ "bar", 25 }));
+    EXPECT_FALSE(evaluator.evaluate(multi_obj<std::string, unsigned>{ "bar", 5 }));
+
+    EXPECT_FALSE(evaluator.compile_decision_diagram(1));
+    EXPECT_FALSE(evaluator.decision_diagram().is_built());
+    EXPECT_TRUE(evaluator.evaluate(multi_obj<std::string, unsigned>{ "bar", 15 }));
+
+    EXPECT_TRUE(evaluator.compile_decision_diagram());
+    EXPECT_TRUE(evaluator.expression("field_a bar"));
+    EXPECT_FALSE(evaluator.decision_diagram().is_built());
+    EXPECT_TRUE(evaluator.evaluate(multi_obj<std::string, unsigned>{ "bar", 15 }));
+}
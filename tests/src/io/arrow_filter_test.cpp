@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <booleval/exceptions.hpp>
+#include <booleval/io/arrow_filter.hpp>
+
+class ArrowFilterTest : public testing::Test {
+public:
+    /**
+     * Owns the buffers of a record batch with the following columns:
+     * id (int32), price (float64, with nulls), symbol (utf8), active (boolean)
+     * and tag (float16, not supported).
+     */
+    struct batch {
+        std::vector<int32_t> ids;
+        std::vector<double> prices;
+        std::vector<uint8_t> price_validity;
+        std::vector<int32_t> symbol_offsets;
+        std::string symbol_data;
+        std::vector<uint8_t> active;
+
+        std::array<void const*, 2> id_buffers{};
+        std::array<void const*, 2> price_buffers{};
+        std::array<void const*, 3> symbol_buffers{};
+        std::array<void const*, 2> active_buffers{};
+        std::array<void const*, 2> tag_buffers{};
+        std::array<void const*, 1> struct_buffers{};
+
+        std::array<ArrowArray, 5> columns{};
+        std::array<ArrowArray*, 5> children{};
+        ArrowArray array{};
+
+        std::array<ArrowSchema, 5> column_schemas{};
+        std::array<ArrowSchema*, 5> schema_children{};
+        ArrowSchema schema{};
+
+        batch(std::size_t const length) {
+            static char const* symbols[] = { "AAPL", "MSFT", "GOOG" };
+
+            symbol_offsets.push_back(0);
+            price_validity.assign((length + 7) / 8, 0);
+            active.assign((length + 7) / 8, 0);
+            for (std::size_t i = 0; i < length; ++i) {
+                ids.push_back(static_cast<int32_t>(i));
+                prices.push_back(static_cast<double>(i % 10) / 2);
+                if (0 != i % 7) {
+                    price_validity[i / 8] |= static_cast<uint8_t>(1 << (i % 8));
+                }
+                symbol_data += symbols[i % 3];
+                symbol_offsets.push_back(static_cast<int32_t>(symbol_data.size()));
+                if (0 == i % 2) {
+                    active[i / 8] |= static_cast<uint8_t>(1 << (i % 8));
+                }
+            }
+
+            id_buffers = { nullptr, ids.data() };
+            price_buffers = { price_validity.data(), prices.data() };
+            symbol_buffers = { nullptr, symbol_offsets.data(), symbol_data.data() };
+            active_buffers = { nullptr, active.data() };
+            tag_buffers = { nullptr, nullptr };
+
+            auto const n = static_cast<int64_t>(length);
+            columns[0] = make_array(n, 0, 2, id_buffers.data());
+            columns[1] = make_array(n, static_cast<int64_t>(length / 7 + 1), 2, price_buffers.data());
+            columns[2] = make_array(n, 0, 3, symbol_buffers.data());
+            columns[3] = make_array(n, 0, 2, active_buffers.data());
+            columns[4] = make_array(n, 0, 2, tag_buffers.data());
+            for (std::size_t i = 0; i < columns.size(); ++i) {
+                children[i] = &columns[i];
+            }
+
+            array = make_array(n, 0, 1, struct_buffers.data());
+            array.n_children = 5;
+            array.children = children.data();
+
+            column_schemas[0] = make_schema("i", "id");
+            column_schemas[1] = make_schema("g", "price");
+            column_schemas[2] = make_schema("u", "symbol");
+            column_schemas[3] = make_schema("b", "active");
+            column_schemas[4] = make_schema("e", "tag");
+            for (std::size_t i = 0; i < column_schemas.size(); ++i) {
+                schema_children[i] = &column_schemas[i];
+            }
+
+            schema = make_schema("+s", "");
+            schema.n_children = 5;
+            schema.children = schema_children.data();
+        }
+
+        static ArrowArray make_array(int64_t const length, int64_t const null_count,
+                                     int64_t const n_buffers, void const** buffers) {
+            ArrowArray a{};
+            a.length = length;
+            a.null_count = null_count;
+            a.n_buffers = n_buffers;
+            a.buffers = buffers;
+            return a;
+        }
+
+        static ArrowSchema make_schema(char const* format, char const* name) {
+            ArrowSchema s{};
+            s.format = format;
+            s.name = name;
+            return s;
+        }
+    };
+
+    static std::vector<std::size_t> expected(std::size_t const first, std::size_t const last, bool (*predicate)(std::size_t)) {
+        std::vector<std::size_t> indices;
+        for (auto i = first; i < last; ++i) {
+            if (predicate(i)) {
+                indices.push_back(i - first);
+            }
+        }
+        return indices;
+    }
+};
+
+TEST_F(ArrowFilterTest, Schema) {
+    using namespace booleval;
+
+    batch b{ 10 };
+    io::arrow_filter filter{ b.schema };
+
+    EXPECT_FALSE(filter.is_activated());
+    EXPECT_TRUE(filter.expression("id > 1 and symbol AAPL"));
+    EXPECT_TRUE(filter.is_activated());
+
+    EXPECT_THROW((void) filter.expression("name foo"), field_not_found);
+    EXPECT_FALSE(filter.is_activated());
+    EXPECT_THROW((void) filter.expression("tag 1"), field_not_found);
+
+    EXPECT_FALSE(filter.expression("(id 1"));
+    EXPECT_TRUE(filter.expression(""));
+    EXPECT_FALSE(filter.is_activated());
+
+    EXPECT_THROW(io::arrow_filter{ b.column_schemas[0] }, schema_error);
+}
+
+TEST_F(ArrowFilterTest, Columns) {
+    using namespace booleval;
+
+    batch b{ 3000 };
+    io::arrow_filter filter{ b.schema };
+
+    EXPECT_TRUE(filter.expression("id >= 1000 and id < 1010"));
+    EXPECT_EQ(filter.select(b.array), expected(0, 3000, [](auto i) { return i >= 1000 && i < 1010; }));
+
+    // Null prices satisfy no comparison, not even neq
+    EXPECT_TRUE(filter.expression("price neq 1.5"));
+    EXPECT_EQ(filter.select(b.array), expected(0, 3000, [](auto i) { return 0 != i % 7 && 3 != i % 10; }));
+
+    EXPECT_TRUE(filter.expression("price 4.5 or symbol GOOG"));
+    EXPECT_EQ(filter.select(b.array), expected(0, 3000, [](auto i) { return (0 != i % 7 && 9 == i % 10) || 2 == i % 3; }));
+
+    EXPECT_TRUE(filter.expression("symbol > GOOG"));
+    EXPECT_EQ(filter.select(b.array), expected(0, 3000, [](auto i) { return 1 == i % 3; }));
+
+    EXPECT_TRUE(filter.expression("active true and id < 10"));
+    EXPECT_EQ(filter.select(b.array), (std::vector<std::size_t>{ 0, 2, 4, 6, 8 }));
+
+    EXPECT_TRUE(filter.expression("active 0 and id < 10"));
+    EXPECT_EQ(filter.select(b.array), (std::vector<std::size_t>{ 1, 3, 5, 7, 9 }));
+}
+
+TEST_F(ArrowFilterTest, Offsets) {
+    using namespace booleval;
+
+    batch b{ 3000 };
+    io::arrow_filter filter{ b.schema };
+
+    // Sliced batch starting at an offset not aligned to bytes
+    b.array.offset = 13;
+    b.array.length = 2500;
+    EXPECT_TRUE(filter.expression("price > 3 and active false"));
+    EXPECT_EQ(filter.select(b.array), expected(13, 2513, [](auto i) { return 0 != i % 7 && i % 10 > 6 && 1 == i % 2; }));
+
+    // Sliced column
+    b.columns[2].offset = 1;
+    EXPECT_TRUE(filter.expression("symbol AAPL"));
+    EXPECT_EQ(filter.select(b.array), expected(13, 2513, [](auto i) { return 0 == (i + 1) % 3; }));
+}
+
+TEST_F(ArrowFilterTest, NullRows) {
+    using namespace booleval;
+
+    batch b{ 16 };
+    std::array<uint8_t, 2> validity{ 0xFF, 0x0F };
+    b.struct_buffers[0] = validity.data();
+    b.array.null_count = 4;
+
+    io::arrow_filter filter{ b.schema };
+    EXPECT_TRUE(filter.expression("id >= 10"));
+    EXPECT_EQ(filter.select(b.array), (std::vector<std::size_t>{ 10, 11 }));
+}
+
+TEST_F(ArrowFilterTest, NullTests) {
+    using namespace booleval;
+
+    batch b{ 3000 };
+    io::arrow_filter filter{ b.schema };
+
+    EXPECT_TRUE(filter.expression("price is null"));
+    EXPECT_EQ(filter.select(b.array), expected(0, 3000, [](auto i) { return 0 == i % 7; }));
+
+    EXPECT_TRUE(filter.expression("price is not null and symbol AAPL"));
+    EXPECT_EQ(filter.select(b.array), expected(0, 3000, [](auto i) { return 0 != i % 7 && 0 == i % 3; }));
+
+    EXPECT_TRUE(filter.expression("price is null or price > 4"));
+    EXPECT_EQ(filter.select(b.array), expected(0, 3000, [](auto i) { return 0 == i % 7 || i % 10 > 8; }));
+
+    EXPECT_TRUE(filter.expression("id IS NULL"));
+    EXPECT_TRUE(filter.select(b.array).empty());
+
+    b.array.offset = 13;
+    b.array.length = 2500;
+    EXPECT_TRUE(filter.expression("price is null"));
+    EXPECT_EQ(filter.select(b.array), expected(13, 2513, [](auto i) { return 0 == i % 7; }));
+}
+
+TEST_F(ArrowFilterTest, StringMatching) {
+    using namespace booleval;
+
+    batch b{ 3000 };
+    io::arrow_filter filter{ b.schema };
+
+    EXPECT_TRUE(filter.expression("symbol starts_with G or symbol ends_with FT"));
+    EXPECT_EQ(filter.select(b.array), expected(0, 3000, [](auto i) { return 0 != i % 3; }));
+
+    EXPECT_TRUE(filter.expression("symbol like \"_A%L\" and id contains 99"));
+    EXPECT_EQ(filter.select(b.array), expected(0, 3000, [](auto i) {
+        return 0 == i % 3 && std::to_string(i).find("99") != std::string::npos;
+    }));
+
+    // Null prices match no pattern
+    EXPECT_TRUE(filter.expression("price like \"%.5\""));
+    EXPECT_EQ(filter.select(b.array), expected(0, 3000, [](auto i) { return 0 != i % 7 && 1 == i % 2; }));
+}
+
+TEST_F(ArrowFilterTest, MismatchedBatch) {
+    using namespace booleval;
+
+    batch b{ 16 };
+    io::arrow_filter filter{ b.schema };
+    EXPECT_TRUE(filter.expression("id 1"));
+
+    b.array.n_children = 2;
+    std::vector<uint64_t> bits;
+    EXPECT_THROW((void) filter.evaluate(b.array, bits), schema_error);
+}
+
+TEST_F(ArrowFilterTest, Bitmap) {
+    using namespace booleval;
+
+    batch b{ 3000 };
+    io::arrow_filter filter{ b.schema };
+    EXPECT_TRUE(filter.expression("id >= 1000 and id < 1010"));
+
+    utils::bitmap bits;
+    EXPECT_EQ(filter.evaluate(b.array, bits), 10U);
+    EXPECT_EQ(bits.size(), 3000U);
+    EXPECT_EQ(bits.indices(), filter.select(b.array));
+
+    EXPECT_TRUE(filter.expression("id < 3"));
+    EXPECT_EQ(filter.evaluate(b.array, bits), 3U);
+    EXPECT_EQ(bits.indices(), (std::vector<std::size_t>{ 0, 1, 2 }));
+}
+
+TEST_F(ArrowFilterTest, ZoneMap) {
+    using namespace booleval;
+
+    batch b{ 5000 };
+    io::arrow_filter filter{ b.schema };
+
+    io::zone_map zones{ 500 };
+    zones.add("id", b.ids);
+    zones.add("price", b.prices);
+
+    char const* expressions[] = {
+        "id >= 3000 and price > 2",
+        "id < 100 or price >= 4.5",
+        "id neq 10000 and price < 5",
+        "id > 4000 and symbol MSFT",
+        "(id < 1500 or id > 3500) and active true",
+        "id 2500 or price is null"
+    };
+
+    for (auto const expression : expressions) {
+        EXPECT_TRUE(filter.expression(expression));
+
+        utils::bitmap expected_bits;
+        utils::bitmap bits;
+        EXPECT_EQ(filter.evaluate(b.array, zones, bits), filter.evaluate(b.array, expected_bits)) << expression;
+        EXPECT_EQ(bits, expected_bits) << expression;
+    }
+
+    // Statistics claiming all ids are 0 decide the comparisons without scanning them
+    io::zone_map wrong{ 500 };
+    wrong.add("id", std::vector<int32_t>(5000, 0));
+
+    EXPECT_TRUE(filter.expression("id > 0"));
+    utils::bitmap bits;
+    EXPECT_EQ(filter.evaluate(b.array, wrong, bits), 0U);
+
+    EXPECT_TRUE(filter.expression("id < 1 and price is not null"));
+    EXPECT_EQ(filter.evaluate(b.array, wrong, bits), 5000U - 715U);
+
+    // Equalities are rejected by the Bloom filters of the zones
+    io::zone_map blooms{ 500 };
+    blooms.add_bloom_filters("id", b.ids);
+    blooms.add_bloom_filters("symbol", std::vector<std::string>(5000, "AAPL"));
+
+    EXPECT_TRUE(filter.expression("id 2500 or id 7000"));
+    EXPECT_EQ(filter.evaluate(b.array, blooms, bits), 1U);
+
+    EXPECT_TRUE(filter.expression("symbol MSFT or symbol AAPL"));
+    utils::bitmap expected_bits;
+    EXPECT_EQ(filter.evaluate(b.array, blooms, bits), filter.evaluate(b.array, expected_bits) - 1667U);
+}
+
+TEST_F(ArrowFilterTest, ExportBitmap) {
+    using namespace booleval;
+
+    batch b{ 100 };
+    io::arrow_filter filter{ b.schema };
+    EXPECT_TRUE(filter.expression("id < 3 or id 99"));
+
+    std::vector<uint64_t> bits;
+    EXPECT_EQ(filter.evaluate(b.array, bits), 4U);
+
+    ArrowArray array{};
+    ArrowSchema schema{};
+    io::arrow_filter::export_bitmap(std::move(bits), 100, array, schema);
+
+    EXPECT_EQ(std::string(schema.format), "b");
+    EXPECT_EQ(array.length, 100);
+    EXPECT_EQ(array.n_buffers, 2);
+    EXPECT_EQ(array.buffers[0], nullptr);
+
+    auto const values = static_cast<uint8_t const*>(array.buffers[1]);
+    EXPECT_EQ(values[0], 0x07);
+    EXPECT_EQ(values[12], 0x08);
+
+    ASSERT_NE(array.release, nullptr);
+    array.release(&array);
+    EXPECT_EQ(array.release, nullptr);
+    schema.release(&schema);
+    EXPECT_EQ(schema.release, nullptr);
+}
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <booleval/evaluator.hpp>
+#include <booleval/io/binary_batch.hpp>
+#include <booleval/tree/expression_tree.hpp>
+
+class BinaryBatchTest : public testing::Test {
+public:
+    static constexpr std::size_t record_size{ 48 };
+
+    static booleval::io::binary_schema schema() {
+        return booleval::io::binary_schema::parse(
+            "i8   int8      0\n"
+            "u8   uint8     1\n"
+            "i16  int16     2  big\n"
+            "u16  uint16    4\n"
+            "i32  int32     8\n"
+            "u32  uint32    12 big\n"
+            "i64  int64     16\n"
+            "u64  uint64    24\n"
+            "f32  float32   32\n"
+            "f64  float64   36 big\n"
+            "s    string[4] 44\n"
+        );
+    }
+
+    /**
+     * Generates records with small values so that the literals hit some of them.
+     */
+    static std::string generate(std::size_t const count) {
+        std::mt19937 generator{ 42 };
+        std::uniform_int_distribution<int> small{ -3, 3 };
+
+        std::string buffer(count * record_size, '\0');
+        for (std::size_t i = 0; i < count; ++i) {
+            auto const record = &buffer[i * record_size];
+            auto const v = small(generator);
+
+            auto const i8 = static_cast<int8_t>(v);
+            auto const u8 = static_cast<uint8_t>(v + 3);
+            auto const i16 = static_cast<uint16_t>(static_cast<int16_t>(v * 1000));
+            auto const u16 = static_cast<uint16_t>(small(generator) + 3);
+            auto const i32 = static_cast<int32_t>(small(generator));
+            auto const u32 = static_cast<uint32_t>(small(generator) + 3);
+            auto const i64 = static_cast<int64_t>(small(generator)) * 1000000000000LL;
+            auto const u64 = static_cast<uint64_t>(small(generator) + 3);
+            auto const f32 = static_cast<float>(small(generator)) / 10.0F;
+            auto const f64 = static_cast<double>(small(generator)) / 4.0;
+
+            std::memcpy(record + 0, &i8, 1);
+            std::memcpy(record + 1, &u8, 1);
+            record[2] = static_cast<char>(i16 >> 8);
+            record[3] = static_cast<char>(i16);
+            std::memcpy(record + 4, &u16, 2);
+            std::memcpy(record + 8, &i32, 4);
+            for (std::size_t b = 0; b < 4; ++b) {
+                record[12 + b] = static_cast<char>(u32 >> (8 * (3 - b)));
+            }
+            std::memcpy(record + 16, &i64, 8);
+            std::memcpy(record + 24, &u64, 8);
+            std::memcpy(record + 32, &f32, 4);
+            uint64_t f64_bits;
+            std::memcpy(&f64_bits, &f64, 8);
+            for (std::size_t b = 0; b < 8; ++b) {
+                record[36 + b] = static_cast<char>(f64_bits >> (8 * (7 - b)));
+            }
+            std::memcpy(record + 44, v > 0 ? "ab\0\0" : (v < 0 ? "abc " : "b\0\0\0"), 4);
+        }
+
+        return buffer;
+    }
+
+    /**
+     * Checks that the batch evaluation gives the same results as the evaluator.
+     */
+    static void expect_same(std::string const& expression, std::string const& buffer) {
+        using namespace booleval;
+
+        auto const binary_schema = schema();
+
+        std::map<std::string_view, io::binary_field> fields;
+        for (auto const& entry : binary_schema.fields()) {
+            fields.emplace(entry.name, entry.field);
+        }
+
+        evaluator<io::binary_field> evaluator{ fields };
+        ASSERT_TRUE(evaluator.expression(expression)) << expression;
+
+        tree::expression_tree tree;
+        ASSERT_TRUE(tree.build(expression));
+        io::binary_batch const batch{ *tree.root(), binary_schema };
+        ASSERT_TRUE(batch.is_compiled());
+
+        auto const data = reinterpret_cast<std::byte const*>(buffer.data());
+        auto const count = buffer.size() / record_size;
+
+        std::array<uint64_t, io::binary_batch::block_size / 64> bits;
+        for (std::size_t first = 0; first < count; first += io::binary_batch::block_size) {
+            auto const size = std::min(io::binary_batch::block_size, count - first);
+            bits.fill(~uint64_t{ 0 });
+
+            auto const matches = batch.evaluate(data + first * record_size, size, bits.data());
+
+            std::size_t expected_matches{ 0 };
+            for (std::size_t i = 0; i < size; ++i) {
+                io::binary_record const record(data + (first + i) * record_size, record_size);
+                auto const expected = evaluator.evaluate(record);
+                expected_matches += expected ? 1 : 0;
+                ASSERT_EQ(0 != (bits[i / 64] & (uint64_t{ 1 } << (i % 64))), expected)
+                    << expression << " at record " << first + i;
+            }
+            EXPECT_EQ(matches, expected_matches) << expression;
+
+            if (0 != size % 64) {
+                EXPECT_EQ(bits[size / 64] >> (size % 64), 0U) << expression;
+            }
+        }
+    }
+};
+
+TEST_F(BinaryBatchTest, Comparisons) {
+    auto const buffer = generate(1500);
+
+    std::vector<std::string> const literals = {
+        "0", "1", "-1", "2", "01", "+1", "1.0", "2.5", "-0", "abc", "", "1000000000000", "-2000", "0.1", "0.25", "-0.5", "nan", "ab"
+    };
+    std::vector<std::string> const operators = { "eq", "neq", "gt", "lt", "geq", "leq" };
+    std::vector<std::string> const names = { "i8", "u8", "i16", "u16", "i32", "u32", "i64", "u64", "f32", "f64", "s" };
+
+    for (auto const& name : names) {
+        for (auto const& op : operators) {
+            for (auto const& literal : literals) {
+                if (literal.empty()) {
+                    continue;
+                }
+                expect_same(name + " " + op + " " + literal, buffer);
+            }
+        }
+    }
+}
+
+TEST_F(BinaryBatchTest, LogicalOperations) {
+    auto const buffer = generate(2100);
+
+    expect_same("i8 > 0 and u16 2", buffer);
+    expect_same("i8 > 0 or u16 2", buffer);
+    expect_same("(i8 > 0 or s ab) and (f64 < 0 or u32 >= 5)", buffer);
+    expect_same("i8 > 100 and u16 2", buffer);
+    expect_same("i8 > -100 or u16 2", buffer);
+    expect_same("f32 0.1 or f32 -0.2 or i64 -3000000000000", buffer);
+    expect_same("i8 is null or u16 2", buffer);
+    expect_same("s is not null and i8 > 0", buffer);
+}
+
+TEST_F(BinaryBatchTest, Selections) {
+    auto const buffer = generate(2100);
+
+    // Operands following selective ones scan the few selected records only
+    expect_same("i8 3 and u16 3 and i32 3 and u32 > 4", buffer);
+    expect_same("i8 3 and u16 3 and (f32 < 0.1 or f64 -0.75)", buffer);
+    expect_same("i8 3 and u16 3 and (s ab or s matches \"c $\")", buffer);
+    expect_same("i8 3 and u16 3 and (i64 3000000000000 or u64 like \"%5\")", buffer);
+    expect_same("i8 3 and u16 3 and i8 > 100", buffer);
+    expect_same("i8 3 and u16 3 and i8 > -100", buffer);
+    expect_same("i8 > -3 or u16 > 0 or i32 -3 or u64 3", buffer);
+    expect_same("(i8 > -3 or u16 > 0) and (i32 -3 or i16 < -2500) and s is not null", buffer);
+}
+
+TEST_F(BinaryBatchTest, StringMatching) {
+    auto const buffer = generate(2100);
+
+    expect_same("s starts_with a", buffer);
+    expect_same("s ends_with b or s contains c", buffer);
+    expect_same("s like \"_b%\"", buffer);
+    expect_same("i8 starts_with - and u16 ends_with 2", buffer);
+    expect_same("f64 contains . or i64 like \"%00\"", buffer);
+    expect_same("s matches \"^a.?c?$\" and i32 matches \"[13579]$\"", buffer);
+}
+
+TEST_F(BinaryBatchTest, Empty) {
+    using namespace booleval;
+
+    io::binary_batch const batch;
+    EXPECT_FALSE(batch.is_compiled());
+
+    std::array<uint64_t, 1> bits{ ~uint64_t{ 0 } };
+    EXPECT_EQ(batch.evaluate(nullptr, 10, bits.data()), 0U);
+    EXPECT_EQ(bits[0], 0U);
+}
@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <array>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <sstream>
+#include <gtest/gtest.h>
+#include <booleval/exceptions.hpp>
+#include <booleval/io/binary_filter.hpp>
+
+class BinaryFilterTest : public testing::Test {
+public:
+    /**
+     * Appends a 16-byte record: little endian uint32 id, big endian int16
+     * quantity, 2 bytes of padding, little endian float32 price and
+     * 4-character symbol.
+     */
+    void append_record(std::string& buffer, uint32_t id, int16_t quantity, float price, std::string_view symbol) {
+        std::array<unsigned char, 16> record{};
+        for (std::size_t i = 0; i < 4; ++i) {
+            record[i] = static_cast<unsigned char>(id >> (8 * i));
+        }
+
+        auto const q = static_cast<uint16_t>(quantity);
+        record[4] = static_cast<unsigned char>(q >> 8);
+        record[5] = static_cast<unsigned char>(q);
+
+        uint32_t p;
+        std::memcpy(&p, &price, sizeof(p));
+        for (std::size_t i = 0; i < 4; ++i) {
+            record[8 + i] = static_cast<unsigned char>(p >> (8 * i));
+        }
+
+        std::memcpy(record.data() + 12, symbol.data(), std::min<std::size_t>(symbol.size(), 4));
+        buffer.append(reinterpret_cast<char const*>(record.data()), record.size());
+    }
+
+    booleval::io::binary_schema schema() {
+        return booleval::io::binary_schema::parse(
+            "id        uint32     0\n"
+            "quantity  int16      4  big\n"
+            "price     float32    8\n"
+            "symbol    string[4]  12\n"
+        );
+    }
+};
+
+TEST_F(BinaryFilterTest, Field) {
+    using namespace booleval::io;
+
+    std::string buffer;
+    append_record(buffer, 70000, -5, 2.5F, "AB");
+    binary_record const record(buffer.data(), buffer.size());
+
+    EXPECT_EQ(binary_field(0, binary_type::uint32).invoke(record), 70000U);
+    EXPECT_EQ(binary_field(4, binary_type::int16, byte_order::big).invoke(record), -5);
+    EXPECT_EQ(binary_field(8, binary_type::float32).invoke(record), 2.5);
+    EXPECT_EQ(binary_field(12, binary_type::string, byte_order::little, 4).invoke(record), "AB");
+    EXPECT_EQ(binary_field(14, binary_type::uint32).invoke(record), "");
+}
+
+TEST_F(BinaryFilterTest, Matches) {
+    booleval::io::binary_filter filter(schema());
+    EXPECT_TRUE(filter.expression("quantity < 0 and symbol AB"));
+    EXPECT_TRUE(filter.is_activated());
+    EXPECT_EQ(filter.schema().record_size(), 16U);
+
+    std::string buffer;
+    append_record(buffer, 1, -5, 2.5F, "AB");
+    append_record(buffer, 2, 5, 2.5F, "AB");
+
+    EXPECT_TRUE(filter.matches(booleval::io::binary_record(buffer.data(), 16)));
+    EXPECT_FALSE(filter.matches(booleval::io::binary_record(buffer.data() + 16, 16)));
+}
+
+TEST_F(BinaryFilterTest, UnknownField) {
+    booleval::io::binary_filter filter(schema());
+    EXPECT_THROW((void) filter.expression("volume > 1"), booleval::field_not_found);
+    EXPECT_FALSE(filter.is_activated());
+    EXPECT_FALSE(filter.expression("(id 1"));
+}
+
+TEST_F(BinaryFilterTest, EmptyExpression) {
+    booleval::io::binary_filter filter(schema());
+    EXPECT_TRUE(filter.expression("id 1"));
+    EXPECT_TRUE(filter.is_activated());
+
+    EXPECT_TRUE(filter.expression(""));
+    EXPECT_FALSE(filter.is_activated());
+
+    std::string buffer;
+    append_record(buffer, 1, 5, 2.5F, "AB");
+
+    booleval::utils::bitmap bits;
+    EXPECT_EQ(filter.evaluate(buffer, bits), 0U);
+    EXPECT_EQ(bits.size(), 0U);
+}
+
+TEST_F(BinaryFilterTest, SelectAndFilter) {
+    booleval::io::binary_filter filter(schema());
+    EXPECT_TRUE(filter.expression("price > 1.5 or id 3"));
+
+    std::string buffer;
+    append_record(buffer, 1, 1, 1.0F, "A");
+    append_record(buffer, 2, 1, 2.0F, "B");
+    append_record(buffer, 3, 1, 0.5F, "C");
+    append_record(buffer, 4, 1, 1.5F, "D");
+    buffer += "trailing";
+
+    EXPECT_EQ(filter.select(buffer), (std::vector<std::size_t>{ 1, 2 }));
+
+    std::ostringstream out;
+    EXPECT_EQ(filter.filter(buffer, out), 2U);
+    EXPECT_EQ(out.str(), buffer.substr(16, 32));
+}
+
+TEST_F(BinaryFilterTest, EvaluateBuffer) {
+    booleval::io::binary_filter filter(schema());
+    EXPECT_TRUE(filter.expression("id < 3 or price > 2999"));
+
+    std::string buffer;
+    for (uint32_t i = 0; i < 3000; ++i) {
+        append_record(buffer, i, 1, static_cast<float>(i), "A");
+    }
+
+    booleval::utils::bitmap bits;
+    EXPECT_EQ(filter.evaluate(buffer, bits), 3U);
+    EXPECT_EQ(bits.size(), 3000U);
+    EXPECT_EQ(bits.count(), 3U);
+    EXPECT_EQ(bits.indices(), (std::vector<std::size_t>{ 0, 1, 2 }));
+
+    EXPECT_TRUE(filter.expression("price >= 1000 and price < 2100"));
+    EXPECT_EQ(filter.evaluate(buffer, bits), 1100U);
+    EXPECT_EQ(bits.indices(), filter.select(buffer));
+    EXPECT_FALSE(bits.test(999));
+    EXPECT_TRUE(bits.test(1000));
+    EXPECT_TRUE(bits.test(2099));
+    EXPECT_FALSE(bits.test(2100));
+}
+
+TEST_F(BinaryFilterTest, ZoneMap) {
+    booleval::io::binary_filter filter(schema());
+
+    std::string buffer;
+    std::vector<uint32_t> ids;
+    std::vector<float> prices;
+    for (uint32_t i = 0; i < 5000; ++i) {
+        ids.push_back(i);
+        prices.push_back(static_cast<float>(i % 10));
+        append_record(buffer, i, 1, prices.back(), "A");
+    }
+
+    booleval::io::zone_map zones{ 1000 };
+    zones.add("id", ids);
+    zones.add("price", prices);
+
+    char const* expressions[] = {
+        "id >= 3000 and price > 2",
+        "id < 100 or price >= 9",
+        "id neq 10000 and price < 5",
+        "(id < 1500 or id > 3500) and symbol A",
+        "id 2500 or id 4999"
+    };
+
+    for (auto const expression : expressions) {
+        EXPECT_TRUE(filter.expression(expression));
+
+        booleval::utils::bitmap expected_bits;
+        booleval::utils::bitmap bits;
+        EXPECT_EQ(filter.evaluate(buffer, zones, bits), filter.evaluate(buffer, expected_bits)) << expression;
+        EXPECT_EQ(bits, expected_bits) << expression;
+    }
+
+    // Statistics claiming all ids are 0 decide the comparisons without scanning them
+    booleval::io::zone_map wrong{ 1000 };
+    wrong.add("id", std::vector<uint32_t>(5000, 0));
+    wrong.add("price", std::vector<float>(5000, 0.0F));
+
+    booleval::utils::bitmap bits;
+    EXPECT_TRUE(filter.expression("id > 0"));
+    EXPECT_EQ(filter.evaluate(buffer, wrong, bits), 0U);
+    EXPECT_TRUE(filter.expression("id <= 0"));
+    EXPECT_EQ(filter.evaluate(buffer, wrong, bits), 5000U);
+
+    // float32 comparisons are always scanned
+    EXPECT_TRUE(filter.expression("price > 0"));
+    EXPECT_EQ(filter.evaluate(buffer, wrong, bits), 4500U);
+}
+
+TEST_F(BinaryFilterTest, ZoneMapBloomFilters) {
+    booleval::io::binary_filter filter(schema());
+
+    std::string buffer;
+    std::vector<int16_t> quantities;
+    std::vector<float> prices;
+    std::vector<std::string> symbols;
+    for (uint32_t i = 0; i < 5000; ++i) {
+        quantities.push_back(static_cast<int16_t>(i % 7 - 3));
+        prices.push_back(0 == i % 999 ? 0.0001F : static_cast<float>(i % 10) / 4);
+        symbols.push_back("S" + std::to_string(i / 1000));
+        append_record(buffer, i, quantities.back(), prices.back(), symbols.back());
+    }
+
+    booleval::io::zone_map zones{ 1000 };
+    zones.add_bloom_filters("quantity", quantities);
+    zones.add_bloom_filters("price", prices);
+    zones.add_bloom_filters("symbol", symbols);
+
+    char const* expressions[] = {
+        "symbol S3",
+        "symbol S3 and quantity -2",
+        "quantity 10 or symbol S9",
+        "price 0.25 and symbol neq S1",
+        "price 0.250 or (symbol S0 and id > 500)",
+        "price 0.0001",
+        "price 0.0001 and symbol S2"
+    };
+
+    for (auto const expression : expressions) {
+        EXPECT_TRUE(filter.expression(expression));
+
+        booleval::utils::bitmap expected_bits;
+        booleval::utils::bitmap bits;
+        EXPECT_EQ(filter.evaluate(buffer, zones, bits), filter.evaluate(buffer, expected_bits)) << expression;
+        EXPECT_EQ(bits, expected_bits) << expression;
+    }
+
+    // Filters claiming the zones hold no symbols skip the equalities without scanning them
+    booleval::io::zone_map wrong{ 1000 };
+    wrong.add_bloom_filters("symbol", std::vector<booleval::utils::bloom_filter>(5, booleval::utils::bloom_filter(1000)));
+
+    booleval::utils::bitmap bits;
+    EXPECT_TRUE(filter.expression("price 0.0001"));
+    EXPECT_EQ(filter.evaluate(buffer, zones, bits), 6U);
+
+    EXPECT_TRUE(filter.expression("symbol S1"));
+    EXPECT_EQ(filter.evaluate(buffer, wrong, bits), 0U);
+    EXPECT_TRUE(filter.expression("symbol neq S1"));
+    EXPECT_EQ(filter.evaluate(buffer, wrong, bits), 4000U);
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string>
+#include <gtest/gtest.h>
+#include <booleval/exceptions.hpp>
+#include <booleval/io/binary_schema.hpp>
+
+class BinarySchemaTest : public testing::Test {};
+
+TEST_F(BinarySchemaTest, AddFields) {
+    using namespace booleval::io;
+
+    binary_schema schema;
+    EXPECT_TRUE(schema.add("id", binary_field(0, binary_type::uint32)));
+    EXPECT_TRUE(schema.add("price", binary_field(8, binary_type::float64, byte_order::big)));
+    EXPECT_FALSE(schema.add("id", binary_field(16, binary_type::uint8)));
+    EXPECT_FALSE(schema.add("symbol", binary_field(16, binary_type::string)));
+    EXPECT_FALSE(schema.add("", binary_field(16, binary_type::uint8)));
+
+    ASSERT_EQ(schema.fields().size(), 2U);
+    EXPECT_EQ(schema.fields()[0].name, "id");
+    EXPECT_EQ(schema.fields()[1].name, "price");
+    EXPECT_EQ(schema.record_size(), 16U);
+
+    schema.record_size(32);
+    EXPECT_EQ(schema.record_size(), 32U);
+
+    schema.record_size(4);
+    EXPECT_EQ(schema.record_size(), 16U);
+
+    ASSERT_NE(schema.find("price"), nullptr);
+    EXPECT_EQ(schema.find("price")->offset(), 8U);
+    EXPECT_EQ(schema.find("price")->order(), byte_order::big);
+    EXPECT_EQ(schema.find("volume"), nullptr);
+}
+
+TEST_F(BinarySchemaTest, Parse) {
+    using namespace booleval::io;
+
+    auto const schema = binary_schema::parse(
+        "# trade record\n"
+        "record_size 32\n"
+        "\n"
+        "id      uint32     0\n"
+        "price   float64    8  big  # in USD\n"
+        "symbol  string[8]  16 little\n"
+        "volume  int16      24\r\n"
+    );
+
+    EXPECT_EQ(schema.record_size(), 32U);
+    ASSERT_EQ(schema.fields().size(), 4U);
+
+    auto const symbol = schema.find("symbol");
+    ASSERT_NE(symbol, nullptr);
+    EXPECT_EQ(symbol->type(), binary_type::string);
+    EXPECT_EQ(symbol->offset(), 16U);
+    EXPECT_EQ(symbol->width(), 8U);
+
+    auto const volume = schema.find("volume");
+    ASSERT_NE(volume, nullptr);
+    EXPECT_EQ(volume->type(), binary_type::int16);
+    EXPECT_EQ(volume->width(), 2U);
+    EXPECT_EQ(volume->order(), byte_order::little);
+}
+
+TEST_F(BinarySchemaTest, ParseInvalid) {
+    using namespace booleval;
+
+    EXPECT_THROW((void) io::binary_schema::parse(""), schema_error);
+    EXPECT_THROW((void) io::binary_schema::parse("id uint32"), schema_error);
+    EXPECT_THROW((void) io::binary_schema::parse("id uint33 0"), schema_error);
+    EXPECT_THROW((void) io::binary_schema::parse("id uint32 -1"), schema_error);
+    EXPECT_THROW((void) io::binary_schema::parse("id uint32 0 middle"), schema_error);
+    EXPECT_THROW((void) io::binary_schema::parse("id uint32 0\nid uint8 4"), schema_error);
+    EXPECT_THROW((void) io::binary_schema::parse("name string[] 0"), schema_error);
+    EXPECT_THROW((void) io::binary_schema::parse("record_size 2\nid uint32 0"), schema_error);
+
+    try {
+        (void) io::binary_schema::parse("id uint32 0\nprice double 4");
+        FAIL();
+    } catch (schema_error const& e) {
+        EXPECT_STREQ(e.what(), "Line 2: invalid type 'double'");
+    }
+}
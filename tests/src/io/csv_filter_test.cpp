@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <gtest/gtest.h>
+#include <booleval/io/csv_filter.hpp>
+
+class CsvFilterTest : public testing::Test {
+public:
+    std::vector<std::string_view> matches(booleval::io::csv_filter const& filter, std::string_view rows) {
+        std::vector<std::string_view> lines;
+        filter.for_each_match(rows, [&lines](auto const, auto const line) {
+            lines.push_back(line);
+        });
+        return lines;
+    }
+};
+
+TEST_F(CsvFilterTest, InvalidExpression) {
+    booleval::io::csv_filter filter;
+    EXPECT_FALSE(filter.expression("(name foo"));
+    EXPECT_FALSE(filter.is_activated());
+    EXPECT_TRUE(filter.header("name"));
+    EXPECT_TRUE(matches(filter, "foo\n").empty());
+}
+
+TEST_F(CsvFilterTest, Header) {
+    booleval::io::csv_filter filter;
+    EXPECT_TRUE(filter.expression("name foo and age > 18"));
+    EXPECT_TRUE(filter.header("\xEF\xBB\xBFid,\"name\",age\r"));
+    EXPECT_FALSE(filter.header("id,name,city"));
+}
+
+TEST_F(CsvFilterTest, SplitHeader) {
+    std::string_view buffer{ "a,b\n1,2\n3,4\n" };
+    EXPECT_EQ(booleval::io::csv_filter::split_header(buffer), "a,b");
+    EXPECT_EQ(buffer, "1,2\n3,4\n");
+
+    std::string_view header_only{ "a,b" };
+    EXPECT_EQ(booleval::io::csv_filter::split_header(header_only), "a,b");
+    EXPECT_TRUE(header_only.empty());
+}
+
+TEST_F(CsvFilterTest, ReferencedColumns) {
+    booleval::io::csv_filter filter;
+    EXPECT_TRUE(filter.expression("city Paris and age >= 30"));
+    EXPECT_TRUE(filter.header("id,name,age,city,country"));
+
+    auto const lines = matches(filter,
+        "1,Alice,31,Paris,France\n"
+        "2,Bob,25,Paris,France\r\n"
+        "3,Carol,42,Paris,France\r\n"
+        "4,Dave,42,Lyon,France"
+    );
+
+    ASSERT_EQ(lines.size(), 2U);
+    EXPECT_EQ(lines[0], "1,Alice,31,Paris,France");
+    EXPECT_EQ(lines[1], "3,Carol,42,Paris,France");
+}
+
+TEST_F(CsvFilterTest, QuotedValues) {
+    booleval::io::csv_filter filter;
+    EXPECT_TRUE(filter.expression("city \"New York\""));
+    EXPECT_TRUE(filter.header("name,city,note"));
+
+    auto const lines = matches(filter,
+        "\"Smith, John\",\"New York\",\"multi\nline, note\"\n"
+        "Jane,Boston,\"say \"\"hi\"\"\"\n"
+        "\"Doe\nJohn\",\"New York\",\n"
+    );
+
+    ASSERT_EQ(lines.size(), 2U);
+    EXPECT_EQ(lines[0], "\"Smith, John\",\"New York\",\"multi\nline, note\"");
+    EXPECT_EQ(lines[1], "\"Doe\nJohn\",\"New York\",");
+}
+
+TEST_F(CsvFilterTest, DoubledQuotes) {
+    booleval::io::csv_filter filter;
+    EXPECT_TRUE(filter.expression("note like \"say _hi_\" and name Jane"));
+    EXPECT_TRUE(filter.header("name,note"));
+
+    auto const lines = matches(filter,
+        "Jane,\"say \"\"hi\"\"\"\n"
+        "Jane,\"say hi\"\n"
+        "\"Jane\",\"say \"\"\"\"hi\"\"\"\"\"\n"
+    );
+
+    ASSERT_EQ(lines.size(), 1U);
+    EXPECT_EQ(lines[0], "Jane,\"say \"\"hi\"\"\"");
+
+    auto record = filter.make_record();
+    EXPECT_FALSE(filter.matches("Jane,\"say \"\"hi\"\" \"\"\"\"\"", record));
+    EXPECT_EQ(record[0].text, "say \"hi\" \"\"");
+}
+
+TEST_F(CsvFilterTest, MissingValues) {
+    booleval::io::csv_filter filter;
+    EXPECT_TRUE(filter.expression("a 1 or b x"));
+    EXPECT_TRUE(filter.header("a,b,c"));
+
+    auto const lines = matches(filter,
+        "1,,\n"
+        ",x,\n"
+        ",\"\",\n"
+        ",\n"
+        "2\n"
+    );
+
+    ASSERT_EQ(lines.size(), 2U);
+    EXPECT_EQ(lines[0], "1,,");
+    EXPECT_EQ(lines[1], ",x,");
+}
+
+TEST_F(CsvFilterTest, TabSeparatedValues) {
+    booleval::io::csv_filter filter('\t');
+    EXPECT_EQ(filter.delimiter(), '\t');
+    EXPECT_TRUE(filter.expression("score > 0.5"));
+    EXPECT_TRUE(filter.header("id\tscore\tlabel"));
+
+    auto const lines = matches(filter,
+        "1\t0.75\ta,b\n"
+        "2\t0.25\tc\n"
+    );
+
+    ASSERT_EQ(lines.size(), 1U);
+    EXPECT_EQ(lines[0], "1\t0.75\ta,b");
+}
+
+TEST_F(CsvFilterTest, SelectRowIndices) {
+    booleval::io::csv_filter filter;
+    EXPECT_TRUE(filter.expression("value > 1"));
+    EXPECT_TRUE(filter.header("value"));
+
+    auto const indices = filter.select("2\n1\n\n3\n0\n5");
+    EXPECT_EQ(indices, (std::vector<std::size_t>{ 0, 2, 4 }));
+}
+
+TEST_F(CsvFilterTest, RowBoundaries) {
+    booleval::io::csv_filter filter;
+
+    std::string_view const rows{ "a,\"x\ny\",1\r\n\nb,2,\"p\nq\"\nc,3" };
+    EXPECT_EQ(filter.count_rows(rows), 3U);
+    EXPECT_EQ(filter.count_rows("a\n\r\n\n"), 1U);
+    EXPECT_EQ(filter.count_rows(""), 0U);
+
+    // Line breaks within quoted values are not row boundaries
+    EXPECT_EQ(filter.row_boundary(rows, 0), 0U);
+    EXPECT_EQ(filter.row_boundary(rows, 4), 0U);
+    EXPECT_EQ(filter.row_boundary(rows, 11), 11U);
+    EXPECT_EQ(filter.row_boundary(rows, 15), 12U);
+    EXPECT_EQ(filter.row_boundary(rows, 21), 12U);
+    EXPECT_EQ(filter.row_boundary(rows, 22), 22U);
+
+    // The last row is not complete until its line break
+    EXPECT_EQ(filter.row_boundary(rows, rows.size()), 22U);
+    EXPECT_EQ(filter.row_boundary("a,1\nb,\"2\n", 9), 4U);
+    EXPECT_EQ(filter.row_boundary("a,1\nb,2\n", 8), 8U);
+}
+
+TEST_F(CsvFilterTest, FilterToStream) {
+    booleval::io::csv_filter filter;
+    EXPECT_TRUE(filter.expression("b gt 1"));
+    EXPECT_TRUE(filter.header("a,b"));
+
+    std::ostringstream out;
+    EXPECT_EQ(filter.filter("x,1\ny,2\nz,3", out), 2U);
+    EXPECT_EQ(out.str(), "y,2\nz,3\n");
+
+    auto record = filter.make_record();
+    EXPECT_TRUE(filter.matches("w,4", record));
+    EXPECT_FALSE(filter.matches("w,0", record));
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <cstdio>
+#include <string>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <booleval/io/mapped_file.hpp>
+
+class MappedFileTest : public testing::Test {
+public:
+    std::string write_file(std::string const& name, std::string const& content) {
+        auto path = testing::TempDir() + name;
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+        return path;
+    }
+};
+
+TEST_F(MappedFileTest, DefaultConstructor) {
+    booleval::io::mapped_file file;
+    EXPECT_FALSE(file.is_open());
+    EXPECT_TRUE(file.data().empty());
+}
+
+TEST_F(MappedFileTest, OpenFile) {
+    auto const path = write_file("mapped_file_test.txt", "foo\nbar\n");
+
+    booleval::io::mapped_file file;
+    EXPECT_TRUE(file.open(path));
+    EXPECT_TRUE(file.is_open());
+    EXPECT_EQ(file.data(), "foo\nbar\n");
+
+    file.close();
+    EXPECT_FALSE(file.is_open());
+    EXPECT_TRUE(file.data().empty());
+
+    std::remove(path.c_str());
+}
+
+TEST_F(MappedFileTest, OpenEmptyFile) {
+    auto const path = write_file("mapped_file_empty_test.txt", "");
+
+    booleval::io::mapped_file file;
+    EXPECT_TRUE(file.open(path));
+    EXPECT_TRUE(file.is_open());
+    EXPECT_TRUE(file.data().empty());
+
+    std::remove(path.c_str());
+}
+
+TEST_F(MappedFileTest, OpenMissingFile) {
+    booleval::io::mapped_file file;
+    EXPECT_FALSE(file.open(testing::TempDir() + "mapped_file_missing_test.txt"));
+    EXPECT_FALSE(file.is_open());
+}
+
+TEST_F(MappedFileTest, MoveFile) {
+    auto const path = write_file("mapped_file_move_test.txt", "foo");
+
+    booleval::io::mapped_file file;
+    EXPECT_TRUE(file.open(path));
+
+    booleval::io::mapped_file other{ std::move(file) };
+    EXPECT_FALSE(file.is_open());
+    EXPECT_TRUE(other.is_open());
+    EXPECT_EQ(other.data(), "foo");
+
+    std::remove(path.c_str());
+}
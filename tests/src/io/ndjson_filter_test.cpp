@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <booleval/io/ndjson_filter.hpp>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+class NdjsonFilterTest : public testing::Test {
+public:
+    std::vector<std::string_view> matches(booleval::io::ndjson_filter const& filter, std::string_view buffer) {
+        std::vector<std::string_view> lines;
+        filter.for_each_match(buffer, [&lines](auto const line) {
+            lines.push_back(line);
+        });
+        return lines;
+    }
+};
+
+TEST_F(NdjsonFilterTest, InvalidExpression) {
+    booleval::io::ndjson_filter filter;
+    EXPECT_FALSE(filter.expression("(field_a foo"));
+    EXPECT_FALSE(filter.is_activated());
+    EXPECT_TRUE(matches(filter, "{\"field_a\":\"foo\"}").empty());
+}
+
+TEST_F(NdjsonFilterTest, StringField) {
+    booleval::io::ndjson_filter filter;
+    EXPECT_TRUE(filter.expression("level error"));
+    EXPECT_TRUE(filter.is_activated());
+
+    auto const lines = matches(filter,
+        "{\"level\":\"info\",\"msg\":\"started\"}\n"
+        "{\"msg\":\"failed\", \"level\" : \"error\"}\n"
+        "{\"level\":\"warning\"}\n"
+    );
+
+    ASSERT_EQ(lines.size(), 1U);
+    EXPECT_EQ(lines[0], "{\"msg\":\"failed\", \"level\" : \"error\"}");
+}
+
+TEST_F(NdjsonFilterTest, NumberFields) {
+    booleval::io::ndjson_filter filter;
+    EXPECT_TRUE(filter.expression("status >= 500 and latency > 1.5"));
+
+    auto const lines = matches(filter,
+        "{\"status\":200,\"latency\":2.5}\n"
+        "{\"status\":503,\"latency\":2.25}\r\n"
+        "{\"status\":504,\"latency\":0.5}\n"
+        "{\"status\":\"1000\",\"latency\":3}\n"
+    );
+
+    ASSERT_EQ(lines.size(), 1U);
+    EXPECT_EQ(lines[0], "{\"status\":503,\"latency\":2.25}");
+}
+
+TEST_F(NdjsonFilterTest, NumberEquality) {
+    booleval::io::ndjson_filter filter;
+
+    EXPECT_TRUE(filter.expression("price 1.0"));
+    EXPECT_EQ(matches(filter, "{\"price\":1.0}\n{\"price\":1}\n{\"price\":1.01}\n{\"price\":\"1\"}\n").size(), 2U);
+
+    EXPECT_TRUE(filter.expression("price 1.50"));
+    EXPECT_EQ(matches(filter, "{\"price\":1.50}\n{\"price\":1.5}\n{\"price\":15}\n").size(), 2U);
+
+    EXPECT_TRUE(filter.expression("x 1e2"));
+    EXPECT_EQ(matches(filter, "{\"x\":1e2}\n{\"x\":100}\n{\"x\":1E+2}\n{\"x\":\"100\"}\n").size(), 3U);
+
+    EXPECT_TRUE(filter.expression("id neq 9007199254740993"));
+    EXPECT_EQ(matches(filter, "{\"id\":9007199254740993}\n{\"id\":9007199254740992}\n").size(), 1U);
+}
+
+TEST_F(NdjsonFilterTest, EscapedStrings) {
+    booleval::io::ndjson_filter filter;
+
+    EXPECT_TRUE(filter.expression("path \"a/b\""));
+    EXPECT_EQ(matches(filter, "{\"path\":\"a\\/b\"}\n{\"path\":\"a/b\"}\n{\"path\":\"a\\\\/b\"}\n").size(), 2U);
+
+    EXPECT_TRUE(filter.expression("msg like \"say _hi_\""));
+    EXPECT_EQ(matches(filter, "{\"msg\":\"say \\\"hi\\\"\"}\n{\"msg\":\"say hi\"}\n").size(), 1U);
+
+    auto record = filter.make_record();
+    ASSERT_TRUE(filter.extract("{\"msg\":\"say \\\"hi\\\" \\\\o/\"}", record));
+    EXPECT_EQ(record[0].text, "say \"hi\" \\o/");
+
+    EXPECT_TRUE(filter.expression("name caf\u00e9 and symbol \U0001F600"));
+    EXPECT_EQ(matches(filter, "{\"name\":\"caf\\u00e9\",\"symbol\":\"\\ud83d\\ude00\"}\n").size(), 1U);
+
+    // String operators see the decoded values as well
+    EXPECT_TRUE(filter.expression("tab starts_with \"a\tb\" and tab ends_with c"));
+    EXPECT_EQ(matches(filter, "{\"tab\":\"a\\tbc\"}\n{\"tab\":\"a\\\\tbc\"}\n").size(), 1U);
+}
+
+TEST_F(NdjsonFilterTest, NestedFields) {
+    booleval::io::ndjson_filter filter;
+    EXPECT_TRUE(filter.expression("http.status 404 or http.request.method DELETE"));
+
+    auto const lines = matches(filter,
+        "{\"http\":{\"status\":404,\"request\":{\"method\":\"GET\"}}}\n"
+        "{\"http\":{\"status\":200,\"request\":{\"method\":\"DELETE\"}}}\n"
+        "{\"http\":{\"status\":200,\"request\":{\"method\":\"GET\"}}}\n"
+        "{\"status\":404}\n"
+    );
+
+    ASSERT_EQ(lines.size(), 2U);
+    EXPECT_EQ(lines[0], "{\"http\":{\"status\":404,\"request\":{\"method\":\"GET\"}}}");
+    EXPECT_EQ(lines[1], "{\"http\":{\"status\":200,\"request\":{\"method\":\"DELETE\"}}}");
+}
+
+TEST_F(NdjsonFilterTest, ObjectFieldAndNestedField) {
+    booleval::io::ndjson_filter filter;
+    EXPECT_TRUE(filter.expression("a is not null and a.b 1"));
+
+    auto const lines = matches(filter,
+        "{\"a\":{\"b\":1}}\n"
+        "{\"a\":{\"b\":2}}\n"
+        "{\"a\":1}\n"
+        "{\"c\":{\"b\":1}}\n"
+    );
+
+    ASSERT_EQ(lines.size(), 1U);
+    EXPECT_EQ(lines[0], "{\"a\":{\"b\":1}}");
+
+    auto record = filter.make_record();
+    EXPECT_TRUE(filter.expression("a.b 1 and a neq x"));
+    EXPECT_TRUE(filter.matches("{\"a\": { \"b\" : 1 }, \"c\": 2}", record));
+    EXPECT_EQ(record[1].text, "{ \"b\" : 1 }");
+}
+
+TEST_F(NdjsonFilterTest, SkipUnreferencedValues) {
+    booleval::io::ndjson_filter filter;
+    EXPECT_TRUE(filter.expression("name \"foo bar\""));
+
+    auto const lines = matches(filter,
+        "{\"tags\":[\"a\",{\"b\":\"}\"}],\"quote\":\"say \\\"hi\\\"\",\"name\":\"foo bar\"}\n"
+        "{\"meta\":{\"name\":\"foo bar\"},\"name\":\"baz\"}\n"
+    );
+
+    ASSERT_EQ(lines.size(), 1U);
+    EXPECT_EQ(lines[0], "{\"tags\":[\"a\",{\"b\":\"}\"}],\"quote\":\"say \\\"hi\\\"\",\"name\":\"foo bar\"}");
+}
+
+TEST_F(NdjsonFilterTest, MissingAndNullFields) {
+    booleval::io::ndjson_filter filter;
+    EXPECT_TRUE(filter.expression("user neq admin"));
+
+    auto const lines = matches(filter,
+        "{\"user\":\"admin\"}\n"
+        "{\"user\":\"guest\"}\n"
+        "{\"user\":null}\n"
+        "{}\n"
+    );
+
+    // Missing and null values satisfy no comparison, not even neq
+    ASSERT_EQ(lines.size(), 1U);
+    EXPECT_EQ(lines[0], "{\"user\":\"guest\"}");
+
+    EXPECT_TRUE(filter.expression("user is null"));
+    auto const nulls = matches(filter,
+        "{\"user\":\"admin\"}\n"
+        "{\"user\":null}\n"
+        "{}\n"
+    );
+
+    ASSERT_EQ(nulls.size(), 2U);
+    EXPECT_EQ(nulls[0], "{\"user\":null}");
+    EXPECT_EQ(nulls[1], "{}");
+}
+
+TEST_F(NdjsonFilterTest, InvalidRecords) {
+    booleval::io::ndjson_filter filter;
+    EXPECT_TRUE(filter.expression("a 1"));
+
+    auto const lines = matches(filter,
+        "[1,2,3]\n"
+        "{\"b\":1,\"a\"\n"
+        "{\"a\" 1}\n"
+        "{\"a\":\"1}\n"
+        "\n"
+        "{\"a\":1}"
+    );
+
+    ASSERT_EQ(lines.size(), 1U);
+    EXPECT_EQ(lines[0], "{\"a\":1}");
+}
+
+TEST_F(NdjsonFilterTest, StopsAfterReferencedFields) {
+    booleval::io::ndjson_filter filter;
+    EXPECT_TRUE(filter.expression("a 1"));
+
+    auto const lines = matches(filter, "{\"a\":1,\"b\":[\n");
+
+    ASSERT_EQ(lines.size(), 1U);
+}
+
+TEST_F(NdjsonFilterTest, FilterToStream) {
+    booleval::io::ndjson_filter filter;
+    EXPECT_TRUE(filter.expression("a gt 1"));
+
+    std::ostringstream out;
+    EXPECT_EQ(filter.filter("{\"a\":1}\n{\"a\":2}\n{\"a\":3}", out), 2U);
+    EXPECT_EQ(out.str(), "{\"a\":2}\n{\"a\":3}\n");
+}
+
+TEST_F(NdjsonFilterTest, FilterFileDescriptor) {
+    booleval::io::ndjson_filter filter;
+    EXPECT_TRUE(filter.expression("a 7"));
+
+    std::string content;
+    for (std::size_t i = 0; i < 200000; ++i) {
+        content += "{\"a\":" + std::to_string(i % 10) + ",\"padding\":\"xxxxxxxxxx\"}\n";
+    }
+
+    auto const path = testing::TempDir() + "ndjson_filter_test.json";
+    auto file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fwrite(content.data(), 1, content.size(), file);
+    std::fclose(file);
+
+#if defined(_WIN32)
+    auto const fd = ::_open(path.c_str(), _O_RDONLY | _O_BINARY);
+#else
+    auto const fd = ::open(path.c_str(), O_RDONLY);
+#endif
+    ASSERT_NE(fd, -1);
+
+    std::ostringstream out;
+    EXPECT_EQ(filter.filter(fd, out), 20000U);
+
+#if defined(_WIN32)
+    ::_close(fd);
+#else
+    ::close(fd);
+#endif
+    std::remove(path.c_str());
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <cstdio>
+#include <string>
+#include <fcntl.h>
+#include <system_error>
+#include <gtest/gtest.h>
+#include <booleval/io/stream_reader.hpp>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+class StreamReaderTest : public testing::Test {
+public:
+    int open_file(std::string const& path, std::string const& content) {
+        auto file = std::fopen(path.c_str(), "wb");
+        if (nullptr == file) {
+            return -1;
+        }
+        std::fwrite(content.data(), 1, content.size(), file);
+        std::fclose(file);
+
+#if defined(_WIN32)
+        return ::_open(path.c_str(), _O_RDONLY | _O_BINARY);
+#else
+        return ::open(path.c_str(), O_RDONLY);
+#endif
+    }
+
+    void close_file(std::string const& path, int const fd) {
+#if defined(_WIN32)
+        ::_close(fd);
+#else
+        ::close(fd);
+#endif
+        std::remove(path.c_str());
+    }
+};
+
+TEST_F(StreamReaderTest, ReadChunks) {
+    auto const path = testing::TempDir() + "stream_reader_chunks_test.txt";
+    auto const fd = open_file(path, "0123456789");
+    ASSERT_NE(fd, -1);
+
+    booleval::io::stream_reader reader(fd, 4);
+    EXPECT_TRUE(reader.read());
+    EXPECT_EQ(reader.data(), "0123");
+
+    reader.consume(3);
+    EXPECT_EQ(reader.data(), "3");
+
+    EXPECT_TRUE(reader.read());
+    EXPECT_EQ(reader.data(), "3456");
+
+    reader.consume(4);
+    EXPECT_TRUE(reader.read());
+    EXPECT_EQ(reader.data(), "789");
+
+    EXPECT_FALSE(reader.read());
+    EXPECT_EQ(reader.data(), "789");
+
+    reader.consume(10);
+    EXPECT_TRUE(reader.data().empty());
+
+    close_file(path, fd);
+}
+
+TEST_F(StreamReaderTest, GrowBuffer) {
+    auto const path = testing::TempDir() + "stream_reader_grow_test.txt";
+    auto const fd = open_file(path, "0123456789");
+    ASSERT_NE(fd, -1);
+
+    booleval::io::stream_reader reader(fd, 4);
+    EXPECT_TRUE(reader.read());
+    EXPECT_EQ(reader.data(), "0123");
+
+    EXPECT_TRUE(reader.read());
+    EXPECT_EQ(reader.data(), "01234567");
+
+    EXPECT_TRUE(reader.read());
+    EXPECT_EQ(reader.data(), "0123456789");
+
+    EXPECT_FALSE(reader.read());
+
+    close_file(path, fd);
+}
+
+#if !defined(_WIN32)
+TEST_F(StreamReaderTest, ReadAvailableBytes) {
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+
+    // Bytes written so far are returned without waiting for the buffer to fill up
+    booleval::io::stream_reader reader(fds[0], 1024);
+    ASSERT_EQ(::write(fds[1], "foo\n", 4), 4);
+    EXPECT_TRUE(reader.read());
+    EXPECT_EQ(reader.data(), "foo\n");
+
+    ASSERT_EQ(::write(fds[1], "bar\n", 4), 4);
+    EXPECT_TRUE(reader.read());
+    EXPECT_EQ(reader.data(), "foo\nbar\n");
+
+    ::close(fds[1]);
+    EXPECT_FALSE(reader.read());
+    ::close(fds[0]);
+}
+
+TEST_F(StreamReaderTest, ReadError) {
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    ::close(fds[0]);
+
+    // Reading from the write end of the pipe fails
+    booleval::io::stream_reader reader(fds[1], 1024);
+    EXPECT_THROW((void) reader.read(), std::system_error);
+    ::close(fds[1]);
+}
+#endif
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <booleval/io/text_record.hpp>
+
+class TextRecordTest : public testing::Test {};
+
+TEST_F(TextRecordTest, Clear) {
+    using namespace booleval::io;
+
+    text_record record{ 2 };
+    EXPECT_EQ(record.size(), 2U);
+
+    record[0] = text_value{ "foo", true, true };
+    record[1] = text_value{ "123", false, true };
+    EXPECT_TRUE(record[0].present);
+    EXPECT_TRUE(record[1].present);
+
+    record.clear();
+    EXPECT_FALSE(record[0].present);
+    EXPECT_FALSE(record[1].present);
+}
+
+TEST_F(TextRecordTest, FieldValues) {
+    using namespace booleval::io;
+
+    text_record record{ 5 };
+    record[0] = text_value{ "foo", true, true };
+    record[1] = text_value{ "123", false, true };
+    record[2] = text_value{ "1.50", false, true };
+    record[3] = text_value{ "123", true, true };
+    record[4] = text_value{ "12 Main St", false, true };
+
+    EXPECT_EQ(text_field{ 0 }.invoke(record), "foo");
+
+    EXPECT_EQ(text_field{ 1 }.invoke(record), "123");
+    EXPECT_TRUE(text_field{ 1 }.invoke(record) > "100");
+
+    EXPECT_EQ(text_field{ 2 }.invoke(record), "1.5");
+    EXPECT_TRUE(text_field{ 2 }.invoke(record) < "2");
+
+    // Quoted numbers are compared as strings
+    EXPECT_TRUE(text_field{ 3 }.invoke(record) < "2");
+
+    EXPECT_EQ(text_field{ 4 }.invoke(record), "12 Main St");
+}
+
+TEST_F(TextRecordTest, MissingFieldValue) {
+    using namespace booleval::io;
+
+    text_record record{ 1 };
+    EXPECT_EQ(text_field{ 0 }.invoke(record), "");
+}
+
+TEST_F(TextRecordTest, NumberEquality) {
+    using namespace booleval::io;
+
+    text_record record{ 4 };
+    record[0] = text_value{ "1.0", false, true };
+    record[1] = text_value{ "1e2", false, true };
+    record[2] = text_value{ "1.0", true, true };
+    record[3] = text_value{ "9007199254740993", false, true };
+
+    EXPECT_EQ(text_field{ 0 }.invoke(record), "1.0");
+    EXPECT_EQ(text_field{ 0 }.invoke(record), "1");
+    EXPECT_NE(text_field{ 0 }.invoke(record), "1.01");
+
+    EXPECT_EQ(text_field{ 1 }.invoke(record), "1e2");
+    EXPECT_EQ(text_field{ 1 }.invoke(record), "100");
+    EXPECT_TRUE(text_field{ 1 }.invoke(record) > "99.5");
+
+    EXPECT_EQ(text_field{ 2 }.invoke(record), "1.0");
+    EXPECT_NE(text_field{ 2 }.invoke(record), "1");
+
+    EXPECT_EQ(text_field{ 3 }.invoke(record), "9007199254740993");
+    EXPECT_NE(text_field{ 3 }.invoke(record), "9007199254740992");
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <gtest/gtest.h>
+#include <booleval/io/zone_map.hpp>
+
+class ZoneMapTest : public testing::Test {};
+
+TEST_F(ZoneMapTest, Decide) {
+    using namespace booleval::io;
+    using booleval::token::token_type;
+
+    zone_map::bounds const b{ 10, 20 };
+
+    EXPECT_EQ(zone_map::decide(token_type::eq, 5, b), zone_match::none);
+    EXPECT_EQ(zone_map::decide(token_type::eq, 15, b), zone_match::some);
+    EXPECT_EQ(zone_map::decide(token_type::neq, 25, b), zone_match::all);
+    EXPECT_EQ(zone_map::decide(token_type::neq, 20, b), zone_match::some);
+
+    EXPECT_EQ(zone_map::decide(token_type::gt, 20, b), zone_match::none);
+    EXPECT_EQ(zone_map::decide(token_type::gt, 15, b), zone_match::some);
+    EXPECT_EQ(zone_map::decide(token_type::gt, 9.5, b), zone_match::all);
+
+    EXPECT_EQ(zone_map::decide(token_type::geq, 20.5, b), zone_match::none);
+    EXPECT_EQ(zone_map::decide(token_type::geq, 20, b), zone_match::some);
+    EXPECT_EQ(zone_map::decide(token_type::geq, 10, b), zone_match::all);
+
+    EXPECT_EQ(zone_map::decide(token_type::lt, 10, b), zone_match::none);
+    EXPECT_EQ(zone_map::decide(token_type::lt, 20, b), zone_match::some);
+    EXPECT_EQ(zone_map::decide(token_type::lt, 21, b), zone_match::all);
+
+    EXPECT_EQ(zone_map::decide(token_type::leq, 9, b), zone_match::none);
+    EXPECT_EQ(zone_map::decide(token_type::leq, 10, b), zone_match::some);
+    EXPECT_EQ(zone_map::decide(token_type::leq, 20, b), zone_match::all);
+
+    auto const nan = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_EQ(zone_map::decide(token_type::gt, nan, b), zone_match::some);
+    EXPECT_EQ(zone_map::decide(token_type::gt, 0, zone_map::bounds{}), zone_match::some);
+    EXPECT_EQ(zone_map::decide(token_type::is_null, 0, b), zone_match::some);
+}
+
+TEST_F(ZoneMapTest, Find) {
+    using namespace booleval::io;
+
+    zone_map zones{ 100 };
+    EXPECT_EQ(zones.zone_size(), 100U);
+    zones.add("ts", { { 0, 99 }, { 100, 199 }, {}, { 300, 399 } });
+
+    auto const first = zones.find("ts", 0, 100);
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->min, 0);
+    EXPECT_EQ(first->max, 99);
+
+    auto const spanning = zones.find("ts", 50, 100);
+    ASSERT_TRUE(spanning.has_value());
+    EXPECT_EQ(spanning->min, 0);
+    EXPECT_EQ(spanning->max, 199);
+
+    EXPECT_FALSE(zones.find("ts", 150, 100).has_value());
+    EXPECT_TRUE(zones.find("ts", 300, 100).has_value());
+    EXPECT_FALSE(zones.find("ts", 300, 101).has_value());
+    EXPECT_FALSE(zones.find("ts", 0, 0).has_value());
+    EXPECT_FALSE(zones.find("price", 0, 100).has_value());
+
+    zones.add("ts", { { 5, 6 } });
+    EXPECT_EQ(zones.find("ts", 0, 10)->min, 5);
+}
+
+TEST_F(ZoneMapTest, Values) {
+    using namespace booleval::io;
+
+    std::vector<double> values;
+    for (std::size_t i = 0; i < 250; ++i) {
+        values.push_back(150 == i ? std::nan("") : static_cast<double>(i % 100));
+    }
+
+    zone_map zones{ 100 };
+    zones.add("value", values);
+
+    auto const b = zones.find("value", 0, 100);
+    ASSERT_TRUE(b.has_value());
+    EXPECT_EQ(b->min, 0);
+    EXPECT_EQ(b->max, 99);
+
+    EXPECT_FALSE(zones.find("value", 100, 100).has_value());
+
+    auto const last = zones.find("value", 200, 50);
+    ASSERT_TRUE(last.has_value());
+    EXPECT_EQ(last->min, 0);
+    EXPECT_EQ(last->max, 49);
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <vector>
+#include <gtest/gtest.h>
+#include <booleval/parallel/parallel_filter.hpp>
+#include <booleval/parallel/shared_evaluator.hpp>
+
+class ParallelFilterTest : public testing::Test {
+public:
+    class obj {
+    public:
+        obj() : value_a_{} {}
+        obj(uint32_t value) : value_a_{ value } {}
+        uint32_t value_a() const noexcept { return value_a_; }
+
+    private:
+        uint32_t value_a_;
+    };
+
+    std::vector<obj> make_objects(std::size_t const count) {
+        std::vector<obj> objects;
+        objects.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            objects.emplace_back(static_cast<uint32_t>(i % 10));
+        }
+        return objects;
+    }
+};
+
+TEST_F(ParallelFilterTest, SelectionVector) {
+    using namespace booleval;
+
+    auto const objects = make_objects(1000);
+
+    evaluator<> evaluator({
+        { "field_a", &obj::value_a }
+    });
+    EXPECT_TRUE(evaluator.expression("field_a 3 or field_a 7"));
+
+    parallel::thread_pool pool{ 4 };
+    auto const selection = parallel::parallel_filter(objects, evaluator, pool, 64);
+
+    ASSERT_EQ(selection.size(), 200U);
+    for (std::size_t i = 0; i < selection.size(); ++i) {
+        EXPECT_EQ(selection[i], i / 2 * 10 + (0 == i % 2 ? 3 : 7));
+    }
+}
+
+TEST_F(ParallelFilterTest, ChunkBitmaps) {
+    using namespace booleval;
+
+    auto const objects = make_objects(1000);
+
+    evaluator<> evaluator({
+        { "field_a", &obj::value_a }
+    });
+    EXPECT_TRUE(evaluator.expression("field_a lt 5"));
+
+    parallel::thread_pool pool{ 3 };
+    auto const chunks = parallel::parallel_filter_chunks(objects, evaluator, pool, 100);
+
+    // Chunk size is rounded up to 128
+    ASSERT_EQ(chunks.size(), 8U);
+    EXPECT_EQ(chunks.back().offset, 896U);
+    EXPECT_EQ(chunks.back().size, 104U);
+
+    std::size_t total{ 0 };
+    for (auto const& chunk : chunks) {
+        EXPECT_EQ(0U, reinterpret_cast<std::uintptr_t>(&chunk) % parallel::cache_line_size);
+        for (std::size_t i = 0; i < chunk.size; ++i) {
+            EXPECT_EQ(chunk.test(i), (chunk.offset + i) % 10 < 5);
+        }
+        total += chunk.count;
+    }
+    EXPECT_EQ(total, 500U);
+}
+
+TEST_F(ParallelFilterTest, SharedEvaluator) {
+    using namespace booleval;
+
+    auto const objects = make_objects(1000);
+
+    parallel::shared_evaluator<> evaluator({
+        { "field_a", &obj::value_a }
+    });
+    EXPECT_TRUE(evaluator.expression("field_a gt 7"));
+
+    parallel::thread_pool pool{ 4 };
+    auto const selection = parallel::parallel_filter(objects, evaluator, pool, 128);
+
+    ASSERT_EQ(selection.size(), 200U);
+    for (std::size_t i = 0; i < selection.size(); ++i) {
+        EXPECT_EQ(selection[i], i / 2 * 10 + (0 == i % 2 ? 8 : 9));
+    }
+}
+
+TEST_F(ParallelFilterTest, ProfiledEvaluator) {
+    using namespace booleval;
+
+    auto const objects = make_objects(1000);
+
+    evaluator<utils::any_mem_fn, true> evaluator({
+        { "field_a", &obj::value_a }
+    });
+    EXPECT_TRUE(evaluator.expression("field_a 3 or field_a 7"));
+
+    parallel::thread_pool pool{ 4 };
+    auto const selection = parallel::parallel_filter(objects, evaluator, pool, 64);
+    EXPECT_EQ(selection.size(), 200U);
+
+    auto const report = evaluator.profile();
+    ASSERT_EQ(report.nodes().size(), 3U);
+    EXPECT_EQ(report.nodes()[0].evaluations, 1000U);
+    EXPECT_EQ(report.nodes()[0].true_count, 200U);
+    EXPECT_EQ(report.nodes()[1].evaluations, 1000U);
+    EXPECT_EQ(report.nodes()[1].true_count, 100U);
+    EXPECT_EQ(report.nodes()[2].true_count, 100U);
+}
+
+TEST_F(ParallelFilterTest, EmptyRange) {
+    using namespace booleval;
+
+    std::vector<obj> objects;
+
+    evaluator<> evaluator({
+        { "field_a", &obj::value_a }
+    });
+    EXPECT_TRUE(evaluator.expression("field_a 1"));
+
+    parallel::thread_pool pool{ 2 };
+    EXPECT_TRUE(parallel::parallel_filter(objects, evaluator, pool).empty());
+}
+
+TEST_F(ParallelFilterTest, UnknownField) {
+    using namespace booleval;
+
+    auto const objects = make_objects(100);
+
+    evaluator<> evaluator({
+        { "field_a", &obj::value_a }
+    });
+    EXPECT_TRUE(evaluator.expression("field_x 1"));
+
+    parallel::thread_pool pool{ 2 };
+    EXPECT_THROW(auto selection = parallel::parallel_filter(objects, evaluator, pool), field_not_found);
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <booleval/parallel/rcu_cell.hpp>
+
+namespace {
+
+    struct tracked {
+        tracked(int const v, std::atomic<int>& alive)
+            : value(v), alive_count(alive) {
+            alive_count++;
+        }
+
+        ~tracked() {
+            alive_count--;
+        }
+
+        int value;
+        std::atomic<int>& alive_count;
+    };
+
+} // namespace
+
+class RcuCellTest : public testing::Test {};
+
+TEST_F(RcuCellTest, Empty) {
+    using namespace booleval;
+
+    parallel::rcu_cell<int> cell;
+    auto const guard = cell.read();
+    EXPECT_FALSE(guard);
+    EXPECT_EQ(guard.get(), nullptr);
+    EXPECT_EQ(cell.reclaim(), 0U);
+}
+
+TEST_F(RcuCellTest, Publish) {
+    using namespace booleval;
+
+    parallel::rcu_cell<int> cell{ std::make_unique<int>(1) };
+    EXPECT_EQ(*cell.read(), 1);
+
+    cell.publish(std::make_unique<int>(2));
+    EXPECT_EQ(*cell.read(), 2);
+    EXPECT_EQ(cell.reclaim(), 0U);
+}
+
+TEST_F(RcuCellTest, ReaderKeepsRetiredValue) {
+    using namespace booleval;
+
+    std::atomic<int> alive{ 0 };
+    parallel::rcu_cell<tracked> cell{ std::make_unique<tracked>(1, alive) };
+
+    {
+        auto const guard = cell.read();
+        cell.publish(std::make_unique<tracked>(2, alive));
+        EXPECT_EQ(guard->value, 1);
+        EXPECT_EQ(cell.read()->value, 2);
+
+        // Values retired while a reader is inside its critical section wait for it
+        cell.publish(std::make_unique<tracked>(3, alive));
+        EXPECT_EQ(cell.reclaim(), 2U);
+        EXPECT_EQ(alive.load(), 3);
+        EXPECT_EQ(guard->value, 1);
+    }
+
+    EXPECT_EQ(cell.reclaim(), 0U);
+    EXPECT_EQ(alive.load(), 1);
+    EXPECT_EQ(cell.read()->value, 3);
+}
+
+TEST_F(RcuCellTest, GuardMove) {
+    using namespace booleval;
+
+    std::atomic<int> alive{ 0 };
+    parallel::rcu_cell<tracked> cell{ std::make_unique<tracked>(1, alive) };
+
+    {
+        auto guard = cell.read();
+        auto moved = std::move(guard);
+        cell.publish(std::make_unique<tracked>(2, alive));
+        EXPECT_EQ(cell.reclaim(), 1U);
+        EXPECT_EQ(moved->value, 1);
+    }
+
+    cell.synchronize();
+    EXPECT_EQ(alive.load(), 1);
+}
+
+TEST_F(RcuCellTest, ConcurrentReadersAndWriter) {
+    using namespace booleval;
+
+    std::atomic<int> alive{ 0 };
+    std::atomic<bool> done{ false };
+    std::atomic<bool> consistent{ true };
+
+    {
+        parallel::rcu_cell<tracked> cell{ std::make_unique<tracked>(0, alive) };
+
+        std::vector<std::thread> readers;
+        for (std::size_t i = 0; i < 4; ++i) {
+            readers.emplace_back([&] {
+                auto last{ 0 };
+                while (!done.load()) {
+                    auto const guard = cell.read();
+                    auto const value = guard->value;
+                    std::this_thread::yield();
+                    if (value < last || guard->value != value) {
+                        consistent = false;
+                    }
+                    last = value;
+                }
+            });
+        }
+
+        for (auto i = 1; i <= 1000; ++i) {
+            cell.publish(std::make_unique<tracked>(i, alive));
+        }
+
+        done = true;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+
+        cell.synchronize();
+        EXPECT_EQ(alive.load(), 1);
+        EXPECT_EQ(cell.read()->value, 1000);
+    }
+
+    EXPECT_TRUE(consistent.load());
+    EXPECT_EQ(alive.load(), 0);
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <booleval/parallel/shared_evaluator.hpp>
+
+class SharedEvaluatorTest : public testing::Test {
+public:
+    struct obj {
+        obj(int const value) : value_(value) {}
+
+        int value() const noexcept { return value_; }
+
+        int value_;
+    };
+};
+
+TEST_F(SharedEvaluatorTest, NoExpression) {
+    using namespace booleval;
+
+    parallel::shared_evaluator<> evaluator{ { { "value", &obj::value } } };
+    EXPECT_FALSE(evaluator.is_activated());
+    EXPECT_FALSE(evaluator.acquire());
+    EXPECT_FALSE(evaluator.evaluate(obj{ 1 }));
+}
+
+TEST_F(SharedEvaluatorTest, ReplaceExpression) {
+    using namespace booleval;
+
+    parallel::shared_evaluator<> evaluator{ { { "value", &obj::value } } };
+
+    EXPECT_TRUE(evaluator.expression("value > 1"));
+    EXPECT_TRUE(evaluator.is_activated());
+    EXPECT_TRUE(evaluator.evaluate(obj{ 2 }));
+
+    auto const snapshot = evaluator.acquire();
+
+    EXPECT_TRUE(evaluator.expression("value < 1"));
+    EXPECT_FALSE(evaluator.evaluate(obj{ 2 }));
+    EXPECT_TRUE(evaluator.evaluate(obj{ 0 }));
+
+    EXPECT_TRUE(snapshot->evaluator.evaluate(obj{ 2 }));
+    EXPECT_EQ(snapshot->text, "value > 1");
+}
+
+TEST_F(SharedEvaluatorTest, InvalidExpressionKeepsPrevious) {
+    using namespace booleval;
+
+    parallel::shared_evaluator<> evaluator{ { { "value", &obj::value } } };
+
+    EXPECT_TRUE(evaluator.expression("value > 1"));
+    EXPECT_FALSE(evaluator.expression("(value > 1"));
+    EXPECT_TRUE(evaluator.is_activated());
+    EXPECT_TRUE(evaluator.evaluate(obj{ 2 }));
+    EXPECT_EQ(evaluator.acquire()->text, "value > 1");
+}
+
+TEST_F(SharedEvaluatorTest, ReplaceWhileEvaluating) {
+    using namespace booleval;
+
+    parallel::shared_evaluator<> evaluator{ { { "value", &obj::value } } };
+    EXPECT_TRUE(evaluator.expression("value eq 0"));
+
+    std::atomic<bool> done{ false };
+    std::atomic<bool> consistent{ true };
+
+    std::vector<std::thread> readers;
+    for (auto i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                // Each published expression matches exactly one value
+                auto const snapshot = evaluator.acquire();
+                std::size_t matches{ 0 };
+                for (auto v = 0; v < 100; ++v) {
+                    matches += snapshot->evaluator.evaluate(obj{ v }) ? 1 : 0;
+                }
+                if (1 != matches) {
+                    consistent = false;
+                }
+            }
+        });
+    }
+
+    for (auto i = 1; i < 100; ++i) {
+        EXPECT_TRUE(evaluator.expression("value eq " + std::to_string(i)));
+    }
+
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    evaluator.synchronize();
+    EXPECT_EQ(evaluator.reclaim(), 0U);
+    EXPECT_TRUE(consistent.load());
+    EXPECT_TRUE(evaluator.evaluate(obj{ 99 }));
+}
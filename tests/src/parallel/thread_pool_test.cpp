@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <atomic>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include <booleval/parallel/thread_pool.hpp>
+
+class ThreadPoolTest : public testing::Test {};
+
+TEST_F(ThreadPoolTest, Size) {
+    using namespace booleval;
+
+    parallel::thread_pool pool{ 3 };
+    EXPECT_EQ(pool.size(), 3U);
+
+    parallel::thread_pool empty_pool{ 0 };
+    EXPECT_EQ(empty_pool.size(), 1U);
+}
+
+TEST_F(ThreadPoolTest, ExecuteTasks) {
+    using namespace booleval;
+
+    parallel::thread_pool pool{ 4 };
+    std::atomic<std::size_t> counter{ 0 };
+
+    for (std::size_t i = 0; i < 1000; ++i) {
+        pool.submit([&counter] { counter++; });
+    }
+    pool.wait();
+
+    EXPECT_EQ(counter.load(), 1000U);
+}
+
+TEST_F(ThreadPoolTest, ExecuteNestedTasks) {
+    using namespace booleval;
+
+    parallel::thread_pool pool{ 2 };
+    std::atomic<std::size_t> counter{ 0 };
+
+    for (std::size_t i = 0; i < 100; ++i) {
+        pool.submit([&pool, &counter] {
+            for (std::size_t j = 0; j < 10; ++j) {
+                pool.submit([&counter] { counter++; });
+            }
+        });
+    }
+    pool.wait();
+
+    EXPECT_EQ(counter.load(), 1000U);
+}
+
+TEST_F(ThreadPoolTest, WaitWithoutTasks) {
+    using namespace booleval;
+
+    parallel::thread_pool pool{ 2 };
+    pool.wait();
+    SUCCEED();
+}
+
+TEST_F(ThreadPoolTest, RethrowException) {
+    using namespace booleval;
+
+    parallel::thread_pool pool{ 2 };
+    pool.submit([] { throw std::runtime_error("error"); });
+    EXPECT_THROW(pool.wait(), std::runtime_error);
+
+    std::atomic<std::size_t> counter{ 0 };
+    pool.submit([&counter] { counter++; });
+    EXPECT_NO_THROW(pool.wait());
+    EXPECT_EQ(counter.load(), 1U);
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string>
+#include <gtest/gtest.h>
+#include <booleval/exceptions.hpp>
+#include <booleval/path_evaluator.hpp>
+
+class PathEvaluatorTest : public testing::Test {
+public:
+    struct customer {
+        std::string name;
+        unsigned tier;
+    };
+
+    struct order {
+        double price;
+        customer const* buyer;
+    };
+
+    static booleval::utils::object_schema make_schema() {
+        booleval::utils::object_schema schema;
+        schema.add("price", &order::price);
+        schema.add("customer", &order::buyer);
+        schema.add("name", &customer::name);
+        schema.add("tier", &customer::tier);
+        return schema;
+    }
+};
+
+TEST_F(PathEvaluatorTest, NestedPaths) {
+    using namespace booleval;
+
+    customer const gold{ "foo", 3 };
+    customer const basic{ "bar", 1 };
+
+    path_evaluator<order> evaluator{ make_schema() };
+    EXPECT_TRUE(evaluator.expression("price > 10 and (customer.tier >= 2 or customer.name bar)"));
+    EXPECT_TRUE(evaluator.is_activated());
+
+    EXPECT_TRUE(evaluator.evaluate(order{ 20, &gold }));
+    EXPECT_TRUE(evaluator.evaluate(order{ 20, &basic }));
+    EXPECT_FALSE(evaluator.evaluate(order{ 5, &gold }));
+    EXPECT_FALSE(evaluator.evaluate(order{ 20, nullptr }));
+}
+
+TEST_F(PathEvaluatorTest, UnresolvedPath) {
+    using namespace booleval;
+
+    path_evaluator<order> evaluator{ make_schema() };
+    EXPECT_THROW((void) evaluator.expression("customer.email foo"), field_not_found);
+    EXPECT_FALSE(evaluator.is_activated());
+
+    EXPECT_TRUE(evaluator.expression("customer.name foo"));
+    EXPECT_TRUE(evaluator.is_activated());
+}
+
+TEST_F(PathEvaluatorTest, InvalidExpression) {
+    using namespace booleval;
+
+    path_evaluator<order> evaluator{ make_schema() };
+    EXPECT_FALSE(evaluator.expression("(price > 1"));
+    EXPECT_FALSE(evaluator.is_activated());
+
+    EXPECT_TRUE(evaluator.expression(""));
+    EXPECT_FALSE(evaluator.is_activated());
+}
+
+TEST_F(PathEvaluatorTest, SharedPrefixTraversedOnce) {
+    using namespace booleval;
+
+    struct tracked_order {
+        customer const& buyer() const noexcept {
+            ++calls;
+            return owner;
+        }
+
+        customer owner;
+        mutable int calls{ 0 };
+    };
+
+    utils::object_schema schema;
+    schema.add("customer", &tracked_order::buyer);
+    schema.add("name", &customer::name);
+    schema.add("tier", &customer::tier);
+
+    path_evaluator<tracked_order> evaluator{ std::move(schema) };
+    EXPECT_TRUE(evaluator.expression("customer.name foo and customer.tier 3"));
+
+    tracked_order const o{ { "foo", 3 } };
+    EXPECT_TRUE(evaluator.evaluate(o));
+    EXPECT_EQ(o.calls, 1);
+
+    EXPECT_TRUE(evaluator.evaluate(o));
+    EXPECT_EQ(o.calls, 2);
+}
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <random>
+#include <string>
+#include <vector>
+#include <string_view>
+#include <gtest/gtest.h>
+#include <booleval/rule_set.hpp>
+#include <booleval/evaluator.hpp>
+
+class RuleSetTest : public testing::Test {
+public:
+    class request {
+    public:
+        request(std::string host, std::string path, unsigned status)
+            : host_{ std::move(host) }, path_{ std::move(path) }, status_{ status }
+        {}
+
+        std::string host() const noexcept { return host_; }
+        std::string path() const noexcept { return path_; }
+        unsigned status() const noexcept { return status_; }
+        std::string referer(bool& is_valid) const noexcept { is_valid = false; return {}; }
+
+    private:
+        std::string host_;
+        std::string path_;
+        unsigned status_;
+    };
+};
+
+TEST_F(RuleSetTest, EmptyRuleSet) {
+    booleval::rule_set<> rules;
+    EXPECT_EQ(rules.size(), 0);
+    EXPECT_TRUE(rules.evaluate(request{ "example.com", "/", 200 }).empty());
+
+    EXPECT_TRUE(rules.rules({}));
+    EXPECT_TRUE(rules.evaluate(request{ "example.com", "/", 200 }).empty());
+}
+
+TEST_F(RuleSetTest, InvalidRule) {
+    booleval::rule_set<> rules({
+        { "path", &request::path }
+    });
+
+    EXPECT_TRUE(rules.rules({ "path /" }));
+    EXPECT_EQ(rules.size(), 1);
+
+    EXPECT_FALSE(rules.rules({ "path /", "(path /index.html" }));
+    EXPECT_EQ(rules.size(), 0);
+    EXPECT_TRUE(rules.evaluate(request{ "example.com", "/", 200 }).empty());
+}
+
+TEST_F(RuleSetTest, Routing) {
+    booleval::rule_set<> rules({
+        { "host",   &request::host },
+        { "path",   &request::path },
+        { "status", &request::status }
+    });
+
+    EXPECT_TRUE(rules.rules({
+        "path /",
+        "path \"/index.html\" or path \"/home\"",
+        "path contains /api/ and host api.example.com",
+        "path contains /admin",
+        "",
+        "status >= 500",
+        "host www.example.com and (path / or status 404)",
+        "path contains /api/v2/ or path contains /api/v3/",
+        "path / and path contains /api/",
+        "status 200"
+    }));
+    EXPECT_EQ(rules.size(), 10);
+    EXPECT_EQ(rules.indexed_predicates(), 11);
+
+    using ids = std::vector<std::size_t>;
+    EXPECT_EQ(rules.evaluate(request{ "www.example.com", "/", 200 }), (ids{ 0, 6, 9 }));
+    EXPECT_EQ(rules.evaluate(request{ "www.example.com", "/home", 404 }), (ids{ 1, 6 }));
+    EXPECT_EQ(rules.evaluate(request{ "api.example.com", "/api/v2/users", 200 }), (ids{ 2, 7, 9 }));
+    EXPECT_EQ(rules.evaluate(request{ "api.example.com", "/admin/api/v3/", 503 }), (ids{ 2, 3, 5, 7 }));
+    EXPECT_EQ(rules.evaluate(request{ "example.com", "/index.htm", 301 }), ids{});
+
+    ids matches{ 42 };
+    rules.evaluate(request{ "example.com", "/index.html", 200 }, matches);
+    EXPECT_EQ(matches, (ids{ 1, 9 }));
+}
+
+TEST_F(RuleSetTest, FirstMatch) {
+    booleval::rule_set<> rules({
+        { "host",   &request::host },
+        { "path",   &request::path },
+        { "status", &request::status }
+    });
+
+    EXPECT_FALSE(rules.first_match(request{ "example.com", "/", 200 }).has_value());
+
+    EXPECT_TRUE(rules.rules({
+        "host a.com and path /",
+        "host a.com and path /login",
+        "host b.com and path / and status 200",
+        "host b.com and path /",
+        "host b.com and path starts_with /static/",
+        "(host c.com or host d.com) and path /",
+        "status >= 500",
+        "host a.com",
+        "path /"
+    }));
+    EXPECT_GT(rules.decision_nodes(), 1);
+
+    EXPECT_EQ(rules.first_match(request{ "a.com", "/", 500 }), 0);
+    EXPECT_EQ(rules.first_match(request{ "a.com", "/login", 200 }), 1);
+    EXPECT_EQ(rules.first_match(request{ "b.com", "/", 200 }), 2);
+    EXPECT_EQ(rules.first_match(request{ "b.com", "/", 404 }), 3);
+    EXPECT_EQ(rules.first_match(request{ "b.com", "/static/app.js", 200 }), 4);
+    EXPECT_EQ(rules.first_match(request{ "d.com", "/", 200 }), 5);
+    EXPECT_EQ(rules.first_match(request{ "d.com", "/home", 503 }), 6);
+    EXPECT_EQ(rules.first_match(request{ "a.com", "/home", 200 }), 7);
+    EXPECT_EQ(rules.first_match(request{ "e.com", "/", 200 }), 8);
+    EXPECT_FALSE(rules.first_match(request{ "e.com", "/home", 200 }).has_value());
+}
+
+TEST_F(RuleSetTest, NullAndMissingFields) {
+    booleval::rule_set<booleval::utils::any_mem_fn_bool> rules({
+        { "referer", &request::referer }
+    });
+
+    EXPECT_TRUE(rules.rules({ "referer contains example", "referer neq foo", "referer is null" }));
+    EXPECT_EQ(rules.evaluate(request{ "example.com", "/", 200 }), std::vector<std::size_t>{ 2 });
+    EXPECT_EQ(rules.first_match(request{ "example.com", "/", 200 }), 2);
+
+    EXPECT_TRUE(rules.rules({ "referer example.com", "referer is null" }));
+    EXPECT_EQ(rules.first_match(request{ "example.com", "/", 200 }), 1);
+
+    EXPECT_TRUE(rules.rules({ "path /" }));
+    try {
+        [[maybe_unused]] auto result = rules.evaluate(request{ "example.com", "/", 200 });
+        FAIL() << "Expected booleval::field_not_found";
+    } catch (booleval::field_not_found const& ex) {
+        EXPECT_EQ(ex.what(), std::string("Field 'path' not found"));
+    }
+}
+
+TEST_F(RuleSetTest, SameResultsAsEvaluator) {
+    std::map<std::string_view, booleval::utils::any_mem_fn> const fields{
+        { "host",   &request::host },
+        { "path",   &request::path },
+        { "status", &request::status }
+    };
+
+    char const* hosts[] = { "a.com", "b.com", "ab.com" };
+    char const* paths[] = { "/", "/a", "/a/b", "/b/a", "/ab" };
+    unsigned const statuses[] = { 200, 404, 500 };
+    char const* predicates[] = {
+        "host a.com", "host ab.com", "host contains b", "host contains ab.",
+        "path /", "path /a", "path contains /a", "path contains b/", "path contains a",
+        "path starts_with /a", "path neq /ab", "status 404", "status > 200", "host is null"
+    };
+
+    std::mt19937 generator{ 42 };
+    auto const random_expression = [&](auto const& self, std::size_t const depth) -> std::string {
+        if (0 == depth || 0 == generator() % 3) {
+            return predicates[generator() % std::size(predicates)];
+        }
+
+        auto const op = 0 == generator() % 2 ? " and " : " or ";
+        return "(" + self(self, depth - 1) + op + self(self, depth - 1) + ")";
+    };
+
+    for (std::size_t round = 0; round < 50; ++round) {
+        std::vector<std::string> expressions;
+        for (std::size_t i = 0; i < 40; ++i) {
+            expressions.push_back(random_expression(random_expression, 3));
+        }
+
+        booleval::rule_set<> rules{ fields };
+        ASSERT_TRUE(rules.rules(std::vector<std::string_view>(std::begin(expressions), std::end(expressions))));
+
+        std::vector<booleval::evaluator<>> evaluators(expressions.size(), booleval::evaluator<>{ fields });
+        for (std::size_t i = 0; i < expressions.size(); ++i) {
+            ASSERT_TRUE(evaluators[i].expression(expressions[i]));
+        }
+
+        for (auto const host : hosts) {
+            for (auto const path : paths) {
+                for (auto const status : statuses) {
+                    request const r{ host, path, status };
+
+                    std::vector<std::size_t> expected;
+                    for (std::size_t i = 0; i < evaluators.size(); ++i) {
+                        if (evaluators[i].evaluate(r)) {
+                            expected.push_back(i);
+                        }
+                    }
+
+                    ASSERT_EQ(rules.evaluate(r), expected);
+                    if (expected.empty()) {
+                        ASSERT_FALSE(rules.first_match(r).has_value());
+                    } else {
+                        ASSERT_EQ(rules.first_match(r), expected.front());
+                    }
+                }
+            }
+        }
+    }
+}
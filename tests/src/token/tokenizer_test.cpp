@@ -189,6 +189,127 @@ TEST_F(TokenizerTest, TokenizeSymbolBasedExpression) {
     EXPECT_EQ(tokenizer.next_token().value(), "baz");
 }
 
+TEST_F(TokenizerTest, TokenizeNullTestExpression) {
+    using namespace booleval;
+
+    std::string_view expression{ "field_a is null or field_b IS NOT NULL" };
+
+    token::tokenizer tokenizer;
+    tokenizer.expression(expression);
+    tokenizer.tokenize();
+    EXPECT_TRUE(tokenizer.has_tokens());
+
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::field));
+    EXPECT_TRUE(tokenizer.weak_next_token().is(token::token_type::is_null));
+    EXPECT_EQ(tokenizer.next_token().value(), "is null");
+
+    EXPECT_TRUE(tokenizer.weak_next_token().is(token::token_type::field));
+    EXPECT_EQ(tokenizer.next_token().value(), "null");
+
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::logical_or));
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::field));
+    EXPECT_TRUE(tokenizer.weak_next_token().is(token::token_type::is_not_null));
+    EXPECT_EQ(tokenizer.next_token().value(), "IS NOT NULL");
+
+    EXPECT_TRUE(tokenizer.weak_next_token().is(token::token_type::field));
+    EXPECT_EQ(tokenizer.next_token().value(), "NULL");
+    EXPECT_FALSE(tokenizer.has_tokens());
+}
+
+TEST_F(TokenizerTest, TokenizeNullWordsAsFieldExpression) {
+    using namespace booleval;
+
+    std::string_view expression{ "field_a is and field_b null" };
+
+    token::tokenizer tokenizer;
+    tokenizer.expression(expression);
+    tokenizer.tokenize();
+
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::field));
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::eq));
+    EXPECT_EQ(tokenizer.next_token().value(), "is");
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::logical_and));
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::field));
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::eq));
+
+    EXPECT_TRUE(tokenizer.weak_next_token().is(token::token_type::field));
+    EXPECT_EQ(tokenizer.next_token().value(), "null");
+}
+
+TEST_F(TokenizerTest, TokenizeStringMatchingWordsAsFieldExpression) {
+    using namespace booleval;
+
+    std::string_view expression{ "field_a == like and LIKE != field_b and contains starts_with foo" };
+
+    token::tokenizer tokenizer;
+    tokenizer.expression(expression);
+    tokenizer.tokenize();
+
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::field));
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::eq));
+    EXPECT_TRUE(tokenizer.weak_next_token().is(token::token_type::field));
+    EXPECT_EQ(tokenizer.next_token().value(), "like");
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::logical_and));
+
+    EXPECT_TRUE(tokenizer.weak_next_token().is(token::token_type::field));
+    EXPECT_EQ(tokenizer.next_token().value(), "LIKE");
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::neq));
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::field));
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::logical_and));
+
+    EXPECT_TRUE(tokenizer.weak_next_token().is(token::token_type::field));
+    EXPECT_EQ(tokenizer.next_token().value(), "contains");
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::starts_with));
+    EXPECT_TRUE(tokenizer.weak_next_token().is(token::token_type::field));
+    EXPECT_EQ(tokenizer.next_token().value(), "foo");
+    EXPECT_FALSE(tokenizer.has_tokens());
+}
+
+TEST_F(TokenizerTest, TokenizeStringMatchingWordsAsValueExpression) {
+    using namespace booleval;
+
+    std::string_view expression{ "field_a contains like or field_b ends_with" };
+
+    token::tokenizer tokenizer;
+    tokenizer.expression(expression);
+    tokenizer.tokenize();
+
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::field));
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::contains));
+    EXPECT_TRUE(tokenizer.weak_next_token().is(token::token_type::field));
+    EXPECT_EQ(tokenizer.next_token().value(), "like");
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::logical_or));
+
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::field));
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::eq));
+    EXPECT_TRUE(tokenizer.weak_next_token().is(token::token_type::field));
+    EXPECT_EQ(tokenizer.next_token().value(), "ends_with");
+    EXPECT_FALSE(tokenizer.has_tokens());
+}
+
+TEST_F(TokenizerTest, TokenizeMatchesWordAsFieldExpression) {
+    using namespace booleval;
+
+    std::string_view expression{ "matches == field_a or field_b MATCHES matches" };
+
+    token::tokenizer tokenizer;
+    tokenizer.expression(expression);
+    tokenizer.tokenize();
+
+    EXPECT_TRUE(tokenizer.weak_next_token().is(token::token_type::field));
+    EXPECT_EQ(tokenizer.next_token().value(), "matches");
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::eq));
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::field));
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::logical_or));
+
+    EXPECT_TRUE(tokenizer.next_token().is(token::token_type::field));
+    EXPECT_TRUE(tokenizer.weak_next_token().is(token::token_type::matches));
+    EXPECT_EQ(tokenizer.next_token().value(), "MATCHES");
+    EXPECT_TRUE(tokenizer.weak_next_token().is(token::token_type::field));
+    EXPECT_EQ(tokenizer.next_token().value(), "matches");
+    EXPECT_FALSE(tokenizer.has_tokens());
+}
+
 TEST_F(TokenizerTest, Reset) {
     using namespace booleval;
 
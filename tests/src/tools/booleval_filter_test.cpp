@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <gtest/gtest.h>
+
+/**
+ * Runs the booleval-filter tool built along with the tests. The standard
+ * input, output and error of the tool are redirected to files.
+ */
+class BoolevalFilterTest : public testing::Test {
+public:
+    struct result {
+        bool success{ false };
+        std::string out;
+        std::string err;
+    };
+
+    std::string write_file(std::string const& name, std::string const& content) {
+        auto path = testing::TempDir() + name;
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+        return path;
+    }
+
+    std::string read_file(std::string const& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    result run(std::vector<std::string> const& args, std::string const& input = {}) {
+        auto const in = write_file("booleval_filter_test.in", input);
+        auto const out = testing::TempDir() + "booleval_filter_test.out";
+        auto const err = testing::TempDir() + "booleval_filter_test.err";
+
+        std::string command = quote(BOOLEVAL_FILTER_PATH);
+        for (auto const& arg : args) {
+            command += " " + quote(arg);
+        }
+        command += " < " + quote(in) + " > " + quote(out) + " 2> " + quote(err);
+
+        result r;
+        r.success = 0 == std::system(command.c_str());
+        r.out = read_file(out);
+        r.err = read_file(err);
+
+        std::remove(in.c_str());
+        std::remove(out.c_str());
+        std::remove(err.c_str());
+        return r;
+    }
+
+    static std::string quote(std::string const& arg) {
+        std::string quoted{ "\"" };
+        for (auto const c : arg) {
+            if ('"' == c || '\\' == c) {
+                quoted.push_back('\\');
+            }
+            quoted.push_back(c);
+        }
+        quoted.push_back('"');
+        return quoted;
+    }
+
+    static constexpr char const* orders_csv =
+        "id,city,amount\n"
+        "1,Paris,150\n"
+        "2,Berlin,200\n"
+        "3,Paris,50\n"
+        "4,\"Paris\",120\n";
+
+    static constexpr char const* events_ndjson =
+        "{\"level\":\"error\",\"http\":{\"status\":503}}\n"
+        "{\"level\":\"info\",\"http\":{\"status\":200}}\n"
+        "{\"level\":\"error\",\"http\":{\"status\":404}}";
+};
+
+TEST_F(BoolevalFilterTest, Usage) {
+    auto const help = run({ "--help" });
+    EXPECT_FALSE(help.success);
+    EXPECT_NE(help.err.find("Usage:"), std::string::npos);
+    EXPECT_TRUE(help.out.empty());
+
+    EXPECT_FALSE(run({}).success);
+    EXPECT_FALSE(run({ "a 1", "b", "c" }).success);
+}
+
+TEST_F(BoolevalFilterTest, InvalidOptions) {
+    auto const option = run({ "--verbose", "a 1" });
+    EXPECT_FALSE(option.success);
+    EXPECT_NE(option.err.find("Unknown option '--verbose'!"), std::string::npos);
+
+    auto const format = run({ "-f", "xml", "a 1" });
+    EXPECT_FALSE(format.success);
+    EXPECT_NE(format.err.find("Unknown input format 'xml'!"), std::string::npos);
+
+    auto const threads = run({ "--threads", "many", "a 1" });
+    EXPECT_FALSE(threads.success);
+    EXPECT_NE(threads.err.find("Invalid number of threads 'many'!"), std::string::npos);
+
+    auto const schema = run({ "-f", "binary", "a 1" });
+    EXPECT_FALSE(schema.success);
+    EXPECT_NE(schema.err.find("Binary input requires the schema!"), std::string::npos);
+}
+
+TEST_F(BoolevalFilterTest, Ndjson) {
+    auto const path = write_file("booleval_filter_test.ndjson", events_ndjson);
+
+    auto const file = run({ "level error and http.status >= 500", path });
+    EXPECT_TRUE(file.success);
+    EXPECT_EQ(file.out, "{\"level\":\"error\",\"http\":{\"status\":503}}\n");
+    EXPECT_TRUE(file.err.empty());
+
+    // Standard input defaults to NDJSON and its last line needs no line break
+    auto const input = run({ "level error" }, events_ndjson);
+    EXPECT_TRUE(input.success);
+    EXPECT_EQ(input.out,
+        "{\"level\":\"error\",\"http\":{\"status\":503}}\n"
+        "{\"level\":\"error\",\"http\":{\"status\":404}}\n");
+
+    EXPECT_EQ(run({ "-f", "jsonl", "http.status 200", "-" }, events_ndjson).out,
+        "{\"level\":\"info\",\"http\":{\"status\":200}}\n");
+
+    std::remove(path.c_str());
+}
+
+TEST_F(BoolevalFilterTest, Csv) {
+    auto const path = write_file("booleval_filter_test.csv", orders_csv);
+
+    // Format is deduced from the extension and the header is written first
+    auto const file = run({ "city Paris and amount > 100", path });
+    EXPECT_TRUE(file.success);
+    EXPECT_EQ(file.out, "id,city,amount\n1,Paris,150\n4,\"Paris\",120\n");
+
+    auto const input = run({ "-f", "csv", "amount < 100" }, orders_csv);
+    EXPECT_TRUE(input.success);
+    EXPECT_EQ(input.out, "id,city,amount\n3,Paris,50\n");
+
+    auto const tsv = run({ "--format", "tsv", "city Berlin" }, "id\tcity\n1\tParis\n2\tBerlin\n");
+    EXPECT_TRUE(tsv.success);
+    EXPECT_EQ(tsv.out, "id\tcity\n2\tBerlin\n");
+
+    auto const missing = run({ "-f", "csv", "country France" }, orders_csv);
+    EXPECT_FALSE(missing.success);
+    EXPECT_NE(missing.err.find("Fields referenced in the expression are missing from the header!"), std::string::npos);
+
+    std::remove(path.c_str());
+}
+
+TEST_F(BoolevalFilterTest, Binary) {
+    std::string records;
+    for (unsigned char id = 1; id <= 4; ++id) {
+        records.append({ static_cast<char>(id), 0, 0, 0, 'S', static_cast<char>('0' + id % 2), 0, 0 });
+    }
+
+    auto const schema = write_file("booleval_filter_test.schema", "id uint32 0\nsymbol string[4] 4\n");
+
+    auto const matches = run({ "--schema", schema, "symbol S1 and id > 1" }, records);
+    EXPECT_TRUE(matches.success);
+    EXPECT_EQ(matches.out, records.substr(16, 8));
+
+    auto const count = run({ "-s", schema, "-c", "symbol S0" }, records);
+    EXPECT_TRUE(count.success);
+    EXPECT_EQ(count.out, "2\n");
+
+    auto const unknown = run({ "-s", schema, "price > 1" }, records);
+    EXPECT_FALSE(unknown.success);
+    EXPECT_NE(unknown.err.find("price"), std::string::npos);
+
+    auto const invalid = write_file("booleval_filter_test_invalid.schema", "id uint24 0\n");
+    auto const bad_schema = run({ "-s", invalid, "id 1" }, records);
+    EXPECT_FALSE(bad_schema.success);
+    EXPECT_NE(bad_schema.err.find("uint24"), std::string::npos);
+
+    auto const missing = run({ "-s", testing::TempDir() + "booleval_filter_test_missing.schema", "id 1" }, records);
+    EXPECT_FALSE(missing.success);
+    EXPECT_NE(missing.err.find("Cannot read schema"), std::string::npos);
+
+    std::remove(schema.c_str());
+    std::remove(invalid.c_str());
+}
+
+TEST_F(BoolevalFilterTest, CountAndStats) {
+    auto const count = run({ "-f", "csv", "--count", "city Paris" }, orders_csv);
+    EXPECT_TRUE(count.success);
+    EXPECT_EQ(count.out, "3\n");
+
+    // Rows are counted by the CSV rules, so the quoted line break does not start a record
+    auto const stats = run({ "-f", "csv", "--stats", "city Paris" }, "id,city\n1,Paris\n2,\"Pa\nris\"\n3,Paris\n");
+    EXPECT_TRUE(stats.success);
+    EXPECT_EQ(stats.out, "id,city\n1,Paris\n3,Paris\n");
+    EXPECT_NE(stats.err.find("records:     3\n"), std::string::npos);
+    EXPECT_NE(stats.err.find("matches:     2 (66.67 %)\n"), std::string::npos);
+
+    auto const ndjson = run({ "--stats", "-c", "level error" }, events_ndjson);
+    EXPECT_TRUE(ndjson.success);
+    EXPECT_EQ(ndjson.out, "2\n");
+    EXPECT_NE(ndjson.err.find("records:     3\n"), std::string::npos);
+}
+
+TEST_F(BoolevalFilterTest, Errors) {
+    auto const expression = run({ "level error and" }, events_ndjson);
+    EXPECT_FALSE(expression.success);
+    EXPECT_NE(expression.err.find("Expression not valid!"), std::string::npos);
+    EXPECT_TRUE(expression.out.empty());
+
+    auto const csv = run({ "-f", "csv", "(city Paris" }, orders_csv);
+    EXPECT_FALSE(csv.success);
+    EXPECT_NE(csv.err.find("Expression not valid!"), std::string::npos);
+
+    auto const file = run({ "level error", testing::TempDir() + "booleval_filter_test_missing.ndjson" });
+    EXPECT_FALSE(file.success);
+    EXPECT_NE(file.err.find("Cannot open file"), std::string::npos);
+}
+
+TEST_F(BoolevalFilterTest, Threads) {
+    std::string input{ "id,value\n" };
+    std::string expected{ "id,value\n" };
+    // Large enough to be split into several parts, some of them inside quoted values
+    for (std::size_t i = 0; i < 600000; ++i) {
+        auto const row = std::to_string(i) + "," + (0 == i % 3 ? "\"a\nb\"" : "c") + "\n";
+        input += row;
+        if (0 == i % 3) {
+            expected += row;
+        }
+    }
+    auto const path = write_file("booleval_filter_test_threads.csv", input);
+
+    auto const parallel = run({ "-t", "4", "--stats", "value neq c", path });
+    EXPECT_TRUE(parallel.success);
+    EXPECT_EQ(parallel.out, expected);
+    EXPECT_NE(parallel.err.find("records:     600000\n"), std::string::npos);
+
+    auto const all_cores = run({ "--threads", "0", "-c", "value c", path });
+    EXPECT_TRUE(all_cores.success);
+    EXPECT_EQ(all_cores.out, "400000\n");
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <random>
+#include <string>
+#include <gtest/gtest.h>
+#include <booleval/evaluator.hpp>
+#include <booleval/tree/closure_tree.hpp>
+
+class ClosureTreeTest : public testing::Test {
+public:
+    class obj {
+    public:
+        obj(std::string name, int count, double ratio)
+            : name_{ std::move(name) }, count_{ count }, ratio_{ ratio }
+        {}
+
+        std::string name() const noexcept { return name_; }
+        int count() const noexcept { return count_; }
+        double ratio() const noexcept { return ratio_; }
+        std::string note(bool& is_valid) const noexcept { is_valid = count_ > 0; return name_; }
+
+    private:
+        std::string name_;
+        int count_;
+        double ratio_;
+    };
+};
+
+TEST_F(ClosureTreeTest, DefaultConstructor) {
+    booleval::tree::closure_tree<obj> closures;
+    EXPECT_FALSE(closures.is_compiled());
+    EXPECT_FALSE(closures.evaluate(obj{ "foo", 1, 0.5 }));
+}
+
+TEST_F(ClosureTreeTest, Compile) {
+    booleval::evaluator<> evaluator({
+        { "name",  &obj::name },
+        { "count", &obj::count },
+        { "ratio", &obj::ratio }
+    });
+
+    EXPECT_FALSE(evaluator.compile<obj>().is_compiled());
+
+    EXPECT_TRUE(evaluator.expression("name starts_with f and (count > 10 or ratio <= 0.25)"));
+    auto const closures = evaluator.compile<obj>();
+    EXPECT_TRUE(closures.is_compiled());
+
+    EXPECT_TRUE(closures.evaluate(obj{ "foo", 11, 0.5 }));
+    EXPECT_TRUE(closures.evaluate(obj{ "foo", 1, 0.25 }));
+    EXPECT_FALSE(closures.evaluate(obj{ "foo", 1, 0.5 }));
+    EXPECT_FALSE(closures.evaluate(obj{ "bar", 11, 0.1 }));
+
+    // The compiled expression does not depend on the evaluator
+    EXPECT_TRUE(evaluator.expression("name bar"));
+    EXPECT_TRUE(closures.evaluate(obj{ "foo", 11, 0.5 }));
+}
+
+TEST_F(ClosureTreeTest, MissingField) {
+    booleval::evaluator<> evaluator({
+        { "name", &obj::name }
+    });
+
+    EXPECT_TRUE(evaluator.expression("name foo or missing 1"));
+    auto const closures = evaluator.compile<obj>();
+    EXPECT_TRUE(closures.evaluate(obj{ "foo", 1, 0.5 }));
+
+    try {
+        [[maybe_unused]] auto const result = closures.evaluate(obj{ "bar", 1, 0.5 });
+        FAIL() << "Expected booleval::field_not_found";
+    } catch (booleval::field_not_found const& ex) {
+        EXPECT_EQ(ex.what(), std::string("Field 'missing' not found"));
+    }
+}
+
+TEST_F(ClosureTreeTest, SameResultsAsEvaluator) {
+    booleval::evaluator<booleval::utils::any_mem_fn_bool> evaluator({
+        { "note", &obj::note }
+    });
+
+    booleval::evaluator<> fields_evaluator({
+        { "name",  &obj::name },
+        { "count", &obj::count },
+        { "ratio", &obj::ratio }
+    });
+
+    char const* predicates[] = {
+        "name foo", "name neq bar", "name > bar", "name <= foo", "name < 5", "name contains o",
+        "count 3", "count neq 3", "count > 2", "count >= -1", "count < 3.5", "count <= abc", "count > abc",
+        "ratio 0.5", "ratio > 0.25", "ratio < 1e-1", "ratio geq 2", "count is null", "ratio is not null",
+        "name like \"_o%\""
+    };
+
+    std::mt19937 generator{ 42 };
+    auto const random_expression = [&](auto const& self, std::size_t const depth) -> std::string {
+        if (0 == depth || 0 == generator() % 3) {
+            return predicates[generator() % std::size(predicates)];
+        }
+
+        auto const op = 0 == generator() % 2 ? " and " : " or ";
+        return "(" + self(self, depth - 1) + op + self(self, depth - 1) + ")";
+    };
+
+    obj const objects[] = {
+        { "foo", 3, 0.5 }, { "bar", -2, 0.05 }, { "boo", 0, 2.0 }, { "5", 10, 0.25 }, { "", 1, -1.0 }
+    };
+
+    for (std::size_t round = 0; round < 300; ++round) {
+        auto const expression = random_expression(random_expression, 3);
+        ASSERT_TRUE(fields_evaluator.expression(expression));
+        auto const closures = fields_evaluator.compile<obj>();
+
+        for (auto const& o : objects) {
+            ASSERT_EQ(closures.evaluate(o), fields_evaluator.evaluate(o)) << expression;
+        }
+    }
+
+    EXPECT_TRUE(evaluator.expression("note is null or note foo"));
+    auto const closures = evaluator.compile<obj>();
+    EXPECT_TRUE(closures.evaluate(obj{ "bar", 0, 0.5 }));
+    EXPECT_TRUE(closures.evaluate(obj{ "foo", 1, 0.5 }));
+    EXPECT_FALSE(closures.evaluate(obj{ "bar", 1, 0.5 }));
+}
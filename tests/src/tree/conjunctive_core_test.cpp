@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <vector>
+#include <cstdint>
+#include <string_view>
+#include <gtest/gtest.h>
+#include <booleval/evaluator.hpp>
+#include <booleval/tree/expression_tree.hpp>
+#include <booleval/tree/conjunctive_core.hpp>
+
+class ConjunctiveCoreTest : public testing::Test {
+public:
+    using literals = std::vector<std::string_view>;
+
+    /**
+     * Extracts the equality conditions of the expression.
+     */
+    static booleval::tree::equality_conditions extract(std::string_view const expression) {
+        booleval::tree::expression_tree tree;
+        EXPECT_TRUE(tree.build(expression));
+        return tree.conjunctive_core();
+    }
+};
+
+TEST_F(ConjunctiveCoreTest, NotBuilt) {
+    using namespace booleval;
+
+    EXPECT_TRUE(tree::conjunctive_core(nullptr).empty());
+    EXPECT_TRUE(tree::expression_tree{}.conjunctive_core().empty());
+    EXPECT_TRUE(evaluator<>{}.conjunctive_core().empty());
+}
+
+TEST_F(ConjunctiveCoreTest, Equality) {
+    auto const conditions = extract("field_a 1");
+    ASSERT_EQ(conditions.size(), 1U);
+    EXPECT_EQ(conditions.at("field_a"), (literals{ "1" }));
+}
+
+TEST_F(ConjunctiveCoreTest, Conjunction) {
+    auto const conditions = extract("field_a 1 and field_b foo and field_c > 2");
+    ASSERT_EQ(conditions.size(), 2U);
+    EXPECT_EQ(conditions.at("field_a"), (literals{ "1" }));
+    EXPECT_EQ(conditions.at("field_b"), (literals{ "foo" }));
+}
+
+TEST_F(ConjunctiveCoreTest, Disjunction) {
+    auto const conditions = extract("(field_a 2 and field_b 1) or (field_b 3 and field_a 1) or field_a 2");
+    ASSERT_EQ(conditions.size(), 1U);
+    EXPECT_EQ(conditions.at("field_a"), (literals{ "1", "2" }));
+
+    EXPECT_TRUE(extract("field_a 1 or field_b 2").empty());
+    EXPECT_TRUE(extract("field_a 1 or field_a > 2").empty());
+}
+
+TEST_F(ConjunctiveCoreTest, Intersection) {
+    auto const conditions = extract("(field_a 1 or field_a 2) and (field_a 2 or field_a 3) and field_b 4");
+    ASSERT_EQ(conditions.size(), 2U);
+    EXPECT_EQ(conditions.at("field_a"), (literals{ "2" }));
+    EXPECT_EQ(conditions.at("field_b"), (literals{ "4" }));
+}
+
+TEST_F(ConjunctiveCoreTest, Contradiction) {
+    auto const conditions = extract("field_a 1 and field_b 2 and field_a 3");
+    ASSERT_EQ(conditions.size(), 2U);
+    EXPECT_TRUE(conditions.at("field_a").empty());
+}
+
+TEST_F(ConjunctiveCoreTest, OtherOperators) {
+    EXPECT_TRUE(extract("field_a neq 1 and field_b > 2 and field_c <= 3").empty());
+    EXPECT_TRUE(extract("field_a starts_with foo").empty());
+}
+
+TEST_F(ConjunctiveCoreTest, Evaluator) {
+    using namespace booleval;
+
+    struct foo {
+        uint8_t value{ 0 };
+    };
+
+    evaluator<> evaluator({
+        { "field_a", &foo::value }
+    });
+    ASSERT_TRUE(evaluator.expression("field_a 1 or (field_a 2 and field_a < 3)"));
+
+    auto const conditions = evaluator.conjunctive_core();
+    ASSERT_EQ(conditions.size(), 1U);
+    EXPECT_EQ(conditions.at("field_a"), (literals{ "1", "2" }));
+}
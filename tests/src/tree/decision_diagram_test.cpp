@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <map>
+#include <random>
+#include <string>
+#include <gtest/gtest.h>
+#include <booleval/tree/expression_tree.hpp>
+#include <booleval/tree/decision_diagram.hpp>
+
+class DecisionDiagramTest : public testing::Test {
+public:
+    using assignment = std::map<std::string_view, bool>;
+
+    /**
+     * Evaluates the tree with the predicates assigned by their fields.
+     */
+    static bool evaluate(booleval::tree::tree_node const& node, assignment const& values) {
+        using booleval::token::token_type;
+
+        if (node.token.is(token_type::logical_and)) {
+            return evaluate(*node.left, values) && evaluate(*node.right, values);
+        }
+        if (node.token.is(token_type::logical_or)) {
+            return evaluate(*node.left, values) || evaluate(*node.right, values);
+        }
+        return values.at(node.left->token.value());
+    }
+};
+
+TEST_F(DecisionDiagramTest, DefaultConstructor) {
+    using namespace booleval;
+
+    tree::decision_diagram diagram;
+    EXPECT_FALSE(diagram.is_built());
+    EXPECT_EQ(diagram.size(), 0);
+    EXPECT_EQ(diagram.variables(), 0);
+}
+
+TEST_F(DecisionDiagramTest, SharedPredicates) {
+    using namespace booleval;
+
+    tree::expression_tree tree;
+    ASSERT_TRUE(tree.build("field_a 1 and (field_b 2 or field_a 1)"));
+
+    tree::decision_diagram diagram;
+    EXPECT_TRUE(diagram.build(tree.root().get()));
+    EXPECT_TRUE(diagram.is_built());
+    EXPECT_EQ(diagram.variables(), 2);
+    EXPECT_EQ(diagram.size(), 1);
+
+    std::size_t evaluations{ 0 };
+    EXPECT_TRUE(diagram.evaluate([&evaluations](tree::tree_node const& node) {
+        ++evaluations;
+        return node.left->token.value() == "field_a";
+    }));
+    EXPECT_EQ(evaluations, 1);
+
+    diagram.clear();
+    EXPECT_FALSE(diagram.is_built());
+}
+
+TEST_F(DecisionDiagramTest, EachPredicateEvaluatedOnce) {
+    using namespace booleval;
+
+    tree::expression_tree tree;
+    ASSERT_TRUE(tree.build("(a 1 or b 1) and (c 1 or d 1) or (a 1 and d 1)"));
+
+    tree::decision_diagram diagram;
+    ASSERT_TRUE(diagram.build(tree.root().get()));
+    EXPECT_EQ(diagram.variables(), 4);
+
+    std::string_view const fields[] = { "a", "b", "c", "d" };
+    for (unsigned bits = 0; bits < 16; ++bits) {
+        assignment values;
+        for (std::size_t i = 0; i < std::size(fields); ++i) {
+            values[fields[i]] = 0 != (bits & (1U << i));
+        }
+
+        std::map<std::string_view, std::size_t> evaluations;
+        auto const result = diagram.evaluate([&](tree::tree_node const& node) {
+            auto const field = node.left->token.value();
+            ++evaluations[field];
+            return values.at(field);
+        });
+
+        EXPECT_EQ(result, evaluate(*tree.root(), values)) << bits;
+        for (auto const& [field, count] : evaluations) {
+            EXPECT_EQ(count, 1) << field;
+        }
+    }
+}
+
+TEST_F(DecisionDiagramTest, SizeCap) {
+    using namespace booleval;
+
+    tree::expression_tree tree;
+    ASSERT_TRUE(tree.build("a 1 and b 1 and c 1"));
+
+    tree::decision_diagram diagram;
+    EXPECT_FALSE(diagram.build(tree.root().get(), 2));
+    EXPECT_FALSE(diagram.is_built());
+
+    EXPECT_TRUE(diagram.build(tree.root().get()));
+    EXPECT_EQ(diagram.size(), 3);
+
+    // The diagram of pairwise disjunctions ordered by their first variables is exponential
+    ASSERT_TRUE(tree.build("(a 1 or b 1 or c 1 or d 1 or e 1 or f 1 or g 1 or h 1) and "
+                           "(a 1 or i 1) and (b 1 or j 1) and (c 1 or k 1) and (d 1 or l 1) and "
+                           "(e 1 or m 1) and (f 1 or n 1) and (g 1 or o 1) and (h 1 or p 1)"));
+    EXPECT_TRUE(diagram.build(tree.root().get()));
+    EXPECT_FALSE(diagram.build(tree.root().get(), 64));
+    EXPECT_FALSE(diagram.is_built());
+}
+
+TEST_F(DecisionDiagramTest, RandomExpressions) {
+    using namespace booleval;
+
+    std::string_view const fields[] = { "a", "b", "c", "d", "e", "f" };
+    std::mt19937 generator{ 42 };
+    auto const random_expression = [&](auto const& self, std::size_t const depth) -> std::string {
+        if (0 == depth || 0 == generator() % 4) {
+            return std::string(fields[generator() % std::size(fields)]) + " 1";
+        }
+
+        auto const op = 0 == generator() % 2 ? " and " : " or ";
+        return "(" + self(self, depth - 1) + op + self(self, depth - 1) + ")";
+    };
+
+    for (std::size_t round = 0; round < 200; ++round) {
+        auto const expression = random_expression(random_expression, 5);
+
+        tree::expression_tree tree;
+        ASSERT_TRUE(tree.build(expression));
+
+        tree::decision_diagram diagram;
+        ASSERT_TRUE(diagram.build(tree.root().get()));
+
+        for (unsigned bits = 0; bits < 64; ++bits) {
+            assignment values;
+            for (std::size_t i = 0; i < std::size(fields); ++i) {
+                values[fields[i]] = 0 != (bits & (1U << i));
+            }
+
+            std::size_t evaluations{ 0 };
+            auto const result = diagram.evaluate([&](tree::tree_node const& node) {
+                ++evaluations;
+                return values.at(node.left->token.value());
+            });
+
+            ASSERT_EQ(result, evaluate(*tree.root(), values)) << expression;
+            ASSERT_LE(evaluations, diagram.variables()) << expression;
+        }
+    }
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string>
+#include <sstream>
+#include <gtest/gtest.h>
+#include <booleval/evaluator.hpp>
+#include <booleval/typed_evaluator.hpp>
+#include <booleval/tree/explain.hpp>
+#include <booleval/tree/expression_tree.hpp>
+
+class ExplainTest : public testing::Test {
+public:
+    class obj {
+    public:
+        int a() const noexcept { return 0; }
+    };
+};
+
+TEST_F(ExplainTest, TokenRange) {
+    using namespace booleval::tree;
+
+    std::string_view const expression{ "a 1 and b \"x y\"" };
+
+    auto const field = token_range(expression, expression.substr(0, 1));
+    ASSERT_TRUE(field);
+    EXPECT_EQ(field->first, 0U);
+    EXPECT_EQ(field->second, 1U);
+
+    auto const quoted = token_range(expression, expression.substr(11, 3));
+    ASSERT_TRUE(quoted);
+    EXPECT_EQ(quoted->first, 10U);
+    EXPECT_EQ(quoted->second, 15U);
+
+    EXPECT_FALSE(token_range(expression, "eq"));
+    EXPECT_FALSE(token_range(expression, expression.substr(0, 0)));
+}
+
+TEST_F(ExplainTest, ExpressionTree) {
+    booleval::tree::expression_tree tree;
+    EXPECT_TRUE(tree.build("field_a foo or field_b >= 2.5"));
+
+    std::ostringstream out;
+    tree.explain(out);
+
+    EXPECT_EQ(out.str(),
+        "Expression: field_a foo or field_b >= 2.5\n"
+        "\n"
+        "Parsed tree:\n"
+        "or\n"
+        "|-- eq (implicit)\n"
+        "|   |-- field field_a\n"
+        "|   `-- literal foo  <string>\n"
+        "`-- >=\n"
+        "    |-- field field_b\n"
+        "    `-- literal 2.5  <floating point>\n"
+        "\n"
+        "Field bindings:\n"
+        "  field_a  (1 reference)\n"
+        "  field_b  (1 reference)\n"
+        "\n"
+        "Estimated cost per record: 27 units\n"
+        "  field lookups and accessor calls: 2\n"
+        "  numeric comparisons:              1\n"
+        "  string comparisons:               1\n"
+        "  (1 unit is roughly a comparison of two short strings; both operands\n"
+        "   of logical operators are always evaluated)\n"
+    );
+}
+
+TEST_F(ExplainTest, NullTest) {
+    booleval::tree::expression_tree tree;
+    EXPECT_TRUE(tree.build("field_a is not null and field_a > 1"));
+
+    std::ostringstream out;
+    tree.explain(out);
+
+    auto const description = out.str();
+    EXPECT_NE(description.find(
+        "and\n"
+        "|-- is not null\n"
+        "|   `-- field field_a\n"
+        "`-- >\n"), std::string::npos);
+    EXPECT_NE(description.find("  field lookups and accessor calls: 2\n"), std::string::npos);
+    EXPECT_NE(description.find("  numeric comparisons:              1\n"), std::string::npos);
+    EXPECT_NE(description.find("  string comparisons:               0\n"), std::string::npos);
+}
+
+TEST_F(ExplainTest, EvaluatorBindings) {
+    booleval::evaluator<> evaluator({
+        { "a", &obj::a }
+    });
+    EXPECT_TRUE(evaluator.expression("a 1 and b 2 and a 3"));
+
+    std::ostringstream out;
+    evaluator.explain(out);
+
+    auto const description = out.str();
+    EXPECT_NE(description.find("field a  [bound]"), std::string::npos);
+    EXPECT_NE(description.find("field b  [not bound]"), std::string::npos);
+    EXPECT_NE(description.find("  a  bound  (2 references)\n"), std::string::npos);
+    EXPECT_NE(description.find("  b  not bound  (1 reference)\n"), std::string::npos);
+}
+
+TEST_F(ExplainTest, InvalidExpression) {
+    booleval::evaluator<> evaluator;
+    EXPECT_FALSE(evaluator.expression("(a 1"));
+
+    std::ostringstream out;
+    evaluator.explain(out);
+    EXPECT_EQ(out.str(), "Expression: (a 1\nExpression tree is not built\n");
+}
+
+TEST_F(ExplainTest, EmptyExpressionAfterValid) {
+    booleval::evaluator<> evaluator({
+        { "a", &obj::a }
+    });
+    booleval::typed_evaluator<obj> typed_evaluator({
+        { "a", &obj::a }
+    });
+
+    {
+        // The evaluators must not refer to the expression once it is replaced
+        std::string const expression{ "a == 1" };
+        EXPECT_TRUE(evaluator.expression(expression));
+        EXPECT_TRUE(typed_evaluator.expression(expression));
+    }
+
+    EXPECT_TRUE(evaluator.expression(""));
+    EXPECT_FALSE(evaluator.is_activated());
+    EXPECT_TRUE(typed_evaluator.expression(""));
+    EXPECT_FALSE(typed_evaluator.is_activated());
+
+    std::ostringstream out;
+    evaluator.explain(out);
+    EXPECT_EQ(out.str(), "Expression: \nExpression tree is not built\n");
+
+    std::ostringstream typed_out;
+    typed_evaluator.explain(typed_out);
+    EXPECT_EQ(typed_out.str(), "Expression: \nExpression tree is not built\n");
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string>
+#include <sstream>
+#include <gtest/gtest.h>
+#include <booleval/evaluator.hpp>
+#include <booleval/tree/node_profiler.hpp>
+
+class NodeProfilerTest : public testing::Test {
+public:
+    class obj {
+    public:
+        obj(int a, std::string b) : a_{ a }, b_{ std::move(b) } {}
+        int a() const noexcept { return a_; }
+        std::string b() const noexcept { return b_; }
+
+    private:
+        int a_;
+        std::string b_;
+    };
+
+    template <bool Profile>
+    booleval::evaluator<booleval::utils::any_mem_fn, Profile> make_evaluator() {
+        return booleval::evaluator<booleval::utils::any_mem_fn, Profile>({
+            { "a", &obj::a },
+            { "b", &obj::b }
+        });
+    }
+};
+
+TEST_F(NodeProfilerTest, NodeRanges) {
+    auto evaluator = make_evaluator<true>();
+    std::string const expression{ "(a > 1 and b \"x y\") or a 7" };
+    EXPECT_TRUE(evaluator.expression(expression));
+
+    auto const report = evaluator.profile();
+    EXPECT_EQ(report.expression(), expression);
+    ASSERT_EQ(report.nodes().size(), 5U);
+
+    auto const& nodes = report.nodes();
+    EXPECT_EQ(nodes[0].type, booleval::token::token_type::logical_or);
+    EXPECT_EQ(nodes[0].depth, 0U);
+    EXPECT_EQ(report.text(nodes[0]), expression);
+    EXPECT_EQ(report.text(nodes[1]), "a > 1 and b \"x y\"");
+    EXPECT_EQ(report.text(nodes[2]), "a > 1");
+    EXPECT_EQ(nodes[2].depth, 2U);
+    EXPECT_EQ(report.text(nodes[3]), "b \"x y\"");
+    EXPECT_EQ(nodes[3].type, booleval::token::token_type::eq);
+    EXPECT_EQ(report.text(nodes[4]), "a 7");
+}
+
+TEST_F(NodeProfilerTest, Counters) {
+    auto evaluator = make_evaluator<true>();
+    EXPECT_TRUE(evaluator.expression("a > 1 and b foo"));
+
+    EXPECT_TRUE(evaluator.evaluate(obj{ 2, "foo" }));
+    EXPECT_FALSE(evaluator.evaluate(obj{ 2, "bar" }));
+    EXPECT_FALSE(evaluator.evaluate(obj{ 0, "foo" }));
+    EXPECT_FALSE(evaluator.evaluate(obj{ 0, "bar" }));
+
+    auto const report = evaluator.profile();
+    ASSERT_EQ(report.nodes().size(), 3U);
+
+    auto const& root = report.nodes()[0];
+    EXPECT_EQ(root.evaluations, 4U);
+    EXPECT_EQ(root.true_count, 1U);
+    EXPECT_EQ(root.accessor_nanoseconds, 0U);
+
+    auto const& a = report.nodes()[1];
+    EXPECT_EQ(report.text(a), "a > 1");
+    EXPECT_EQ(a.evaluations, 4U);
+    EXPECT_EQ(a.true_count, 2U);
+    EXPECT_GT(a.accessor_nanoseconds + a.accessor_cycles, 0U);
+
+    auto const& b = report.nodes()[2];
+    EXPECT_EQ(b.true_count, 2U);
+
+    evaluator.clear_profile();
+    EXPECT_EQ(evaluator.profile().nodes()[0].evaluations, 0U);
+}
+
+TEST_F(NodeProfilerTest, ExpressionChange) {
+    auto evaluator = make_evaluator<true>();
+    EXPECT_TRUE(evaluator.expression("a 1"));
+    EXPECT_TRUE(evaluator.evaluate(obj{ 1, "" }));
+
+    EXPECT_TRUE(evaluator.expression("a 1 or a 2"));
+    auto const report = evaluator.profile();
+    ASSERT_EQ(report.nodes().size(), 3U);
+    EXPECT_EQ(report.nodes()[0].evaluations, 0U);
+
+    EXPECT_FALSE(evaluator.expression("(a 1"));
+    EXPECT_TRUE(evaluator.profile().nodes().empty());
+}
+
+TEST_F(NodeProfilerTest, Dump) {
+    auto evaluator = make_evaluator<true>();
+    EXPECT_TRUE(evaluator.expression("a 1 or b foo"));
+    EXPECT_TRUE(evaluator.evaluate(obj{ 1, "bar" }));
+
+    std::ostringstream out;
+    evaluator.profile().dump(out);
+
+    std::istringstream lines(out.str());
+    std::string line;
+
+    ASSERT_TRUE(std::getline(lines, line));
+    EXPECT_EQ(line.find("a 1 or b foo"), 0U);
+    EXPECT_NE(line.find("evaluations"), std::string::npos);
+
+    ASSERT_TRUE(std::getline(lines, line));
+    EXPECT_EQ(line.find("^^^^^^^^^^^^"), 0U);
+
+    ASSERT_TRUE(std::getline(lines, line));
+    EXPECT_EQ(line.find("^^^        "), 0U);
+
+    ASSERT_TRUE(std::getline(lines, line));
+    EXPECT_EQ(line.find("       ^^^^^"), 0U);
+
+    EXPECT_FALSE(std::getline(lines, line));
+}
+
+TEST_F(NodeProfilerTest, ProfilingOff) {
+    auto evaluator = make_evaluator<false>();
+    EXPECT_TRUE(evaluator.expression("a 1"));
+    EXPECT_TRUE(evaluator.evaluate(obj{ 1, "" }));
+}
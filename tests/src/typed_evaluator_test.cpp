@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <random>
+#include <string>
+#include <gtest/gtest.h>
+#include <booleval/evaluator.hpp>
+#include <booleval/typed_evaluator.hpp>
+
+class TypedEvaluatorTest : public testing::Test {
+public:
+    struct obj {
+        std::string name;
+        int count{ 0 };
+        int64_t id{ 0 };
+        double ratio{ 0 };
+        float weight{ 0 };
+
+        std::string const& get_name() const noexcept { return name; }
+        unsigned get_count() const noexcept { return static_cast<unsigned>(count < 0 ? -count : count); }
+        std::string note(bool& is_valid) const noexcept { is_valid = count > 0; return name; }
+    };
+};
+
+TEST_F(TypedEvaluatorTest, DefaultConstructor) {
+    booleval::typed_evaluator<obj> evaluator;
+    EXPECT_FALSE(evaluator.is_activated());
+    EXPECT_FALSE(evaluator.evaluate(obj{}));
+
+    EXPECT_TRUE(evaluator.expression(""));
+    EXPECT_FALSE(evaluator.is_activated());
+    EXPECT_FALSE(evaluator.expression("(name foo"));
+    EXPECT_FALSE(evaluator.is_activated());
+}
+
+TEST_F(TypedEvaluatorTest, Evaluate) {
+    booleval::typed_evaluator<obj> evaluator({
+        { "name",  &obj::name },
+        { "count", &obj::count },
+        { "ratio", &obj::ratio }
+    });
+
+    EXPECT_TRUE(evaluator.expression("name foo and (count > 10 or ratio <= 0.25)"));
+    EXPECT_TRUE(evaluator.is_activated());
+    EXPECT_EQ(evaluator.referenced_fields(), (std::vector<std::string_view>{ "name", "count", "ratio" }));
+
+    EXPECT_TRUE(evaluator.evaluate(obj{ "foo", 11, 0, 0.5, 0 }));
+    EXPECT_TRUE(evaluator.evaluate(obj{ "foo", 1, 0, 0.25, 0 }));
+    EXPECT_FALSE(evaluator.evaluate(obj{ "foo", 1, 0, 0.5, 0 }));
+    EXPECT_FALSE(evaluator.evaluate(obj{ "bar", 11, 0, 0.1, 0 }));
+
+    EXPECT_TRUE(evaluator.expression("name contains o and count 3"));
+    EXPECT_TRUE(evaluator.evaluate(obj{ "foo", 3, 0, 0, 0 }));
+    EXPECT_FALSE(evaluator.evaluate(obj{ "foo", 4, 0, 0, 0 }));
+}
+
+TEST_F(TypedEvaluatorTest, SharedExpressionTree) {
+    auto expression_tree = std::make_shared<booleval::tree::expression_tree>();
+    ASSERT_TRUE(expression_tree->build("name foo and count > 1"));
+
+    booleval::typed_evaluator<obj> by_name({ { "name", &obj::name }, { "count", &obj::count } });
+    booleval::typed_evaluator<obj> by_getter({ { "name", &obj::get_name }, { "count", &obj::get_count } });
+    by_name.expression_tree(expression_tree);
+    by_getter.expression_tree(expression_tree);
+    expression_tree.reset();
+
+    EXPECT_TRUE(by_name.is_activated());
+    EXPECT_TRUE(by_name.evaluate(obj{ "foo", 2 }));
+    EXPECT_FALSE(by_name.evaluate(obj{ "foo", -2 }));
+    EXPECT_TRUE(by_getter.evaluate(obj{ "foo", -2 }));
+    EXPECT_FALSE(by_getter.evaluate(obj{ "bar", 2 }));
+
+    by_name.expression_tree(std::make_shared<booleval::tree::expression_tree>());
+    EXPECT_FALSE(by_name.is_activated());
+    EXPECT_TRUE(by_getter.is_activated());
+}
+
+TEST_F(TypedEvaluatorTest, FloatingPointMagnitudes) {
+    booleval::typed_evaluator<obj> evaluator({
+        { "ratio",  &obj::ratio },
+        { "weight", &obj::weight }
+    });
+
+    EXPECT_TRUE(evaluator.expression("ratio 0.0001 and weight == 0.00001"));
+    EXPECT_TRUE(evaluator.evaluate(obj{ "", 0, 0, 0.0001, 0.00001F }));
+    EXPECT_FALSE(evaluator.evaluate(obj{ "", 0, 0, 0.0001, 0.0001F }));
+
+    EXPECT_TRUE(evaluator.expression("ratio 123456789012345680 or weight neq 0.0001"));
+    EXPECT_TRUE(evaluator.evaluate(obj{ "", 0, 0, 1.2345678901234568e17, 0.0001F }));
+    EXPECT_FALSE(evaluator.evaluate(obj{ "", 0, 0, 1e17, 0.0001F }));
+}
+
+TEST_F(TypedEvaluatorTest, MissingField) {
+    booleval::typed_evaluator<obj> evaluator({
+        { "name", &obj::name }
+    });
+
+    EXPECT_TRUE(evaluator.expression("name foo or missing 1"));
+    EXPECT_TRUE(evaluator.evaluate(obj{ "foo" }));
+
+    try {
+        [[maybe_unused]] auto const result = evaluator.evaluate(obj{ "bar" });
+        FAIL() << "Expected booleval::field_not_found";
+    } catch (booleval::field_not_found const& ex) {
+        EXPECT_EQ(ex.what(), std::string("Field 'missing' not found"));
+    }
+
+    evaluator.fields({ { "name", &obj::name }, { "missing", &obj::count } });
+    EXPECT_FALSE(evaluator.evaluate(obj{ "bar" }));
+}
+
+TEST_F(TypedEvaluatorTest, SameResultsAsEvaluator) {
+    booleval::typed_evaluator<obj> typed({
+        { "name",   &obj::get_name },
+        { "count",  &obj::count },
+        { "ucount", &obj::get_count },
+        { "id",     &obj::id },
+        { "ratio",  &obj::ratio },
+        { "weight", &obj::weight },
+        { "note",   &obj::note }
+    });
+
+    booleval::evaluator<> erased({
+        { "name",   &obj::get_name },
+        { "count",  &obj::count },
+        { "ucount", &obj::get_count },
+        { "id",     &obj::id },
+        { "ratio",  &obj::ratio },
+        { "weight", &obj::weight }
+    });
+
+    booleval::evaluator<booleval::utils::any_mem_fn_bool> erased_note({
+        { "note", &obj::note }
+    });
+
+    char const* predicates[] = {
+        "name foo", "name neq bar", "name > bar", "name <= foo", "name < 5", "name contains o", "name like \"_o%\"",
+        "count 3", "count 03", "count 3.0", "count neq -2", "count > 2", "count >= -1", "count < 3.5", "count <= abc",
+        "ucount 2", "ucount > 2.5", "ucount matches ^1",
+        "id 9007199254740993", "id neq 9007199254740993", "id > 9007199254740992", "id < -5",
+        "ratio 0.5", "ratio 0", "ratio -0", "ratio neq 0", "ratio > 0.25", "ratio < 1e-1", "ratio geq 2", "ratio 2.0",
+        "weight 0.1", "weight > 0.1", "weight <= 0.1", "weight 1.5", "weight contains 1",
+        "count is null", "ratio is not null"
+    };
+
+    std::mt19937 generator{ 42 };
+    auto const random_expression = [&](auto const& self, std::size_t const depth) -> std::string {
+        if (0 == depth || 0 == generator() % 3) {
+            return predicates[generator() % std::size(predicates)];
+        }
+
+        auto const op = 0 == generator() % 2 ? " and " : " or ";
+        return "(" + self(self, depth - 1) + op + self(self, depth - 1) + ")";
+    };
+
+    obj const objects[] = {
+        { "foo", 3, 9007199254740993, 0.5, 0.1f },
+        { "bar", -2, 9007199254740992, 0.0, 1.5f },
+        { "boo", 0, -6, -0.0, 0.2f },
+        { "5", 10, 7, 0.25, -1.0f },
+        { "", 1, 0, 2.0, 0.0f }
+    };
+
+    for (std::size_t round = 0; round < 500; ++round) {
+        auto const expression = random_expression(random_expression, 3);
+        ASSERT_TRUE(typed.expression(expression));
+        ASSERT_TRUE(erased.expression(expression));
+
+        for (auto const& o : objects) {
+            ASSERT_EQ(typed.evaluate(o), erased.evaluate(o)) << expression << " " << o.name;
+        }
+    }
+
+    for (auto const expression : { "note is null", "note is not null", "note foo", "note neq foo", "note > bar" }) {
+        ASSERT_TRUE(typed.expression(expression));
+        ASSERT_TRUE(erased_note.expression(expression));
+
+        for (auto const& o : objects) {
+            ASSERT_EQ(typed.evaluate(o), erased_note.evaluate(o)) << expression << " " << o.name;
+        }
+    }
+}
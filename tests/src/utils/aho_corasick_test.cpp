@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <string_view>
+#include <gtest/gtest.h>
+#include <booleval/utils/aho_corasick.hpp>
+
+class AhoCorasickTest : public testing::Test {
+public:
+    static std::vector<std::size_t> matched(booleval::utils::aho_corasick const& automaton, std::string_view const value) {
+        std::vector<std::size_t> patterns;
+        automaton.find(value, [&patterns](auto const pattern) {
+            patterns.push_back(pattern);
+        });
+        std::sort(std::begin(patterns), std::end(patterns));
+        patterns.erase(std::unique(std::begin(patterns), std::end(patterns)), std::end(patterns));
+        return patterns;
+    }
+};
+
+TEST_F(AhoCorasickTest, EmptyAutomaton) {
+    using namespace booleval::utils;
+
+    aho_corasick const automaton;
+    EXPECT_EQ(automaton.size(), 0);
+    EXPECT_TRUE(matched(automaton, "foo").empty());
+
+    aho_corasick const built{ {} };
+    EXPECT_TRUE(matched(built, "foo").empty());
+}
+
+TEST_F(AhoCorasickTest, OverlappingPatterns) {
+    using namespace booleval::utils;
+
+    aho_corasick const automaton{ { "he", "she", "his", "hers" } };
+    EXPECT_EQ(automaton.size(), 4);
+
+    std::vector<std::size_t> occurrences;
+    automaton.find("ushers", [&occurrences](auto const pattern) {
+        occurrences.push_back(pattern);
+    });
+    EXPECT_EQ(occurrences, (std::vector<std::size_t>{ 1, 0, 3 }));
+
+    EXPECT_EQ(matched(automaton, "ahishers"), (std::vector<std::size_t>{ 0, 1, 2, 3 }));
+    EXPECT_EQ(matched(automaton, "h"), std::vector<std::size_t>{});
+    EXPECT_EQ(matched(automaton, ""), std::vector<std::size_t>{});
+}
+
+TEST_F(AhoCorasickTest, EmptyAndDuplicatedPatterns) {
+    using namespace booleval::utils;
+
+    aho_corasick const automaton{ { "ab", "", "ab", "b" } };
+
+    std::vector<std::size_t> occurrences;
+    automaton.find("abab", [&occurrences](auto const pattern) {
+        occurrences.push_back(pattern);
+    });
+    EXPECT_EQ(occurrences, (std::vector<std::size_t>{ 1, 0, 2, 3, 0, 2, 3 }));
+
+    EXPECT_EQ(matched(automaton, ""), std::vector<std::size_t>{ 1 });
+}
+
+TEST_F(AhoCorasickTest, RandomPatterns) {
+    using namespace booleval::utils;
+
+    std::mt19937 generator{ 42 };
+    auto const random_string = [&generator](std::size_t const max_length) {
+        std::string value(generator() % (max_length + 1), 'a');
+        for (auto& c : value) {
+            c = static_cast<char>('a' + generator() % 3);
+        }
+        return value;
+    };
+
+    for (std::size_t round = 0; round < 200; ++round) {
+        std::vector<std::string> patterns;
+        for (std::size_t i = 0; i < 1 + generator() % 20; ++i) {
+            patterns.push_back(random_string(5));
+        }
+
+        aho_corasick const automaton{ std::vector<std::string_view>(std::begin(patterns), std::end(patterns)) };
+        for (std::size_t i = 0; i < 20; ++i) {
+            auto const value = random_string(30);
+
+            std::vector<std::size_t> expected;
+            for (std::size_t p = 0; p < patterns.size(); ++p) {
+                if (std::string::npos != value.find(patterns[p])) {
+                    expected.push_back(p);
+                }
+            }
+
+            ASSERT_EQ(matched(automaton, value), expected) << value;
+        }
+    }
+}
@@ -44,6 +44,11 @@ public:
     private:
         T value_;
     };
+
+    template <typename T>
+    struct record {
+        T value;
+    };
 };
 
 TEST_F(AnyMemFnTest, IntValue) {
@@ -121,3 +126,17 @@ TEST_F(AnyMemFnTest, FloatingPointComparisons) {
     EXPECT_TRUE(fn.invoke(foo) <= 1.234567F);
     EXPECT_TRUE(fn.invoke(foo) <= 2.345678F);
 }
+
+TEST_F(AnyMemFnTest, DataMember) {
+    using namespace booleval::utils;
+
+    record<uint8_t> foo{ 1 };
+    any_mem_fn int_fn{ &record<uint8_t>::value };
+    EXPECT_EQ(int_fn.invoke(foo), 1U);
+
+    record<std::string> bar{ "abc" };
+    any_mem_fn string_fn{ &record<std::string>::value };
+    EXPECT_EQ(string_fn.invoke(bar), "abc");
+
+    EXPECT_TRUE(int_fn.invoke(bar).is_null());
+}
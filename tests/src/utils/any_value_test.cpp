@@ -109,3 +109,14 @@ TEST_F(AnyValueTest, FloatingPointComparisons) {
     EXPECT_TRUE(value <= 1.234567F);
     EXPECT_TRUE(value <= 2.345678F);
 }
+
+TEST_F(AnyValueTest, NullValue) {
+    using namespace booleval::utils;
+
+    any_value value;
+    EXPECT_TRUE(value.is_null());
+
+    value = 0;
+    EXPECT_FALSE(value.is_null());
+    EXPECT_FALSE(any_value{ "" }.is_null());
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <vector>
+#include <gtest/gtest.h>
+#include <booleval/utils/bitmap.hpp>
+
+class BitmapTest : public testing::Test {};
+
+TEST_F(BitmapTest, Construction) {
+    using namespace booleval::utils;
+
+    bitmap const empty;
+    EXPECT_EQ(empty.size(), 0U);
+    EXPECT_EQ(empty.count(), 0U);
+    EXPECT_FALSE(empty.any());
+    EXPECT_TRUE(empty.indices().empty());
+
+    bitmap const ones(130, true);
+    EXPECT_EQ(ones.size(), 130U);
+    EXPECT_EQ(ones.word_count(), 3U);
+    EXPECT_EQ(ones.count(), 130U);
+    EXPECT_TRUE(ones.all());
+    EXPECT_EQ(ones.data()[2], 0x3U);
+
+    bitmap const words({ ~uint64_t{ 0 }, ~uint64_t{ 0 } }, 70);
+    EXPECT_EQ(words.word_count(), 2U);
+    EXPECT_EQ(words.count(), 70U);
+}
+
+TEST_F(BitmapTest, SetAndTest) {
+    using namespace booleval::utils;
+
+    bitmap bits(200);
+    bits.set(0);
+    bits.set(63);
+    bits.set(64);
+    bits.set(199);
+    EXPECT_TRUE(bits.test(63));
+    EXPECT_FALSE(bits.test(62));
+    EXPECT_EQ(bits.count(), 4U);
+    EXPECT_EQ(bits.indices(), (std::vector<std::size_t>{ 0, 63, 64, 199 }));
+    EXPECT_EQ(bits.indices(1000), (std::vector<std::size_t>{ 1000, 1063, 1064, 1199 }));
+
+    bits.reset(63);
+    EXPECT_FALSE(bits.test(63));
+    EXPECT_EQ(bits.count(), 3U);
+
+    bits.resize(64);
+    EXPECT_EQ(bits.indices(), (std::vector<std::size_t>{ 0 }));
+    bits.resize(200);
+    EXPECT_EQ(bits.count(), 1U);
+}
+
+TEST_F(BitmapTest, LogicalOperations) {
+    using namespace booleval::utils;
+
+    bitmap multiples_of_2(300);
+    bitmap multiples_of_3(300);
+    for (std::size_t i = 0; i < 300; ++i) {
+        if (0 == i % 2) multiples_of_2.set(i);
+        if (0 == i % 3) multiples_of_3.set(i);
+    }
+
+    auto const both = multiples_of_2 & multiples_of_3;
+    auto const either = multiples_of_2 | multiples_of_3;
+    auto only = multiples_of_2;
+    only.and_not(multiples_of_3);
+    auto neither = either;
+    neither.flip();
+
+    for (std::size_t i = 0; i < 300; ++i) {
+        EXPECT_EQ(both.test(i), 0 == i % 6);
+        EXPECT_EQ(either.test(i), 0 == i % 2 || 0 == i % 3);
+        EXPECT_EQ(only.test(i), 0 == i % 2 && 0 != i % 3);
+        EXPECT_EQ(neither.test(i), 0 != i % 2 && 0 != i % 3);
+    }
+    EXPECT_EQ(both.count(), 50U);
+    EXPECT_EQ(either.count() + neither.count(), 300U);
+    EXPECT_EQ(neither.size(), 300U);
+
+    EXPECT_EQ(both | only, multiples_of_2);
+    EXPECT_NE(both, multiples_of_2);
+}
+
+TEST_F(BitmapTest, DifferentSizes) {
+    using namespace booleval::utils;
+
+    bitmap const small(10, true);
+    bitmap const large(200, true);
+
+    auto const intersection = large & small;
+    EXPECT_EQ(intersection.size(), 200U);
+    EXPECT_EQ(intersection.count(), 10U);
+
+    auto const unions = small | large;
+    EXPECT_EQ(unions.size(), 200U);
+    EXPECT_EQ(unions.count(), 200U);
+
+    auto difference = large;
+    difference.and_not(small);
+    EXPECT_EQ(difference.count(), 190U);
+}
+
+TEST_F(BitmapTest, Release) {
+    using namespace booleval::utils;
+
+    bitmap bits(100, true);
+    auto const words = bits.release();
+    EXPECT_EQ(words.size(), 2U);
+    EXPECT_EQ(bits.size(), 0U);
+    EXPECT_EQ(bits.count(), 0U);
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <booleval/utils/bloom_filter.hpp>
+
+class BloomFilterTest : public testing::Test {};
+
+TEST_F(BloomFilterTest, DefaultConstructor) {
+    using namespace booleval::utils;
+
+    bloom_filter const filter;
+    EXPECT_TRUE(filter.may_contain("foo"));
+    EXPECT_EQ(filter.size_in_bytes(), 0U);
+}
+
+TEST_F(BloomFilterTest, Empty) {
+    using namespace booleval::utils;
+
+    bloom_filter const filter(0);
+    EXPECT_EQ(filter.size_in_bytes(), 32U);
+    EXPECT_FALSE(filter.may_contain("foo"));
+    EXPECT_FALSE(filter.may_contain(""));
+}
+
+TEST_F(BloomFilterTest, NoFalseNegatives) {
+    using namespace booleval::utils;
+
+    bloom_filter filter(10000);
+    for (std::size_t i = 0; i < 10000; ++i) {
+        filter.add("key_" + std::to_string(i));
+    }
+
+    for (std::size_t i = 0; i < 10000; ++i) {
+        EXPECT_TRUE(filter.may_contain("key_" + std::to_string(i))) << i;
+    }
+}
+
+TEST_F(BloomFilterTest, FalsePositiveRate) {
+    using namespace booleval::utils;
+
+    bloom_filter filter(10000);
+    EXPECT_EQ(filter.size_in_bytes(), 12512U);
+    for (std::size_t i = 0; i < 10000; ++i) {
+        filter.add(std::to_string(i));
+    }
+
+    std::size_t false_positives{ 0 };
+    for (std::size_t i = 10000; i < 110000; ++i) {
+        false_positives += filter.may_contain(std::to_string(i)) ? 1 : 0;
+    }
+    EXPECT_LT(false_positives, 3000U);
+}
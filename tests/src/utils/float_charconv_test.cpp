@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#define BOOLEVAL_BUNDLED_FLOAT_CHARCONV
+
+#include <array>
+#include <limits>
+#include <clocale>
+#include <gtest/gtest.h>
+#include <booleval/utils/string_utils.hpp>
+
+class FloatCharconvTest : public testing::Test {
+protected:
+    void SetUp() override {
+#ifdef BOOLEVAL_STD_FLOAT_CHARCONV
+        GTEST_SKIP() << "Bundled floating point conversions are not used";
+#endif
+        for (auto const name : { "de_DE.UTF-8", "de_DE.utf8", "de_DE", "fr_FR.UTF-8", "fr_FR.utf8", "ru_RU.UTF-8" }) {
+            if (nullptr != std::setlocale(LC_NUMERIC, name)) {
+                return;
+            }
+        }
+        GTEST_SKIP() << "No locale with comma decimal point is available";
+    }
+
+    void TearDown() override {
+        std::setlocale(LC_NUMERIC, "C");
+    }
+};
+
+TEST_F(FloatCharconvTest, ParsingWithCommaLocale) {
+    using namespace booleval::utils;
+
+    std::array<char, 16> buffer;
+    std::snprintf(buffer.data(), buffer.size(), "%.1f", 1.5);
+    ASSERT_STREQ(buffer.data(), "1,5");
+
+    std::size_t length{ 0 };
+    EXPECT_EQ(from_chars<double>("1.5", length), 1.5);
+    EXPECT_EQ(length, 3U);
+    EXPECT_EQ(from_chars<double>("-0.125"), -0.125);
+    EXPECT_EQ(from_chars<double>("1e-300"), 1e-300);
+    EXPECT_EQ(from_chars<double>("123456789012345678901234"), 123456789012345678901234.0);
+    EXPECT_EQ(from_chars<double>("1.2345678901234567890123e-5"), 1.2345678901234567890123e-5);
+    EXPECT_EQ(from_chars<double>("0.30000000000000004"), 0.1 + 0.2);
+    EXPECT_EQ(from_chars<float>("3.4028234e38"), std::numeric_limits<float>::max());
+    EXPECT_EQ(from_chars<long double>("2.5"), 2.5L);
+    EXPECT_FALSE(from_chars<double>("1e400"));
+    EXPECT_EQ(from_chars<double>("1,5", length), 1.0);
+    EXPECT_EQ(length, 1U);
+}
+
+TEST_F(FloatCharconvTest, FormattingWithCommaLocale) {
+    using namespace booleval::utils;
+
+    std::array<char, max_chars<double>> buffer;
+    EXPECT_EQ(to_chars(buffer, 1.5), "1.5");
+    EXPECT_EQ(to_chars(buffer, -0.125), "-0.125");
+    EXPECT_EQ(to_chars(buffer, 0.1 + 0.2), "0.30000000000000004");
+    EXPECT_EQ(to_chars(buffer, 0.0001), "0.0001");
+    EXPECT_EQ(to_chars(buffer, 1.25e21), "1250000000000000000000");
+    EXPECT_EQ(to_chars(buffer, 3.0), "3");
+
+    std::array<char, max_chars<float>> float_buffer;
+    EXPECT_EQ(to_chars(float_buffer, 0.1F), "0.1");
+}
+
+TEST_F(FloatCharconvTest, RoundTripWithCommaLocale) {
+    using namespace booleval::utils;
+
+    std::array<char, max_chars<double>> buffer;
+    for (auto const value : { 0.1, 2.0 / 3.0, 1e-310, 6.02214076e23, std::numeric_limits<double>::max() }) {
+        EXPECT_EQ(from_chars_exact<double>(to_chars(buffer, value)), value);
+    }
+}
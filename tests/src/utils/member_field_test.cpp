@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <booleval/evaluator.hpp>
+#include <booleval/utils/member_field.hpp>
+
+class MemberFieldTest : public testing::Test {
+public:
+    enum class tier : uint8_t { basic = 1, premium = 2 };
+
+    struct header {
+        uint64_t timestamp;
+        tier level;
+    };
+
+    struct customer {
+        std::string name;
+
+        std::string const& display_name() const noexcept { return name; }
+        std::string greeting() const { return "hello " + name; }
+    };
+
+    struct order {
+        header head;
+        customer buyer;
+        double price;
+        int quantity;
+
+        customer buyer_copy() const { return buyer; }
+        header head_copy() const noexcept { return head; }
+    };
+};
+
+TEST_F(MemberFieldTest, DataMember) {
+    using namespace booleval::utils;
+
+    order const o{ { 10, tier::premium }, { "foo" }, 1.5, 3 };
+
+    member_field<order> price{ &order::price };
+    member_field<order> quantity{ &order::quantity };
+
+    EXPECT_EQ(price.invoke(o), "1.5");
+    EXPECT_EQ(quantity.invoke(o), 3);
+}
+
+TEST_F(MemberFieldTest, NestedPath) {
+    using namespace booleval::utils;
+
+    order const o{ { 10, tier::premium }, { "foo" }, 1.5, 3 };
+
+    auto const timestamp = member_field<order>::path<&order::head, &header::timestamp>();
+    auto const level = member_field<order>::path<&order::head, &header::level>();
+    auto const name = member_field<order>::path<&order::buyer, &customer::display_name>();
+
+    EXPECT_EQ(timestamp.invoke(o), 10U);
+    EXPECT_EQ(level.invoke(o), 2U);
+    EXPECT_EQ(name.invoke(o), "foo");
+}
+
+TEST_F(MemberFieldTest, PathThroughValues) {
+    using namespace booleval::utils;
+
+    order const o{ { 10, tier::premium }, { "foo bar baz qux quux corge grault" }, 1.5, 3 };
+
+    auto const name = member_field<order>::path<&order::buyer_copy, &customer::name>();
+    auto const display_name = member_field<order>::path<&order::buyer_copy, &customer::display_name>();
+    auto const greeting = member_field<order>::path<&order::buyer_copy, &customer::greeting>();
+    auto const timestamp = member_field<order>::path<&order::head_copy, &header::timestamp>();
+
+    EXPECT_EQ(name.invoke(o), "foo bar baz qux quux corge grault");
+    EXPECT_EQ(display_name.invoke(o), "foo bar baz qux quux corge grault");
+    EXPECT_EQ(greeting.invoke(o), "hello foo bar baz qux quux corge grault");
+    EXPECT_EQ(timestamp.invoke(o), 10U);
+}
+
+TEST_F(MemberFieldTest, NotSet) {
+    using namespace booleval::utils;
+
+    order const o{ { 10, tier::basic }, { "foo" }, 1.5, 3 };
+
+    member_field<order> field;
+    EXPECT_EQ(field.invoke(o), "");
+}
+
+TEST_F(MemberFieldTest, Evaluator) {
+    using namespace booleval;
+
+    evaluator<utils::member_field<order>> evaluator({
+        { "price",          &order::price },
+        { "head.timestamp", utils::member_field<order>::path<&order::head, &header::timestamp>() },
+        { "buyer.name",     utils::member_field<order>::path<&order::buyer, &customer::name>() }
+    });
+
+    EXPECT_TRUE(evaluator.expression("price > 1 and head.timestamp >= 10 and buyer.name foo"));
+    EXPECT_TRUE(evaluator.evaluate(order{ { 10, tier::basic }, { "foo" }, 1.5, 3 }));
+    EXPECT_FALSE(evaluator.evaluate(order{ { 9, tier::basic }, { "foo" }, 1.5, 3 }));
+    EXPECT_FALSE(evaluator.evaluate(order{ { 10, tier::basic }, { "bar" }, 1.5, 3 }));
+}
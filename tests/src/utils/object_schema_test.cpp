@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string>
+#include <cstdint>
+#include <typeindex>
+#include <gtest/gtest.h>
+#include <booleval/exceptions.hpp>
+#include <booleval/utils/object_schema.hpp>
+
+class ObjectSchemaTest : public testing::Test {
+public:
+    enum class tier : uint8_t { basic = 1, premium = 2 };
+
+    struct address {
+        std::string city;
+    };
+
+    struct customer {
+        tier level;
+        address home;
+        address const* billing;
+
+        address const& shipping() const noexcept { return home; }
+    };
+
+    struct order {
+        int id;
+        customer buyer;
+    };
+
+    static booleval::utils::object_schema make_schema() {
+        booleval::utils::object_schema schema;
+        schema.add("id", &order::id);
+        schema.add("customer", &order::buyer);
+        schema.add("tier", &customer::level);
+        schema.add("home", &customer::home);
+        schema.add("billing", &customer::billing);
+        schema.add("shipping", &customer::shipping);
+        schema.add("city", &address::city);
+        return schema;
+    }
+};
+
+TEST_F(ObjectSchemaTest, Add) {
+    using namespace booleval::utils;
+
+    object_schema schema;
+    EXPECT_TRUE(schema.add("id", &order::id));
+    EXPECT_FALSE(schema.add("id", &order::buyer));
+    EXPECT_TRUE(schema.add("id", &customer::level));
+
+    auto const id = schema.find(typeid(order), "id");
+    ASSERT_NE(id, nullptr);
+    EXPECT_FALSE(id->is_object());
+    EXPECT_EQ(schema.find(typeid(order), "tier"), nullptr);
+    EXPECT_EQ(schema.find(typeid(address), "id"), nullptr);
+}
+
+TEST_F(ObjectSchemaTest, Resolve) {
+    using namespace booleval::utils;
+
+    auto const schema = make_schema();
+
+    auto const chain = schema.resolve(typeid(order), "customer.home.city");
+    ASSERT_EQ(chain.size(), 3U);
+    EXPECT_TRUE(chain[0]->is_object());
+    EXPECT_EQ(chain[0]->target, std::type_index(typeid(customer)));
+    EXPECT_TRUE(chain[1]->is_object());
+    EXPECT_EQ(chain[1]->target, std::type_index(typeid(address)));
+    EXPECT_FALSE(chain[2]->is_object());
+
+    EXPECT_EQ(schema.resolve(typeid(order), "id").size(), 1U);
+    EXPECT_EQ(schema.resolve(typeid(order), "customer.billing.city").size(), 3U);
+    EXPECT_EQ(schema.resolve(typeid(order), "customer.shipping.city").size(), 3U);
+
+    EXPECT_TRUE(schema.resolve(typeid(order), "customer").empty());
+    EXPECT_TRUE(schema.resolve(typeid(order), "customer.home").empty());
+    EXPECT_TRUE(schema.resolve(typeid(order), "id.city").empty());
+    EXPECT_TRUE(schema.resolve(typeid(order), "customer.name").empty());
+    EXPECT_TRUE(schema.resolve(typeid(order), "customer..tier").empty());
+    EXPECT_TRUE(schema.resolve(typeid(customer), "customer.tier").empty());
+}
+
+TEST_F(ObjectSchemaTest, Compile) {
+    using namespace booleval;
+
+    auto const schema = make_schema();
+
+    address const billing{ "zagreb" };
+    order const o{ 7, { tier::premium, { "split" }, &billing } };
+    order const no_billing{ 8, { tier::basic, { "rijeka" }, nullptr } };
+
+    auto const fields = schema.compile(typeid(order), {
+        "id", "customer.tier", "customer.home.city", "customer.billing.city", "customer.shipping.city"
+    });
+    ASSERT_EQ(fields.size(), 5U);
+
+    utils::path_record const record{ &o };
+    EXPECT_EQ(fields.at("id").invoke(record), 7);
+    EXPECT_EQ(fields.at("customer.tier").invoke(record), 2);
+    EXPECT_EQ(fields.at("customer.home.city").invoke(record), "split");
+    EXPECT_EQ(fields.at("customer.billing.city").invoke(record), "zagreb");
+    EXPECT_EQ(fields.at("customer.shipping.city").invoke(record), "split");
+
+    utils::path_record const null_record{ &no_billing };
+    EXPECT_EQ(fields.at("customer.billing.city").invoke(null_record), "");
+    EXPECT_EQ(fields.at("customer.home.city").invoke(null_record), "rijeka");
+
+    EXPECT_THROW((void) schema.compile(typeid(order), { "id", "customer.name" }), field_not_found);
+}
+
+TEST_F(ObjectSchemaTest, PrefixMemoization) {
+    using namespace booleval::utils;
+
+    path_record const record{ nullptr };
+    void const* object{ nullptr };
+
+    EXPECT_FALSE(record.recall(0, object));
+
+    int const value{ 0 };
+    record.memoize(0, &value);
+    record.memoize(path_record::memo_capacity, &value);
+
+    EXPECT_TRUE(record.recall(0, object));
+    EXPECT_EQ(object, &value);
+    EXPECT_FALSE(record.recall(1, object));
+    EXPECT_FALSE(record.recall(path_record::memo_capacity, object));
+}
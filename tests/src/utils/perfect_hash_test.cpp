@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string>
+#include <vector>
+#include <string_view>
+#include <gtest/gtest.h>
+#include <booleval/utils/perfect_hash.hpp>
+
+class PerfectHashTest : public testing::Test {};
+
+TEST_F(PerfectHashTest, EmptySet) {
+    using namespace booleval::utils;
+
+    perfect_hash const set;
+    EXPECT_EQ(set.size(), 0);
+    EXPECT_EQ(set.find("foo"), perfect_hash::npos);
+    EXPECT_EQ(set.find(""), perfect_hash::npos);
+
+    perfect_hash const built{ {} };
+    EXPECT_EQ(built.find("foo"), perfect_hash::npos);
+}
+
+TEST_F(PerfectHashTest, Find) {
+    using namespace booleval::utils;
+
+    perfect_hash const set{ { "/", "/index.html", "", "/api/v1/users", "/api/v1/users/" } };
+    EXPECT_EQ(set.size(), 5);
+    EXPECT_EQ(set.find("/"), 0);
+    EXPECT_EQ(set.find("/index.html"), 1);
+    EXPECT_EQ(set.find(""), 2);
+    EXPECT_EQ(set.find("/api/v1/users"), 3);
+    EXPECT_EQ(set.find("/api/v1/users/"), 4);
+    EXPECT_EQ(set.find("/api/v1/user"), perfect_hash::npos);
+    EXPECT_EQ(set.find("/INDEX.html"), perfect_hash::npos);
+}
+
+TEST_F(PerfectHashTest, DuplicatedKeys) {
+    using namespace booleval::utils;
+
+    perfect_hash const set{ { "foo", "bar", "foo", "baz", "bar" } };
+    EXPECT_EQ(set.size(), 5);
+    EXPECT_EQ(set.find("foo"), 0);
+    EXPECT_EQ(set.find("bar"), 1);
+    EXPECT_EQ(set.find("baz"), 3);
+}
+
+TEST_F(PerfectHashTest, ManyKeys) {
+    using namespace booleval::utils;
+
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < 50000; ++i) {
+        keys.push_back("/api/v" + std::to_string(i % 7) + "/resource/" + std::to_string(i));
+    }
+
+    perfect_hash const set{ std::vector<std::string_view>(std::begin(keys), std::end(keys)) };
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        ASSERT_EQ(set.find(keys[i]), i);
+        ASSERT_EQ(set.find(keys[i] + "/"), perfect_hash::npos);
+    }
+}
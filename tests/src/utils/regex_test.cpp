@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <regex>
+#include <random>
+#include <string>
+#include <string_view>
+#include <gtest/gtest.h>
+#include <booleval/utils/regex.hpp>
+
+class RegexTest : public testing::Test {};
+
+TEST_F(RegexTest, Literals) {
+    using namespace booleval::utils;
+
+    regex const expression{ "error" };
+    EXPECT_TRUE(expression.is_valid());
+    EXPECT_TRUE(expression.matches("error"));
+    EXPECT_TRUE(expression.matches("2020-01-01 error: disk full"));
+    EXPECT_FALSE(expression.matches("warning"));
+    EXPECT_FALSE(expression.matches(""));
+}
+
+TEST_F(RegexTest, Anchors) {
+    using namespace booleval::utils;
+
+    EXPECT_TRUE(regex{ "^GET " }.matches("GET /index.html"));
+    EXPECT_FALSE(regex{ "^GET " }.matches("FORGET "));
+    EXPECT_TRUE(regex{ "\\.html$" }.matches("/index.html"));
+    EXPECT_FALSE(regex{ "\\.html$" }.matches("/index.html?x=1"));
+    EXPECT_TRUE(regex{ "^$" }.matches(""));
+    EXPECT_FALSE(regex{ "^$" }.matches("a"));
+    EXPECT_TRUE(regex{ "^a|b$" }.matches("xxb"));
+    EXPECT_FALSE(regex{ "^a|b$" }.matches("xaxbx"));
+}
+
+TEST_F(RegexTest, ClassesAndQuantifiers) {
+    using namespace booleval::utils;
+
+    regex const status{ "HTTP/1\\.[01]\" [45]\\d{2} " };
+    EXPECT_TRUE(status.matches("\"GET / HTTP/1.1\" 404 512"));
+    EXPECT_FALSE(status.matches("\"GET / HTTP/1.1\" 200 512"));
+
+    regex const address{ "(?:\\d{1,3}\\.){3}\\d{1,3}" };
+    EXPECT_TRUE(address.matches("client 192.168.0.1 connected"));
+    EXPECT_FALSE(address.matches("client 192.168.0 connected"));
+
+    EXPECT_TRUE(regex{ "[^a-z]+$" }.matches("abc123"));
+    EXPECT_TRUE(regex{ "[]-]" }.matches("a]b"));
+    EXPECT_TRUE(regex{ "colou?r" }.matches("color"));
+    EXPECT_TRUE(regex{ "a.*?b" }.matches("axxb"));
+}
+
+TEST_F(RegexTest, InvalidExpressions) {
+    using namespace booleval::utils;
+
+    for (auto const pattern : { "(", "a)", "[a-", "*a", "a{2,1}", "a{1001}", "\\b", "\\1", "a^*", "[z-a]" }) {
+        EXPECT_FALSE(regex{ pattern }.is_valid()) << pattern;
+        EXPECT_FALSE(regex{ pattern }.matches(pattern)) << pattern;
+    }
+
+    // The automaton of the value having 'a' at the 20th position from the end is too large
+    EXPECT_FALSE(regex{ "a[ab]{19}$" }.is_valid());
+}
+
+TEST_F(RegexTest, AgainstStandardRegex) {
+    using namespace booleval::utils;
+
+    std::mt19937 engine{ 11 };
+    char const* atoms[] = { "a", "b", "c", ".", "[ab]", "[^a]", "\\d", "(a|bc)", "(?:ab|c)", "^", "$", "()" };
+    char const* quantifiers[] = { "", "", "", "*", "+", "?", "{2}", "{1,2}", "{0,}" };
+
+    for (auto i = 0; i < 3000; ++i) {
+        std::string pattern;
+        for (auto n = engine() % 5 + 1; n > 0; --n) {
+            std::string atom = atoms[engine() % std::size(atoms)];
+            if ('^' != atom.front() && '$' != atom.front()) {
+                atom += quantifiers[engine() % std::size(quantifiers)];
+            }
+            pattern += atom;
+            if (0 == engine() % 6) {
+                pattern += '|';
+            }
+        }
+        if ('|' == pattern.back()) {
+            pattern.pop_back();
+        }
+
+        regex const expression{ pattern };
+        ASSERT_TRUE(expression.is_valid()) << pattern;
+
+        std::regex const reference{ pattern, std::regex::ECMAScript };
+        for (auto j = 0; j < 20; ++j) {
+            std::string value;
+            for (auto n = engine() % 8; n > 0; --n) {
+                value.push_back("abc1 "[engine() % 5]);
+            }
+            ASSERT_EQ(expression.matches(value), std::regex_search(value, reference))
+                << "'" << value << "' matches '" << pattern << "'";
+        }
+    }
+}
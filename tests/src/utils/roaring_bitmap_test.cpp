@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <booleval/utils/roaring_bitmap.hpp>
+
+class RoaringBitmapTest : public testing::Test {};
+
+TEST_F(RoaringBitmapTest, Empty) {
+    using namespace booleval::utils;
+
+    roaring_bitmap const set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(set.cardinality(), 0U);
+    EXPECT_FALSE(set.contains(0));
+    EXPECT_TRUE(set.indices().empty());
+    EXPECT_EQ(set.to_bitmap(100), bitmap(100));
+
+    roaring_bitmap const compressed{ bitmap(100000) };
+    EXPECT_TRUE(compressed.empty());
+}
+
+TEST_F(RoaringBitmapTest, Add) {
+    using namespace booleval::utils;
+
+    roaring_bitmap set;
+    set.add(70000);
+    set.add(5);
+    set.add(5);
+    set.add(65535);
+    set.add(4000000000U);
+
+    EXPECT_EQ(set.cardinality(), 4U);
+    EXPECT_EQ(set.container_count(), 3U);
+    EXPECT_TRUE(set.contains(5));
+    EXPECT_TRUE(set.contains(65535));
+    EXPECT_TRUE(set.contains(70000));
+    EXPECT_TRUE(set.contains(4000000000U));
+    EXPECT_FALSE(set.contains(6));
+    EXPECT_FALSE(set.contains(65536));
+    EXPECT_EQ(set.indices(), (std::vector<std::size_t>{ 5, 65535, 70000, 4000000000U }));
+}
+
+TEST_F(RoaringBitmapTest, Containers) {
+    using namespace booleval::utils;
+
+    roaring_bitmap sparse;
+    for (uint32_t i = 0; i < roaring_bitmap::array_limit; ++i) {
+        sparse.add(i * 16);
+    }
+    EXPECT_EQ(sparse.container_count(), 1U);
+    EXPECT_EQ(sparse.size_in_bytes(), roaring_bitmap::array_limit * 2);
+
+    // The next value turns the array into a bitmap
+    sparse.add(1);
+    EXPECT_EQ(sparse.cardinality(), roaring_bitmap::array_limit + 1);
+    EXPECT_EQ(sparse.size_in_bytes(), 8192U);
+    EXPECT_TRUE(sparse.contains(1));
+    EXPECT_TRUE(sparse.contains(16));
+    EXPECT_FALSE(sparse.contains(17));
+
+    // Removing values turns the bitmap back into an array
+    roaring_bitmap odd;
+    odd.add(1);
+    odd.add(16);
+    sparse.and_not(odd);
+    EXPECT_EQ(sparse.cardinality(), roaring_bitmap::array_limit - 1);
+    EXPECT_EQ(sparse.size_in_bytes(), (roaring_bitmap::array_limit - 1) * 2);
+}
+
+TEST_F(RoaringBitmapTest, Bitmap) {
+    using namespace booleval::utils;
+
+    bitmap bits(200000);
+    for (std::size_t i = 0; i < 200000; ++i) {
+        if ((i < 65536 && 0 == i % 7) || (i >= 131072 && 0 == i % 1000)) {
+            bits.set(i);
+        }
+    }
+
+    roaring_bitmap const set{ bits };
+    EXPECT_EQ(set.container_count(), 3U);
+    EXPECT_EQ(set.cardinality(), bits.count());
+    EXPECT_EQ(set.indices(), bits.indices());
+    EXPECT_EQ(set.to_bitmap(200000), bits);
+    EXPECT_LT(set.size_in_bytes(), bits.word_count() * 8);
+
+    auto const truncated = set.to_bitmap(132001);
+    EXPECT_EQ(truncated.size(), 132001U);
+    EXPECT_EQ(truncated.count(), 9363U + 1U);
+}
+
+TEST_F(RoaringBitmapTest, LogicalOperations) {
+    using namespace booleval::utils;
+
+    std::mt19937 generator{ 42 };
+    for (auto const density : { 0.001, 0.05, 0.5 }) {
+        std::bernoulli_distribution distribution{ density };
+
+        bitmap lhs(300000);
+        bitmap rhs(300000);
+        for (std::size_t i = 0; i < 300000; ++i) {
+            if (distribution(generator)) lhs.set(i);
+            if (distribution(generator) || (i > 100000 && i < 120000)) rhs.set(i);
+        }
+
+        roaring_bitmap const lhs_set{ lhs };
+        roaring_bitmap const rhs_set{ rhs };
+
+        auto difference = lhs;
+        difference.and_not(rhs);
+        auto difference_set = lhs_set;
+        difference_set.and_not(rhs_set);
+
+        EXPECT_EQ((lhs_set & rhs_set).to_bitmap(300000), lhs & rhs) << density;
+        EXPECT_EQ((lhs_set | rhs_set).to_bitmap(300000), lhs | rhs) << density;
+        EXPECT_EQ(difference_set.to_bitmap(300000), difference) << density;
+
+        EXPECT_EQ((lhs_set & rhs_set), roaring_bitmap{ lhs & rhs }) << density;
+        EXPECT_EQ((lhs_set | rhs_set), roaring_bitmap{ lhs | rhs }) << density;
+        EXPECT_EQ(difference_set, roaring_bitmap{ difference }) << density;
+    }
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <gtest/gtest.h>
+#include <booleval/utils/string_matcher.hpp>
+
+class StringMatcherTest : public testing::Test {
+public:
+    /**
+     * Matches the value against the LIKE pattern by backtracking.
+     */
+    static bool like(std::string_view value, std::string_view pattern) {
+        if (pattern.empty()) {
+            return value.empty();
+        }
+
+        if ('%' == pattern.front()) {
+            for (std::size_t i = 0; i <= value.size(); ++i) {
+                if (like(value.substr(i), pattern.substr(1))) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        auto const escaped = '\\' == pattern.front() && pattern.size() > 1;
+        auto const c = pattern[escaped ? 1 : 0];
+        if (value.empty() || (value.front() != c && (escaped || '_' != c))) {
+            return false;
+        }
+
+        return like(value.substr(1), pattern.substr(escaped ? 2 : 1));
+    }
+};
+
+TEST_F(StringMatcherTest, Prefix) {
+    using namespace booleval::utils;
+
+    string_matcher matcher{ match_kind::prefix, "api." };
+    EXPECT_TRUE(matcher.matches("api.example.com"));
+    EXPECT_TRUE(matcher.matches("api."));
+    EXPECT_FALSE(matcher.matches("api"));
+    EXPECT_FALSE(matcher.matches("www.api.example.com"));
+
+    EXPECT_TRUE((string_matcher{ match_kind::prefix, "" }.matches("")));
+}
+
+TEST_F(StringMatcherTest, Suffix) {
+    using namespace booleval::utils;
+
+    string_matcher matcher{ match_kind::suffix, ".com" };
+    EXPECT_TRUE(matcher.matches("api.example.com"));
+    EXPECT_TRUE(matcher.matches(".com"));
+    EXPECT_FALSE(matcher.matches("com"));
+    EXPECT_FALSE(matcher.matches("example.com.br"));
+}
+
+TEST_F(StringMatcherTest, Substring) {
+    using namespace booleval::utils;
+
+    string_matcher matcher{ match_kind::substring, "/admin/" };
+    EXPECT_TRUE(matcher.matches("/admin/"));
+    EXPECT_TRUE(matcher.matches("/api/admin/users"));
+    EXPECT_FALSE(matcher.matches("/api/admin"));
+    EXPECT_FALSE(matcher.matches("/administrator/"));
+
+    // Characters of the pattern are taken literally
+    EXPECT_TRUE((string_matcher{ match_kind::substring, "50%" }.matches("up to 50% off")));
+    EXPECT_FALSE((string_matcher{ match_kind::substring, "50%" }.matches("up to 500 off")));
+    EXPECT_TRUE((string_matcher{ match_kind::substring, "" }.matches("")));
+}
+
+TEST_F(StringMatcherTest, Like) {
+    using namespace booleval::utils;
+
+    EXPECT_TRUE((string_matcher{ match_kind::like, "%.example.com" }.matches("api.example.com")));
+    EXPECT_TRUE((string_matcher{ match_kind::like, "/api/v_/%" }.matches("/api/v2/users")));
+    EXPECT_FALSE((string_matcher{ match_kind::like, "/api/v_/%" }.matches("/api/v10/users")));
+    EXPECT_TRUE((string_matcher{ match_kind::like, "%a%b%" }.matches("xxaxxbxx")));
+    EXPECT_FALSE((string_matcher{ match_kind::like, "%a%b%" }.matches("xxbxxaxx")));
+    EXPECT_FALSE((string_matcher{ match_kind::like, "ab%ba" }.matches("aba")));
+    EXPECT_TRUE((string_matcher{ match_kind::like, "100\\%" }.matches("100%")));
+    EXPECT_FALSE((string_matcher{ match_kind::like, "100\\%" }.matches("1000")));
+    EXPECT_TRUE((string_matcher{ match_kind::like, "%" }.matches("")));
+    EXPECT_TRUE((string_matcher{ match_kind::like, "" }.matches("")));
+    EXPECT_FALSE((string_matcher{ match_kind::like, "" }.matches("a")));
+}
+
+TEST_F(StringMatcherTest, LikeAgainstBacktracking) {
+    using namespace booleval::utils;
+
+    std::mt19937 engine{ 7 };
+    std::uniform_int_distribution<std::size_t> length{ 0, 8 };
+    std::string_view const pattern_symbols{ "ab%_\\" };
+    std::string_view const value_symbols{ "ab_%" };
+
+    for (auto i = 0; i < 20000; ++i) {
+        std::string pattern;
+        for (auto n = length(engine); n > 0; --n) {
+            pattern.push_back(pattern_symbols[engine() % pattern_symbols.size()]);
+        }
+
+        std::string value;
+        for (auto n = length(engine); n > 0; --n) {
+            value.push_back(value_symbols[engine() % value_symbols.size()]);
+        }
+
+        string_matcher const matcher{ match_kind::like, pattern };
+        ASSERT_EQ(matcher.matches(value), like(value, pattern)) << "'" << value << "' like '" << pattern << "'";
+    }
+}
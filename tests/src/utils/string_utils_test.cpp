@@ -27,6 +27,9 @@
  *
  */
 
+#include <cmath>
+#include <limits>
+#include <string>
 #include <gtest/gtest.h>
 #include <booleval/utils/string_utils.hpp>
 
@@ -169,3 +172,108 @@ TEST_F(StringUtilsTest, To) {
     EXPECT_EQ(to_chars<double>(1.234567), "1.234567");
     EXPECT_EQ(to_chars<float>(1.234567F), "1.234567");
 }
+
+TEST_F(StringUtilsTest, FromFloatingPoint) {
+    using namespace booleval::utils;
+
+    EXPECT_DOUBLE_EQ(from_chars<double>("-1.5").value(), -1.5);
+    EXPECT_DOUBLE_EQ(from_chars<double>("1e3").value(), 1000.0);
+    EXPECT_DOUBLE_EQ(from_chars<double>("2.5E-3").value(), 0.0025);
+    EXPECT_DOUBLE_EQ(from_chars<double>("123").value(), 123.0);
+    EXPECT_EQ(from_chars<double>("abc"), std::nullopt);
+    EXPECT_EQ(from_chars<double>(""), std::nullopt);
+    EXPECT_EQ(from_chars<double>("-"), std::nullopt);
+}
+
+TEST_F(StringUtilsTest, ToFloatingPoint) {
+    using namespace booleval::utils;
+
+    EXPECT_EQ(to_chars<double>(1.0), "1");
+    EXPECT_EQ(to_chars<double>(-0.5), "-0.5");
+    EXPECT_EQ(to_chars<double>(1e20), "100000000000000000000");
+    EXPECT_EQ(to_chars<double>(0.0001), "0.0001");
+    EXPECT_EQ(to_chars<double>(0.00001), "0.00001");
+    EXPECT_EQ(to_chars<float>(0.0001F), "0.0001");
+    EXPECT_EQ(to_chars<double>(1.2345678901234568e17), "123456789012345680");
+    EXPECT_EQ(to_chars<double>(-2.5e-7), "-0.00000025");
+    EXPECT_EQ(to_chars<float>(1.24F), "1.24");
+    EXPECT_EQ(to_chars<double>(0.1 + 0.2), "0.30000000000000004");
+}
+
+TEST_F(StringUtilsTest, ToBuffer) {
+    using namespace booleval::utils;
+
+    std::array<char, max_chars<double>> buffer;
+    EXPECT_EQ(to_chars(buffer, 1.234567), "1.234567");
+    auto const lowest = to_chars(buffer, std::numeric_limits<double>::lowest());
+    EXPECT_EQ(lowest.size(), 310U);
+    EXPECT_EQ(lowest.substr(0, 18), "-17976931348623157");
+    EXPECT_EQ(to_chars(buffer, 1e23), "99999999999999991611392");
+    EXPECT_EQ(to_chars(buffer, std::numeric_limits<double>::denorm_min()), "0." + std::string(323, '0') + "5");
+
+    std::array<char, max_chars<int64_t>> int_buffer;
+    EXPECT_EQ(to_chars(int_buffer, std::numeric_limits<int64_t>::min()), "-9223372036854775808");
+
+    std::array<char, 2> small_buffer;
+    EXPECT_EQ(to_chars(small_buffer, 1.234567), "");
+}
+
+TEST_F(StringUtilsTest, BundledFloatingPointParsing) {
+    using namespace booleval::utils;
+
+    EXPECT_DOUBLE_EQ(detail::parse_floating_point<double>("1.23456789").value(), 1.23456789);
+    EXPECT_FLOAT_EQ(detail::parse_floating_point<float>("1.23456789").value(), 1.23456789F);
+    EXPECT_EQ(detail::parse_floating_point<double>("0.1").value(), 0.1);
+    EXPECT_EQ(detail::parse_floating_point<double>("-2.5e2").value(), -250.0);
+    EXPECT_EQ(detail::parse_floating_point<double>("123456789012345678901234").value(), 123456789012345678901234.0);
+    EXPECT_EQ(detail::parse_floating_point<double>("1e-300").value(), 1e-300);
+    EXPECT_EQ(detail::parse_floating_point<double>("1.5abc").value(), 1.5);
+    EXPECT_TRUE(std::isinf(detail::parse_floating_point<double>("-inf").value()));
+    EXPECT_TRUE(std::isnan(detail::parse_floating_point<double>("nan").value()));
+    EXPECT_EQ(detail::parse_floating_point<double>("abc"), std::nullopt);
+    EXPECT_EQ(detail::parse_floating_point<double>("."), std::nullopt);
+}
+
+TEST_F(StringUtilsTest, BundledFloatingPointFormatting) {
+    using namespace booleval::utils;
+
+    auto format = [](auto const value) {
+        std::array<char, max_chars<decltype(value)>> buffer;
+        auto end = detail::format_floating_point(buffer.data(), buffer.data() + buffer.size(), value);
+        return std::string(buffer.data(), end);
+    };
+
+    EXPECT_EQ(format(1.234567), "1.234567");
+    EXPECT_EQ(format(1.234567F), "1.234567");
+    EXPECT_EQ(format(0.1 + 0.2), "0.30000000000000004");
+    EXPECT_EQ(format(1e20), "100000000000000000000");
+    EXPECT_EQ(format(0.0001), "0.0001");
+    EXPECT_EQ(format(0.00001F), "0.00001");
+    EXPECT_EQ(format(1.2345678901234568e17), "123456789012345680");
+    EXPECT_EQ(format(-2.5e-7), "-0.00000025");
+    EXPECT_EQ(format(-0.0), "-0");
+    EXPECT_EQ(format(0.0), "0");
+    EXPECT_EQ(format(std::numeric_limits<double>::max()).size(), 309U);
+    EXPECT_EQ(format(std::numeric_limits<double>::max()).substr(0, 17), "17976931348623157");
+    EXPECT_EQ(format(1e23), "99999999999999991611392");
+    EXPECT_EQ(format(std::numeric_limits<double>::denorm_min()), "0." + std::string(323, '0') + "5");
+    EXPECT_EQ(format(std::numeric_limits<float>::denorm_min()), "0." + std::string(44, '0') + "1");
+    EXPECT_EQ(format(-std::numeric_limits<double>::infinity()), "-inf");
+
+    std::array<char, 2> buffer;
+    EXPECT_EQ(detail::format_floating_point(buffer.data(), buffer.data() + buffer.size(), 1.5), nullptr);
+}
+
+TEST_F(StringUtilsTest, FromExact) {
+    using namespace booleval::utils;
+
+    EXPECT_EQ(from_chars_exact<int64_t>("123").value(), 123);
+    EXPECT_EQ(from_chars_exact<int64_t>("123abc"), std::nullopt);
+    EXPECT_DOUBLE_EQ(from_chars_exact<double>("1.5").value(), 1.5);
+    EXPECT_EQ(from_chars_exact<double>("1.5.2"), std::nullopt);
+    EXPECT_EQ(from_chars_exact<double>(""), std::nullopt);
+
+    std::size_t length{ 0 };
+    EXPECT_DOUBLE_EQ(from_chars<double>("2.5e1 rest", length).value(), 25.0);
+    EXPECT_EQ(length, 5U);
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <string>
+#include <vector>
+#include <variant>
+#include <gtest/gtest.h>
+#include <booleval/variant_evaluator.hpp>
+
+class VariantEvaluatorTest : public testing::Test {
+public:
+    struct login_event {
+        std::string user;
+        bool success{ false };
+        std::string const& source() const noexcept { return user; }
+    };
+
+    struct http_event {
+        std::string host;
+        unsigned status{ 0 };
+        std::string user;
+    };
+
+    struct metric_event {
+        std::string name;
+        double value{ 0 };
+    };
+
+    using event = std::variant<login_event, http_event, metric_event>;
+};
+
+TEST_F(VariantEvaluatorTest, DefaultConstructor) {
+    booleval::variant_evaluator<event> evaluator;
+    EXPECT_FALSE(evaluator.is_activated());
+    EXPECT_FALSE(evaluator.evaluate(event{ metric_event{ "cpu", 0.5 } }));
+
+    EXPECT_TRUE(evaluator.expression(""));
+    EXPECT_FALSE(evaluator.is_activated());
+    EXPECT_FALSE(evaluator.expression("(user foo"));
+    EXPECT_FALSE(evaluator.is_activated());
+}
+
+TEST_F(VariantEvaluatorTest, Evaluate) {
+    booleval::variant_evaluator<event> evaluator;
+    evaluator.fields<login_event>({ { "user", &login_event::user } });
+    evaluator.fields<http_event>({
+        { "host",   &http_event::host },
+        { "status", &http_event::status },
+        { "user",   &http_event::user }
+    });
+    evaluator.fields<metric_event>({
+        { "name",  &metric_event::name },
+        { "value", &metric_event::value }
+    });
+
+    EXPECT_TRUE(evaluator.expression("user admin or status >= 500 or (name cpu and value > 0.9)"));
+    EXPECT_TRUE(evaluator.is_activated());
+
+    std::vector<std::pair<event, bool>> const events{
+        { login_event{ "admin", true }, true },
+        { login_event{ "guest", true }, false },
+        { http_event{ "example.com", 503, "guest" }, true },
+        { http_event{ "example.com", 200, "admin" }, true },
+        { http_event{ "example.com", 200, "guest" }, false },
+        { metric_event{ "cpu", 0.95 }, true },
+        { metric_event{ "cpu", 0.5 }, false },
+        { metric_event{ "memory", 0.95 }, false }
+    };
+
+    for (auto const& [e, expected] : events) {
+        EXPECT_EQ(evaluator.evaluate(e), expected) << e.index();
+    }
+}
+
+TEST_F(VariantEvaluatorTest, MissingFieldsAreNull) {
+    booleval::variant_evaluator<event> evaluator;
+    evaluator.fields<login_event>({ { "user", &login_event::source } });
+    evaluator.fields<http_event>({ { "user", &http_event::user }, { "status", &http_event::status } });
+
+    EXPECT_TRUE(evaluator.expression("status is null"));
+    EXPECT_TRUE(evaluator.evaluate(event{ login_event{ "admin", true } }));
+    EXPECT_FALSE(evaluator.evaluate(event{ http_event{ "example.com", 200, "admin" } }));
+    EXPECT_TRUE(evaluator.evaluate(event{ metric_event{ "cpu", 0.5 } }));
+
+    EXPECT_TRUE(evaluator.expression("status neq 200 or user is not null"));
+    EXPECT_TRUE(evaluator.evaluate(event{ login_event{ "admin", true } }));
+    EXPECT_TRUE(evaluator.evaluate(event{ http_event{ "example.com", 200, "admin" } }));
+    EXPECT_TRUE(evaluator.evaluate(event{ http_event{ "example.com", 404, "admin" } }));
+    EXPECT_FALSE(evaluator.evaluate(event{ metric_event{ "cpu", 0.5 } }));
+
+    EXPECT_TRUE(evaluator.alternative<metric_event>().is_activated());
+}
+
+TEST_F(VariantEvaluatorTest, SharedExpressionTree) {
+    booleval::variant_evaluator<event> evaluator;
+    evaluator.fields<login_event>({ { "user", &login_event::user } });
+    evaluator.fields<http_event>({ { "user", &http_event::user } });
+
+    EXPECT_TRUE(evaluator.expression("user admin"));
+    auto const copy = evaluator;
+    EXPECT_TRUE(evaluator.expression("user guest"));
+
+    EXPECT_TRUE(copy.evaluate(event{ http_event{ "example.com", 200, "admin" } }));
+    EXPECT_FALSE(copy.evaluate(event{ login_event{ "guest", true } }));
+    EXPECT_TRUE(evaluator.evaluate(event{ login_event{ "guest", true } }));
+    EXPECT_FALSE(evaluator.evaluate(event{ metric_event{ "cpu", 0.5 } }));
+
+    EXPECT_EQ(evaluator.alternative<login_event>().referenced_fields(),
+              evaluator.alternative<metric_event>().referenced_fields());
+
+    EXPECT_FALSE(evaluator.expression("user"));
+    EXPECT_FALSE(evaluator.alternative<http_event>().is_activated());
+    EXPECT_TRUE(copy.alternative<http_event>().is_activated());
+}
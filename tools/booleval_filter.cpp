@@ -0,0 +1,534 @@
+/*
+ * Copyright (c) 2020, Marin Peko
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above
+ *   copyright notice, this list of conditions and the following disclaimer
+ *   in the documentation and/or other materials provided with the
+ *   distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <iostream>
+#include <optional>
+#include <memory>
+#include <thread>
+#include <algorithm>
+#include <functional>
+#include <system_error>
+#include <string_view>
+#include <booleval/exceptions.hpp>
+#include <booleval/io/csv_filter.hpp>
+#include <booleval/io/mapped_file.hpp>
+#include <booleval/io/binary_filter.hpp>
+#include <booleval/io/ndjson_filter.hpp>
+#include <booleval/io/stream_reader.hpp>
+#include <booleval/parallel/thread_pool.hpp>
+
+namespace {
+
+/**
+ * Minimum size of the input part processed by a single task.
+ */
+constexpr std::size_t min_task_size{ 1 << 20 };
+
+/**
+ * Size of the chunks read from the standard input.
+ */
+constexpr std::size_t stdin_chunk_size{ 16 << 20 };
+
+enum class input_format {
+    csv,
+    tsv,
+    ndjson,
+    binary
+};
+
+struct options {
+    std::string expression;
+    std::string path;
+    std::string schema_path;
+    std::optional<input_format> format;
+    std::size_t threads{ 1 };
+    bool count{ false };
+    bool stats{ false };
+};
+
+/**
+ * struct chunk_result
+ *
+ * Represents the result of filtering a part of the input.
+ */
+struct chunk_result {
+    std::size_t records{ 0 };
+    std::size_t matches{ 0 };
+    std::string output;
+};
+
+/**
+ * Filters the part of the input consisting of complete records and appends
+ * the matching ones to the output (unless only counting).
+ */
+using chunk_filter = std::function<void(std::string_view, chunk_result&)>;
+
+/**
+ * Gets the last record boundary at or before the position.
+ */
+using record_boundary = std::function<std::size_t(std::string_view, std::size_t)>;
+
+void print_usage(char const* program) {
+    std::cerr
+        << "Usage: " << program << " [options] <expression> [file]\n"
+        << "\n"
+        << "Filters the records of the file (or of the standard input if the file\n"
+        << "is omitted or '-') and writes the matching ones to the standard output.\n"
+        << "\n"
+        << "Options:\n"
+        << "  -f, --format <format>  Input format: csv, tsv, ndjson or binary. If omitted,\n"
+        << "                         it is deduced from the file extension, otherwise ndjson\n"
+        << "  -s, --schema <file>    Schema of the fixed-size binary records, one field\n"
+        << "                         per line: <name> <type> <offset> [little|big]\n"
+        << "  -t, --threads <n>      Number of threads (0 = number of cores, default 1)\n"
+        << "  -c, --count            Print the number of matching records only\n"
+        << "      --stats            Print the filtering statistics to the standard error\n"
+        << "  -h, --help             Print this help\n";
+}
+
+[[nodiscard]] std::optional<input_format> parse_format(std::string_view name) {
+    if ("csv" == name) {
+        return input_format::csv;
+    } else if ("tsv" == name) {
+        return input_format::tsv;
+    } else if ("ndjson" == name || "jsonl" == name || "json" == name) {
+        return input_format::ndjson;
+    } else if ("binary" == name || "bin" == name) {
+        return input_format::binary;
+    }
+    return std::nullopt;
+}
+
+[[nodiscard]] input_format deduce_format(options const& opts) {
+    if (!opts.schema_path.empty()) {
+        return input_format::binary;
+    }
+
+    auto const dot = opts.path.rfind('.');
+    if (std::string::npos != dot) {
+        auto const format = parse_format(std::string_view(opts.path).substr(dot + 1));
+        if (format) {
+            return format.value();
+        }
+    }
+
+    return input_format::ndjson;
+}
+
+[[nodiscard]] bool parse_arguments(int argc, char* argv[], options& opts) {
+    std::vector<std::string_view> positional;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view const arg(argv[i]);
+        auto const has_value = i + 1 < argc;
+
+        if ("-h" == arg || "--help" == arg) {
+            return false;
+        } else if ("-c" == arg || "--count" == arg) {
+            opts.count = true;
+        } else if ("--stats" == arg) {
+            opts.stats = true;
+        } else if (("-f" == arg || "--format" == arg) && has_value) {
+            opts.format = parse_format(argv[++i]);
+            if (!opts.format) {
+                std::cerr << "Unknown input format '" << argv[i] << "'!" << std::endl;
+                return false;
+            }
+        } else if (("-s" == arg || "--schema" == arg) && has_value) {
+            opts.schema_path = argv[++i];
+        } else if (("-t" == arg || "--threads" == arg) && has_value) {
+            auto const threads = booleval::utils::from_chars_exact<uint32_t>(argv[++i]);
+            if (!threads) {
+                std::cerr << "Invalid number of threads '" << argv[i] << "'!" << std::endl;
+                return false;
+            }
+            opts.threads = 0 == threads.value()
+                ? std::max(1U, std::thread::hardware_concurrency())
+                : threads.value();
+        } else if (arg.size() > 1 && '-' == arg.front()) {
+            std::cerr << "Unknown option '" << arg << "'!" << std::endl;
+            return false;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+
+    if (positional.empty() || positional.size() > 2) {
+        return false;
+    }
+
+    opts.expression = positional[0];
+    if (2 == positional.size() && "-" != positional[1]) {
+        opts.path = positional[1];
+    }
+
+    if (!opts.format) {
+        opts.format = deduce_format(opts);
+    }
+
+    if (input_format::binary == opts.format && opts.schema_path.empty()) {
+        std::cerr << "Binary input requires the schema!" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+[[nodiscard]] std::optional<std::string> read_file(std::string const& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return std::nullopt;
+    }
+
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+void write(std::string_view data) {
+    std::fwrite(data.data(), 1, data.size(), stdout);
+}
+
+[[nodiscard]] std::size_t line_boundary(std::string_view data, std::size_t const position) {
+    if (0 == position || data.empty()) {
+        return 0;
+    }
+
+    auto const newline = data.rfind('\n', std::min(position, data.size()) - 1);
+    return std::string_view::npos == newline ? 0 : newline + 1;
+}
+
+[[nodiscard]] std::size_t count_lines(std::string_view data) {
+    auto const lines = static_cast<std::size_t>(std::count(data.begin(), data.end(), '\n'));
+    return !data.empty() && '\n' != data.back() ? lines + 1 : lines;
+}
+
+/**
+ * class filter_runner
+ *
+ * Represents the driver that splits the input into parts processed
+ * in parallel and writes the results in the order of the input.
+ */
+class filter_runner {
+public:
+    filter_runner(options const& opts, chunk_filter filter, record_boundary boundary)
+        : opts_(opts),
+          filter_(std::move(filter)),
+          boundary_(std::move(boundary))
+    {
+        if (opts_.threads > 1) {
+            // The calling thread helps executing the tasks
+            pool_ = std::make_unique<booleval::parallel::thread_pool>(opts_.threads - 1);
+        }
+    }
+
+    /**
+     * Filters the part of the input consisting of complete records.
+     *
+     * @param data Part of the input
+     */
+    void run(std::string_view data) {
+        bytes_ += data.size();
+
+        auto const tasks = nullptr == pool_
+            ? std::size_t{ 1 }
+            : std::clamp<std::size_t>(data.size() / min_task_size, 1, 4 * opts_.threads);
+
+        std::vector<chunk_result> results(tasks);
+        if (1 == tasks) {
+            filter_(data, results.front());
+        } else {
+            std::size_t first{ 0 };
+            for (std::size_t i = 0; i < tasks; ++i) {
+                // Searching from the previous boundary scans the data once in total
+                auto const target = std::max(first, data.size() / tasks * (i + 1));
+                auto const last = i + 1 == tasks
+                    ? data.size()
+                    : first + boundary_(data.substr(first), target - first);
+                auto const chunk = data.substr(first, last - first);
+                pool_->submit([this, chunk, &result = results[i]] { filter_(chunk, result); });
+                first = last;
+            }
+            pool_->wait();
+        }
+
+        for (auto const& result : results) {
+            records_ += result.records;
+            matches_ += result.matches;
+            write(result.output);
+        }
+    }
+
+    [[nodiscard]] std::size_t records() const noexcept { return records_; }
+    [[nodiscard]] std::size_t matches() const noexcept { return matches_; }
+    [[nodiscard]] std::size_t bytes() const noexcept { return bytes_; }
+
+private:
+    options const& opts_;
+    chunk_filter filter_;
+    record_boundary boundary_;
+    std::unique_ptr<booleval::parallel::thread_pool> pool_;
+    std::size_t records_{ 0 };
+    std::size_t matches_{ 0 };
+    std::size_t bytes_{ 0 };
+};
+
+/**
+ * Filters the whole input, either mapped into memory or read from the standard
+ * input in chunks. The header, if the format has one, is passed to the function
+ * before filtering. The trailing bytes following the last record boundary form
+ * the last record only if the format is line-based.
+ */
+[[nodiscard]] bool process_input(options const& opts, filter_runner& runner,
+                                 record_boundary const& boundary,
+                                 std::function<bool(std::string_view&)> const& header) {
+    auto const line_based = input_format::binary != opts.format;
+    if (!opts.path.empty()) {
+        booleval::io::mapped_file file;
+        if (!file.open(opts.path)) {
+            std::cerr << "Cannot open file '" << opts.path << "'!" << std::endl;
+            return false;
+        }
+
+        auto data = file.data();
+        if (header && !header(data)) {
+            return false;
+        }
+
+        runner.run(line_based ? data : data.substr(0, boundary(data, data.size())));
+        return true;
+    }
+
+    booleval::io::stream_reader reader(0, stdin_chunk_size);
+    auto header_pending = static_cast<bool>(header);
+    auto eof = false;
+
+    while (!eof) {
+        eof = !reader.read();
+
+        auto data = reader.data();
+        if (header_pending) {
+            if (!eof && std::string_view::npos == data.find('\n')) {
+                continue;
+            }
+
+            auto const size = data.size();
+            if (!header(data)) {
+                return false;
+            }
+            reader.consume(size - data.size());
+            header_pending = false;
+        }
+
+        // Complete records only, unless the end of the input is reached
+        auto const complete = eof && line_based ? data.size() : boundary(data, data.size());
+        if (0 != complete) {
+            runner.run(data.substr(0, complete));
+            reader.consume(complete);
+
+            // Matches of a slow stream are written as they are found
+            std::fflush(stdout);
+        }
+    }
+
+    return true;
+}
+
+void print_stats(filter_runner const& runner, double const seconds) {
+    auto const records = static_cast<double>(runner.records());
+    auto const selectivity = 0 == runner.records()
+        ? 0.0
+        : 100.0 * static_cast<double>(runner.matches()) / records;
+
+    std::cerr << std::fixed << std::setprecision(2)
+              << "records:     " << runner.records() << "\n"
+              << "matches:     " << runner.matches() << " (" << selectivity << " %)\n"
+              << "input:       " << static_cast<double>(runner.bytes()) / (1 << 20) << " MiB\n"
+              << "elapsed:     " << std::setprecision(3) << seconds << " s\n"
+              << "throughput:  " << std::setprecision(2)
+              << records / seconds / 1e6 << " M records/s, "
+              << static_cast<double>(runner.bytes()) / seconds / (1 << 20) << " MiB/s" << std::endl;
+}
+
+} // namespace
+
+/**
+ * Filters the records of CSV, TSV, NDJSON or fixed-size binary input.
+ *
+ * Usage: booleval-filter [options] <expression> [file]
+ * E.g.:  booleval-filter --threads 8 --stats "level error and http.status >= 500" app.log
+ */
+int main(int argc, char* argv[]) {
+    using namespace booleval;
+
+    options opts;
+    if (!parse_arguments(argc, argv, opts)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    std::ios::sync_with_stdio(false);
+
+    io::csv_filter csv(input_format::tsv == opts.format ? '\t' : ',');
+    io::ndjson_filter ndjson;
+    io::binary_filter binary;
+
+    chunk_filter filter;
+    record_boundary boundary = line_boundary;
+    std::function<bool(std::string_view&)> header;
+
+    auto const count = opts.count;
+    auto const stats = opts.stats;
+    auto const append = [count](chunk_result& result, std::string_view record, bool const newline) {
+        ++result.matches;
+        if (!count) {
+            result.output.append(record);
+            if (newline) {
+                result.output.push_back('\n');
+            }
+        }
+    };
+
+    try {
+        switch (opts.format.value()) {
+            case input_format::csv:
+            case input_format::tsv:
+                if (!csv.expression(opts.expression)) {
+                    std::cerr << "Expression not valid!" << std::endl;
+                    return 1;
+                }
+
+                header = [&csv, count](std::string_view& data) {
+                    auto const line = io::csv_filter::split_header(data);
+                    if (!csv.header(line)) {
+                        std::cerr << "Fields referenced in the expression are missing from the header!" << std::endl;
+                        return false;
+                    }
+
+                    if (!count) {
+                        write(line);
+                        write("\n");
+                    }
+                    return true;
+                };
+
+                // Quoted values may contain line breaks, so the rows are not split by them
+                boundary = [&csv](std::string_view data, std::size_t const position) {
+                    return csv.row_boundary(data, position);
+                };
+
+                filter = [&csv, &append, stats](std::string_view chunk, chunk_result& result) {
+                    if (stats) {
+                        result.records += csv.count_rows(chunk);
+                    }
+                    csv.for_each_match(chunk, [&](auto const, auto const line) {
+                        append(result, line, true);
+                    });
+                };
+                break;
+
+            case input_format::ndjson:
+                if (!ndjson.expression(opts.expression)) {
+                    std::cerr << "Expression not valid!" << std::endl;
+                    return 1;
+                }
+
+                filter = [&ndjson, &append, stats](std::string_view chunk, chunk_result& result) {
+                    if (stats) {
+                        result.records += count_lines(chunk);
+                    }
+                    ndjson.for_each_match(chunk, [&](auto const line) {
+                        append(result, line, true);
+                    });
+                };
+                break;
+
+            case input_format::binary: {
+                auto const description = read_file(opts.schema_path);
+                if (!description) {
+                    std::cerr << "Cannot read schema '" << opts.schema_path << "'!" << std::endl;
+                    return 1;
+                }
+
+                binary = io::binary_filter(io::binary_schema::parse(description.value()));
+                if (!binary.expression(opts.expression)) {
+                    std::cerr << "Expression not valid!" << std::endl;
+                    return 1;
+                }
+
+                auto const record_size = binary.schema().record_size();
+                boundary = [record_size](std::string_view data, std::size_t const position) {
+                    return std::min(position, data.size()) / record_size * record_size;
+                };
+
+                filter = [&binary, &append, record_size](std::string_view chunk, chunk_result& result) {
+                    result.records += chunk.size() / record_size;
+                    binary.for_each_match(chunk, [&](auto const, auto const& record) {
+                        append(result, std::string_view(reinterpret_cast<char const*>(record.data()), record.size()), false);
+                    });
+                };
+                break;
+            }
+        }
+    } catch (base_exception const& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+
+    filter_runner runner(opts, filter, boundary);
+    try {
+        if (!process_input(opts, runner, boundary, header)) {
+            return 1;
+        }
+    } catch (std::system_error const& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    if (opts.count) {
+        std::cout << runner.matches() << std::endl;
+    }
+    std::fflush(stdout);
+
+    if (opts.stats) {
+        auto const end = std::chrono::steady_clock::now();
+        print_stats(runner, std::chrono::duration<double>(end - start).count());
+    }
+
+    return 0;
+}